@@ -0,0 +1,148 @@
+/**
+ *  @file analysis.cc
+ *
+ *  @brief Signal comparison and spectral analysis of rendered audio
+ *
+ */
+
+#include "analysis.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+namespace hostsim {
+
+  namespace {
+
+    const size_t k_spectrum_size = 4096;
+
+  }  // namespace
+
+  void fft(std::vector<std::complex<double> > & x) {
+    const size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+      size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+        j ^= bit;
+      j ^= bit;
+      if (i < j)
+        std::swap(x[i], x[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+      const double a = -2.0 * M_PI / len;
+      const std::complex<double> wl(cos(a), sin(a));
+      for (size_t i = 0; i < n; i += len) {
+        std::complex<double> w(1.0, 0.0);
+        for (size_t k = 0; k < len / 2; ++k) {
+          const std::complex<double> u = x[i + k];
+          const std::complex<double> v = x[i + k + len / 2] * w;
+          x[i + k] = u + v;
+          x[i + k + len / 2] = u - v;
+          w *= wl;
+        }
+      }
+    }
+  }
+
+  double power_db(double ratio) {
+    if (ratio <= 1e-30)
+      return -300.0;
+    if (ratio >= 1e30)
+      return 300.0;
+    return 10.0 * log10(ratio);
+  }
+
+  std::vector<double> power_spectrum_db(const WavData & wav, uint16_t channel, size_t size) {
+    const size_t frames = wav.frames();
+    std::vector<double> power(size / 2 + 1, 0.0);
+    std::vector<double> window(size);
+    for (size_t i = 0; i < size; ++i)
+      window[i] = 0.5 - 0.5 * cos(2.0 * M_PI * i / size);
+
+    std::vector<std::complex<double> > buf(size);
+    size_t segments = 0;
+    for (size_t start = 0; start + size <= frames || (segments == 0 && start < std::max<size_t>(frames, 1));
+         start += size / 2) {
+      for (size_t i = 0; i < size; ++i) {
+        const size_t f = start + i;
+        const double s = (f < frames) ? wav.samples[f * wav.channels + channel] : 0.0;
+        buf[i] = std::complex<double>(s * window[i], 0.0);
+      }
+      fft(buf);
+      for (size_t k = 0; k < power.size(); ++k)
+        power[k] += std::norm(buf[k]);
+      ++segments;
+    }
+    for (size_t k = 0; k < power.size(); ++k)
+      power[k] = power_db(power[k] / std::max<size_t>(segments, 1));
+    return power;
+  }
+
+  SignalDiff compare_signals(const WavData & ref, const WavData & test, size_t block,
+                             double floor_db, double spectrum_range_db) {
+    SignalDiff d;
+    const size_t frames = std::min(ref.frames(), test.frames());
+    const uint16_t channels = std::min(ref.channels, test.channels);
+    d.length_mismatch = ref.frames() != test.frames() || ref.channels != test.channels;
+    block = std::max<size_t>(block, 1);
+
+    const double floor_power = pow(10.0, floor_db / 10.0);
+    double sig_total = 0, err_total = 0;
+    bool have_block = false;
+    for (size_t b = 0; b * block < frames; ++b) {
+      double sig = 0, err = 0;
+      const size_t end = std::min(frames, (b + 1) * block);
+      for (size_t f = b * block; f < end; ++f) {
+        for (uint16_t ch = 0; ch < channels; ++ch) {
+          const double r = ref.samples[f * ref.channels + ch];
+          const double e = test.samples[f * test.channels + ch] - r;
+          sig += r * r;
+          err += e * e;
+          if (fabs(e) > d.max_abs_error || e != e) {
+            d.max_abs_error = (e != e) ? INFINITY : fabs(e);
+            d.max_error_frame = f;
+          }
+          d.ref_peak = std::max(d.ref_peak, fabs(r));
+        }
+      }
+      sig_total += sig;
+      err_total += err;
+      const double n = static_cast<double>((end - b * block) * channels);
+      if (sig / n < floor_power)
+        continue;
+      const double snr = (err > 0) ? power_db(sig / err) : 300.0;
+      if (!have_block || snr < d.worst_block_snr_db) {
+        d.worst_block_snr_db = snr;
+        d.worst_block = b;
+        have_block = true;
+      }
+    }
+    if (!have_block)
+      d.worst_block_snr_db = 300.0;
+    d.snr_db = (err_total > 0) ? power_db(sig_total / err_total) : 300.0;
+    if (err_total != err_total)
+      d.snr_db = d.worst_block_snr_db = -300.0;
+
+    // Spectra of the full signals, so that changes hidden in phase still show up in level
+    for (uint16_t ch = 0; ch < channels; ++ch) {
+      const std::vector<double> a = power_spectrum_db(ref, ch, k_spectrum_size);
+      const std::vector<double> b = power_spectrum_db(test, ch, k_spectrum_size);
+      const double peak = *std::max_element(a.begin(), a.end());
+      double sum = 0;
+      size_t count = 0;
+      for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k] < peak - spectrum_range_db && b[k] < peak - spectrum_range_db)
+          continue;
+        const double diff = fabs(a[k] - b[k]);
+        d.spectral_max_db = std::max(d.spectral_max_db, diff);
+        sum += diff;
+        ++count;
+      }
+      if (count)
+        d.spectral_mean_db = std::max(d.spectral_mean_db, sum / count);
+    }
+    return d;
+  }
+
+}  // namespace hostsim
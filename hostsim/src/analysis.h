@@ -0,0 +1,60 @@
+/**
+ *  @file analysis.h
+ *
+ *  @brief Signal comparison and spectral analysis of rendered audio
+ *
+ */
+
+#ifndef HOSTSIM_ANALYSIS_H_
+#define HOSTSIM_ANALYSIS_H_
+
+#include <complex>
+#include <vector>
+
+#include "wav.h"
+
+namespace hostsim {
+
+  /** In place radix-2 FFT, size must be a power of two. */
+  void fft(std::vector<std::complex<double> > & x);
+
+  /**
+   * Averaged power spectrum of one channel (Welch, Hann window, 50% overlap), in dB.
+   * Returns size / 2 + 1 bins.
+   */
+  std::vector<double> power_spectrum_db(const WavData & wav, uint16_t channel, size_t size);
+
+  /** Differences between a reference and a test signal of the same layout. */
+  struct SignalDiff {
+    double snr_db;               /** Over the whole signal, infinite if identical. */
+    double worst_block_snr_db;   /** Lowest SNR of blocks whose reference is above the block floor. */
+    size_t worst_block;          /** Index of that block. */
+    double max_abs_error;
+    size_t max_error_frame;
+    double spectral_max_db;      /** Largest spectrum difference in bins within range of the reference peak. */
+    double spectral_mean_db;     /** Mean absolute spectrum difference over those bins. */
+    double ref_peak;
+    bool length_mismatch;
+
+    SignalDiff() :
+      snr_db(0), worst_block_snr_db(0), worst_block(0), max_abs_error(0), max_error_frame(0),
+      spectral_max_db(0), spectral_mean_db(0), ref_peak(0), length_mismatch(false)
+    { }
+  };
+
+  /**
+   * Compare test against ref block by block.
+   *
+   * @param block        Frames per block for the per-block SNR.
+   * @param floor_db     Blocks with a reference RMS below this level (dBFS) do not count toward the worst block SNR.
+   * @param spectrum_range_db Spectrum bins more than this far below the reference peak are ignored.
+   */
+  SignalDiff compare_signals(const WavData & ref, const WavData & test, size_t block,
+                             double floor_db = -80.0, double spectrum_range_db = 90.0);
+
+  /** Decibels of a power ratio, clamped to +-300 dB. */
+  double power_db(double ratio);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_ANALYSIS_H_
@@ -0,0 +1,150 @@
+/**
+ *  @file cli.cc
+ *
+ *  @brief Command line helpers shared by hostsim commands
+ *
+ */
+
+#include "cli.h"
+#include "preset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace hostsim {
+
+  const char * const k_render_options_usage =
+    "  -s <seconds>     Length of rendered audio (default 4)\n"
+    "  -b <frames>      Frames per unit_render call (default 64)\n"
+    "  -n <note>|none   Note sent at start (default 60)\n"
+    "  -v <velocity>    Note on velocity (default 100)\n"
+    "  -g <seconds>     Note length, held if omitted\n"
+    "  -t <bpm>         Tempo (default 120)\n"
+    "  -p <id>=<value>  Set parameter, may be repeated\n"
+    "  --preset <json>  Note and parameters from a preset written by search\n"
+    "  --trace <file>   Replay a callback trace instead of the note and clock, sets -s\n"
+    "  --sdram <bytes>  SDRAM pool size (default: module limit)\n";
+
+  namespace {
+
+    bool parse_double(const char * s, double * v) {
+      char * end;
+      *v = strtod(s, &end);
+      return end != s && *end == '\0';
+    }
+
+    bool parse_long(const char * s, long * v) {
+      char * end;
+      *v = strtol(s, &end, 0);
+      return end != s && *end == '\0';
+    }
+
+  }  // namespace
+
+  int parse_render_option(int argc, char ** argv, int * i, RenderOptions * opt) {
+    const char * arg = argv[*i];
+    static const char * const with_value[] = { "-s", "-b", "-n", "-v", "-g", "-t", "-p", "--preset", "--trace", "--sdram" };
+    bool known = false;
+    for (size_t k = 0; k < sizeof(with_value) / sizeof(with_value[0]); ++k)
+      known |= !strcmp(arg, with_value[k]);
+    if (!known)
+      return 0;
+    if (*i + 1 >= argc) {
+      fprintf(stderr, "missing value for %s\n", arg);
+      return -1;
+    }
+    const char * val = argv[++(*i)];
+    double d;
+    long l;
+    bool ok = true;
+
+    if (!strcmp(arg, "-s")) {
+      ok = parse_double(val, &d) && d > 0;
+      if (ok)
+        opt->seconds = d;
+    }
+    else if (!strcmp(arg, "-b")) {
+      ok = parse_long(val, &l) && l > 0 && l <= 4096;
+      if (ok)
+        opt->frames_per_buffer = static_cast<uint16_t>(l);
+    }
+    else if (!strcmp(arg, "-n")) {
+      if (!strcmp(val, "none"))
+        opt->note = -1;
+      else if ((ok = parse_long(val, &l) && l >= 0 && l < 128))
+        opt->note = static_cast<int>(l);
+    }
+    else if (!strcmp(arg, "-v")) {
+      ok = parse_long(val, &l) && l >= 0 && l < 128;
+      if (ok)
+        opt->velocity = static_cast<uint8_t>(l);
+    }
+    else if (!strcmp(arg, "-g")) {
+      ok = parse_double(val, &d) && d >= 0;
+      if (ok)
+        opt->gate_seconds = d;
+    }
+    else if (!strcmp(arg, "-t")) {
+      ok = parse_double(val, &d) && d > 0;
+      if (ok)
+        opt->bpm = static_cast<float>(d);
+    }
+    else if (!strcmp(arg, "-p")) {
+      const char * eq = strchr(val, '=');
+      long id;
+      ok = eq && parse_long(std::string(val, eq).c_str(), &id) && id >= 0 && id < UNIT_MAX_PARAM_COUNT
+        && parse_long(eq + 1, &l);
+      if (ok)
+        opt->params.push_back(std::make_pair(static_cast<uint8_t>(id), static_cast<int32_t>(l)));
+    }
+    else if (!strcmp(arg, "--preset")) {
+      std::string err;
+      if (!preset_read(val, opt, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return -1;
+      }
+    }
+    else if (!strcmp(arg, "--trace")) {
+      Trace trace;
+      std::string err;
+      if (!trace_read(val, &trace, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return -1;
+      }
+      opt->trace.swap(trace.events);
+      opt->seconds = static_cast<double>(trace.length) / k_samplerate;
+    }
+    else if (!strcmp(arg, "--sdram")) {
+      ok = parse_long(val, &l) && l >= 0;
+      if (ok)
+        opt->sdram_size = static_cast<size_t>(l);
+    }
+
+    if (!ok) {
+      fprintf(stderr, "invalid value for %s: %s\n", arg, val);
+      return -1;
+    }
+    return 1;
+  }
+
+  bool open_unit(HostUnit & unit, const std::string & path, const RenderOptions & opt) {
+    std::string err;
+    if (!unit.load(path, &err)) {
+      fprintf(stderr, "%s: %s\n", path.c_str(), err.c_str());
+      return false;
+    }
+    set_tempo_bpm(opt.bpm);
+    const int8_t res = unit.init(opt.frames_per_buffer, opt.sdram_size);
+    if (res != k_unit_err_none) {
+      fprintf(stderr, "%s: unit_init failed with k_unit_err_%s (%d)", unit.name().c_str(), unit_err_name(res), res);
+      if (unit.sdram() && unit.sdram()->failed())
+        fprintf(stderr, ", %zu SDRAM allocation(s) did not fit in %zu bytes",
+                unit.sdram()->failed(), unit.sdram()->capacity());
+      fprintf(stderr, "\n");
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,47 @@
+/**
+ *  @file cli.h
+ *
+ *  @brief Command line helpers shared by hostsim commands
+ *
+ */
+
+#ifndef HOSTSIM_CLI_H_
+#define HOSTSIM_CLI_H_
+
+#include <string>
+
+#include "host_unit.h"
+#include "render.h"
+
+namespace hostsim {
+
+  /** Commands, each implemented in its own translation unit. */
+  int cmd_render(int argc, char ** argv);
+  int cmd_bench(int argc, char ** argv);
+  int cmd_search(int argc, char ** argv);
+  int cmd_footprint(int argc, char ** argv);
+  int cmd_compare(int argc, char ** argv);
+  int cmd_trace(int argc, char ** argv);
+  int cmd_batch(int argc, char ** argv);
+  int cmd_chain(int argc, char ** argv);
+  int cmd_storage(int argc, char ** argv);
+  int cmd_oversample(int argc, char ** argv);
+  int cmd_approx(int argc, char ** argv);
+  int cmd_convolve(int argc, char ** argv);
+
+  /**
+   * Consume a render option at argv[*i] if it is one, advancing *i past its value.
+   *
+   * @return 1 if consumed, 0 if not a render option, -1 on a malformed value (reported on stderr).
+   */
+  int parse_render_option(int argc, char ** argv, int * i, RenderOptions * opt);
+
+  /** Usage text for the options accepted by parse_render_option. */
+  extern const char * const k_render_options_usage;
+
+  /** Load and initialize a unit, reporting failures on stderr. */
+  bool open_unit(HostUnit & unit, const std::string & path, const RenderOptions & opt);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_CLI_H_
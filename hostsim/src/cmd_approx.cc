@@ -0,0 +1,249 @@
+/**
+ *  @file cmd_approx.cc
+ *
+ *  @brief hostsim approx: max error and cost of the dsp::approx tiers and the float_math.h approximations
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "json.h"
+
+#include "utils/float_math.h"
+#include "dsp/approx.hpp"
+
+namespace hostsim {
+
+  namespace {
+
+    namespace ap = dsp::approx;
+
+    const uint32_t k_points = 1 << 18;
+    const uint32_t k_pow_exponents = 61;  // p in [-3, 3] by 0.1
+    const int k_bench_runs = 10;
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim approx [options]\n"
+              "  -j <file.json>           Write the results as JSON\n");
+    }
+
+    typedef void (*Kernel)(const float * in, float * out, uint32_t n, float p);
+    typedef double (*Reference)(double x, double p);
+
+    enum Domain { k_exp2, k_log2, k_angle, k_tanh, k_sigmoid, k_pow };
+
+    struct Case {
+      const char * function;
+      const char * tier;
+      Domain domain;
+      bool relative;
+      Kernel kernel;
+      Reference reference;
+    };
+
+    struct Result {
+      const Case * c;
+      double max_error;
+      double worst_x;
+      double worst_p;
+      double ns_per_sample;
+    };
+
+    /* Reference functions in double precision */
+    double ref_exp2(double x, double) { return exp2(x); }
+    double ref_log2(double x, double) { return log2(x); }
+    double ref_sin(double x, double) { return sin(x); }
+    double ref_cos(double x, double) { return cos(x); }
+    double ref_tanh(double x, double) { return tanh(x); }
+    double ref_sigmoid(double x, double) { return 1.0 / (1.0 + exp(-x)); }
+    double ref_pow(double x, double p) { return pow(x, p); }
+
+    /* dsp::approx block forms */
+    template <ap::Tier T> void k_ap_exp2(const float * in, float * out, uint32_t n, float) { ap::exp2<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_log2(const float * in, float * out, uint32_t n, float) { ap::log2<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_sin(const float * in, float * out, uint32_t n, float) { ap::sin<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_cos(const float * in, float * out, uint32_t n, float) { ap::cos<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_tanh(const float * in, float * out, uint32_t n, float) { ap::tanh<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_sigmoid(const float * in, float * out, uint32_t n, float) { ap::sigmoid<T>(in, out, n); }
+    template <ap::Tier T> void k_ap_pow(const float * in, float * out, uint32_t n, float p) { ap::pow<T>(in, p, out, n); }
+
+    /* float_math.h functions, in the same loop for comparison */
+#define HOSTSIM_APPROX_KERNEL(fn)                                           \
+    void k_##fn(const float * in, float * out, uint32_t n, float) {         \
+      for (uint32_t i = 0; i < n; ++i)                                      \
+        out[i] = fn(in[i]);                                                 \
+    }
+    HOSTSIM_APPROX_KERNEL(fastpow2f)
+    HOSTSIM_APPROX_KERNEL(fasterpow2f)
+    HOSTSIM_APPROX_KERNEL(fastlog2f)
+    HOSTSIM_APPROX_KERNEL(fasterlog2f)
+    HOSTSIM_APPROX_KERNEL(fastsinf)
+    HOSTSIM_APPROX_KERNEL(fastersinf)
+    HOSTSIM_APPROX_KERNEL(fastersinfullf)
+    HOSTSIM_APPROX_KERNEL(fastertanhf)
+    HOSTSIM_APPROX_KERNEL(fastertanh2f)
+#undef HOSTSIM_APPROX_KERNEL
+    void k_fastpowf(const float * in, float * out, uint32_t n, float p) {
+      for (uint32_t i = 0; i < n; ++i)
+        out[i] = fastpowf(in[i], p);
+    }
+    void k_fasterpowf(const float * in, float * out, uint32_t n, float p) {
+      for (uint32_t i = 0; i < n; ++i)
+        out[i] = fasterpowf(in[i], p);
+    }
+
+#define HOSTSIM_APPROX_TIERS(name, domain, relative, ref)                                            \
+    { #name, "precise", domain, relative, k_ap_##name<ap::k_precise>, ref },                          \
+    { #name, "fast", domain, relative, k_ap_##name<ap::k_fast>, ref },                                \
+    { #name, "faster", domain, relative, k_ap_##name<ap::k_faster>, ref }
+
+    const Case k_cases[] = {
+      HOSTSIM_APPROX_TIERS(exp2, k_exp2, true, ref_exp2),
+      { "exp2", "fastpow2f", k_exp2, true, k_fastpow2f, ref_exp2 },
+      { "exp2", "fasterpow2f", k_exp2, true, k_fasterpow2f, ref_exp2 },
+      HOSTSIM_APPROX_TIERS(log2, k_log2, false, ref_log2),
+      { "log2", "fastlog2f", k_log2, false, k_fastlog2f, ref_log2 },
+      { "log2", "fasterlog2f", k_log2, false, k_fasterlog2f, ref_log2 },
+      HOSTSIM_APPROX_TIERS(sin, k_angle, false, ref_sin),
+      { "sin", "fastsinf", k_angle, false, k_fastsinf, ref_sin },
+      { "sin", "fastersinf", k_angle, false, k_fastersinf, ref_sin },
+      { "sin", "fastersinfullf", k_angle, false, k_fastersinfullf, ref_sin },
+      HOSTSIM_APPROX_TIERS(cos, k_angle, false, ref_cos),
+      HOSTSIM_APPROX_TIERS(tanh, k_tanh, false, ref_tanh),
+      { "tanh", "fastertanhf", k_tanh, false, k_fastertanhf, ref_tanh },
+      { "tanh", "fastertanh2f", k_tanh, false, k_fastertanh2f, ref_tanh },
+      HOSTSIM_APPROX_TIERS(sigmoid, k_sigmoid, false, ref_sigmoid),
+      HOSTSIM_APPROX_TIERS(pow, k_pow, true, ref_pow),
+      { "pow", "fastpowf", k_pow, true, k_fastpowf, ref_pow },
+      { "pow", "fasterpowf", k_pow, true, k_fasterpowf, ref_pow },
+    };
+#undef HOSTSIM_APPROX_TIERS
+
+    const char * domain_name(Domain d) {
+      switch (d) {
+        case k_exp2:    return "[-20, 20]";
+        case k_log2:    return "[1e-6, 1e6]";
+        case k_angle:   return "[-pi, pi]";
+        case k_tanh:    return "[-8, 8]";
+        case k_sigmoid: return "[-16, 16]";
+        case k_pow:     return "[0.01, 100]^[-3, 3]";
+      }
+      return "";
+    }
+
+    /** Evenly spaced points, log spaced for log2 and pow. */
+    std::vector<float> make_inputs(Domain d) {
+      std::vector<float> x(k_points);
+      for (uint32_t i = 0; i < k_points; ++i) {
+        const double t = static_cast<double>(i) / (k_points - 1);
+        switch (d) {
+          case k_exp2:    x[i] = static_cast<float>(-20.0 + 40.0 * t); break;
+          case k_log2:    x[i] = static_cast<float>(pow(10.0, -6.0 + 12.0 * t)); break;
+          case k_angle:   x[i] = static_cast<float>(M_PI * (2.0 * t - 1.0)); break;
+          case k_tanh:    x[i] = static_cast<float>(-8.0 + 16.0 * t); break;
+          case k_sigmoid: x[i] = static_cast<float>(-16.0 + 32.0 * t); break;
+          case k_pow:     x[i] = static_cast<float>(pow(10.0, -2.0 + 4.0 * t)); break;
+        }
+      }
+      return x;
+    }
+
+    Result measure(const Case & c) {
+      Result r;
+      r.c = &c;
+      r.max_error = 0;
+      r.worst_x = r.worst_p = 0;
+      r.ns_per_sample = HUGE_VAL;
+
+      const std::vector<float> in = make_inputs(c.domain);
+      std::vector<float> out(in.size());
+      const uint32_t exponents = (c.domain == k_pow) ? k_pow_exponents : 1;
+      for (uint32_t e = 0; e < exponents; ++e) {
+        const float p = (c.domain == k_pow) ? static_cast<float>(-3.0 + 0.1 * e) : 0.f;
+        c.kernel(&in[0], &out[0], k_points, p);
+        for (uint32_t i = 0; i < k_points; ++i) {
+          const double ref = c.reference(in[i], p);
+          double err = fabs(out[i] - ref);
+          if (c.relative)
+            err /= fabs(ref);
+          if (!(err <= r.max_error)) {
+            r.max_error = err;
+            r.worst_x = in[i];
+            r.worst_p = p;
+          }
+        }
+      }
+
+      for (int run = 0; run < k_bench_runs; ++run) {
+        const double t0 = now_ns();
+        c.kernel(&in[0], &out[0], k_points, 1.5f);
+        const double ns = (now_ns() - t0) / k_points;
+        if (ns < r.ns_per_sample)
+          r.ns_per_sample = ns;
+      }
+      return r;
+    }
+
+  }  // namespace
+
+  int cmd_approx(int argc, char ** argv) {
+    std::string json_path;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+
+    std::vector<Result> res;
+    for (size_t i = 0; i < sizeof(k_cases) / sizeof(k_cases[0]); ++i)
+      res.push_back(measure(k_cases[i]));
+
+    printf("max error against double libm, rel(ative) or abs(olute), block form cost\n");
+    printf("%-8s %-15s %-20s %-4s %10s %12s %8s\n", "function", "tier", "domain", "", "max error", "at x", "ns/smp");
+    for (size_t r = 0; r < res.size(); ++r) {
+      const Case & c = *res[r].c;
+      printf("%-8s %-15s %-20s %-4s %10.2e %12.5g %8.2f\n", c.function, c.tier, domain_name(c.domain),
+             c.relative ? "rel" : "abs", res[r].max_error, res[r].worst_x, res[r].ns_per_sample);
+    }
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        return 1;
+      }
+      JsonWriter w(fp);
+      w.beginArray();
+      for (size_t r = 0; r < res.size(); ++r) {
+        const Case & c = *res[r].c;
+        w.beginObject();
+        w.field("function", c.function);
+        w.field("tier", c.tier);
+        w.field("domain", domain_name(c.domain));
+        w.field("error", c.relative ? "relative" : "absolute");
+        w.field("max_error", res[r].max_error);
+        w.field("worst_x", res[r].worst_x);
+        if (c.domain == k_pow)
+          w.field("worst_p", res[r].worst_p);
+        w.field("ns_per_sample", res[r].ns_per_sample);
+        w.endObject();
+      }
+      w.endArray();
+      fputc('\n', fp);
+      fclose(fp);
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,404 @@
+/**
+ *  @file cmd_batch.cc
+ *
+ *  @brief hostsim batch: render a regression corpus in parallel
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "isolate.h"
+#include "json.h"
+
+namespace hostsim {
+
+  namespace {
+
+    /** One corpus line, parsed in the parent and inherited by the child that renders it. */
+    struct BatchJob {
+      unsigned line;
+      std::string unit_path;
+      std::string input_path;
+      std::string output_path;
+      RenderOptions opt;
+    };
+
+    /** Result passed back from the child process, plain data only. */
+    struct BatchResult {
+      char name[64];
+      int32_t init_err;
+      uint64_t frames;
+      double ns_per_sample;
+      float peak;
+      uint32_t nonfinite;
+      uint64_t checksum;
+    };
+
+    struct BatchEntry {
+      std::string status;
+      std::string checksum;
+      std::string baseline; // checksum of the same output in the baseline, empty if none
+    };
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim batch <corpus.txt> -o <dir> [options]\n"
+              "  -o <dir>              Output directory for the rendered WAV files\n"
+              "  -P <jobs>             Units rendered in parallel (default: number of CPUs)\n"
+              "  -j <report.json>      Write a JSON report\n"
+              "  --baseline <json>     Report outputs that differ from an earlier report\n"
+              "  --timeout <seconds>   Per job time limit (default 120)\n"
+              "\n"
+              "Each corpus line is '<unit.so> [options]' with the options of render, including\n"
+              "-i <file.wav>, --trace <file> and -o <name.wav>. Relative paths are relative to the\n"
+              "corpus file, -o to the output directory. '#' starts a comment.\n");
+    }
+
+    /** FNV-1a over the sample bits, identical renders give identical checksums. */
+    uint64_t checksum(const float * samples, size_t count) {
+      uint64_t h = 0xCBF29CE484222325ULL;
+      const uint8_t * p = reinterpret_cast<const uint8_t *>(samples);
+      for (size_t i = 0; i < count * sizeof(float); ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ULL;
+      }
+      return h;
+    }
+
+    int batch_child(void * ctx, void * out, size_t size) {
+      const BatchJob & job = *static_cast<BatchJob *>(ctx);
+      BatchResult & r = *static_cast<BatchResult *>(out);
+      (void)size;
+      memset(&r, 0, sizeof(r));
+
+      HostUnit unit;
+      std::string err;
+      if (!unit.load(job.unit_path, &err)) {
+        fprintf(stderr, "%s: %s\n", job.unit_path.c_str(), err.c_str());
+        return 3;
+      }
+      snprintf(r.name, sizeof(r.name), "%s", unit.name().c_str());
+
+      set_tempo_bpm(job.opt.bpm);
+      r.init_err = unit.init(job.opt.frames_per_buffer, job.opt.sdram_size);
+      if (r.init_err != k_unit_err_none)
+        return 0;
+
+      const size_t frames = static_cast<size_t>(job.opt.seconds * k_samplerate);
+      MappedWav input;
+      WavData excitation;
+      const float * in = NULL;
+      size_t in_frames = 0;
+      uint16_t in_channels = 0;
+      if (!job.input_path.empty()) {
+        if (!input.open(job.input_path, &err)) {
+          fprintf(stderr, "%s\n", err.c_str());
+          return 3;
+        }
+        in = input.samples();
+        in_frames = input.frames();
+        in_channels = input.channels();
+      }
+      else if (unit.module() != k_unit_module_osc) {
+        make_excitation(&excitation, frames);
+        in = excitation.samples.data();
+        in_frames = excitation.frames();
+        in_channels = excitation.channels;
+      }
+
+      MappedWav output;
+      if (!output.create(job.output_path, unit.outputChannels(), k_samplerate, frames, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 3;
+      }
+
+      RenderStats stats;
+      render_unit(unit, job.opt, in, in_frames, in_channels, output.samples(), &stats);
+
+      const size_t count = frames * output.channels();
+      const float * s = output.samples();
+      for (size_t i = 0; i < count; ++i) {
+        if (!isfinite(s[i]))
+          ++r.nonfinite;
+        else if (fabsf(s[i]) > r.peak)
+          r.peak = fabsf(s[i]);
+      }
+      r.checksum = checksum(s, count);
+      r.frames = stats.frames;
+      r.ns_per_sample = stats.nsPerSample();
+      return 0;
+    }
+
+    void on_done(size_t index, const IsolatedStatus & st, void * arg) {
+      size_t * finished = static_cast<size_t *>(arg);
+      ++finished[0];
+      fprintf(stderr, "[%zu/%zu] job %zu: %s\n", finished[0], finished[1], index + 1, isolated_status_str(st));
+    }
+
+    bool is_absolute(const std::string & path) {
+      return !path.empty() && path[0] == '/';
+    }
+
+    std::string base_name(const std::string & path) {
+      std::string base = path.substr(path.find_last_of('/') + 1);
+      return base.substr(0, base.rfind(".so"));
+    }
+
+    /**
+     * Split a corpus line into arguments, resolving relative paths against dir.
+     *
+     * @return 1 for a job, 0 for a blank or comment line, -1 on errors (reported on stderr).
+     */
+    int parse_line(const std::string & text, unsigned line, const std::string & dir, const std::string & out_dir,
+                  BatchJob * job) {
+      std::vector<std::string> args;
+      size_t pos = 0;
+      const std::string body = text.substr(0, text.find('#'));
+      while (pos < body.size()) {
+        const size_t start = body.find_first_not_of(" \t\r", pos);
+        if (start == std::string::npos)
+          break;
+        const size_t end = body.find_first_of(" \t\r", start);
+        args.push_back(body.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        pos = end == std::string::npos ? body.size() : end;
+      }
+      if (args.empty())
+        return 0;
+
+      job->line = line;
+      std::string output;
+      for (size_t i = 0; i < args.size(); ++i) {
+        const bool path_value = i > 0 && (args[i - 1] == "-i" || args[i - 1] == "--trace" || args[i - 1] == "--preset");
+        if ((i == 0 || path_value) && !is_absolute(args[i]))
+          args[i] = dir + args[i];
+      }
+      job->unit_path = args[0];
+
+      std::vector<char *> argv;
+      for (size_t i = 1; i < args.size(); ++i)
+        argv.push_back(&args[i][0]);
+      const int argc = static_cast<int>(argv.size());
+      for (int i = 0; i < argc; ++i) {
+        const int r = parse_render_option(argc, argv.data(), &i, &job->opt);
+        if (r < 0)
+          return -1;
+        if (r > 0)
+          continue;
+        if (!strcmp(argv[i], "-i") && i + 1 < argc)
+          job->input_path = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+          output = argv[++i];
+        else {
+          fprintf(stderr, "unknown option %s\n", argv[i]);
+          return -1;
+        }
+      }
+      if (output.empty()) {
+        char prefix[16];
+        snprintf(prefix, sizeof(prefix), "%04u_", line);
+        output = prefix + base_name(job->unit_path) + ".wav";
+      }
+      job->output_path = is_absolute(output) ? output : out_dir + "/" + output;
+      return 1;
+    }
+
+    void write_report(FILE * fp, const std::vector<BatchJob> & jobs, const std::vector<BatchResult> & results,
+                      const std::vector<BatchEntry> & entries) {
+      JsonWriter w(fp);
+      w.beginObject();
+      w.field("samplerate", k_samplerate);
+      w.key("jobs");
+      w.beginArray();
+      for (size_t i = 0; i < jobs.size(); ++i) {
+        const BatchResult & r = results[i];
+        w.beginObject();
+        w.field("line", jobs[i].line);
+        w.field("unit", jobs[i].unit_path);
+        w.field("output", jobs[i].output_path);
+        w.field("status", entries[i].status);
+        if (entries[i].status == "ok") {
+          w.field("frames", static_cast<unsigned long long>(r.frames));
+          w.field("ns_per_sample", r.ns_per_sample);
+          w.field("peak", static_cast<double>(r.peak));
+          w.field("nonfinite", r.nonfinite);
+          w.field("checksum", entries[i].checksum);
+        }
+        w.endObject();
+      }
+      w.endArray();
+      w.endObject();
+    }
+
+  }  // namespace
+
+  int cmd_batch(int argc, char ** argv) {
+    std::string corpus_path, out_dir, json_path, baseline_path;
+    unsigned workers = cpu_count();
+    unsigned timeout_s = 120;
+
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        out_dir = argv[++i];
+      else if (!strcmp(argv[i], "-P") && i + 1 < argc)
+        workers = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+      else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else if (!strcmp(argv[i], "--baseline") && i + 1 < argc)
+        baseline_path = argv[++i];
+      else if (!strcmp(argv[i], "--timeout") && i + 1 < argc)
+        timeout_s = static_cast<unsigned>(atoi(argv[++i]));
+      else if (argv[i][0] != '-' && corpus_path.empty())
+        corpus_path = argv[i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (corpus_path.empty() || out_dir.empty()) {
+      usage();
+      return 2;
+    }
+
+    FILE * fp = fopen(corpus_path.c_str(), "r");
+    if (!fp) {
+      fprintf(stderr, "cannot open %s\n", corpus_path.c_str());
+      return 1;
+    }
+    const size_t slash = corpus_path.find_last_of('/');
+    const std::string dir = slash == std::string::npos ? std::string() : corpus_path.substr(0, slash + 1);
+    std::vector<BatchJob> jobs;
+    char buf[4096];
+    unsigned line = 0;
+    bool ok = true;
+    while (fgets(buf, sizeof(buf), fp)) {
+      ++line;
+      buf[strcspn(buf, "\n")] = '\0';
+      BatchJob job;
+      const int r = parse_line(buf, line, dir, out_dir, &job);
+      if (r > 0)
+        jobs.push_back(job);
+      else if (r < 0) {
+        fprintf(stderr, "%s:%u: invalid corpus line\n", corpus_path.c_str(), line);
+        ok = false;
+      }
+    }
+    fclose(fp);
+
+    // Children render straight into their output mapping, two lines on one file would race
+    std::map<std::string, unsigned> outputs;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      const std::map<std::string, unsigned>::const_iterator it = outputs.find(jobs[i].output_path);
+      if (it != outputs.end()) {
+        fprintf(stderr, "%s:%u: output %s is also written by line %u\n", corpus_path.c_str(), jobs[i].line,
+                jobs[i].output_path.c_str(), it->second);
+        ok = false;
+      }
+      else
+        outputs[jobs[i].output_path] = jobs[i].line;
+    }
+    if (!ok)
+      return 2;
+    if (jobs.empty()) {
+      fprintf(stderr, "%s: no jobs\n", corpus_path.c_str());
+      return 2;
+    }
+
+    JsonValue baseline;
+    if (!baseline_path.empty()) {
+      std::string err;
+      if (!json_read_file(baseline_path, &baseline, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+    }
+
+    if (mkdir(out_dir.c_str(), 0755) != 0) {
+      struct stat st;
+      if (stat(out_dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "cannot create %s\n", out_dir.c_str());
+        return 1;
+      }
+    }
+
+    std::vector<void *> ctx(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+      ctx[i] = &jobs[i];
+    std::vector<BatchResult> results(jobs.size());
+    std::vector<IsolatedStatus> status(jobs.size());
+    size_t progress[2] = { 0, jobs.size() };
+
+    fprintf(stderr, "%zu jobs on %u workers\n", jobs.size(), workers);
+    const double t0 = now_ns();
+    run_isolated_pool(batch_child, ctx.data(), results.data(), sizeof(BatchResult), jobs.size(), workers, timeout_s,
+                      status.data(), on_done, progress);
+    const double elapsed_s = (now_ns() - t0) * 1e-9;
+
+    std::vector<BatchEntry> entries(jobs.size());
+    const JsonValue & base_jobs = baseline["jobs"];
+    int changed = 0, failed = 0;
+    printf("%5s %-22s %10s %9s  %s\n", "line", "unit", "ns/sample", "peak", "status");
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      const BatchResult & r = results[i];
+      BatchEntry & e = entries[i];
+      e.status = isolated_status_str(status[i]);
+      if (status[i].completed && status[i].exit_code == 0 && r.init_err != k_unit_err_none)
+        e.status = std::string("init k_unit_err_") + unit_err_name(static_cast<int8_t>(r.init_err));
+      const std::string name = status[i].completed ? r.name : base_name(jobs[i].unit_path);
+      std::string base_status;
+      for (size_t k = 0; k < base_jobs.array.size(); ++k)
+        if (base_jobs.array[k]["output"].str() == jobs[i].output_path) {
+          base_status = base_jobs.array[k]["status"].str();
+          e.baseline = base_jobs.array[k]["checksum"].str();
+        }
+      if (e.status != "ok") {
+        printf("%5u %-22s %10s %9s  %s", jobs[i].line, name.c_str(), "-", "-", e.status.c_str());
+        if (base_status == "ok") {
+          printf(" CHANGED, ok in the baseline");
+          ++changed;
+        }
+        printf("\n");
+        ++failed;
+        continue;
+      }
+      char sum[20];
+      snprintf(sum, sizeof(sum), "%016llx", static_cast<unsigned long long>(r.checksum));
+      e.checksum = sum;
+
+      printf("%5u %-22s %10.1f %9.4f  ok", jobs[i].line, name.c_str(), r.ns_per_sample, r.peak);
+      if (r.nonfinite)
+        printf(", %u non-finite samples", r.nonfinite);
+      if (!e.baseline.empty() && e.baseline != e.checksum) {
+        printf(" CHANGED");
+        ++changed;
+      }
+      printf("\n");
+    }
+    printf("%zu jobs in %.1f s on %u workers, %d failed", jobs.size(), elapsed_s, workers, failed);
+    if (!baseline_path.empty())
+      printf(", %d output(s) changed", changed);
+    printf("\n");
+
+    if (!json_path.empty()) {
+      FILE * out = fopen(json_path.c_str(), "w");
+      if (!out) {
+        fprintf(stderr, "cannot create %s\n", json_path.c_str());
+        return 1;
+      }
+      write_report(out, jobs, results, entries);
+      fclose(out);
+      printf("report: %s\n", json_path.c_str());
+    }
+    return (changed || failed) ? 1 : 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,305 @@
+/**
+ *  @file cmd_bench.cc
+ *
+ *  @brief hostsim bench: rank units by render cost and track regressions
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "isolate.h"
+#include "json.h"
+#include "preset.h"
+
+namespace hostsim {
+
+  namespace {
+
+    /** Result passed back from the child process, plain data only. */
+    struct BenchSample {
+      char name[64];
+      char header_name[UNIT_NAME_SIZE];
+      uint32_t module;
+      int32_t init_err;
+      uint64_t frames;
+      double ns_per_sample;
+      double realtime_factor;
+      double mean_block_ns;
+      double p99_block_ns;
+      double max_block_ns;
+      uint64_t sdram_peak;
+    };
+
+    struct BenchEntry {
+      std::string path;
+      std::string status;
+      std::string preset; // empty if rendered with the common options
+      BenchSample sample;
+      double baseline_ns; // < 0 if not in baseline
+    };
+
+    struct BenchJob {
+      const std::string * path;
+      const RenderOptions * opt;
+      unsigned runs;
+    };
+
+    int bench_child(void * ctx, void * out, size_t size) {
+      const BenchJob & job = *static_cast<BenchJob *>(ctx);
+      BenchSample & s = *static_cast<BenchSample *>(out);
+      (void)size;
+      memset(&s, 0, sizeof(s));
+
+      HostUnit unit;
+      std::string err;
+      if (!unit.load(*job.path, &err)) {
+        fprintf(stderr, "%s: %s\n", job.path->c_str(), err.c_str());
+        return 3;
+      }
+      snprintf(s.name, sizeof(s.name), "%s", unit.name().c_str());
+      snprintf(s.header_name, sizeof(s.header_name), "%s", unit.header()->name);
+      s.module = unit.module();
+
+      set_tempo_bpm(job.opt->bpm);
+      s.init_err = unit.init(job.opt->frames_per_buffer, job.opt->sdram_size);
+      if (s.init_err != k_unit_err_none)
+        return 0;
+
+      RenderOptions opt = *job.opt;
+      if (unit.module() != k_unit_module_osc)
+        opt.note = -1;
+      WavData input;
+      if (unit.module() != k_unit_module_osc)
+        make_excitation(&input, static_cast<size_t>(opt.seconds * k_samplerate));
+
+      // Warm up caches and lazy initialization before measuring
+      RenderOptions warmup = opt;
+      warmup.seconds = 0.25;
+      RenderStats stats;
+      render_unit(unit, warmup, input.samples.empty() ? NULL : &input, NULL, &stats);
+
+      // Keep the fastest of several runs, the least disturbed by the rest of the system
+      RenderStats best;
+      for (unsigned r = 0; r < job.runs; ++r) {
+        unit.allNoteOff();
+        unit.reset();
+        render_unit(unit, opt, input.samples.empty() ? NULL : &input, NULL, &stats);
+        if (r == 0 || stats.total_ns < best.total_ns)
+          best = stats;
+      }
+
+      s.frames = best.frames;
+      s.ns_per_sample = best.nsPerSample();
+      s.realtime_factor = best.realtimeFactor();
+      s.mean_block_ns = best.meanBlockNs();
+      s.p99_block_ns = best.percentileBlockNs(99.0);
+      s.max_block_ns = best.maxBlockNs();
+      s.sdram_peak = unit.sdram()->peak();
+      return 0;
+    }
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim bench [options] <unit.so>...\n"
+              "  -j <report.json>      Write a JSON report\n"
+              "  -r <runs>             Measured runs per unit, the fastest is kept (default 3)\n"
+              "  --baseline <json>     Compare against an earlier report\n"
+              "  --tolerance <pct>     Slowdown over baseline reported as regression (default 10)\n"
+              "  --timeout <seconds>   Per unit time limit (default 120)\n"
+              "  --presets <dir>       Render units with <dir>/<unit>.stress.json when present\n"
+              "%s", k_render_options_usage);
+    }
+
+    void write_report(FILE * fp, const RenderOptions & opt, unsigned runs, const std::vector<BenchEntry> & entries) {
+      JsonWriter w(fp);
+      w.beginObject();
+      w.field("samplerate", k_samplerate);
+      w.field("frames_per_buffer", static_cast<unsigned>(opt.frames_per_buffer));
+      w.field("seconds", opt.seconds);
+      w.field("runs", runs);
+      w.field("budget_ns_per_sample", 1e9 / k_samplerate);
+      w.key("units");
+      w.beginArray();
+      for (size_t i = 0; i < entries.size(); ++i) {
+        const BenchEntry & e = entries[i];
+        const BenchSample & s = e.sample;
+        w.beginObject();
+        w.field("name", s.name);
+        if (s.module) {
+          w.field("unit_name", s.header_name);
+          w.field("module", module_name(s.module));
+        }
+        w.field("status", e.status);
+        if (!e.preset.empty())
+          w.field("preset", e.preset);
+        if (e.status == "ok") {
+          w.field("frames", static_cast<unsigned long long>(s.frames));
+          w.field("ns_per_sample", s.ns_per_sample);
+          w.field("realtime_factor", s.realtime_factor);
+          w.field("block_mean_us", s.mean_block_ns * 1e-3);
+          w.field("block_p99_us", s.p99_block_ns * 1e-3);
+          w.field("block_max_us", s.max_block_ns * 1e-3);
+          w.field("sdram_bytes", static_cast<unsigned long long>(s.sdram_peak));
+          if (e.baseline_ns > 0) {
+            w.field("baseline_ns_per_sample", e.baseline_ns);
+            w.field("change_pct", 100.0 * (s.ns_per_sample / e.baseline_ns - 1.0));
+          }
+        }
+        w.endObject();
+      }
+      w.endArray();
+      w.endObject();
+    }
+
+    bool by_cost(const BenchEntry & a, const BenchEntry & b) {
+      const bool ok_a = a.status == "ok", ok_b = b.status == "ok";
+      if (ok_a != ok_b)
+        return ok_a;
+      return a.sample.ns_per_sample > b.sample.ns_per_sample;
+    }
+
+  }  // namespace
+
+  int cmd_bench(int argc, char ** argv) {
+    RenderOptions opt;
+    std::vector<std::string> paths;
+    std::string json_path, baseline_path, presets_dir;
+    unsigned runs = 3;
+    unsigned timeout_s = 120;
+    double tolerance = 10.0;
+
+    for (int i = 0; i < argc; ++i) {
+      const int r = parse_render_option(argc, argv, &i, &opt);
+      if (r < 0)
+        return 2;
+      if (r > 0)
+        continue;
+      if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+        runs = std::max(1, atoi(argv[++i]));
+      else if (!strcmp(argv[i], "--baseline") && i + 1 < argc)
+        baseline_path = argv[++i];
+      else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc)
+        tolerance = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--timeout") && i + 1 < argc)
+        timeout_s = static_cast<unsigned>(atoi(argv[++i]));
+      else if (!strcmp(argv[i], "--presets") && i + 1 < argc)
+        presets_dir = argv[++i];
+      else if (argv[i][0] != '-')
+        paths.push_back(argv[i]);
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (paths.empty()) {
+      usage();
+      return 2;
+    }
+
+    JsonValue baseline;
+    if (!baseline_path.empty()) {
+      std::string err;
+      if (!json_read_file(baseline_path, &baseline, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+    }
+
+    std::vector<BenchEntry> entries;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      BenchEntry e;
+      e.path = paths[i];
+      e.baseline_ns = -1;
+      std::string base = e.path.substr(e.path.find_last_of('/') + 1);
+      base = base.substr(0, base.rfind(".so"));
+
+      RenderOptions unit_opt = opt;
+      if (!presets_dir.empty()) {
+        const std::string preset = presets_dir + "/" + base + ".stress.json";
+        FILE * fp = fopen(preset.c_str(), "r");
+        if (fp) {
+          fclose(fp);
+          std::string err;
+          if (!preset_read(preset, &unit_opt, &err)) {
+            fprintf(stderr, "%s\n", err.c_str());
+            return 1;
+          }
+          e.preset = preset;
+        }
+      }
+
+      BenchJob job = { &paths[i], &unit_opt, runs };
+      fprintf(stderr, "[%zu/%zu] %s\n", i + 1, paths.size(), paths[i].c_str());
+      const IsolatedStatus st = run_isolated(bench_child, &job, &e.sample, sizeof(e.sample), timeout_s);
+      e.status = isolated_status_str(st);
+      if (st.completed && st.exit_code == 0 && e.sample.init_err != k_unit_err_none)
+        e.status = std::string("init k_unit_err_") + unit_err_name(static_cast<int8_t>(e.sample.init_err));
+      if (!st.completed) {
+        // Child died before reporting, name the entry after its file
+        memset(&e.sample, 0, sizeof(e.sample));
+        snprintf(e.sample.name, sizeof(e.sample.name), "%s", base.c_str());
+      }
+
+      const JsonValue & units = baseline["units"];
+      for (size_t k = 0; k < units.array.size(); ++k) {
+        if (units.array[k]["name"].str() == e.sample.name && units.array[k]["status"].str() == "ok")
+          e.baseline_ns = units.array[k]["ns_per_sample"].num(-1);
+      }
+      entries.push_back(e);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), by_cost);
+
+    int regressions = 0;
+    printf("%-22s %-6s %10s %10s %9s %9s %9s  %s\n",
+           "unit", "module", "ns/sample", "rt-factor", "mean us", "p99 us", "worst us", "status");
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const BenchEntry & e = entries[i];
+      const BenchSample & s = e.sample;
+      const char * name = s.name;
+      if (e.status != "ok") {
+        printf("%-22s %-6s %10s %10s %9s %9s %9s  %s\n", name, s.module ? module_name(s.module) : "-",
+               "-", "-", "-", "-", "-", e.status.c_str());
+        continue;
+      }
+      printf("%-22s %-6s %10.1f %9.0fx %9.2f %9.2f %9.2f  ok", name, module_name(s.module), s.ns_per_sample,
+             s.realtime_factor, s.mean_block_ns * 1e-3, s.p99_block_ns * 1e-3, s.max_block_ns * 1e-3);
+      if (e.baseline_ns > 0) {
+        const double change = 100.0 * (s.ns_per_sample / e.baseline_ns - 1.0);
+        printf(" (%+.1f%%)", change);
+        if (change > tolerance) {
+          printf(" REGRESSION");
+          ++regressions;
+        }
+      }
+      printf("\n");
+    }
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot create %s\n", json_path.c_str());
+        return 1;
+      }
+      write_report(fp, opt, runs, entries);
+      fclose(fp);
+      printf("report: %s\n", json_path.c_str());
+    }
+
+    if (regressions) {
+      printf("%d unit(s) slower than baseline by more than %.1f%%\n", regressions, tolerance);
+      return 1;
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
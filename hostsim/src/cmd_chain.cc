@@ -0,0 +1,324 @@
+/**
+ *  @file cmd_chain.cc
+ *
+ *  @brief hostsim chain: run osc, modfx, delfx and revfx units together like the firmware
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "json.h"
+
+namespace hostsim {
+
+  namespace {
+
+    enum {
+      k_slot_osc = 0,
+      k_slot_modfx,
+      k_slot_delfx,
+      k_slot_revfx,
+      k_num_slots
+    };
+
+    const uint32_t k_slot_modules[k_num_slots] = {
+      k_unit_module_osc, k_unit_module_modfx, k_unit_module_delfx, k_unit_module_revfx
+    };
+
+    struct Slot {
+      std::string path;
+      HostUnit unit;
+      std::vector<std::pair<uint8_t, int32_t> > params;
+      std::vector<TraceEvent> events;
+      size_t next;
+      RenderStats stats;
+
+      Slot() : next(0) { }
+    };
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim chain <unit.so>... [options]\n"
+              "  -o <file.wav>               Write the output of the last unit\n"
+              "  -i <file.wav>               Audio input, fed to the oscillator or the first effect\n"
+              "  -j <report.json>            Write the per slot and combined block times as JSON\n"
+              "  --set <module>:<id>=<value> Set a parameter of the unit in a slot, may be repeated\n"
+              "  --scale <factor>            Multiply host times by this factor before the headroom check\n"
+              "%s"
+              "\n"
+              "Units take the slot of their module, at most one per slot. Note, trace parameter\n"
+              "and controller events go to the oscillator, tempo and clock to every unit.\n",
+              k_render_options_usage);
+    }
+
+    int slot_of(uint32_t module) {
+      for (int s = 0; s < k_num_slots; ++s)
+        if (k_slot_modules[s] == module)
+          return s;
+      return -1;
+    }
+
+    int slot_by_name(const std::string & name) {
+      for (int s = 0; s < k_num_slots; ++s)
+        if (name == module_name(k_slot_modules[s]))
+          return s;
+      return -1;
+    }
+
+    /** Events of the shared timeline an effect slot receives: tempo and clock only. */
+    bool effect_event(const TraceEvent & e) {
+      return e.type == k_trace_tempo || e.type == k_trace_tempo_tick;
+    }
+
+    void write_slot(JsonWriter & w, const char * slot, const char * name, const RenderStats & st, double scale) {
+      w.beginObject();
+      w.field("slot", slot);
+      w.field("unit", name);
+      w.field("block_mean_us", st.meanBlockNs() * scale * 1e-3);
+      w.field("block_p99_us", st.percentileBlockNs(99.0) * scale * 1e-3);
+      w.field("block_max_us", st.maxBlockNs() * scale * 1e-3);
+      w.endObject();
+    }
+
+  }  // namespace
+
+  int cmd_chain(int argc, char ** argv) {
+    RenderOptions opt;
+    std::vector<std::string> paths;
+    std::vector<std::pair<std::string, std::string> > sets;
+    std::string out_path, in_path, json_path;
+    double scale = 1.0;
+
+    for (int i = 0; i < argc; ++i) {
+      const int r = parse_render_option(argc, argv, &i, &opt);
+      if (r < 0)
+        return 2;
+      if (r > 0)
+        continue;
+      if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        out_path = argv[++i];
+      else if (!strcmp(argv[i], "-i") && i + 1 < argc)
+        in_path = argv[++i];
+      else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else if (!strcmp(argv[i], "--set") && i + 1 < argc) {
+        const std::string val = argv[++i];
+        const size_t colon = val.find(':');
+        if (colon == std::string::npos) {
+          fprintf(stderr, "invalid value for --set: %s\n", val.c_str());
+          return 2;
+        }
+        sets.push_back(std::make_pair(val.substr(0, colon), val.substr(colon + 1)));
+      }
+      else if (!strcmp(argv[i], "--scale") && i + 1 < argc)
+        scale = atof(argv[++i]);
+      else if (argv[i][0] != '-')
+        paths.push_back(argv[i]);
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (paths.empty() || scale <= 0) {
+      usage();
+      return 2;
+    }
+    if (!opt.params.empty()) {
+      fprintf(stderr, "-p and --preset are ambiguous in a chain, use --set <module>:<id>=<value>\n");
+      return 2;
+    }
+
+    Slot slots[k_num_slots];
+    for (size_t i = 0; i < paths.size(); ++i) {
+      HostUnit probe;
+      std::string err;
+      if (!probe.load(paths[i], &err)) {
+        fprintf(stderr, "%s: %s\n", paths[i].c_str(), err.c_str());
+        return 1;
+      }
+      const int s = slot_of(probe.module());
+      if (s < 0 || !slots[s].path.empty()) {
+        fprintf(stderr, "%s: %s slot is %s\n", paths[i].c_str(), module_name(probe.module()),
+                s < 0 ? "not part of the chain" : "already taken");
+        return 2;
+      }
+      slots[s].path = paths[i];
+    }
+    for (size_t i = 0; i < sets.size(); ++i) {
+      const int s = slot_by_name(sets[i].first);
+      const size_t eq = sets[i].second.find('=');
+      if (s < 0 || slots[s].path.empty() || eq == std::string::npos) {
+        fprintf(stderr, "invalid value for --set: %s:%s\n", sets[i].first.c_str(), sets[i].second.c_str());
+        return 2;
+      }
+      slots[s].params.push_back(std::make_pair(static_cast<uint8_t>(atoi(sets[i].second.c_str())),
+                                               static_cast<int32_t>(atoi(sets[i].second.c_str() + eq + 1))));
+    }
+
+    const uint64_t total = static_cast<uint64_t>(opt.seconds * k_samplerate);
+    for (int s = 0; s < k_num_slots; ++s) {
+      Slot & slot = slots[s];
+      if (slot.path.empty())
+        continue;
+      if (!open_unit(slot.unit, slot.path, opt))
+        return 1;
+      RenderOptions slot_opt = opt;
+      slot_opt.params = slot.params;
+      if (s != k_slot_osc) {
+        slot_opt.note = -1;
+        slot_opt.trace.clear();
+        for (size_t k = 0; k < opt.trace.size(); ++k)
+          if (effect_event(opt.trace[k]))
+            slot_opt.trace.push_back(opt.trace[k]);
+      }
+      render_events(slot_opt, total, &slot.events);
+      slot.stats.block_ns.reserve(total / opt.frames_per_buffer + 1);
+    }
+
+    WavData input;
+    if (!in_path.empty()) {
+      std::string err;
+      if (!wav_read(in_path, &input, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+    }
+    else if (slots[k_slot_osc].path.empty()) {
+      make_excitation(&input, total);
+    }
+
+    WavData output;
+    output.samplerate = k_samplerate;
+    output.channels = 2;
+    if (!out_path.empty())
+      output.samples.assign(total * 2, 0.f);
+
+    // Buffers are handed from slot to slot like the firmware does: the mono oscillator
+    // output is copied to both channels and every effect processes the stereo result.
+    const uint32_t block = opt.frames_per_buffer;
+    std::vector<float> in(2 * block, 0.f), osc_out(block, 0.f), a(2 * block, 0.f), b(2 * block, 0.f);
+    RenderStats chain;
+    chain.block_ns.reserve(total / block + 1);
+    const double budget_ns = 1e9 * block / k_samplerate;
+    unsigned overruns = 0;
+
+    for (uint64_t pos = 0; pos < total; pos += block) {
+      const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(block, total - pos));
+
+      for (int s = 0; s < k_num_slots; ++s) {
+        Slot & slot = slots[s];
+        for (; slot.next < slot.events.size() && slot.events[slot.next].frame <= pos; ++slot.next)
+          deliver_event(slot.unit, slot.events[slot.next]);
+      }
+
+      const size_t in_frames = input.frames();
+      for (uint32_t i = 0; i < frames; ++i) {
+        const size_t f = pos + i;
+        const bool have = f < in_frames;
+        in[2 * i] = have ? input.samples[f * input.channels] : 0.f;
+        in[2 * i + 1] = have ? input.samples[f * input.channels + (input.channels > 1 ? 1 : 0)] : 0.f;
+      }
+
+      double block_ns = 0;
+      float * cur = in.data();
+      for (int s = 0; s < k_num_slots; ++s) {
+        Slot & slot = slots[s];
+        if (slot.path.empty())
+          continue;
+        float * dst = (cur == a.data()) ? b.data() : a.data();
+        const double t0 = now_ns();
+        if (s == k_slot_osc)
+          slot.unit.render(cur, osc_out.data(), frames);
+        else
+          slot.unit.render(cur, dst, frames);
+        const double dt = now_ns() - t0;
+        if (s == k_slot_osc)
+          for (uint32_t i = 0; i < frames; ++i)
+            dst[2 * i] = dst[2 * i + 1] = osc_out[i];
+        cur = dst;
+        slot.stats.block_ns.push_back(dt);
+        slot.stats.total_ns += dt;
+        slot.stats.frames += frames;
+        block_ns += dt;
+      }
+      chain.block_ns.push_back(block_ns);
+      chain.total_ns += block_ns;
+      chain.frames += frames;
+      if (block_ns * scale > budget_ns * frames / block)
+        ++overruns;
+
+      if (!out_path.empty())
+        std::copy(cur, cur + 2 * frames, output.samples.begin() + 2 * pos);
+    }
+
+    printf("chain      :");
+    for (int s = 0, n = 0; s < k_num_slots; ++s)
+      if (!slots[s].path.empty())
+        printf("%s %s (%s)", n++ ? " ->" : "", slots[s].unit.name().c_str(), module_name(k_slot_modules[s]));
+    printf("\n");
+    printf("rendered   : %llu frames in blocks of %u, %.1f us budget per block%s\n",
+           static_cast<unsigned long long>(chain.frames), block, budget_ns * 1e-3,
+           scale != 1.0 ? ", host times scaled" : "");
+    printf("%-6s %-22s %9s %9s %9s %7s\n", "slot", "unit", "mean us", "p99 us", "worst us", "share");
+    for (int s = 0; s < k_num_slots; ++s) {
+      const Slot & slot = slots[s];
+      if (slot.path.empty())
+        continue;
+      printf("%-6s %-22s %9.2f %9.2f %9.2f %6.1f%%\n", module_name(k_slot_modules[s]), slot.unit.name().c_str(),
+             slot.stats.meanBlockNs() * scale * 1e-3, slot.stats.percentileBlockNs(99.0) * scale * 1e-3,
+             slot.stats.maxBlockNs() * scale * 1e-3,
+             chain.total_ns > 0 ? 100.0 * slot.stats.total_ns / chain.total_ns : 0.0);
+    }
+    printf("%-6s %-22s %9.2f %9.2f %9.2f\n", "total", "", chain.meanBlockNs() * scale * 1e-3,
+           chain.percentileBlockNs(99.0) * scale * 1e-3, chain.maxBlockNs() * scale * 1e-3);
+    printf("headroom   : %.1f%% mean, %.1f%% p99, %.1f%% worst block", 100.0 * (1.0 - chain.meanBlockNs() * scale / budget_ns),
+           100.0 * (1.0 - chain.percentileBlockNs(99.0) * scale / budget_ns),
+           100.0 * (1.0 - chain.maxBlockNs() * scale / budget_ns));
+    if (overruns)
+      printf(", %u block(s) over budget", overruns);
+    printf("\n");
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot create %s\n", json_path.c_str());
+        return 1;
+      }
+      JsonWriter w(fp);
+      w.beginObject();
+      w.field("frames_per_buffer", block);
+      w.field("budget_us", budget_ns * 1e-3);
+      w.field("scale", scale);
+      w.key("slots");
+      w.beginArray();
+      for (int s = 0; s < k_num_slots; ++s)
+        if (!slots[s].path.empty())
+          write_slot(w, module_name(k_slot_modules[s]), slots[s].unit.name().c_str(), slots[s].stats, scale);
+      w.endArray();
+      w.key("chain");
+      write_slot(w, "chain", "", chain, scale);
+      w.field("overruns", overruns);
+      w.endObject();
+      fclose(fp);
+      printf("report     : %s\n", json_path.c_str());
+    }
+
+    if (!out_path.empty()) {
+      std::string err;
+      if (!wav_write(out_path, output, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      printf("output     : %s\n", out_path.c_str());
+    }
+    return overruns ? 1 : 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,218 @@
+/**
+ *  @file cmd_compare.cc
+ *
+ *  @brief hostsim compare: check two builds of a unit for equivalence and relative speed
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "analysis.h"
+#include "cli.h"
+
+namespace hostsim {
+
+  namespace {
+
+    struct Limits {
+      double min_snr_db;
+      double max_error;
+      double max_spectral_db;
+    };
+
+    /** True if both paths name the same file, which dlopen() only loads once. */
+    bool same_file(const std::string & a, const std::string & b) {
+      struct stat sa, sb;
+      return !stat(a.c_str(), &sa) && !stat(b.c_str(), &sb) && sa.st_dev == sb.st_dev && sa.st_ino == sb.st_ino;
+    }
+
+    /** Copy a unit to a new temporary file, returns its path or an empty string. */
+    std::string temp_copy(const std::string & path) {
+      char name[] = "/tmp/hostsim-compare-XXXXXX.so";
+      const int fd = mkstemps(name, 3);
+      if (fd < 0)
+        return std::string();
+      FILE * in = fopen(path.c_str(), "rb");
+      FILE * out = fdopen(fd, "wb");
+      bool ok = in && out;
+      char buf[65536];
+      size_t n;
+      while (ok && (n = fread(buf, 1, sizeof(buf), in)) > 0)
+        ok = fwrite(buf, 1, n, out) == n;
+      ok = ok && !ferror(in);
+      if (in)
+        fclose(in);
+      if (out)
+        ok = !fclose(out) && ok;
+      else
+        close(fd);
+      if (!ok) {
+        unlink(name);
+        return std::string();
+      }
+      return name;
+    }
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim compare <reference.so> <test.so> [options]\n"
+              "  -i <file.wav>            Input audio for effects\n"
+              "  -d <file.wav>            Write the difference test - reference\n"
+              "  -r <runs>                Timed runs per build, the fastest is kept (default 3)\n"
+              "  --min-snr <dB>           Lowest accepted SNR, overall and per block (default 60)\n"
+              "  --max-error <value>      Largest accepted absolute sample error (default 1e-3)\n"
+              "  --max-spectral-db <dB>   Largest accepted spectrum difference (default 1)\n"
+              "  --block-floor <dBFS>     Blocks quieter than this are left out of the per block SNR (default -80)\n"
+              "%s", k_render_options_usage);
+    }
+
+    double render_timed(HostUnit & unit, const RenderOptions & opt, const WavData * input, WavData * output) {
+      RenderStats stats;
+      render_unit(unit, opt, input, output, &stats);
+      return stats.nsPerSample();
+    }
+
+  }  // namespace
+
+  int cmd_compare(int argc, char ** argv) {
+    RenderOptions opt;
+    std::string paths[2], in_path, diff_path;
+    size_t npaths = 0;
+    unsigned runs = 3;
+    double floor_db = -80.0;
+    Limits limits = { 60.0, 1e-3, 1.0 };
+
+    for (int i = 0; i < argc; ++i) {
+      const int r = parse_render_option(argc, argv, &i, &opt);
+      if (r < 0)
+        return 2;
+      if (r > 0)
+        continue;
+      if (!strcmp(argv[i], "-i") && i + 1 < argc)
+        in_path = argv[++i];
+      else if (!strcmp(argv[i], "-d") && i + 1 < argc)
+        diff_path = argv[++i];
+      else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+        runs = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+      else if (!strcmp(argv[i], "--min-snr") && i + 1 < argc)
+        limits.min_snr_db = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--max-error") && i + 1 < argc)
+        limits.max_error = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--max-spectral-db") && i + 1 < argc)
+        limits.max_spectral_db = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--block-floor") && i + 1 < argc)
+        floor_db = atof(argv[++i]);
+      else if (argv[i][0] != '-' && npaths < 2)
+        paths[npaths++] = argv[i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (npaths != 2) {
+      usage();
+      return 2;
+    }
+
+    // dlopen() hands out the already loaded copy of the same file, whose statics the first
+    // render has changed, so the test build is then loaded from a copy
+    std::string test_path = paths[1], copy;
+    if (same_file(paths[0], paths[1])) {
+      copy = temp_copy(paths[1]);
+      if (copy.empty()) {
+        fprintf(stderr, "cannot copy %s to a temporary file\n", paths[1].c_str());
+        return 1;
+      }
+      test_path = copy;
+    }
+    HostUnit ref, test;
+    const bool opened = open_unit(ref, paths[0], opt) && open_unit(test, test_path, opt);
+    if (!copy.empty())
+      unlink(copy.c_str());
+    if (!opened)
+      return 1;
+    if (ref.module() != test.module() || ref.header()->num_params != test.header()->num_params) {
+      fprintf(stderr, "%s and %s do not expose the same module and parameters\n", paths[0].c_str(),
+              paths[1].c_str());
+      return 1;
+    }
+
+    const size_t frames = static_cast<size_t>(opt.seconds * k_samplerate);
+    WavData input;
+    if (!in_path.empty()) {
+      std::string err;
+      if (!wav_read(in_path, &input, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+    }
+    else if (ref.module() != k_unit_module_osc) {
+      make_excitation(&input, frames);
+    }
+    const WavData * in = input.samples.empty() ? NULL : &input;
+
+    // The first render from a fresh init provides the audio. Further runs only refine the
+    // timing and alternate between the builds so that both see the same system conditions.
+    WavData out_ref, out_test;
+    double best_ref = render_timed(ref, opt, in, &out_ref);
+    double best_test = render_timed(test, opt, in, &out_test);
+    for (unsigned r = 1; r < runs; ++r) {
+      ref.allNoteOff();
+      ref.reset();
+      best_ref = std::min(best_ref, render_timed(ref, opt, in, NULL));
+      test.allNoteOff();
+      test.reset();
+      best_test = std::min(best_test, render_timed(test, opt, in, NULL));
+    }
+
+    const SignalDiff d = compare_signals(out_ref, out_test, opt.frames_per_buffer, floor_db);
+    const double block_s = static_cast<double>(opt.frames_per_buffer) / k_samplerate;
+
+    printf("reference  : %s (%s)\n", ref.name().c_str(), paths[0].c_str());
+    printf("test       : %s (%s)\n", test.name().c_str(), paths[1].c_str());
+    printf("snr        : %.1f dB overall, worst block %.1f dB at %.3f s (min %.1f dB)\n", d.snr_db,
+           d.worst_block_snr_db, d.worst_block * block_s, limits.min_snr_db);
+    printf("max error  : %.3g at %.3f s, reference peak %.3g (max %.3g)\n", d.max_abs_error,
+           static_cast<double>(d.max_error_frame) / k_samplerate, d.ref_peak, limits.max_error);
+    printf("spectrum   : max %.3f dB, mean %.3f dB difference (max %.3g dB)\n", d.spectral_max_db,
+           d.spectral_mean_db, limits.max_spectral_db);
+    printf("speed      : reference %.1f ns/sample, test %.1f ns/sample, speedup %.2fx\n", best_ref, best_test,
+           best_test > 0 ? best_ref / best_test : 0.0);
+
+    if (!diff_path.empty()) {
+      WavData diff = out_test;
+      for (size_t i = 0; i < diff.samples.size() && i < out_ref.samples.size(); ++i)
+        diff.samples[i] -= out_ref.samples[i];
+      std::string err;
+      if (!wav_write(diff_path, diff, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      printf("difference : %s\n", diff_path.c_str());
+    }
+
+    std::string failures;
+    if (d.snr_db < limits.min_snr_db || d.worst_block_snr_db < limits.min_snr_db)
+      failures += " snr";
+    if (!(d.max_abs_error <= limits.max_error))
+      failures += " max-error";
+    if (d.spectral_max_db > limits.max_spectral_db)
+      failures += " spectrum";
+    if (d.length_mismatch)
+      failures += " layout";
+    if (!failures.empty()) {
+      printf("result     : FAIL:%s\n", failures.c_str());
+      return 1;
+    }
+    printf("result     : PASS\n");
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,270 @@
+/**
+ *  @file cmd_convolve.cc
+ *
+ *  @brief hostsim convolve: latency and cost of dsp::PartitionedConvolver per partition size
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "json.h"
+
+#include "dsp/partitionedconvolver.hpp"
+
+namespace hostsim {
+
+  namespace {
+
+    const uint32_t k_default_lengths[3] = { 1024, 12000, 48000 };  // cabinet, 0.25 s and 1 s
+    const uint32_t k_check_frames = 256;
+    const double k_direct_macs = 2e8;     // direct FIR timing budget, taps x frames
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim convolve [options]\n"
+              "  -l <samples>             Impulse response length, repeat for several (default 1024 12000 48000)\n"
+              "  -j <file.json>           Write the results as JSON\n");
+    }
+
+    struct Result {
+      uint32_t length;
+      uint32_t partition;       // 0 for the direct form row
+      uint32_t partitions;
+      size_t sdram_bytes;       // response spectra and FDL, one channel
+      double sdram_mbps;        // spectra streamed per second at 48 kHz
+      double ns_per_sample;
+      double error_db;          // max error against double precision, relative to the output RMS
+    };
+
+    std::vector<float> make_noise(uint32_t n, uint32_t seed) {
+      std::vector<float> v(n);
+      uint32_t x = seed;
+      for (uint32_t i = 0; i < n; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        v[i] = static_cast<int32_t>(x) * (1.f / 2147483648.f);
+      }
+      return v;
+    }
+
+    /** Noise decaying by 60 dB over its length, a stand-in for a room or cabinet response. */
+    std::vector<float> make_response(uint32_t length) {
+      std::vector<float> h = make_noise(length, 0x2545f491);
+      const double decay = log(1e-3) / length;
+      const double norm = 1.0 / sqrt(length / 6.9);   // about unit gain on noise
+      for (uint32_t i = 0; i < length; ++i)
+        h[i] = static_cast<float>(h[i] * exp(decay * i) * norm);
+      return h;
+    }
+
+    /** Output frame n of the convolution, in double precision. */
+    double reference(const std::vector<float> & h, const std::vector<float> & x, uint32_t n) {
+      double acc = 0;
+      for (uint32_t k = 0; k < h.size() && k <= n; ++k)
+        acc += static_cast<double>(h[k]) * x[n - k];
+      return acc;
+    }
+
+    /** Error of the output window starting at the response length, where every partition contributes. */
+    double check(const std::vector<float> & h, const std::vector<float> & x, const std::vector<float> & y) {
+      const uint32_t start = h.size();
+      double err = 0, sum_sq = 0;
+      for (uint32_t n = start; n < start + k_check_frames; ++n) {
+        const double r = reference(h, x, n);
+        err = fmax(err, fabs(y[n] - r));
+        sum_sq += r * r;
+      }
+      const double rms = sqrt(sum_sq / k_check_frames);
+      return err > 0 ? 20.0 * log10(err / rms) : -HUGE_VAL;
+    }
+
+    /** Direct form FIR over a zero padded input with the response reversed, as FIRFilter does. */
+    __attribute__((optimize("Ofast"), noinline))
+    void direct_fir(const float * hr, uint32_t taps, const float * xp, float * y, uint32_t frames) {
+      for (uint32_t n = 0; n < frames; ++n) {
+        const float * x = xp + n;
+        float acc = 0.f;
+        for (uint32_t k = 0; k < taps; ++k)
+          acc += hr[k] * x[k];
+        y[n] = acc;
+      }
+    }
+
+    Result measure_direct(const std::vector<float> & h, const std::vector<float> & x) {
+      const uint32_t taps = h.size();
+      uint32_t frames = static_cast<uint32_t>(k_direct_macs / taps);
+      if (frames > x.size())
+        frames = x.size();
+      std::vector<float> hr(h.rbegin(), h.rend());
+      std::vector<float> xp(taps - 1, 0.f);
+      xp.insert(xp.end(), x.begin(), x.end());
+      std::vector<float> y(x.size());
+
+      Result r;
+      r.length = taps;
+      r.partition = 0;
+      r.partitions = 0;
+      r.sdram_bytes = 0;
+      r.sdram_mbps = 0;
+      r.ns_per_sample = HUGE_VAL;
+      for (int run = 0; run < 3; ++run) {
+        const double t0 = now_ns();
+        direct_fir(&hr[0], taps, &xp[0], &y[0], frames);
+        const double ns = (now_ns() - t0) / frames;
+        if (ns < r.ns_per_sample)
+          r.ns_per_sample = ns;
+      }
+      direct_fir(&hr[0], taps, &xp[h.size()], &y[h.size()], k_check_frames);
+      r.error_db = check(h, x, y);
+      return r;
+    }
+
+    /** Render the whole input in blocks of one partition, as a runtime with frames_per_buffer == Partition would. */
+    template <uint32_t Partition>
+    Result measure(const std::vector<float> & h, const std::vector<float> & x) {
+      typedef dsp::PartitionedConvolver<Partition> Convolver;
+      static Convolver conv;
+      const uint32_t length = h.size();
+      const uint32_t parts = Convolver::partitionsFor(length);
+      std::vector<float> ram(Convolver::memorySize(length));
+      conv.init();
+      conv.setMemory(&ram[0], parts);
+      conv.setImpulse(&h[0], length);
+
+      const uint32_t frames = x.size() / Partition * Partition;
+      std::vector<float> y(x.size());
+
+      Result r;
+      r.length = length;
+      r.partition = Partition;
+      r.partitions = parts;
+      r.sdram_bytes = ram.size() * sizeof(float);
+      r.sdram_mbps = 2.0 * parts * Convolver::k_fft_size * sizeof(float) * (k_samplerate / Partition) / 1e6;
+      // Fastest of a few runs, as in compare
+      r.ns_per_sample = HUGE_VAL;
+      for (int run = 0; run < 3; ++run) {
+        conv.clear();
+        const double t0 = now_ns();
+        for (uint32_t f = 0; f < frames; f += Partition)
+          conv.process(&x[f], &y[f], Partition);
+        const double ns = (now_ns() - t0) / frames;
+        if (ns < r.ns_per_sample)
+          r.ns_per_sample = ns;
+      }
+      r.error_db = check(h, x, y);
+      return r;
+    }
+
+    void print_db(double db) {
+      if (db == -HUGE_VAL)
+        printf(" %8s", "-inf");
+      else
+        printf(" %8.1f", db);
+    }
+
+  }  // namespace
+
+  int cmd_convolve(int argc, char ** argv) {
+    std::string json_path;
+    std::vector<uint32_t> lengths;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+        const long l = atol(argv[++i]);
+        if (l < 1 || l > 48000 * 10) {
+          fprintf(stderr, "invalid response length: %s\n", argv[i]);
+          return 2;
+        }
+        lengths.push_back(static_cast<uint32_t>(l));
+      }
+      else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (lengths.empty())
+      lengths.assign(k_default_lengths, k_default_lengths + 3);
+
+    std::vector<Result> res;
+    for (size_t l = 0; l < lengths.size(); ++l) {
+      const std::vector<float> h = make_response(lengths[l]);
+      uint32_t frames = lengths[l] + 4 * 1024;
+      if (frames < 2 * k_samplerate)
+        frames = 2 * k_samplerate;
+      const std::vector<float> x = make_noise(frames, 0x12345678);
+
+      res.push_back(measure_direct(h, x));
+      res.push_back(measure<16>(h, x));
+      res.push_back(measure<32>(h, x));
+      res.push_back(measure<64>(h, x));
+      res.push_back(measure<128>(h, x));
+      res.push_back(measure<256>(h, x));
+      res.push_back(measure<512>(h, x));
+      res.push_back(measure<1024>(h, x));
+    }
+
+    printf("mono convolution, partition == frames_per_buffer, latency is one buffer, SDRAM per channel\n");
+    printf("%-7s %9s %6s %10s %6s %9s %8s %8s %8s\n", "length", "partition", "parts",
+           "latency ms", "KB", "MB/s", "ns/smp", "speedup", "err dB");
+    for (size_t r = 0; r < res.size(); ++r) {
+      if (!res[r].partition) {
+        printf("%-7u %9s %6s %10s %6s %9s %8.2f %8s", res[r].length, "direct", "-", "-", "-", "-",
+               res[r].ns_per_sample, "1.0x");
+        print_db(res[r].error_db);
+        printf("\n");
+        continue;
+      }
+      size_t d = r;
+      while (res[d].partition)
+        --d;
+      printf("%-7u %9u %6u %10.2f %6zu %9.1f %8.2f %7.1fx", res[r].length, res[r].partition, res[r].partitions,
+             1e3 * res[r].partition / k_samplerate, res[r].sdram_bytes / 1024, res[r].sdram_mbps,
+             res[r].ns_per_sample, res[d].ns_per_sample / res[r].ns_per_sample);
+      print_db(res[r].error_db);
+      printf("\n");
+    }
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        return 1;
+      }
+      JsonWriter w(fp);
+      w.beginArray();
+      for (size_t r = 0; r < res.size(); ++r) {
+        w.beginObject();
+        w.field("length", res[r].length);
+        if (res[r].partition) {
+          w.field("partition", res[r].partition);
+          w.field("partitions", res[r].partitions);
+          w.field("latency_samples", res[r].partition);
+          w.field("sdram_bytes", static_cast<unsigned>(res[r].sdram_bytes));
+          w.field("sdram_mb_per_s", res[r].sdram_mbps);
+        }
+        else {
+          w.field("partition", "direct");
+        }
+        w.field("ns_per_sample", res[r].ns_per_sample);
+        w.key("error_db");
+        if (res[r].error_db == -HUGE_VAL)
+          w.null();
+        else
+          w.value(res[r].error_db);
+        w.endObject();
+      }
+      w.endArray();
+      fputc('\n', fp);
+      fclose(fp);
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,316 @@
+/**
+ *  @file cmd_footprint.cc
+ *
+ *  @brief hostsim footprint: memory use of units against the module limits
+ *
+ */
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "elf_info.h"
+#include "isolate.h"
+#include "json.h"
+
+namespace hostsim {
+
+  namespace {
+
+    const size_t k_max_allocations = 32;
+
+    /** SDRAM requests made during unit_init, passed back from the child process. */
+    struct SdramReport {
+      uint32_t module;
+      int32_t init_err;
+      uint64_t capacity;
+      uint64_t peak;
+      uint32_t count;       // total requests, may exceed k_max_allocations
+      struct {
+        uint64_t size;
+        uint8_t granted;
+        char caller[56];
+      } allocations[k_max_allocations];
+    };
+
+    struct Footprint {
+      std::string name;
+      std::string elf_path;
+      ElfInfo elf;
+      bool elf_ok;
+      bool sdram_ok;          // unit_init was run
+      std::string status;
+      SdramReport sdram;
+    };
+
+    std::string base_name(const std::string & path) {
+      std::string base = path.substr(path.find_last_of('/') + 1);
+      const size_t dot = base.rfind('.');
+      return (dot == std::string::npos) ? base : base.substr(0, dot);
+    }
+
+    bool ends_with(const std::string & s, const char * suffix) {
+      const size_t n = strlen(suffix);
+      return s.size() >= n && !s.compare(s.size() - n, n, suffix);
+    }
+
+    /**
+     * Device ELF built by the unit's own Makefile, found through the source link
+     * hostsim keeps next to its units, <build>/units/x.so -> <build>/src/x/build/<project>.elf
+     */
+    std::string find_device_elf(const std::string & so_path) {
+      const size_t slash = so_path.find_last_of('/');
+      const std::string units_dir = (slash == std::string::npos) ? "." : so_path.substr(0, slash);
+      const std::string dir = units_dir + "/../src/" + base_name(so_path) + "/build";
+      DIR * d = opendir(dir.c_str());
+      if (!d)
+        return std::string();
+      std::string found;
+      for (struct dirent * e = readdir(d); e; e = readdir(d)) {
+        if (ends_with(e->d_name, ".elf")) {
+          found = dir + "/" + e->d_name;
+          break;
+        }
+      }
+      closedir(d);
+      return found;
+    }
+
+    int sdram_child(void * ctx, void * out, size_t size) {
+      const std::string & path = *static_cast<const std::string *>(ctx);
+      SdramReport & r = *static_cast<SdramReport *>(out);
+      (void)size;
+      memset(&r, 0, sizeof(r));
+
+      HostUnit unit;
+      std::string err;
+      if (!unit.load(path, &err)) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), err.c_str());
+        return 3;
+      }
+      r.module = unit.module();
+      r.init_err = unit.init(64, 0);
+
+      const SdramPool * pool = unit.sdram();
+      r.capacity = pool->capacity();
+      r.peak = pool->peak();
+      const std::vector<SdramPool::Allocation> & allocs = pool->allocations();
+      r.count = static_cast<uint32_t>(allocs.size());
+      for (size_t i = 0; i < allocs.size() && i < k_max_allocations; ++i) {
+        r.allocations[i].size = allocs[i].size;
+        r.allocations[i].granted = allocs[i].granted;
+        Dl_info dl;
+        if (allocs[i].caller && dladdr(allocs[i].caller, &dl) && dl.dli_sname)
+          snprintf(r.allocations[i].caller, sizeof(r.allocations[i].caller), "%s+0x%lx", dl.dli_sname,
+                   static_cast<unsigned long>(static_cast<const char *>(allocs[i].caller)
+                                              - static_cast<const char *>(dl.dli_saddr)));
+      }
+      return 0;
+    }
+
+    double pct(uint64_t v, uint64_t limit) {
+      return limit ? 100.0 * v / limit : 0.0;
+    }
+
+    void print_details(const Footprint & f, size_t max_symbols) {
+      printf("\n%s", f.name.c_str());
+      if (f.elf_ok)
+        printf(" (%s, %s)", f.elf_path.c_str(), f.elf.arm ? "device build" : "host build, code sizes are x86-64");
+      printf("\n");
+      for (size_t i = 0; f.elf_ok && i < f.elf.symbols.size() && i < max_symbols; ++i) {
+        const ElfSymbol & s = f.elf.symbols[i];
+        printf("  %-6s %8llu  %s\n", elf_class_name(s.cls), static_cast<unsigned long long>(s.size), s.name.c_str());
+      }
+      if (f.sdram_ok && f.sdram.count) {
+        printf("  sdram_alloc requests:\n");
+        for (uint32_t i = 0; i < f.sdram.count && i < k_max_allocations; ++i)
+          printf("    %10llu bytes%s  %s\n", static_cast<unsigned long long>(f.sdram.allocations[i].size),
+                 f.sdram.allocations[i].granted ? "" : " (did not fit)",
+                 f.sdram.allocations[i].caller[0] ? f.sdram.allocations[i].caller : "");
+        if (f.sdram.count > k_max_allocations)
+          printf("    ... %u more\n", f.sdram.count - static_cast<uint32_t>(k_max_allocations));
+      }
+    }
+
+    void write_report(FILE * fp, const std::vector<Footprint> & units) {
+      JsonWriter w(fp);
+      w.beginObject();
+      w.key("units");
+      w.beginArray();
+      for (size_t i = 0; i < units.size(); ++i) {
+        const Footprint & f = units[i];
+        const uint32_t module = f.elf.target ? (f.elf.target & UNIT_TARGET_MODULE_MASK) : f.sdram.module;
+        w.beginObject();
+        w.field("name", f.name);
+        w.field("module", module_name(module));
+        w.field("status", f.status);
+        if (f.elf_ok) {
+          w.field("elf", f.elf_path);
+          w.field("device_build", f.elf.arm);
+          for (int c = 0; c < k_num_elf_classes; ++c)
+            w.field(elf_class_name(static_cast<ElfClass>(c)), static_cast<unsigned long long>(f.elf.size[c]));
+          w.field("load_size", static_cast<unsigned long long>(f.elf.budgetSize()));
+          w.field("load_limit", static_cast<unsigned long long>(max_unit_size(module)));
+          w.key("symbols");
+          w.beginArray();
+          for (size_t k = 0; k < f.elf.symbols.size(); ++k) {
+            w.beginObject();
+            w.field("name", f.elf.symbols[k].name);
+            w.field("class", elf_class_name(f.elf.symbols[k].cls));
+            w.field("size", static_cast<unsigned long long>(f.elf.symbols[k].size));
+            w.endObject();
+          }
+          w.endArray();
+        }
+        if (f.sdram_ok) {
+          w.field("sdram_peak", static_cast<unsigned long long>(f.sdram.peak));
+          w.field("sdram_limit", static_cast<unsigned long long>(default_sdram_size(module)));
+          w.key("sdram_requests");
+          w.beginArray();
+          for (uint32_t k = 0; k < f.sdram.count && k < k_max_allocations; ++k) {
+            w.beginObject();
+            w.field("size", static_cast<unsigned long long>(f.sdram.allocations[k].size));
+            w.field("granted", f.sdram.allocations[k].granted != 0);
+            w.field("caller", f.sdram.allocations[k].caller);
+            w.endObject();
+          }
+          w.endArray();
+        }
+        w.endObject();
+      }
+      w.endArray();
+      w.endObject();
+    }
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim footprint [options] <unit.so|unit.elf>...\n"
+              "  -S <count>          Largest symbols listed per unit (default 15 for a single unit, else 0)\n"
+              "  -j <report.json>    Write a JSON report with all symbols and SDRAM requests\n"
+              "  --elf <unit.elf>    Device ELF for a single unit.so, found in the unit's build/ otherwise\n");
+    }
+
+  }  // namespace
+
+  int cmd_footprint(int argc, char ** argv) {
+    std::vector<std::string> paths;
+    std::string json_path, elf_override;
+    long max_symbols = -1;
+
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-S") && i + 1 < argc)
+        max_symbols = atol(argv[++i]);
+      else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else if (!strcmp(argv[i], "--elf") && i + 1 < argc)
+        elf_override = argv[++i];
+      else if (argv[i][0] != '-')
+        paths.push_back(argv[i]);
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (paths.empty() || (!elf_override.empty() && paths.size() != 1)) {
+      usage();
+      return 2;
+    }
+    if (max_symbols < 0)
+      max_symbols = (paths.size() == 1) ? 15 : 0;
+
+    std::vector<Footprint> units(paths.size());
+    int over = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+      Footprint & f = units[i];
+      f.name = base_name(paths[i]);
+      f.sdram_ok = false;
+      memset(&f.sdram, 0, sizeof(f.sdram));
+
+      const bool is_so = ends_with(paths[i], ".so");
+      f.elf_path = !elf_override.empty() ? elf_override : is_so ? find_device_elf(paths[i]) : paths[i];
+      if (f.elf_path.empty())
+        f.elf_path = paths[i];
+      std::string err;
+      f.elf_ok = elf_read(f.elf_path, &f.elf, &err);
+      if (!f.elf_ok)
+        fprintf(stderr, "%s\n", err.c_str());
+      f.status = f.elf_ok ? "ok" : "no elf";
+
+      if (is_so) {
+        const IsolatedStatus st = run_isolated(sdram_child, &paths[i], &f.sdram, sizeof(f.sdram), 60);
+        f.sdram_ok = st.completed && st.exit_code == 0;
+        if (!f.sdram_ok)
+          f.status = std::string("init ") + isolated_status_str(st);
+        else if (f.sdram.init_err != k_unit_err_none) {
+          f.status = std::string("init k_unit_err_") + unit_err_name(static_cast<int8_t>(f.sdram.init_err));
+          uint64_t requested = 0;
+          for (uint32_t k = 0; k < f.sdram.count && k < k_max_allocations; ++k)
+            requested += f.sdram.allocations[k].size;
+          if (requested > f.sdram.capacity) {
+            char buf[64];
+            snprintf(buf, sizeof(buf), ", %llu sdram bytes requested", static_cast<unsigned long long>(requested));
+            f.status += buf;
+          }
+        }
+      }
+    }
+
+    printf("%-22s %-6s %-6s %8s %8s %7s %8s %7s %15s %6s %18s %6s  %s\n", "unit", "module", "elf", "text", "rodata",
+           "data", "bss", "other", "load/limit", "", "sdram/limit", "", "status");
+    for (size_t i = 0; i < units.size(); ++i) {
+      const Footprint & f = units[i];
+      const uint32_t module = f.elf.target ? (f.elf.target & UNIT_TARGET_MODULE_MASK) : f.sdram.module;
+      const uint64_t load_limit = max_unit_size(module);
+      const uint64_t sdram_limit = default_sdram_size(module);
+      char load[32] = "-", load_pct[16] = "", sdram[32] = "-", sdram_pct[16] = "";
+      if (f.elf_ok) {
+        snprintf(load, sizeof(load), "%llu/%lluK", static_cast<unsigned long long>(f.elf.budgetSize()),
+                 static_cast<unsigned long long>(load_limit / 1024));
+        snprintf(load_pct, sizeof(load_pct), "%5.1f%%", pct(f.elf.budgetSize(), load_limit));
+        over += (load_limit && f.elf.budgetSize() > load_limit);
+      }
+      if (f.sdram_ok && (f.sdram.count || sdram_limit)) {
+        snprintf(sdram, sizeof(sdram), "%llu/%lluK", static_cast<unsigned long long>(f.sdram.peak),
+                 static_cast<unsigned long long>(sdram_limit / 1024));
+        if (sdram_limit)
+          snprintf(sdram_pct, sizeof(sdram_pct), "%5.1f%%", pct(f.sdram.peak, sdram_limit));
+      }
+      printf("%-22s %-6s %-6s", f.name.c_str(), module ? module_name(module) : "-",
+             f.elf_ok ? (f.elf.arm ? "device" : "host") : "-");
+      for (int c = 0; c < k_num_elf_classes; ++c) {
+        if (f.elf_ok)
+          printf(" %*llu", c == k_elf_data || c == k_elf_other ? 7 : 8, static_cast<unsigned long long>(f.elf.size[c]));
+        else
+          printf(" %*s", c == k_elf_data || c == k_elf_other ? 7 : 8, "-");
+      }
+      printf(" %15s %6s %18s %6s  %s\n", load, load_pct, sdram, sdram_pct, f.status.c_str());
+    }
+
+    for (size_t i = 0; i < units.size() && max_symbols > 0; ++i)
+      print_details(units[i], static_cast<size_t>(max_symbols));
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot create %s\n", json_path.c_str());
+        return 1;
+      }
+      write_report(fp, units);
+      fclose(fp);
+      printf("report: %s\n", json_path.c_str());
+    }
+
+    if (over) {
+      printf("%d unit(s) exceed the module size limit\n", over);
+      return 1;
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
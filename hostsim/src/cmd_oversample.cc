@@ -0,0 +1,242 @@
+/**
+ *  @file cmd_oversample.cc
+ *
+ *  @brief hostsim oversample: cost and alias rejection of dsp::Oversampler per factor
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "json.h"
+
+#include "utils/float_math.h"
+#include "dsp/oversampler.hpp"
+
+namespace hostsim {
+
+  namespace {
+
+    const uint32_t k_block = 64;
+    const uint32_t k_dft_size = 4800;           // 10 Hz bins, test tones sit on a bin
+    const uint32_t k_settle = 4800;
+    const uint32_t k_bench_frames = 48000 * 8;
+    const uint32_t k_tone_bins[2] = { 297, 797 };  // 2970 Hz and 7970 Hz
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim oversample [options]\n"
+              "  -d <drive>               Gain into the fastertanhf stage (default 4)\n"
+              "  -j <file.json>           Write the results as JSON\n");
+    }
+
+    struct Result {
+      uint32_t factor;
+      double ns_per_sample;
+      double alias_db[2];     // alias power against the fundamental, dB
+      double gain_db[2];      // round trip gain at 15 kHz and 20 kHz without the nonlinearity
+      double delay;           // round trip phase delay at 1 kHz, samples
+    };
+
+    struct Stage {
+      virtual ~Stage() {}
+      virtual void clear() = 0;
+      virtual void run(float * buf, uint32_t frames, float drive) = 0;
+      virtual void pass(float * buf, uint32_t frames) = 0;
+    };
+
+    struct Plain : Stage {
+      void clear() {}
+      void run(float * buf, uint32_t frames, float drive) {
+        for (uint32_t i = 0; i < frames; ++i)
+          buf[i] = fastertanhf(drive * buf[i]);
+      }
+      void pass(float *, uint32_t) {}
+    };
+
+    template <uint32_t Factor>
+    struct Oversampled : Stage {
+      dsp::Oversampler<Factor, k_block> os;
+      void clear() { os.clear(); }
+      void run(float * buf, uint32_t frames, float drive) {
+        os.process(buf, buf, frames, [drive](float x) { return fastertanhf(drive * x); });
+      }
+      void pass(float * buf, uint32_t frames) {
+        os.process(buf, buf, frames, [](float x) { return x; });
+      }
+    };
+
+    /** Run a sine through a stage and return the settled tail. */
+    std::vector<float> render_tone(Stage & st, double hz, bool nonlinear, float drive) {
+      st.clear();
+      std::vector<float> buf(k_settle + k_dft_size);
+      const double w = 2.0 * M_PI * hz / k_samplerate;
+      for (size_t i = 0; i < buf.size(); ++i)
+        buf[i] = static_cast<float>(0.5 * sin(w * i));
+      for (size_t i = 0; i < buf.size(); i += k_block) {
+        if (nonlinear)
+          st.run(&buf[i], k_block, drive);
+        else
+          st.pass(&buf[i], k_block);
+      }
+      return std::vector<float>(buf.begin() + k_settle, buf.end());
+    }
+
+    /** Complex DFT bin of a block. */
+    void dft_bin(const std::vector<float> & x, uint32_t bin, double * re, double * im) {
+      double r = 0, m = 0;
+      for (uint32_t n = 0; n < k_dft_size; ++n) {
+        const double ph = 2.0 * M_PI * ((static_cast<uint64_t>(bin) * n) % k_dft_size) / k_dft_size;
+        r += x[n] * cos(ph);
+        m -= x[n] * sin(ph);
+      }
+      *re = r;
+      *im = m;
+    }
+
+    /**
+     * Power of everything that is not a harmonic of the tone, against the
+     * fundamental. Harmonics above Nyquist fold onto bins between the ones
+     * below it, so this is the aliasing of the stage.
+     */
+    double alias_db(const std::vector<float> & x, uint32_t tone_bin) {
+      double harm = 0, alias = 0;
+      for (uint32_t b = 1; b < k_dft_size / 2; ++b) {
+        double re, im;
+        dft_bin(x, b, &re, &im);
+        const double p = re * re + im * im;
+        if (b == tone_bin)
+          harm = p;
+        else if (b % tone_bin)
+          alias += p;
+      }
+      return alias > 0 ? 10.0 * log10(alias / harm) : -HUGE_VAL;
+    }
+
+    Result measure(Stage & st, uint32_t factor, float drive) {
+      Result r;
+      r.factor = factor;
+
+      for (int t = 0; t < 2; ++t) {
+        const uint32_t bin = k_tone_bins[t];
+        r.alias_db[t] = alias_db(render_tone(st, bin * 10.0, true, drive), bin);
+      }
+
+      const uint32_t gain_bins[2] = { 1500, 2000 };
+      for (int t = 0; t < 2; ++t) {
+        double re, im;
+        dft_bin(render_tone(st, gain_bins[t] * 10.0, false, drive), gain_bins[t], &re, &im);
+        r.gain_db[t] = 20.0 * log10(sqrt(re * re + im * im) / (0.5 * k_dft_size / 2));
+      }
+
+      {
+        // Phase of the tone against a cosine reference starting at the tail
+        double re, im;
+        dft_bin(render_tone(st, 1000.0, false, drive), 100, &re, &im);
+        const double ref = atan2(-1.0, 0.0);   // sine in the DFT phase convention
+        const double lag = ref - atan2(im, re);
+        double d = lag;
+        while (d < 0) d += 2.0 * M_PI;
+        r.delay = d / (2.0 * M_PI * 1000.0 / k_samplerate);
+      }
+
+      std::vector<float> buf(k_block);
+      for (uint32_t i = 0; i < k_block; ++i)
+        buf[i] = 0.5f * sinf(0.37f * i);
+      // Fastest of a few runs, as in compare
+      r.ns_per_sample = HUGE_VAL;
+      for (int run = 0; run < 3; ++run) {
+        st.clear();
+        const double t0 = now_ns();
+        for (uint32_t f = 0; f < k_bench_frames; f += k_block) {
+          st.run(&buf[0], k_block, drive);
+          buf[f / k_block % k_block] += 0.25f;   // keep the input moving
+        }
+        const double ns = (now_ns() - t0) / k_bench_frames;
+        if (ns < r.ns_per_sample)
+          r.ns_per_sample = ns;
+      }
+      return r;
+    }
+
+    void print_db(double db) {
+      if (db == -HUGE_VAL)
+        printf(" %9s", "-inf");
+      else
+        printf(" %9.1f", db);
+    }
+
+  }  // namespace
+
+  int cmd_oversample(int argc, char ** argv) {
+    std::string json_path;
+    float drive = 4.f;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-d") && i + 1 < argc)
+        drive = static_cast<float>(atof(argv[++i]));
+      else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+
+    Plain plain;
+    Oversampled<2> os2;
+    Oversampled<4> os4;
+    std::vector<Result> res;
+    res.push_back(measure(plain, 1, drive));
+    res.push_back(measure(os2, 2, drive));
+    res.push_back(measure(os4, 4, drive));
+
+    printf("fastertanhf(%.2f * x) on a -6 dBFS sine, alias power in dBc, round trip gain in dB\n", drive);
+    printf("%-6s %8s %9s %9s %9s %9s %9s %9s\n", "factor", "ns/smp", "overhead",
+           "alias 3k", "alias 8k", "gain 15k", "gain 20k", "delay 1k");
+    for (size_t r = 0; r < res.size(); ++r) {
+      printf("%-6u %8.2f %8.1fx", res[r].factor, res[r].ns_per_sample, res[r].ns_per_sample / res[0].ns_per_sample);
+      print_db(res[r].alias_db[0]);
+      print_db(res[r].alias_db[1]);
+      printf(" %9.2f %9.2f %9.2f\n", res[r].gain_db[0], res[r].gain_db[1], res[r].delay);
+    }
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        return 1;
+      }
+      JsonWriter w(fp);
+      w.beginArray();
+      for (size_t r = 0; r < res.size(); ++r) {
+        w.beginObject();
+        w.field("factor", res[r].factor);
+        w.field("ns_per_sample", res[r].ns_per_sample);
+        w.field("overhead", res[r].ns_per_sample / res[0].ns_per_sample);
+        const char * const alias_keys[2] = { "alias_2970hz_dbc", "alias_7970hz_dbc" };
+        for (int t = 0; t < 2; ++t) {
+          w.key(alias_keys[t]);
+          if (res[r].alias_db[t] == -HUGE_VAL)
+            w.null();
+          else
+            w.value(res[r].alias_db[t]);
+        }
+        w.field("gain_15khz_db", res[r].gain_db[0]);
+        w.field("gain_20khz_db", res[r].gain_db[1]);
+        w.field("delay_samples", res[r].delay);
+        w.endObject();
+      }
+      w.endArray();
+      fputc('\n', fp);
+      fclose(fp);
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,154 @@
+/**
+ *  @file cmd_render.cc
+ *
+ *  @brief hostsim render: render one unit to WAV and report its render cost
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cli.h"
+#include "unit_profile.h"
+#include "utils/fp_guard.h"
+
+namespace hostsim {
+
+  namespace {
+
+    /** Print the callback profile of units built with -DUNIT_PROFILE. */
+    void print_profile(const HostUnit & unit) {
+      typedef const unit_profile_stats_t * (*get_stats_func)(uint8_t);
+      get_stats_func get_stats = reinterpret_cast<get_stats_func>(unit.symbol("unit_profile_get_stats"));
+      if (!get_stats)
+        return;
+      static const char * const k_names[k_num_unit_profile_callbacks] = { "render", "set_param", "note_on" };
+      printf("profile    : ns per frame (per call for set_param/note_on)\n");
+      for (uint8_t c = 0; c < k_num_unit_profile_callbacks; ++c) {
+        const unit_profile_stats_t * stats = get_stats(c);
+        if (!stats || !stats->calls)
+          continue;
+        printf("  %-9s  %6u calls, min %u, mean %u, max %u\n", k_names[c], stats->calls, stats->min,
+               unit_profile_mean(stats), stats->max);
+        printf("  %-9s ", "");
+        for (uint32_t b = 0; b < UNIT_PROFILE_NUM_BUCKETS; ++b)
+          if (stats->histogram[b])
+            printf(" [%u,%u):%u", 1U << b, 2U << b, stats->histogram[b]);
+        printf("\n");
+      }
+    }
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim render <unit.so> [options]\n"
+              "  -o <file.wav>    Write rendered audio (32-bit float)\n"
+              "  -i <file.wav>    Input audio for effects, 48 kHz (default: gated noise bursts)\n"
+              "  --record <file>  Write the delivered callbacks as a trace\n"
+              "%s", k_render_options_usage);
+    }
+
+    /** Print the denormal/NaN counters of units built with -DFP_GUARD_DIAG. */
+    void print_fp_diag(const HostUnit & unit) {
+      typedef const fp_guard_diag_entry_t * (*entries_func)(uint32_t *);
+      entries_func get_entries = reinterpret_cast<entries_func>(unit.symbol("fp_guard_diag_entries"));
+      if (!get_entries)
+        return;
+      uint32_t count = 0;
+      const fp_guard_diag_entry_t * entries = get_entries(&count);
+      printf("fp guard   : %u watched variable(s)\n", count);
+      for (uint32_t i = 0; i < count; ++i)
+        printf("  %-24s %10u values, %8u denormal, %8u non-finite\n", entries[i].name, entries[i].checks,
+               entries[i].denormals, entries[i].nonfinite);
+    }
+
+  }  // namespace
+
+  int cmd_render(int argc, char ** argv) {
+    RenderOptions opt;
+    std::string unit_path, out_path, in_path, record_path;
+
+    for (int i = 0; i < argc; ++i) {
+      const int r = parse_render_option(argc, argv, &i, &opt);
+      if (r < 0)
+        return 2;
+      if (r > 0)
+        continue;
+      if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        out_path = argv[++i];
+      else if (!strcmp(argv[i], "-i") && i + 1 < argc)
+        in_path = argv[++i];
+      else if (!strcmp(argv[i], "--record") && i + 1 < argc)
+        record_path = argv[++i];
+      else if (argv[i][0] != '-' && unit_path.empty())
+        unit_path = argv[i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (unit_path.empty()) {
+      usage();
+      return 2;
+    }
+
+    HostUnit unit;
+    if (!open_unit(unit, unit_path, opt))
+      return 1;
+
+    WavData input;
+    const size_t frames = static_cast<size_t>(opt.seconds * k_samplerate);
+    if (!in_path.empty()) {
+      std::string err;
+      if (!wav_read(in_path, &input, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      if (input.samplerate != k_samplerate)
+        fprintf(stderr, "warning: %s is %u Hz, rendering as if %u Hz\n", in_path.c_str(), input.samplerate, k_samplerate);
+    }
+    else if (unit.module() != k_unit_module_osc) {
+      make_excitation(&input, frames);
+    }
+
+    WavData output;
+    RenderStats stats;
+    render_unit(unit, opt, input.samples.empty() ? NULL : &input, out_path.empty() ? NULL : &output, &stats);
+
+    const double budget_ns = 1e9 / k_samplerate;
+    printf("unit       : %s (%s, \"%s\")\n", unit.name().c_str(), module_name(unit.module()), unit.header()->name);
+    printf("rendered   : %llu frames (%.2f s) in blocks of %u\n",
+           static_cast<unsigned long long>(stats.frames), stats.frames / static_cast<double>(k_samplerate),
+           opt.frames_per_buffer);
+    printf("cost       : %.1f ns/sample (%.2f%% of the %.0f ns real-time budget on this host)\n",
+           stats.nsPerSample(), 100.0 * stats.nsPerSample() / budget_ns, budget_ns);
+    printf("blocks     : mean %.2f us, p99 %.2f us, worst %.2f us\n",
+           stats.meanBlockNs() * 1e-3, stats.percentileBlockNs(99.0) * 1e-3, stats.maxBlockNs() * 1e-3);
+    printf("realtime   : %.1fx\n", stats.realtimeFactor());
+    if (unit.sdram()->capacity() || unit.sdram()->peak())
+      printf("sdram      : %zu of %zu bytes\n", unit.sdram()->peak(), unit.sdram()->capacity());
+    print_profile(unit);
+    print_fp_diag(unit);
+
+    if (!out_path.empty()) {
+      std::string err;
+      if (!wav_write(out_path, output, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      printf("output     : %s\n", out_path.c_str());
+    }
+    if (!record_path.empty()) {
+      Trace trace;
+      trace.length = frames;
+      render_events(opt, frames, &trace.events);
+      std::string err;
+      if (!trace_write(record_path, trace, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      printf("trace      : %s, %zu events\n", record_path.c_str(), trace.events.size());
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
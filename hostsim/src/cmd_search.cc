@@ -0,0 +1,370 @@
+/**
+ *  @file cmd_search.cc
+ *
+ *  @brief hostsim search: find the parameters and note with the highest render cost
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "isolate.h"
+#include "preset.h"
+
+namespace hostsim {
+
+  namespace {
+
+    const double k_warmup_seconds = 0.25;
+    const int k_note_min = 24;
+    const int k_note_max = 108;
+    const uint8_t k_note_dim = 0xFF;
+    const size_t k_num_leaders = 5;
+
+    /** One searched dimension, a parameter or the note. */
+    struct Dim {
+      uint8_t id;
+      int32_t min;
+      int32_t max;
+    };
+
+    typedef std::vector<int32_t> Config; // one value per Dim
+
+    struct Search {
+      HostUnit * unit;
+      RenderOptions base;
+      const WavData * input;
+      std::vector<Dim> dims;
+      unsigned timeout_s;
+      unsigned evaluations;
+      unsigned crashes;
+      Config first_crash;
+      std::string first_crash_status;
+    };
+
+    struct EvalJob {
+      const Search * search;
+      const Config * config;
+    };
+
+    struct EvalResult {
+      double ns_per_sample;
+    };
+
+    uint32_t s_rng = 0x9E3779B9U;
+
+    uint32_t rand_u32() {
+      s_rng ^= s_rng << 13;
+      s_rng ^= s_rng >> 17;
+      s_rng ^= s_rng << 5;
+      return s_rng;
+    }
+
+    int32_t rand_range(int32_t lo, int32_t hi) {
+      return lo + static_cast<int32_t>(rand_u32() % static_cast<uint32_t>(hi - lo + 1));
+    }
+
+    RenderOptions options_for(const Search & search, const Config & config) {
+      RenderOptions opt = search.base;
+      for (size_t d = 0; d < search.dims.size(); ++d) {
+        if (search.dims[d].id == k_note_dim)
+          opt.note = config[d];
+        else
+          opt.params.push_back(std::make_pair(search.dims[d].id, config[d]));
+      }
+      return opt;
+    }
+
+    /**
+     * Runs in a child forked from the initialized unit, so each evaluation starts from the
+     * same state without reloading. The cost is the lowest mean of three windows after the
+     * warm up, which filters out interference from the rest of the system.
+     */
+    int eval_child(void * ctx, void * out, size_t size) {
+      const EvalJob & job = *static_cast<EvalJob *>(ctx);
+      EvalResult & res = *static_cast<EvalResult *>(out);
+      (void)size;
+
+      RenderOptions opt = options_for(*job.search, *job.config);
+      opt.seconds += k_warmup_seconds;
+      RenderStats stats;
+      render_unit(*job.search->unit, opt, job.search->input, NULL, &stats);
+
+      const size_t skip = static_cast<size_t>(k_warmup_seconds * k_samplerate / opt.frames_per_buffer);
+      const size_t window = (stats.block_ns.size() - skip) / 3;
+      res.ns_per_sample = 0;
+      for (size_t w = 0; w < 3 && window > 0; ++w) {
+        double sum = 0;
+        for (size_t b = 0; b < window; ++b)
+          sum += stats.block_ns[skip + w * window + b];
+        const double ns = sum / (window * opt.frames_per_buffer);
+        if (w == 0 || ns < res.ns_per_sample)
+          res.ns_per_sample = ns;
+      }
+      return 0;
+    }
+
+    /** @return ns per sample, negative if the unit crashed or hung. */
+    double evaluate(Search & search, const Config & config) {
+      EvalJob job = { &search, &config };
+      EvalResult res;
+      const IsolatedStatus st = run_isolated(eval_child, &job, &res, sizeof(res), search.timeout_s);
+      ++search.evaluations;
+      if (st.completed && st.exit_code == 0)
+        return res.ns_per_sample;
+      if (!search.crashes++) {
+        search.first_crash = config;
+        search.first_crash_status = isolated_status_str(st);
+      }
+      return -1;
+    }
+
+    double evaluate_median(Search & search, const Config & config, unsigned runs) {
+      std::vector<double> costs;
+      for (unsigned r = 0; r < runs; ++r)
+        costs.push_back(evaluate(search, config));
+      std::sort(costs.begin(), costs.end());
+      return (costs.front() < 0) ? -1 : costs[costs.size() / 2];
+    }
+
+    void print_config(const Search & search, const Config & config) {
+      for (size_t d = 0; d < search.dims.size(); ++d) {
+        if (search.dims[d].id == k_note_dim)
+          printf(" -n %d", config[d]);
+        else
+          printf(" -p %u=%d", search.dims[d].id, config[d]);
+      }
+      printf("\n");
+    }
+
+    struct PresetInfo {
+      double cost;
+      double default_cost;
+      uint32_t seed;
+      unsigned evaluations;
+      const RenderOptions * opt;
+    };
+
+    void write_search_info(JsonWriter & w, void * ctx) {
+      const PresetInfo & info = *static_cast<PresetInfo *>(ctx);
+      w.field("ns_per_sample", info.cost);
+      w.field("default_ns_per_sample", info.default_cost);
+      w.key("search");
+      w.beginObject();
+      w.field("seed", info.seed);
+      w.field("evaluations", info.evaluations);
+      w.field("frames_per_buffer", static_cast<unsigned>(info.opt->frames_per_buffer));
+      w.field("seconds", info.opt->seconds);
+      w.field("bpm", static_cast<double>(info.opt->bpm));
+      w.endObject();
+    }
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim search <unit.so> [options]\n"
+              "  -o <preset.json>      Output preset (default <unit>.stress.json)\n"
+              "  -e <evaluations>      Evaluation budget (default 300)\n"
+              "  --random <n>          Random samples before coordinate ascent (default 1/3 of the budget)\n"
+              "  --seed <n>            Random seed (default 1)\n"
+              "  --min-gain <pct>      Improvement accepted by coordinate ascent (default 2)\n"
+              "  --timeout <seconds>   Time limit per evaluation (default 30)\n"
+              "%s"
+              "  -s sets the measured length per evaluation (default 1.5), -n and -p the starting point\n",
+              k_render_options_usage);
+    }
+
+  }  // namespace
+
+  int cmd_search(int argc, char ** argv) {
+    RenderOptions opt;
+    opt.seconds = 1.5;
+    std::string path, out_path;
+    unsigned budget = 300;
+    int random_count = -1;
+    uint32_t seed = 1;
+    double min_gain = 2.0;
+    unsigned timeout_s = 30;
+
+    for (int i = 0; i < argc; ++i) {
+      const int r = parse_render_option(argc, argv, &i, &opt);
+      if (r < 0)
+        return 2;
+      if (r > 0)
+        continue;
+      if (!strcmp(argv[i], "-o") && i + 1 < argc)
+        out_path = argv[++i];
+      else if (!strcmp(argv[i], "-e") && i + 1 < argc)
+        budget = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+      else if (!strcmp(argv[i], "--random") && i + 1 < argc)
+        random_count = std::max(0, atoi(argv[++i]));
+      else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+        seed = static_cast<uint32_t>(strtoul(argv[++i], NULL, 0));
+      else if (!strcmp(argv[i], "--min-gain") && i + 1 < argc)
+        min_gain = atof(argv[++i]);
+      else if (!strcmp(argv[i], "--timeout") && i + 1 < argc)
+        timeout_s = static_cast<unsigned>(atoi(argv[++i]));
+      else if (argv[i][0] != '-' && path.empty())
+        path = argv[i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+    if (path.empty()) {
+      usage();
+      return 2;
+    }
+
+    HostUnit unit;
+    if (!open_unit(unit, path, opt))
+      return 1;
+    if (out_path.empty())
+      out_path = unit.name() + ".stress.json";
+    s_rng = seed ? seed : 1;
+
+    Search search;
+    search.unit = &unit;
+    search.base = opt;
+    search.base.params.clear();
+    search.timeout_s = timeout_s;
+    search.evaluations = 0;
+    search.crashes = 0;
+
+    // Starting point: header defaults, overridden by -p/-n/--preset
+    const unit_header_t * header = unit.header();
+    Config start;
+    for (uint32_t id = 0; id < header->num_params && id < UNIT_MAX_PARAM_COUNT; ++id) {
+      const unit_param_t & p = header->params[id];
+      if (p.min >= p.max)
+        continue;
+      Dim dim = { static_cast<uint8_t>(id), p.min, p.max };
+      int32_t value = p.init;
+      for (size_t k = 0; k < opt.params.size(); ++k)
+        if (opt.params[k].first == id)
+          value = std::max(dim.min, std::min(dim.max, opt.params[k].second));
+      search.dims.push_back(dim);
+      start.push_back(value);
+    }
+    if (unit.module() == k_unit_module_osc) {
+      Dim dim = { k_note_dim, k_note_min, k_note_max };
+      search.dims.push_back(dim);
+      start.push_back(opt.note >= 0 ? opt.note : 60);
+    }
+    else {
+      search.base.note = -1;
+    }
+
+    WavData input;
+    if (unit.module() != k_unit_module_osc)
+      make_excitation(&input, static_cast<size_t>((opt.seconds + k_warmup_seconds) * k_samplerate));
+    search.input = input.samples.empty() ? NULL : &input;
+
+    printf("unit       : %s (%s, \"%s\"), %zu dimensions\n", unit.name().c_str(), module_name(unit.module()),
+           header->name, search.dims.size());
+
+    Config best = start;
+    double best_cost = evaluate(search, start);
+    if (best_cost < 0) {
+      printf("starting point failed with %s:", search.first_crash_status.c_str());
+      print_config(search, start);
+      return 1;
+    }
+    printf("start      : %.1f ns/sample\n", best_cost);
+
+    // Random search explores the whole space to find the region with the highest cost.
+    // Single measurements are noisy, so the leading candidates are measured again before
+    // one of them is picked as the start of the ascent.
+    const unsigned n_random = (random_count >= 0) ? static_cast<unsigned>(random_count) : budget / 3;
+    std::vector<std::pair<double, Config> > leaders(1, std::make_pair(best_cost, start));
+    for (unsigned i = 0; i < n_random && search.evaluations < budget; ++i) {
+      Config c(search.dims.size());
+      for (size_t d = 0; d < search.dims.size(); ++d)
+        c[d] = rand_range(search.dims[d].min, search.dims[d].max);
+      const double cost = evaluate(search, c);
+      if (cost > 0)
+        leaders.push_back(std::make_pair(cost, c));
+    }
+    std::sort(leaders.begin(), leaders.end());
+    std::reverse(leaders.begin(), leaders.end());
+    best_cost = -1;
+    for (size_t i = 0; i < leaders.size() && i < k_num_leaders; ++i) {
+      const double cost = evaluate_median(search, leaders[i].second, 3);
+      if (cost > best_cost) {
+        best_cost = cost;
+        best = leaders[i].second;
+      }
+    }
+    printf("random     : %.1f ns/sample after %u evaluations\n", best_cost, search.evaluations);
+
+    // Coordinate ascent refines one dimension at a time from the best point
+    bool improved = true;
+    while (improved && search.evaluations < budget) {
+      improved = false;
+      std::vector<size_t> order(search.dims.size());
+      for (size_t d = 0; d < order.size(); ++d)
+        order[d] = d;
+      for (size_t d = order.size(); d > 1; --d)
+        std::swap(order[d - 1], order[rand_u32() % d]);
+
+      for (size_t k = 0; k < order.size() && search.evaluations < budget; ++k) {
+        const size_t d = order[k];
+        const Dim & dim = search.dims[d];
+        const int32_t range = dim.max - dim.min;
+        const int32_t step = std::max(1, range / 16);
+        const int32_t cur = best[d];
+        const int32_t candidates[] = {
+          dim.min, dim.max, dim.min + range / 4, dim.min + range / 2, dim.min + 3 * range / 4,
+          std::max(dim.min, cur - step), std::min(dim.max, cur + step)
+        };
+        std::vector<int32_t> tried(1, cur);
+        for (size_t c = 0; c < sizeof(candidates) / sizeof(candidates[0]) && search.evaluations < budget; ++c) {
+          if (std::find(tried.begin(), tried.end(), candidates[c]) != tried.end())
+            continue;
+          tried.push_back(candidates[c]);
+          Config trial = best;
+          trial[d] = candidates[c];
+          const double threshold = best_cost * (1.0 + min_gain * 0.01);
+          double cost = evaluate(search, trial);
+          if (cost > threshold)
+            cost = std::min(cost, evaluate(search, trial)); // confirm, a lucky measurement must not move the search
+          if (cost > threshold) {
+            best_cost = cost;
+            best = trial;
+            improved = true;
+          }
+        }
+      }
+    }
+    printf("ascent     : %.1f ns/sample after %u evaluations\n", best_cost, search.evaluations);
+
+    // Confirm against the starting point with fresh measurements
+    const double default_cost = evaluate_median(search, start, 5);
+    best_cost = evaluate_median(search, best, 5);
+    printf("worst case : %.1f ns/sample, %.2fx the starting point (%.1f ns/sample)\n", best_cost,
+           default_cost > 0 ? best_cost / default_cost : 0.0, default_cost);
+    printf("config     :");
+    print_config(search, best);
+    if (search.crashes) {
+      printf("crashes    : %u evaluation(s) failed, first with %s:", search.crashes,
+             search.first_crash_status.c_str());
+      print_config(search, search.first_crash);
+    }
+
+    const RenderOptions best_opt = options_for(search, best);
+    PresetInfo info = { best_cost, default_cost, seed, search.evaluations, &opt };
+    std::string err;
+    if (!preset_write(out_path, unit, best_opt, write_search_info, &info, &err)) {
+      fprintf(stderr, "%s\n", err.c_str());
+      return 1;
+    }
+    printf("preset     : %s (hostsim render %s --preset %s)\n", out_path.c_str(), path.c_str(), out_path.c_str());
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,226 @@
+/**
+ *  @file cmd_storage.cc
+ *
+ *  @brief hostsim storage: noise floor of the delay line sample storage formats
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "cli.h"
+#include "json.h"
+
+#include "dsp/delayline.hpp"
+
+namespace hostsim {
+
+  namespace {
+
+    const uint32_t k_line_size = 8192;
+    const uint32_t k_frames = 48000 * 4;
+    const uint32_t k_loop_delay = 4801;
+    const float k_loop_feedback = 0.9f;
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim storage [options]\n"
+              "  -j <file.json>           Write the results as JSON\n");
+    }
+
+    struct Signal {
+      const char * name;
+      std::vector<float> samples;
+    };
+
+    struct Result {
+      const char * format;
+      size_t bytes;
+      std::vector<double> floor_db;   // error RMS per signal, dBFS
+      double loop_db;                 // error RMS of the feedback loop against float, dBFS
+      double ns_per_sample;
+    };
+
+    double rms_db(double sum_sq, size_t n) {
+      const double rms = sqrt(sum_sq / n);
+      return rms > 0 ? 20.0 * log10(rms) : -HUGE_VAL;
+    }
+
+    std::vector<Signal> make_signals() {
+      std::vector<Signal> sig(6);
+      const double w = 2.0 * M_PI * 997.0 / 48000.0;
+      const double sine_db[3] = { 0.0, -20.0, -60.0 };
+      const char * const sine_name[3] = { "sine 0dB", "sine -20dB", "sine -60dB" };
+      for (int s = 0; s < 3; ++s) {
+        sig[s].name = sine_name[s];
+        const double a = pow(10.0, sine_db[s] / 20.0) * 0.999;
+        for (uint32_t i = 0; i < k_frames; ++i)
+          sig[s].samples.push_back(static_cast<float>(a * sin(w * i)));
+      }
+      sig[3].name = "noise -12dB";
+      uint32_t x = 0x12345678;
+      for (uint32_t i = 0; i < k_frames; ++i) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        sig[3].samples.push_back((static_cast<int32_t>(x) * (1.f / 2147483648.f)) * 0.25f);
+      }
+      sig[4].name = "sine +6dB";
+      for (uint32_t i = 0; i < k_frames; ++i)
+        sig[4].samples.push_back(static_cast<float>(1.99 * sin(w * i)));
+      sig[5].name = "silence";
+      sig[5].samples.assign(k_frames, 0.f);
+      return sig;
+    }
+
+    /** Write and read back at the head of the line, the error is the storage error. */
+    template <class Line>
+    double measure_floor(Line & line, const std::vector<float> & in) {
+      line.clear();
+      double err = 0;
+      for (size_t i = 0; i < in.size(); ++i) {
+        line.write(in[i]);
+        const double d = static_cast<double>(line.read(1)) - in[i];
+        err += d * d;
+      }
+      return rms_db(err, in.size());
+    }
+
+    /**
+     * Recirculate a noise burst through a feedback delay, as delay effects do,
+     * and return the output.
+     */
+    template <class Line>
+    std::vector<float> run_loop(Line & line, const std::vector<float> & burst, double * ns) {
+      line.clear();
+      std::vector<float> out(k_frames);
+      const double t0 = now_ns();
+      for (uint32_t i = 0; i < k_frames; ++i) {
+        const float delayed = line.read(k_loop_delay);
+        const float x = (i < burst.size()) ? burst[i] : 0.f;
+        line.write(x + delayed * k_loop_feedback);
+        out[i] = delayed;
+      }
+      *ns = (now_ns() - t0) / k_frames;
+      return out;
+    }
+
+    template <class Line>
+    Result measure(const char * format, size_t bytes, const std::vector<Signal> & sig,
+                   const std::vector<float> & burst, const std::vector<float> & loop_ref) {
+      std::vector<typename Line::sample_t> ram(k_line_size);
+      Line line;
+      line.setMemory(&ram[0], k_line_size);
+
+      Result r;
+      r.format = format;
+      r.bytes = bytes;
+      for (size_t s = 0; s < sig.size(); ++s)
+        r.floor_db.push_back(measure_floor(line, sig[s].samples));
+
+      const std::vector<float> out = run_loop(line, burst, &r.ns_per_sample);
+      double err = 0;
+      for (uint32_t i = 0; i < k_frames; ++i) {
+        const double d = static_cast<double>(out[i]) - loop_ref[i];
+        err += d * d;
+      }
+      r.loop_db = rms_db(err, k_frames);
+      return r;
+    }
+
+    /** Float line with the interface of PackedDelayLine, for the reference rows. */
+    struct FloatLine : dsp::DelayLine {
+      typedef float sample_t;
+    };
+
+    void print_db(double db) {
+      if (db == -HUGE_VAL)
+        printf(" %11s", "-inf");
+      else
+        printf(" %11.1f", db);
+    }
+
+  }  // namespace
+
+  int cmd_storage(int argc, char ** argv) {
+    std::string json_path;
+    for (int i = 0; i < argc; ++i) {
+      if (!strcmp(argv[i], "-j") && i + 1 < argc)
+        json_path = argv[++i];
+      else {
+        usage();
+        return 2;
+      }
+    }
+
+    const std::vector<Signal> sig = make_signals();
+    const std::vector<float> burst(sig[3].samples.begin(), sig[3].samples.begin() + 4800);
+
+    std::vector<float> loop_ref;
+    {
+      std::vector<float> ram(k_line_size);
+      FloatLine line;
+      line.setMemory(&ram[0], k_line_size);
+      double ns;
+      loop_ref = run_loop(line, burst, &ns);
+    }
+
+    std::vector<Result> res;
+    res.push_back(measure<FloatLine>("float", sizeof(float), sig, burst, loop_ref));
+    res.push_back(measure<dsp::DelayLineQ15>("q15", sizeof(int16_t), sig, burst, loop_ref));
+    res.push_back(measure<dsp::DelayLineF16>("half", sizeof(uint16_t), sig, burst, loop_ref));
+
+    printf("error RMS in dBFS after one write and read, feedback loop against float storage\n");
+    printf("%-7s %5s", "format", "bytes");
+    for (size_t s = 0; s < sig.size(); ++s)
+      printf(" %11s", sig[s].name);
+    printf(" %11s %8s\n", "feedback", "ns/smp");
+    for (size_t r = 0; r < res.size(); ++r) {
+      printf("%-7s %5zu", res[r].format, res[r].bytes);
+      for (size_t s = 0; s < sig.size(); ++s)
+        print_db(res[r].floor_db[s]);
+      print_db(res[r].loop_db);
+      printf(" %8.2f\n", res[r].ns_per_sample);
+    }
+
+    if (!json_path.empty()) {
+      FILE * fp = fopen(json_path.c_str(), "w");
+      if (!fp) {
+        fprintf(stderr, "cannot write %s\n", json_path.c_str());
+        return 1;
+      }
+      JsonWriter w(fp);
+      w.beginArray();
+      for (size_t r = 0; r < res.size(); ++r) {
+        w.beginObject();
+        w.field("format", res[r].format);
+        w.field("bytes_per_sample", static_cast<unsigned>(res[r].bytes));
+        w.key("error_dbfs");
+        w.beginObject();
+        for (size_t s = 0; s < sig.size(); ++s) {
+          w.key(sig[s].name);
+          if (res[r].floor_db[s] == -HUGE_VAL)
+            w.null();
+          else
+            w.value(res[r].floor_db[s]);
+        }
+        w.endObject();
+        w.key("feedback_error_dbfs");
+        if (res[r].loop_db == -HUGE_VAL)
+          w.null();
+        else
+          w.value(res[r].loop_db);
+        w.field("ns_per_sample", res[r].ns_per_sample);
+        w.endObject();
+      }
+      w.endArray();
+      fputc('\n', fp);
+      fclose(fp);
+    }
+    return 0;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,142 @@
+/**
+ *  @file cmd_trace.cc
+ *
+ *  @brief hostsim trace: convert MIDI files to callback traces and list trace contents
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "cli.h"
+
+namespace hostsim {
+
+  namespace {
+
+    void usage() {
+      fprintf(stderr,
+              "usage: hostsim trace midi <file.mid> -o <file.trace> [options]\n"
+              "       hostsim trace dump <file.trace>\n"
+              "  -o <file.trace>          Output trace\n"
+              "  -c <channel>             Convert only this MIDI channel, 1-16 (default all)\n"
+              "  --cc <cc>=<param id>     Map a controller to a parameter, may be repeated\n"
+              "  --unit <unit.so>         Scale mapped controllers to the parameter ranges of this unit\n"
+              "  --tail <seconds>         Length added after the last event (default 1)\n"
+              "  --no-clock               Do not generate unit_tempo_4ppqn_tick calls\n");
+    }
+
+    int trace_midi(int argc, char ** argv) {
+      MidiTraceOptions mopt;
+      std::string in_path, out_path, unit_path;
+
+      for (int i = 0; i < argc; ++i) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc)
+          out_path = argv[++i];
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc)
+          mopt.channel = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cc") && i + 1 < argc) {
+          const char * val = argv[++i];
+          const char * eq = strchr(val, '=');
+          const int cc = atoi(val), id = eq ? atoi(eq + 1) : -1;
+          if (!eq || cc < 0 || cc > 127 || id < 0 || id >= UNIT_MAX_PARAM_COUNT) {
+            fprintf(stderr, "invalid value for --cc: %s\n", val);
+            return 2;
+          }
+          mopt.cc_params.push_back(std::make_pair(static_cast<uint8_t>(cc), static_cast<uint8_t>(id)));
+        }
+        else if (!strcmp(argv[i], "--unit") && i + 1 < argc)
+          unit_path = argv[++i];
+        else if (!strcmp(argv[i], "--tail") && i + 1 < argc)
+          mopt.tail_seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--no-clock"))
+          mopt.clock = false;
+        else if (argv[i][0] != '-' && in_path.empty())
+          in_path = argv[i];
+        else {
+          usage();
+          return 2;
+        }
+      }
+      if (in_path.empty() || out_path.empty() || mopt.channel < 0 || mopt.channel > 16) {
+        usage();
+        return 2;
+      }
+
+      if (!unit_path.empty()) {
+        // The header is all that is needed, the unit is not initialized
+        HostUnit unit;
+        std::string err;
+        if (!unit.load(unit_path, &err)) {
+          fprintf(stderr, "%s: %s\n", unit_path.c_str(), err.c_str());
+          return 1;
+        }
+        for (uint8_t id = 0; id < unit.header()->num_params; ++id) {
+          const unit_param_t & p = unit.header()->params[id];
+          mopt.param_ranges.push_back(std::make_pair(static_cast<int32_t>(p.min), static_cast<int32_t>(p.max)));
+        }
+      }
+
+      Trace trace;
+      std::string err;
+      if (!trace_from_midi(in_path, mopt, &trace, &err) || !trace_write(out_path, trace, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+
+      size_t counts[k_num_trace_event_types] = { 0 };
+      for (size_t i = 0; i < trace.events.size(); ++i)
+        ++counts[trace.events[i].type];
+      printf("trace      : %s, %zu events over %.2f s\n", out_path.c_str(), trace.events.size(),
+             static_cast<double>(trace.length) / k_samplerate);
+      for (uint8_t t = 1; t < k_num_trace_event_types; ++t)
+        if (counts[t])
+          printf("  %-17s %zu\n", trace_event_name(t), counts[t]);
+      return 0;
+    }
+
+    int trace_dump(int argc, char ** argv) {
+      if (argc != 1) {
+        usage();
+        return 2;
+      }
+      Trace trace;
+      std::string err;
+      if (!trace_read(argv[0], &trace, &err)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return 1;
+      }
+      printf("# %zu events, %llu frames (%.3f s)\n", trace.events.size(),
+             static_cast<unsigned long long>(trace.length), static_cast<double>(trace.length) / k_samplerate);
+      for (size_t i = 0; i < trace.events.size(); ++i) {
+        const TraceEvent & e = trace.events[i];
+        printf("%10u %10.4f  %-17s", e.frame, static_cast<double>(e.frame) / k_samplerate, trace_event_name(e.type));
+        switch (e.type) {
+        case k_trace_param:      printf(" %u=%d", e.data, e.value); break;
+        case k_trace_note_on:    printf(" %u vel %d", e.data, e.value); break;
+        case k_trace_note_off:   printf(" %u", e.data); break;
+        case k_trace_aftertouch: printf(" %u %d", e.data, e.value); break;
+        case k_trace_tempo:      printf(" %.3f bpm", e.value / 65536.0); break;
+        case k_trace_all_note_off: break;
+        default:                 printf(" %d", e.value); break;
+        }
+        printf("\n");
+      }
+      return 0;
+    }
+
+  }  // namespace
+
+  int cmd_trace(int argc, char ** argv) {
+    if (argc >= 1 && !strcmp(argv[0], "midi"))
+      return trace_midi(argc - 1, argv + 1);
+    if (argc >= 1 && !strcmp(argv[0], "dump"))
+      return trace_dump(argc - 1, argv + 1);
+    usage();
+    return 2;
+  }
+
+}  // namespace hostsim
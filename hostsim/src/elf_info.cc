@@ -0,0 +1,169 @@
+/**
+ *  @file elf_info.cc
+ *
+ *  @brief Section and symbol sizes of unit ELF files
+ *
+ */
+
+#include "elf_info.h"
+
+#include <cxxabi.h>
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+namespace hostsim {
+
+  namespace {
+
+    bool starts_with(const char * s, const char * prefix) {
+      return !strncmp(s, prefix, strlen(prefix));
+    }
+
+    std::string demangle(const char * name) {
+      int status = 0;
+      char * d = abi::__cxa_demangle(name, NULL, NULL, &status);
+      if (!d)
+        return name;
+      std::string r(d);
+      free(d);
+      return r;
+    }
+
+    bool by_size(const ElfSymbol & a, const ElfSymbol & b) {
+      return a.size > b.size || (a.size == b.size && a.name < b.name);
+    }
+
+    template <typename Ehdr, typename Shdr, typename Sym, int SymType(unsigned char)>
+    bool parse(const std::vector<uint8_t> & file, ElfInfo * info, std::string * err) {
+      if (file.size() < sizeof(Ehdr)) {
+        *err = "truncated ELF header";
+        return false;
+      }
+      const Ehdr * eh = reinterpret_cast<const Ehdr *>(&file[0]);
+      if (!eh->e_shoff || eh->e_shentsize != sizeof(Shdr)
+          || eh->e_shoff + static_cast<uint64_t>(eh->e_shnum) * sizeof(Shdr) > file.size()
+          || eh->e_shstrndx >= eh->e_shnum) {
+        *err = "malformed section table";
+        return false;
+      }
+      info->arm = (eh->e_machine == EM_ARM);
+
+      const Shdr * sh = reinterpret_cast<const Shdr *>(&file[eh->e_shoff]);
+      const Shdr & shstr = sh[eh->e_shstrndx];
+      std::vector<ElfClass> classes(eh->e_shnum, k_num_elf_classes); // k_num_elf_classes: not loaded
+      std::vector<bool> exec(eh->e_shnum, false);
+
+      for (unsigned i = 0; i < eh->e_shnum; ++i) {
+        if (!(sh[i].sh_flags & SHF_ALLOC) || sh[i].sh_name >= shstr.sh_size)
+          continue;
+        const char * name = reinterpret_cast<const char *>(&file[shstr.sh_offset + sh[i].sh_name]);
+        ElfClass cls = k_elf_other;
+        if (sh[i].sh_type == SHT_NOBITS)
+          cls = starts_with(name, ".bss") ? k_elf_bss : k_elf_other;
+        else if (starts_with(name, ".text"))
+          cls = k_elf_text;
+        else if (starts_with(name, ".rodata"))
+          cls = k_elf_rodata;
+        else if (starts_with(name, ".data"))
+          cls = k_elf_data;
+        else if ((sh[i].sh_flags & SHF_WRITE) && !starts_with(name, ".got") && !starts_with(name, ".dynamic")
+                 && !strstr(name, "_array"))
+          cls = k_elf_data;  // e.g. buffers placed in a custom section
+        if (!strcmp(name, ".unit_header") && sh[i].sh_type == SHT_PROGBITS && sh[i].sh_size >= 8
+            && sh[i].sh_offset + 8 <= file.size())
+          memcpy(&info->target, &file[sh[i].sh_offset + 4], sizeof(info->target)); // after header_size
+        classes[i] = cls;
+        exec[i] = (sh[i].sh_flags & SHF_EXECINSTR) != 0;
+        info->size[cls] += sh[i].sh_size;
+        info->load_size += sh[i].sh_size;
+      }
+
+      // Prefer the full symbol table, stripped files only have dynamic symbols
+      const Shdr * symtab = NULL;
+      for (unsigned i = 0; i < eh->e_shnum; ++i)
+        if (sh[i].sh_type == SHT_SYMTAB)
+          symtab = &sh[i];
+      for (unsigned i = 0; !symtab && i < eh->e_shnum; ++i)
+        if (sh[i].sh_type == SHT_DYNSYM)
+          symtab = &sh[i];
+      if (!symtab)
+        return true;
+      if (symtab->sh_link >= eh->e_shnum || symtab->sh_offset + symtab->sh_size > file.size()) {
+        *err = "malformed symbol table";
+        return false;
+      }
+      const Shdr & strtab = sh[symtab->sh_link];
+      const Sym * syms = reinterpret_cast<const Sym *>(&file[symtab->sh_offset]);
+      const size_t count = symtab->sh_size / sizeof(Sym);
+
+      for (size_t i = 0; i < count; ++i) {
+        const Sym & s = syms[i];
+        const int type = SymType(s.st_info);
+        if (!s.st_size || s.st_shndx == SHN_UNDEF || s.st_shndx >= eh->e_shnum)
+          continue;
+        if ((type != STT_FUNC && type != STT_OBJECT) || classes[s.st_shndx] == k_num_elf_classes)
+          continue;
+        if (s.st_name >= strtab.sh_size)
+          continue;
+        ElfSymbol sym;
+        sym.name = demangle(reinterpret_cast<const char *>(&file[strtab.sh_offset + s.st_name]));
+        sym.size = s.st_size;
+        sym.cls = classes[s.st_shndx];
+        if (exec[s.st_shndx] && type == STT_OBJECT) {
+          // Constant tables merged into .text by the device linker script
+          sym.cls = k_elf_rodata;
+          info->size[k_elf_text] -= std::min<uint64_t>(info->size[k_elf_text], s.st_size);
+          info->size[k_elf_rodata] += s.st_size;
+        }
+        info->symbols.push_back(sym);
+      }
+      std::sort(info->symbols.begin(), info->symbols.end(), by_size);
+      return true;
+    }
+
+    int sym_type32(unsigned char i) { return ELF32_ST_TYPE(i); }
+    int sym_type64(unsigned char i) { return ELF64_ST_TYPE(i); }
+
+  }  // namespace
+
+  bool elf_read(const std::string & path, ElfInfo * info, std::string * err) {
+    std::string e;
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+      if (err)
+        *err = "cannot open " + path;
+      return false;
+    }
+    std::vector<uint8_t> file;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+      file.insert(file.end(), buf, buf + n);
+    fclose(fp);
+
+    if (file.size() < EI_NIDENT || memcmp(&file[0], ELFMAG, SELFMAG) || file[EI_DATA] != ELFDATA2LSB) {
+      if (err)
+        *err = path + ": not a little endian ELF file";
+      return false;
+    }
+    *info = ElfInfo();
+    bool ok;
+    if (file[EI_CLASS] == ELFCLASS32)
+      ok = parse<Elf32_Ehdr, Elf32_Shdr, Elf32_Sym, sym_type32>(file, info, &e);
+    else
+      ok = parse<Elf64_Ehdr, Elf64_Shdr, Elf64_Sym, sym_type64>(file, info, &e);
+    if (!ok && err)
+      *err = path + ": " + e;
+    return ok;
+  }
+
+  const char * elf_class_name(ElfClass cls) {
+    static const char * const k_names[k_num_elf_classes] = { "text", "rodata", "data", "bss", "other" };
+    return (cls < k_num_elf_classes) ? k_names[cls] : "?";
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,63 @@
+/**
+ *  @file elf_info.h
+ *
+ *  @brief Section and symbol sizes of unit ELF files
+ *
+ */
+
+#ifndef HOSTSIM_ELF_INFO_H_
+#define HOSTSIM_ELF_INFO_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+  /** Memory class of a section or symbol. */
+  enum ElfClass {
+    k_elf_text = 0,
+    k_elf_rodata,
+    k_elf_data,
+    k_elf_bss,
+    k_elf_other,    /** Dynamic linking tables, unwind info, unit header. */
+    k_num_elf_classes
+  };
+
+  struct ElfSymbol {
+    std::string name;  /** Demangled. */
+    uint64_t size;
+    ElfClass cls;
+  };
+
+  struct ElfInfo {
+    bool arm;                      /** Built for the device, sizes are exact. */
+    uint32_t target;               /** unit_header.target, 0 if not found. */
+    uint64_t size[k_num_elf_classes];
+    uint64_t load_size;            /** All allocated sections, what the runtime loads into RAM. */
+
+    /** Size to compare with the module limit. Host builds leave out their dynamic linking overhead. */
+    uint64_t budgetSize() const { return arm ? load_size : load_size - size[k_elf_other]; }
+    std::vector<ElfSymbol> symbols; /** Sorted by size, largest first. */
+
+    ElfInfo() : arm(false), target(0), load_size(0) {
+      for (int i = 0; i < k_num_elf_classes; ++i)
+        size[i] = 0;
+    }
+  };
+
+  /**
+   * Read section and symbol sizes of a 32 or 64-bit little endian ELF file.
+   *
+   * The device linker script places read-only data in .text, such data is told apart
+   * from code by its symbol type and counted as rodata.
+   */
+  bool elf_read(const std::string & path, ElfInfo * info, std::string * err);
+
+  /** Short name of a class, e.g.: "text". */
+  const char * elf_class_name(ElfClass cls);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_ELF_INFO_H_
@@ -0,0 +1,196 @@
+/**
+ *  @file host_runtime.cc
+ *
+ *  @brief Host stand-ins for the runtime services a unit sees on the device
+ *
+ */
+
+#include "host_runtime.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace hostsim {
+
+  namespace {
+
+    std::vector<SdramPool *> s_pools;
+    SdramPool * s_current_pool = NULL;
+    float s_tempo_bpm = 120.f;
+
+    __attribute__((noinline)) uint8_t * host_sdram_alloc(size_t size) {
+      return s_current_pool ? s_current_pool->alloc(size, __builtin_return_address(0)) : NULL;
+    }
+
+    void host_sdram_free(const uint8_t * mem) {
+      for (size_t i = 0; i < s_pools.size(); ++i)
+        if (s_pools[i]->free(mem))
+          return;
+    }
+
+    size_t host_sdram_avail(void) {
+      return s_current_pool ? s_current_pool->avail() : 0;
+    }
+
+  }  // namespace
+
+  SdramPool::SdramPool(size_t capacity) :
+    base_(NULL),
+    capacity_(capacity),
+    used_(0),
+    peak_(0),
+    failed_(0)
+  {
+    if (capacity_)
+      base_ = static_cast<uint8_t *>(calloc(capacity_, 1));
+    // SDRAM is always resident on the device, fault the pages in now so that the first
+    // unit_render calls are not charged for them
+    if (base_)
+      memset(base_, 0, capacity_);
+    if (!base_)
+      capacity_ = 0;
+    s_pools.push_back(this);
+  }
+
+  SdramPool::~SdramPool() {
+    for (size_t i = 0; i < s_pools.size(); ++i) {
+      if (s_pools[i] == this) {
+        s_pools.erase(s_pools.begin() + i);
+        break;
+      }
+    }
+    if (s_current_pool == this)
+      s_current_pool = NULL;
+    ::free(base_);
+  }
+
+  uint8_t * SdramPool::alloc(size_t size, const void * caller) {
+    // Keep allocations 16-byte aligned so SIMD code behaves as on the device
+    const size_t aligned = (size + 15U) & ~static_cast<size_t>(15U);
+    if (!size || aligned > capacity_ - used_) {
+      ++failed_;
+      Allocation a = { used_, size, false, false, caller };
+      allocations_.push_back(a);
+      return NULL;
+    }
+    Allocation a = { used_, size, true, true, caller };
+    allocations_.push_back(a);
+    uint8_t * mem = base_ + used_;
+    used_ += aligned;
+    if (used_ > peak_)
+      peak_ = used_;
+    return mem;
+  }
+
+  bool SdramPool::free(const uint8_t * mem) {
+    if (!base_ || mem < base_ || mem >= base_ + capacity_)
+      return false;
+    const size_t offset = static_cast<size_t>(mem - base_);
+    for (size_t i = allocations_.size(); i-- > 0;) {
+      if (allocations_[i].live && allocations_[i].offset == offset) {
+        allocations_[i].live = false;
+        break;
+      }
+    }
+    // Reclaim space past the highest live allocation
+    size_t top = 0;
+    for (size_t i = 0; i < allocations_.size(); ++i) {
+      const Allocation & a = allocations_[i];
+      const size_t end = a.offset + ((a.size + 15U) & ~static_cast<size_t>(15U));
+      if (a.live && end > top)
+        top = end;
+    }
+    used_ = top;
+    return true;
+  }
+
+  void set_current_sdram_pool(SdramPool * pool) {
+    s_current_pool = pool;
+  }
+
+  unit_runtime_hooks_t sdram_hooks(const unit_runtime_base_context_t * context) {
+    unit_runtime_hooks_t hooks;
+    hooks.runtime_context = context;
+    hooks.sdram_alloc = host_sdram_alloc;
+    hooks.sdram_free = host_sdram_free;
+    hooks.sdram_avail = host_sdram_avail;
+    return hooks;
+  }
+
+  size_t default_sdram_size(uint32_t module) {
+    // See "Supported Modules" in platform/nts-1_mkii/README.md
+    switch (module) {
+    case k_unit_module_modfx:
+      return 256U * 1024U;
+    case k_unit_module_delfx:
+    case k_unit_module_revfx:
+      return 3U * 1024U * 1024U;
+    default:
+      return 0;
+    }
+  }
+
+  size_t max_unit_size(uint32_t module) {
+    // See "Supported Modules" in platform/nts-1_mkii/README.md
+    switch (module) {
+    case k_unit_module_osc:
+      return 48U * 1024U;
+    case k_unit_module_modfx:
+      return 16U * 1024U;
+    case k_unit_module_delfx:
+    case k_unit_module_revfx:
+      return 24U * 1024U;
+    default:
+      return 0;
+    }
+  }
+
+  void set_tempo_bpm(float bpm) {
+    s_tempo_bpm = bpm;
+  }
+
+  float tempo_bpm() {
+    return s_tempo_bpm;
+  }
+
+  const char * module_name(uint32_t module) {
+    switch (module) {
+    case k_unit_module_global:   return "global";
+    case k_unit_module_modfx:    return "modfx";
+    case k_unit_module_delfx:    return "delfx";
+    case k_unit_module_revfx:    return "revfx";
+    case k_unit_module_osc:      return "osc";
+    case k_unit_module_synth:    return "synth";
+    case k_unit_module_masterfx: return "masterfx";
+    default:                     return "unknown";
+    }
+  }
+
+  const char * unit_err_name(int8_t err) {
+    switch (err) {
+    case k_unit_err_none:        return "none";
+    case k_unit_err_target:      return "target";
+    case k_unit_err_api_version: return "api_version";
+    case k_unit_err_samplerate:  return "samplerate";
+    case k_unit_err_geometry:    return "geometry";
+    case k_unit_err_memory:      return "memory";
+    case k_unit_err_undef:       return "undef";
+    default:                     return "unknown";
+    }
+  }
+
+}  // namespace hostsim
+
+// ---- Runtime API provided by the firmware on the device -----------------------------------------
+
+extern "C" {
+
+  uint16_t fx_get_bpm(void) {
+    return static_cast<uint16_t>(hostsim::tempo_bpm() * 10.f);
+  }
+
+  float fx_get_bpmf(void) {
+    return hostsim::tempo_bpm();
+  }
+
+}
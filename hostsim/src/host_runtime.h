@@ -0,0 +1,84 @@
+/**
+ *  @file host_runtime.h
+ *
+ *  @brief Host stand-ins for the runtime services a unit sees on the device
+ *
+ */
+
+#ifndef HOSTSIM_HOST_RUNTIME_H_
+#define HOSTSIM_HOST_RUNTIME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "runtime.h"
+
+namespace hostsim {
+
+  /**
+   * Bounded allocator standing in for a unit's dedicated SDRAM area.
+   * Allocations are carved linearly from a fixed pool and never move, freed
+   * blocks are only reclaimed when they are the last allocation.
+   */
+  class SdramPool {
+  public:
+    struct Allocation {
+      size_t offset;
+      size_t size;
+      bool   live;
+      bool   granted;       /** False if the request did not fit. */
+      const void * caller;  /** Return address of the sdram_alloc call, may be NULL. */
+    };
+
+    explicit SdramPool(size_t capacity);
+    ~SdramPool();
+
+    uint8_t * alloc(size_t size, const void * caller = NULL);
+    bool free(const uint8_t * mem);
+    size_t avail() const { return capacity_ - used_; }
+
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+    size_t peak() const { return peak_; }
+    size_t failed() const { return failed_; }
+    const std::vector<Allocation> & allocations() const { return allocations_; }
+
+  private:
+    SdramPool(const SdramPool &);
+    SdramPool & operator=(const SdramPool &);
+
+    uint8_t * base_;
+    size_t capacity_;
+    size_t used_;
+    size_t peak_;
+    size_t failed_;
+    std::vector<Allocation> allocations_;
+  };
+
+  /** Pool that the runtime hooks forward sdram_alloc/sdram_avail calls to. */
+  void set_current_sdram_pool(SdramPool * pool);
+
+  /** Runtime hooks backed by the current SDRAM pool. */
+  unit_runtime_hooks_t sdram_hooks(const unit_runtime_base_context_t * context);
+
+  /** Allocatable external memory for a module on NTS-1 mkII, in bytes. */
+  size_t default_sdram_size(uint32_t module);
+
+  /** Maximum unit (RAM load) size for a module on NTS-1 mkII, in bytes. */
+  size_t max_unit_size(uint32_t module);
+
+  /** Global tempo as reported by fx_get_bpm()/fx_get_bpmf(). */
+  void set_tempo_bpm(float bpm);
+  float tempo_bpm();
+
+  /** Human readable name of a unit module, e.g.: "osc". */
+  const char * module_name(uint32_t module);
+
+  /** Human readable name of a k_unit_err_* code. */
+  const char * unit_err_name(int8_t err);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_HOST_RUNTIME_H_
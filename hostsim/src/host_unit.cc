@@ -0,0 +1,144 @@
+/**
+ *  @file host_unit.cc
+ *
+ *  @brief A unit shared object loaded into the host process
+ *
+ */
+
+#include "host_unit.h"
+
+#include <dlfcn.h>
+#include <string.h>
+
+namespace hostsim {
+
+  namespace {
+
+    void noop_osc_notify_input_usage(uint8_t usage) { (void)usage; }
+
+    template <typename T>
+    bool resolve(void * handle, const char * symbol, T * fn, std::string * err) {
+      void * sym = dlsym(handle, symbol);
+      if (!sym) {
+        if (err)
+          *err = std::string("missing symbol ") + symbol;
+        return false;
+      }
+      *fn = reinterpret_cast<T>(sym);
+      return true;
+    }
+
+  }  // namespace
+
+  HostUnit::HostUnit() :
+    handle_(NULL),
+    header_(NULL),
+    sdram_(NULL),
+    initialized_(false)
+  {
+    memset(&desc_, 0, sizeof(desc_));
+    memset(&osc_context_, 0, sizeof(osc_context_));
+    osc_context_.notify_input_usage = noop_osc_notify_input_usage;
+  }
+
+  HostUnit::~HostUnit() {
+    teardown();
+    delete sdram_;
+    if (handle_)
+      dlclose(handle_);
+  }
+
+  bool HostUnit::load(const std::string & path, std::string * err) {
+    // Symbols other than the runtime API must never leak between units
+    handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle_) {
+      if (err)
+        *err = dlerror();
+      return false;
+    }
+    path_ = path;
+    const size_t slash = path.find_last_of('/');
+    name_ = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    const size_t dot = name_.find_last_of('.');
+    if (dot != std::string::npos)
+      name_.erase(dot);
+
+    header_ = static_cast<const unit_header_t *>(dlsym(handle_, "unit_header"));
+    if (!header_) {
+      if (err)
+        *err = "missing symbol unit_header";
+      return false;
+    }
+
+    return resolve(handle_, "unit_init", &init_, err)
+      && resolve(handle_, "unit_teardown", &teardown_, err)
+      && resolve(handle_, "unit_reset", &reset_, err)
+      && resolve(handle_, "unit_resume", &resume_, err)
+      && resolve(handle_, "unit_suspend", &suspend_, err)
+      && resolve(handle_, "unit_render", &render_, err)
+      && resolve(handle_, "unit_get_param_value", &get_param_value_, err)
+      && resolve(handle_, "unit_get_param_str_value", &get_param_str_value_, err)
+      && resolve(handle_, "unit_set_param_value", &set_param_value_, err)
+      && resolve(handle_, "unit_set_tempo", &set_tempo_, err)
+      && resolve(handle_, "unit_tempo_4ppqn_tick", &tempo_4ppqn_tick_, err)
+      && resolve(handle_, "unit_note_on", &note_on_, err)
+      && resolve(handle_, "unit_note_off", &note_off_, err)
+      && resolve(handle_, "unit_all_note_off", &all_note_off_, err)
+      && resolve(handle_, "unit_pitch_bend", &pitch_bend_, err)
+      && resolve(handle_, "unit_channel_pressure", &channel_pressure_, err)
+      && resolve(handle_, "unit_aftertouch", &aftertouch_, err);
+  }
+
+  void * HostUnit::symbol(const char * name) const {
+    return handle_ ? dlsym(handle_, name) : NULL;
+  }
+
+  int8_t HostUnit::init(uint16_t frames_per_buffer, size_t sdram_size) {
+    const uint32_t mod = module();
+
+    delete sdram_;
+    sdram_ = new SdramPool(sdram_size ? sdram_size : default_sdram_size(mod));
+
+    desc_.target = header_->target;
+    desc_.api = UNIT_API_VERSION;
+    desc_.samplerate = 48000;
+    desc_.frames_per_buffer = frames_per_buffer;
+    // Oscillators receive the stereo audio input and render mono, effects are stereo in/out
+    desc_.input_channels = 2;
+    desc_.output_channels = (mod == k_unit_module_osc) ? 1 : 2;
+    desc_.hooks = sdram_hooks(mod == k_unit_module_osc ? &osc_context_ : NULL);
+
+    set_current_sdram_pool(sdram_);
+    const int8_t err = init_(&desc_);
+    initialized_ = (err == k_unit_err_none);
+    if (initialized_) {
+      applyDefaultParams();
+      setTempo(tempo_bpm());
+    }
+    return err;
+  }
+
+  void HostUnit::teardown() {
+    if (initialized_) {
+      set_current_sdram_pool(sdram_);
+      teardown_();
+      initialized_ = false;
+    }
+  }
+
+  void HostUnit::applyDefaultParams() {
+    for (uint32_t id = 0; id < header_->num_params && id < UNIT_MAX_PARAM_COUNT; ++id)
+      set_param_value_(id, header_->params[id].init);
+  }
+
+  void HostUnit::noteOn(uint8_t note, uint8_t velocity) {
+    osc_context_.pitch = static_cast<uint16_t>(note << 8);
+    note_on_(note, velocity);
+  }
+
+  void HostUnit::setTempo(float bpm) {
+    // 16.16 fixed point, as passed by the runtime
+    set_tempo_(static_cast<uint32_t>(bpm * 65536.f));
+  }
+
+}  // namespace hostsim
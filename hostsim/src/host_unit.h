@@ -0,0 +1,122 @@
+/**
+ *  @file host_unit.h
+ *
+ *  @brief A unit shared object loaded into the host process
+ *
+ */
+
+#ifndef HOSTSIM_HOST_UNIT_H_
+#define HOSTSIM_HOST_UNIT_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "unit_osc.h"
+
+#include "host_runtime.h"
+
+namespace hostsim {
+
+  /**
+   * Wraps a unit built by unit.mk. The shared object is opened with local
+   * symbol scope, so several units (or several builds of the same unit) can be
+   * loaded side by side even though unit code relies heavily on static globals.
+   */
+  class HostUnit {
+  public:
+    HostUnit();
+    ~HostUnit();
+
+    /** Open the shared object and resolve the unit API. */
+    bool load(const std::string & path, std::string * err);
+
+    /**
+     * Initialize the unit as the runtime would, then apply default parameter values.
+     *
+     * @param frames_per_buffer Maximum frames per render call.
+     * @param sdram_size        Size of the SDRAM pool, 0 selects the module default.
+     * @return k_unit_err_* code returned by unit_init.
+     */
+    int8_t init(uint16_t frames_per_buffer, size_t sdram_size);
+
+    /** Call unit_teardown, if the unit was successfully initialized. */
+    void teardown();
+
+    /** Set every parameter to the init value from the unit header. */
+    void applyDefaultParams();
+
+    const std::string & path() const { return path_; }
+    const std::string & name() const { return name_; }
+    const unit_header_t * header() const { return header_; }
+    const unit_runtime_desc_t & desc() const { return desc_; }
+    uint32_t module() const { return header_ ? (header_->target & UNIT_TARGET_MODULE_MASK) : 0; }
+    uint8_t inputChannels() const { return desc_.input_channels; }
+    uint8_t outputChannels() const { return desc_.output_channels; }
+    const SdramPool * sdram() const { return sdram_; }
+
+    /** Look up an optional symbol exported by the unit, NULL if absent. */
+    void * symbol(const char * name) const;
+
+    // ---- Runtime callbacks ----------------------------------------------------------------------
+
+    void render(const float * in, float * out, uint32_t frames) {
+      set_current_sdram_pool(sdram_);
+      render_(in, out, frames);
+    }
+
+    void setParam(uint8_t id, int32_t value) { set_param_value_(id, value); }
+    int32_t getParam(uint8_t id) { return get_param_value_(id); }
+    const char * getParamStr(uint8_t id, int32_t value) { return get_param_str_value_(id, value); }
+
+    /** Note on, also updates the oscillator pitch context like the runtime does. */
+    void noteOn(uint8_t note, uint8_t velocity);
+    void noteOff(uint8_t note) { note_off_(note); }
+    void allNoteOff() { all_note_off_(); }
+    void setTempo(float bpm);
+    void tempoTick(uint32_t counter) { tempo_4ppqn_tick_(counter); }
+    void pitchBend(uint16_t bend) { pitch_bend_(bend); }
+    void channelPressure(uint8_t pressure) { channel_pressure_(pressure); }
+    void aftertouch(uint8_t note, uint8_t pressure) { aftertouch_(note, pressure); }
+    void reset() { reset_(); }
+    void resume() { resume_(); }
+    void suspend() { suspend_(); }
+
+    /** Oscillator context exposed through the runtime descriptor. */
+    unit_runtime_osc_context_t & oscContext() { return osc_context_; }
+
+  private:
+    HostUnit(const HostUnit &);
+    HostUnit & operator=(const HostUnit &);
+
+    void * handle_;
+    std::string path_;
+    std::string name_;
+    const unit_header_t * header_;
+    unit_runtime_desc_t desc_;
+    unit_runtime_osc_context_t osc_context_;
+    SdramPool * sdram_;
+    bool initialized_;
+
+    unit_init_func init_;
+    unit_teardown_func teardown_;
+    unit_reset_func reset_;
+    unit_resume_func resume_;
+    unit_suspend_func suspend_;
+    unit_render_func render_;
+    unit_get_param_value_func get_param_value_;
+    unit_get_param_str_value_func get_param_str_value_;
+    unit_set_param_value_func set_param_value_;
+    unit_set_tempo_func set_tempo_;
+    unit_tempo_4ppqn_tick_func tempo_4ppqn_tick_;
+    unit_note_on_func note_on_;
+    unit_note_off_func note_off_;
+    unit_all_note_off_func all_note_off_;
+    unit_pitch_bend_func pitch_bend_;
+    unit_channel_pressure_func channel_pressure_;
+    unit_aftertouch_func aftertouch_;
+  };
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_HOST_UNIT_H_
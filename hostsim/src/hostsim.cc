@@ -0,0 +1,79 @@
+/**
+ *  @file hostsim.cc
+ *
+ *  @brief Host render harness entry point
+ *
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cli.h"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define HOSTSIM_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define HOSTSIM_ASAN 1
+#endif
+#endif
+
+namespace {
+
+  struct Command {
+    const char * name;
+    int (*run)(int argc, char ** argv);
+    const char * help;
+  };
+
+  const Command k_commands[] = {
+    { "render", hostsim::cmd_render, "Render one unit to WAV and report its render cost" },
+    { "bench",  hostsim::cmd_bench,  "Render a set of units and rank them by render cost" },
+    { "search", hostsim::cmd_search, "Search the parameters and note with the highest render cost" },
+    { "footprint", hostsim::cmd_footprint, "Report code, data and SDRAM use against the module limits" },
+    { "compare", hostsim::cmd_compare, "Check two builds of a unit for equivalent output and compare their speed" },
+    { "trace",  hostsim::cmd_trace,  "Convert MIDI files to callback traces for render --trace, list traces" },
+    { "batch",  hostsim::cmd_batch,  "Render a corpus of unit, trace and input jobs in parallel" },
+    { "chain",  hostsim::cmd_chain,  "Run an osc, modfx, delfx and revfx chain and report the combined headroom" },
+    { "storage", hostsim::cmd_storage, "Measure the noise floor of the delay line storage formats" },
+    { "oversample", hostsim::cmd_oversample, "Measure the cost and alias rejection of each oversampling factor" },
+    { "approx",     hostsim::cmd_approx, "Measure the max error and cost of the fast math approximations" },
+    { "convolve",   hostsim::cmd_convolve, "Measure the latency and cost of partitioned convolution per partition size" },
+  };
+
+  void on_fatal_signal(int sig) {
+    // Units have no memory protection on the device, so out of range LUT reads often only show up here
+    static const char msg[] =
+      "hostsim: unit crashed, rebuild the driver and unit with HOST_OPT=\"-O1 -g -fsanitize=address\" to locate the fault\n";
+    if (write(STDERR_FILENO, msg, sizeof(msg) - 1) < 0) {}
+    signal(sig, SIG_DFL);
+    raise(sig);
+  }
+
+  void usage() {
+    fprintf(stderr, "usage: hostsim <command> [options]\n\ncommands:\n");
+    for (size_t i = 0; i < sizeof(k_commands) / sizeof(k_commands[0]); ++i)
+      fprintf(stderr, "  %-10s %s\n", k_commands[i].name, k_commands[i].help);
+  }
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+  if (argc < 2) {
+    usage();
+    return 2;
+  }
+#if !defined(HOSTSIM_ASAN)
+  // An instrumented build leaves the signals to AddressSanitizer, which reports the faulting access
+  signal(SIGSEGV, on_fatal_signal);
+  signal(SIGBUS, on_fatal_signal);
+  signal(SIGFPE, on_fatal_signal);
+#endif
+  for (size_t i = 0; i < sizeof(k_commands) / sizeof(k_commands[0]); ++i)
+    if (!strcmp(argv[1], k_commands[i].name))
+      return k_commands[i].run(argc - 2, argv + 2);
+  usage();
+  return 2;
+}
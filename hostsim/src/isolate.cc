@@ -0,0 +1,197 @@
+/**
+ *  @file isolate.cc
+ *
+ *  @brief Run unit work in a child process
+ *
+ */
+
+#include "isolate.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <vector>
+
+namespace hostsim {
+
+  namespace {
+
+    /** Fork a child running fn, returns its pid or -1. *read_fd receives the result pipe. */
+    pid_t start_child(isolated_func fn, void * ctx, void * out, size_t size, unsigned timeout_s, int * read_fd) {
+      int fds[2];
+      if (pipe(fds) != 0)
+        return -1;
+
+      fflush(stdout);
+      fflush(stderr);
+      const pid_t pid = fork();
+      if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+      }
+
+      if (pid == 0) {
+        close(fds[0]);
+        if (timeout_s)
+          alarm(timeout_s);
+        const int code = fn(ctx, out, size);
+        const char * p = static_cast<const char *>(out);
+        size_t left = size;
+        while (left > 0) {
+          const ssize_t n = write(fds[1], p, left);
+          if (n <= 0)
+            break;
+          p += n;
+          left -= static_cast<size_t>(n);
+        }
+        close(fds[1]);
+        fflush(stdout);
+        fflush(stderr);
+        _exit(code & 0xFF);
+      }
+
+      close(fds[1]);
+      *read_fd = fds[0];
+      return pid;
+    }
+
+    IsolatedStatus child_status(int wstatus, bool complete) {
+      IsolatedStatus st;
+      if (WIFSIGNALED(wstatus)) {
+        st.signal = WTERMSIG(wstatus);
+      }
+      else if (WIFEXITED(wstatus)) {
+        st.exit_code = WEXITSTATUS(wstatus);
+        st.completed = complete;
+      }
+      return st;
+    }
+
+    struct PoolSlot {
+      pid_t pid;
+      int fd;
+      size_t job;
+      size_t got;
+    };
+
+  }  // namespace
+
+  IsolatedStatus run_isolated(isolated_func fn, void * ctx, void * out, size_t size, unsigned timeout_s) {
+    int fd = -1;
+    const pid_t pid = start_child(fn, ctx, out, size, timeout_s, &fd);
+    if (pid < 0)
+      return IsolatedStatus();
+
+    char * p = static_cast<char *>(out);
+    size_t got = 0;
+    while (got < size) {
+      const ssize_t n = read(fd, p + got, size - got);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        break;
+      got += static_cast<size_t>(n);
+    }
+    close(fd);
+
+    int wstatus = 0;
+    while (waitpid(pid, &wstatus, 0) < 0 && errno == EINTR) {}
+    return child_status(wstatus, got == size);
+  }
+
+  void run_isolated_pool(isolated_func fn, void * const * ctx, void * out, size_t size, size_t count,
+                         unsigned workers, unsigned timeout_s, IsolatedStatus * status,
+                         isolated_done_func done, void * arg) {
+    char * results = static_cast<char *>(out);
+    std::vector<PoolSlot> running;
+    std::vector<struct pollfd> fds;
+    size_t next = 0;
+    if (!workers)
+      workers = 1;
+
+    while (next < count || !running.empty()) {
+      while (next < count && running.size() < workers) {
+        PoolSlot slot = { -1, -1, next++, 0 };
+        slot.pid = start_child(fn, ctx[slot.job], results + slot.job * size, size, timeout_s, &slot.fd);
+        if (slot.pid < 0) {
+          status[slot.job] = IsolatedStatus();
+          if (done)
+            done(slot.job, status[slot.job], arg);
+          continue;
+        }
+        running.push_back(slot);
+      }
+      if (running.empty())
+        continue;
+
+      // Drain result pipes as data arrives so that no child blocks on a full pipe
+      fds.resize(running.size());
+      for (size_t i = 0; i < running.size(); ++i) {
+        fds[i].fd = running[i].fd;
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+      }
+      if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR)
+        break;
+
+      for (size_t i = running.size(); i-- > 0;) {
+        if (!fds[i].revents)
+          continue;
+        PoolSlot & slot = running[i];
+        char * p = results + slot.job * size;
+        const ssize_t n = read(slot.fd, p + slot.got, size - slot.got);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n > 0) {
+          slot.got += static_cast<size_t>(n);
+          if (slot.got < size)
+            continue;
+        }
+        // Result complete or pipe closed, the child is exiting
+        close(slot.fd);
+        int wstatus = 0;
+        while (waitpid(slot.pid, &wstatus, 0) < 0 && errno == EINTR) {}
+        status[slot.job] = child_status(wstatus, slot.got == size);
+        if (done)
+          done(slot.job, status[slot.job], arg);
+        running.erase(running.begin() + i);
+      }
+    }
+  }
+
+  unsigned cpu_count() {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? static_cast<unsigned>(n) : 1;
+  }
+
+  const char * isolated_status_str(const IsolatedStatus & st) {
+    static char buf[32];
+    if (st.signal == SIGALRM)
+      return "timeout";
+    switch (st.signal) {
+    case 0:       break;
+    case SIGSEGV: return "SIGSEGV";
+    case SIGBUS:  return "SIGBUS";
+    case SIGFPE:  return "SIGFPE";
+    case SIGABRT: return "SIGABRT";
+    case SIGILL:  return "SIGILL";
+    default:
+      snprintf(buf, sizeof(buf), "signal %d", st.signal);
+      return buf;
+    }
+    if (!st.completed)
+      return "no result";
+    if (st.exit_code) {
+      snprintf(buf, sizeof(buf), "exit %d", st.exit_code);
+      return buf;
+    }
+    return "ok";
+  }
+
+}  // namespace hostsim
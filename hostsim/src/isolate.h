@@ -0,0 +1,57 @@
+/**
+ *  @file isolate.h
+ *
+ *  @brief Run unit work in a child process
+ *
+ */
+
+#ifndef HOSTSIM_ISOLATE_H_
+#define HOSTSIM_ISOLATE_H_
+
+#include <stddef.h>
+
+namespace hostsim {
+
+  struct IsolatedStatus {
+    bool completed;   /** Child ran to completion and returned its result. */
+    int exit_code;    /** Value returned by the child function. */
+    int signal;       /** Signal that terminated the child, 0 if none. */
+
+    IsolatedStatus() : completed(false), exit_code(-1), signal(0) { }
+  };
+
+  /** Child function, fills out (at most size bytes) and returns an exit code. */
+  typedef int (*isolated_func)(void * ctx, void * out, size_t size);
+
+  /**
+   * Run fn in a forked child so that crashes, hangs and static state of a unit
+   * cannot affect the caller. The result buffer is copied back through a pipe.
+   *
+   * @param timeout_s Child is killed with SIGALRM after this many seconds, 0 to disable.
+   */
+  IsolatedStatus run_isolated(isolated_func fn, void * ctx, void * out, size_t size, unsigned timeout_s);
+
+  /** Called in the parent as each job of run_isolated_pool finishes. */
+  typedef void (*isolated_done_func)(size_t index, const IsolatedStatus & st, void * arg);
+
+  /**
+   * Run fn(ctx[i], out + i * size, size) for count jobs, each in its own forked child,
+   * with up to workers children at a time. A worker slot takes the next pending job
+   * as soon as its child exits, so jobs of uneven length still keep every core busy.
+   *
+   * @param status Receives the status of each job, count entries.
+   * @param done   Progress callback, may be NULL.
+   */
+  void run_isolated_pool(isolated_func fn, void * const * ctx, void * out, size_t size, size_t count,
+                         unsigned workers, unsigned timeout_s, IsolatedStatus * status,
+                         isolated_done_func done, void * arg);
+
+  /** Number of online CPUs, at least 1. */
+  unsigned cpu_count();
+
+  /** Short description such as "ok", "exit 1" or "SIGSEGV". */
+  const char * isolated_status_str(const IsolatedStatus & st);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_ISOLATE_H_
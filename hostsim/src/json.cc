@@ -0,0 +1,314 @@
+/**
+ *  @file json.cc
+ *
+ *  @brief Small JSON writer and reader for hostsim reports and presets
+ *
+ */
+
+#include "json.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+namespace hostsim {
+
+  // ---- Writer -----------------------------------------------------------------------------------
+
+  JsonWriter::JsonWriter(FILE * fp) :
+    fp_(fp),
+    after_key_(false)
+  { }
+
+  void JsonWriter::indent() {
+    fputc('\n', fp_);
+    for (size_t i = 0; i < first_.size(); ++i)
+      fputs("  ", fp_);
+  }
+
+  void JsonWriter::separate() {
+    if (after_key_) {
+      after_key_ = false;
+      return;
+    }
+    if (!first_.empty()) {
+      if (!first_.back())
+        fputc(',', fp_);
+      first_.back() = false;
+      indent();
+    }
+  }
+
+  void JsonWriter::beginObject() {
+    separate();
+    fputc('{', fp_);
+    first_.push_back(true);
+  }
+
+  void JsonWriter::endObject() {
+    const bool empty = first_.back();
+    first_.pop_back();
+    if (!empty)
+      indent();
+    fputc('}', fp_);
+    if (first_.empty())
+      fputc('\n', fp_);
+  }
+
+  void JsonWriter::beginArray() {
+    separate();
+    fputc('[', fp_);
+    first_.push_back(true);
+  }
+
+  void JsonWriter::endArray() {
+    const bool empty = first_.back();
+    first_.pop_back();
+    if (!empty)
+      indent();
+    fputc(']', fp_);
+  }
+
+  void JsonWriter::key(const char * k) {
+    separate();
+    writeString(k);
+    fputs(": ", fp_);
+    after_key_ = true;
+  }
+
+  void JsonWriter::value(const char * s) {
+    separate();
+    writeString(s);
+  }
+
+  void JsonWriter::writeString(const char * s) {
+    fputc('"', fp_);
+    for (; *s; ++s) {
+      const unsigned char c = static_cast<unsigned char>(*s);
+      if (c == '"' || c == '\\')
+        fprintf(fp_, "\\%c", c);
+      else if (c < 0x20)
+        fprintf(fp_, "\\u%04x", c);
+      else
+        fputc(c, fp_);
+    }
+    fputc('"', fp_);
+  }
+
+  void JsonWriter::value(double v) {
+    separate();
+    if (isfinite(v))
+      fprintf(fp_, "%.6g", v);
+    else
+      fputs("null", fp_);
+  }
+
+  void JsonWriter::value(long long v) {
+    separate();
+    fprintf(fp_, "%lld", v);
+  }
+
+  void JsonWriter::value(bool v) {
+    separate();
+    fputs(v ? "true" : "false", fp_);
+  }
+
+  void JsonWriter::null() {
+    separate();
+    fputs("null", fp_);
+  }
+
+  // ---- Reader -----------------------------------------------------------------------------------
+
+  namespace {
+
+    const JsonValue k_null_value;
+
+    struct Parser {
+      const std::string & s;
+      size_t pos;
+      std::string err;
+
+      explicit Parser(const std::string & text) : s(text), pos(0) { }
+
+      void ws() {
+        while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\n' || s[pos] == '\r'))
+          ++pos;
+      }
+
+      bool fail(const char * msg) {
+        if (err.empty()) {
+          char buf[96];
+          snprintf(buf, sizeof(buf), "%s at offset %zu", msg, pos);
+          err = buf;
+        }
+        return false;
+      }
+
+      bool literal(const char * lit) {
+        size_t n = 0;
+        while (lit[n] && pos + n < s.size() && s[pos + n] == lit[n])
+          ++n;
+        if (lit[n])
+          return false;
+        pos += n;
+        return true;
+      }
+
+      bool parseString(std::string * out) {
+        if (s[pos] != '"')
+          return fail("expected string");
+        ++pos;
+        out->clear();
+        while (pos < s.size() && s[pos] != '"') {
+          char c = s[pos++];
+          if (c == '\\' && pos < s.size()) {
+            c = s[pos++];
+            switch (c) {
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case 'r': c = '\r'; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'u':
+              // Only ASCII escapes are produced by the writer
+              c = static_cast<char>(strtol(s.substr(pos, 4).c_str(), NULL, 16));
+              pos += 4;
+              break;
+            default: break;
+            }
+          }
+          out->push_back(c);
+        }
+        if (pos >= s.size())
+          return fail("unterminated string");
+        ++pos;
+        return true;
+      }
+
+      bool parseValue(JsonValue * v) {
+        ws();
+        if (pos >= s.size())
+          return fail("unexpected end of input");
+        const char c = s[pos];
+        if (c == '{') {
+          v->type = JsonValue::k_object;
+          ++pos;
+          ws();
+          if (pos < s.size() && s[pos] == '}') {
+            ++pos;
+            return true;
+          }
+          for (;;) {
+            ws();
+            std::string k;
+            if (!parseString(&k))
+              return false;
+            ws();
+            if (pos >= s.size() || s[pos++] != ':')
+              return fail("expected ':'");
+            if (!parseValue(&v->object[k]))
+              return false;
+            ws();
+            if (pos < s.size() && s[pos] == ',') {
+              ++pos;
+              continue;
+            }
+            if (pos < s.size() && s[pos] == '}') {
+              ++pos;
+              return true;
+            }
+            return fail("expected ',' or '}'");
+          }
+        }
+        if (c == '[') {
+          v->type = JsonValue::k_array;
+          ++pos;
+          ws();
+          if (pos < s.size() && s[pos] == ']') {
+            ++pos;
+            return true;
+          }
+          for (;;) {
+            v->array.push_back(JsonValue());
+            if (!parseValue(&v->array.back()))
+              return false;
+            ws();
+            if (pos < s.size() && s[pos] == ',') {
+              ++pos;
+              continue;
+            }
+            if (pos < s.size() && s[pos] == ']') {
+              ++pos;
+              return true;
+            }
+            return fail("expected ',' or ']'");
+          }
+        }
+        if (c == '"') {
+          v->type = JsonValue::k_string;
+          return parseString(&v->string);
+        }
+        if (literal("true")) {
+          v->type = JsonValue::k_bool;
+          v->boolean = true;
+          return true;
+        }
+        if (literal("false")) {
+          v->type = JsonValue::k_bool;
+          return true;
+        }
+        if (literal("null")) {
+          v->type = JsonValue::k_null;
+          return true;
+        }
+        char * end;
+        v->number = strtod(s.c_str() + pos, &end);
+        if (end == s.c_str() + pos)
+          return fail("unexpected character");
+        v->type = JsonValue::k_number;
+        pos = end - s.c_str();
+        return true;
+      }
+    };
+
+  }  // namespace
+
+  const JsonValue & JsonValue::operator[](const std::string & k) const {
+    if (type != k_object)
+      return k_null_value;
+    std::map<std::string, JsonValue>::const_iterator it = object.find(k);
+    return it == object.end() ? k_null_value : it->second;
+  }
+
+  bool json_parse(const std::string & text, JsonValue * out, std::string * err) {
+    Parser p(text);
+    if (!p.parseValue(out)) {
+      if (err)
+        *err = p.err;
+      return false;
+    }
+    return true;
+  }
+
+  bool json_read_file(const std::string & path, JsonValue * out, std::string * err) {
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+      if (err)
+        *err = "cannot open " + path;
+      return false;
+    }
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+      text.append(buf, n);
+    fclose(fp);
+    if (!json_parse(text, out, err)) {
+      if (err)
+        *err = path + ": " + *err;
+      return false;
+    }
+    return true;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,85 @@
+/**
+ *  @file json.h
+ *
+ *  @brief Small JSON writer and reader for hostsim reports and presets
+ *
+ */
+
+#ifndef HOSTSIM_JSON_H_
+#define HOSTSIM_JSON_H_
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+  /**
+   * Streaming JSON writer. Separators and indentation are handled internally,
+   * callers only open/close containers and emit keys and values in order.
+   */
+  class JsonWriter {
+  public:
+    explicit JsonWriter(FILE * fp);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const char * k);
+
+    void value(const char * s);
+    void value(const std::string & s) { value(s.c_str()); }
+    void value(double v);
+    void value(long long v);
+    void value(int v) { value(static_cast<long long>(v)); }
+    void value(unsigned v) { value(static_cast<long long>(v)); }
+    void value(unsigned long v) { value(static_cast<long long>(v)); }
+    void value(unsigned long long v) { value(static_cast<long long>(v)); }
+    void value(bool v);
+    void null();
+
+    template <typename T>
+    void field(const char * k, const T & v) {
+      key(k);
+      value(v);
+    }
+
+  private:
+    void separate();
+    void indent();
+    void writeString(const char * s);
+
+    FILE * fp_;
+    std::vector<bool> first_; // per open container
+    bool after_key_;
+  };
+
+  /** Parsed JSON value. */
+  struct JsonValue {
+    enum Type { k_null, k_bool, k_number, k_string, k_array, k_object };
+
+    Type type;
+    bool boolean;
+    double number;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    JsonValue() : type(k_null), boolean(false), number(0) { }
+
+    /** Member lookup, returns a null value if absent or not an object. */
+    const JsonValue & operator[](const std::string & k) const;
+
+    double num(double fallback = 0) const { return type == k_number ? number : fallback; }
+    const std::string & str() const { return string; }
+  };
+
+  bool json_parse(const std::string & text, JsonValue * out, std::string * err);
+  bool json_read_file(const std::string & path, JsonValue * out, std::string * err);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_JSON_H_
@@ -0,0 +1,94 @@
+/**
+ *  @file preset.cc
+ *
+ *  @brief Reproducible render configurations stored as JSON
+ *
+ */
+
+#include "preset.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace hostsim {
+
+  bool preset_write(const std::string & path, const HostUnit & unit, const RenderOptions & opt,
+                    void (*extra)(JsonWriter & w, void * ctx), void * ctx, std::string * err) {
+    FILE * fp = fopen(path.c_str(), "w");
+    if (!fp) {
+      if (err)
+        *err = "cannot create " + path;
+      return false;
+    }
+    const unit_header_t * header = unit.header();
+
+    JsonWriter w(fp);
+    w.beginObject();
+    w.field("unit", unit.name());
+    w.field("unit_name", header->name);
+    w.field("module", module_name(unit.module()));
+    w.key("note");
+    if (opt.note >= 0)
+      w.value(opt.note);
+    else
+      w.null();
+    w.field("velocity", static_cast<int>(opt.velocity));
+    w.key("params");
+    w.beginArray();
+    for (uint32_t id = 0; id < header->num_params && id < UNIT_MAX_PARAM_COUNT; ++id) {
+      int32_t value = header->params[id].init;
+      for (size_t k = 0; k < opt.params.size(); ++k)
+        if (opt.params[k].first == id)
+          value = opt.params[k].second;
+      w.beginObject();
+      w.field("id", id);
+      w.field("name", std::string(header->params[id].name, strnlen(header->params[id].name, UNIT_PARAM_NAME_SIZE)));
+      w.field("value", value);
+      w.endObject();
+    }
+    w.endArray();
+    if (extra)
+      extra(w, ctx);
+    w.endObject();
+
+    const bool ok = !ferror(fp);
+    fclose(fp);
+    if (!ok && err)
+      *err = "error writing " + path;
+    return ok;
+  }
+
+  bool preset_read(const std::string & path, RenderOptions * opt, std::string * err) {
+    JsonValue root;
+    if (!json_read_file(path, &root, err))
+      return false;
+    if (root.type != JsonValue::k_object) {
+      if (err)
+        *err = path + ": not a preset";
+      return false;
+    }
+
+    const JsonValue & note = root["note"];
+    if (note.type == JsonValue::k_number)
+      opt->note = static_cast<int>(note.number);
+    else if (note.type == JsonValue::k_null && root.object.count("note"))
+      opt->note = -1;
+    const JsonValue & velocity = root["velocity"];
+    if (velocity.type == JsonValue::k_number)
+      opt->velocity = static_cast<uint8_t>(velocity.number);
+
+    const JsonValue & params = root["params"];
+    for (size_t i = 0; i < params.array.size(); ++i) {
+      const double id = params.array[i]["id"].num(-1);
+      const JsonValue & value = params.array[i]["value"];
+      if (id < 0 || id >= UNIT_MAX_PARAM_COUNT || value.type != JsonValue::k_number) {
+        if (err)
+          *err = path + ": malformed parameter entry";
+        return false;
+      }
+      opt->params.push_back(std::make_pair(static_cast<uint8_t>(id), static_cast<int32_t>(value.number)));
+    }
+    return true;
+  }
+
+}  // namespace hostsim
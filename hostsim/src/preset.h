@@ -0,0 +1,34 @@
+/**
+ *  @file preset.h
+ *
+ *  @brief Reproducible render configurations stored as JSON
+ *
+ */
+
+#ifndef HOSTSIM_PRESET_H_
+#define HOSTSIM_PRESET_H_
+
+#include <string>
+
+#include "host_unit.h"
+#include "json.h"
+#include "render.h"
+
+namespace hostsim {
+
+  /**
+   * Write the note, velocity and full parameter set of opt for unit. Parameters not
+   * listed in opt are written with their header defaults so the preset does not
+   * depend on later changes to the defaults.
+   *
+   * @param extra Called with the writer inside the top level object to add fields, may be NULL.
+   */
+  bool preset_write(const std::string & path, const HostUnit & unit, const RenderOptions & opt,
+                    void (*extra)(JsonWriter & w, void * ctx), void * ctx, std::string * err);
+
+  /** Apply note, velocity and parameters of a preset to opt. */
+  bool preset_read(const std::string & path, RenderOptions * opt, std::string * err);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_PRESET_H_
@@ -0,0 +1,170 @@
+/**
+ *  @file render.cc
+ *
+ *  @brief Offline, timed rendering of a host unit
+ *
+ */
+
+#include "render.h"
+
+#include <math.h>
+#include <time.h>
+
+#include <algorithm>
+
+namespace hostsim {
+
+  namespace {
+
+    bool by_frame(const TraceEvent & a, const TraceEvent & b) { return a.frame < b.frame; }
+
+  }  // namespace
+
+  void deliver_event(HostUnit & unit, const TraceEvent & e) {
+    switch (e.type) {
+    case k_trace_param:            unit.setParam(e.data, e.value); break;
+    case k_trace_note_on:          unit.noteOn(e.data, static_cast<uint8_t>(e.value)); break;
+    case k_trace_note_off:         unit.noteOff(e.data); break;
+    case k_trace_all_note_off:     unit.allNoteOff(); break;
+    case k_trace_tempo_tick:       unit.tempoTick(static_cast<uint32_t>(e.value)); break;
+    case k_trace_pitch_bend:       unit.pitchBend(static_cast<uint16_t>(e.value)); break;
+    case k_trace_channel_pressure: unit.channelPressure(static_cast<uint8_t>(e.value)); break;
+    case k_trace_aftertouch:       unit.aftertouch(e.data, static_cast<uint8_t>(e.value)); break;
+    case k_trace_tempo:
+      set_tempo_bpm(e.value / 65536.f);
+      unit.setTempo(e.value / 65536.f);
+      break;
+    default:
+      break;
+    }
+  }
+
+  double RenderStats::maxBlockNs() const {
+    return block_ns.empty() ? 0 : *std::max_element(block_ns.begin(), block_ns.end());
+  }
+
+  double RenderStats::percentileBlockNs(double p) const {
+    if (block_ns.empty())
+      return 0;
+    std::vector<double> sorted(block_ns);
+    std::sort(sorted.begin(), sorted.end());
+    const size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p / 100.0 * sorted.size()));
+    return sorted[idx];
+  }
+
+  double RenderStats::realtimeFactor() const {
+    return total_ns > 0 ? (frames * 1e9 / k_samplerate) / total_ns : 0;
+  }
+
+  double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+  }
+
+  void make_excitation(WavData * wav, size_t frames) {
+    wav->samplerate = k_samplerate;
+    wav->channels = 2;
+    wav->samples.assign(frames * 2, 0.f);
+    // 125 ms bursts every 500 ms, so that effect tails are exercised as well as the dry path
+    uint32_t state = 0x12345678U;
+    for (size_t i = 0; i < frames; ++i) {
+      if ((i % 24000) >= 6000)
+        continue;
+      for (int ch = 0; ch < 2; ++ch) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        wav->samples[2 * i + ch] = 0.25f * (static_cast<int32_t>(state) * 4.656612873e-10f);
+      }
+    }
+  }
+
+  void render_events(const RenderOptions & opt, uint64_t frames, std::vector<TraceEvent> * events) {
+    events->clear();
+    events->push_back(TraceEvent(0, k_trace_tempo, 0, static_cast<int32_t>(opt.bpm * 65536.f)));
+    for (size_t i = 0; i < opt.params.size(); ++i)
+      events->push_back(TraceEvent(0, k_trace_param, opt.params[i].first, opt.params[i].second));
+
+    if (!opt.trace.empty()) {
+      events->insert(events->end(), opt.trace.begin(), opt.trace.end());
+      return;
+    }
+
+    if (opt.note >= 0) {
+      events->push_back(TraceEvent(0, k_trace_note_on, static_cast<uint8_t>(opt.note), opt.velocity));
+      const double gate = opt.gate_seconds * k_samplerate;
+      if (opt.gate_seconds >= 0 && gate < frames)
+        events->push_back(TraceEvent(static_cast<uint32_t>(gate), k_trace_note_off, static_cast<uint8_t>(opt.note), 0));
+    }
+
+    const double tick_period = k_samplerate * 60.0 / (opt.bpm * 4.0);
+    uint32_t tick = 0;
+    for (double t = 0; t < frames; t += tick_period)
+      events->push_back(TraceEvent(static_cast<uint32_t>(ceil(t)), k_trace_tempo_tick, 0, static_cast<int32_t>(tick++)));
+
+    std::stable_sort(events->begin(), events->end(), by_frame);
+  }
+
+  void render_unit(HostUnit & unit, const RenderOptions & opt, const WavData * input,
+                   WavData * output, RenderStats * stats) {
+    if (output) {
+      output->samplerate = k_samplerate;
+      output->channels = unit.outputChannels();
+      output->samples.assign(static_cast<size_t>(opt.seconds * k_samplerate) * output->channels, 0.f);
+    }
+    render_unit(unit, opt, input ? input->samples.data() : NULL, input ? input->frames() : 0,
+                input ? input->channels : 0, output ? output->samples.data() : NULL, stats);
+  }
+
+  void render_unit(HostUnit & unit, const RenderOptions & opt, const float * input, size_t input_frames,
+                   uint16_t input_channels, float * output, RenderStats * stats) {
+    const uint32_t block = opt.frames_per_buffer;
+    const uint64_t total = static_cast<uint64_t>(opt.seconds * k_samplerate);
+    const uint8_t out_ch = unit.outputChannels();
+
+    std::vector<float> in(2 * block, 0.f);
+    std::vector<float> out(out_ch * block, 0.f);
+    stats->frames = 0;
+    stats->total_ns = 0;
+    stats->block_ns.clear();
+    stats->block_ns.reserve(total / block + 1);
+
+    std::vector<TraceEvent> events;
+    render_events(opt, total, &events);
+    size_t next = 0;
+
+    for (uint64_t pos = 0; pos < total; pos += block) {
+      const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(block, total - pos));
+
+      // Events are delivered between render calls, as on the device
+      for (; next < events.size() && events[next].frame <= pos; ++next)
+        deliver_event(unit, events[next]);
+
+      if (input) {
+        for (uint32_t i = 0; i < frames; ++i) {
+          const size_t f = pos + i;
+          if (f < input_frames) {
+            in[2 * i] = input[f * input_channels];
+            in[2 * i + 1] = input[f * input_channels + (input_channels > 1 ? 1 : 0)];
+          }
+          else {
+            in[2 * i] = in[2 * i + 1] = 0.f;
+          }
+        }
+      }
+
+      const double t0 = now_ns();
+      unit.render(in.data(), out.data(), frames);
+      const double dt = now_ns() - t0;
+
+      stats->block_ns.push_back(dt);
+      stats->total_ns += dt;
+      stats->frames += frames;
+
+      if (output)
+        std::copy(out.begin(), out.begin() + frames * out_ch, output + pos * out_ch);
+    }
+  }
+
+}  // namespace hostsim
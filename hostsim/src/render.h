@@ -0,0 +1,95 @@
+/**
+ *  @file render.h
+ *
+ *  @brief Offline, timed rendering of a host unit
+ *
+ */
+
+#ifndef HOSTSIM_RENDER_H_
+#define HOSTSIM_RENDER_H_
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "host_unit.h"
+#include "trace.h"
+#include "wav.h"
+
+namespace hostsim {
+
+  struct RenderOptions {
+    uint16_t frames_per_buffer;  /** Frames per unit_render call. */
+    double seconds;              /** Length of the rendered audio. */
+    int note;                    /** Note sent at start, negative for none. */
+    uint8_t velocity;            /** Note on velocity. */
+    double gate_seconds;         /** Time until note off, negative to hold. */
+    float bpm;                   /** Tempo, also drives unit_tempo_4ppqn_tick. */
+    size_t sdram_size;           /** SDRAM pool size, 0 for the module default. */
+    std::vector<std::pair<uint8_t, int32_t> > params; /** Values applied over the header defaults. */
+    std::vector<TraceEvent> trace; /** Replayed instead of note, gate and generated clock when not empty. */
+
+    RenderOptions() :
+      frames_per_buffer(64),
+      seconds(4.0),
+      note(60),
+      velocity(100),
+      gate_seconds(-1.0),
+      bpm(120.f),
+      sdram_size(0)
+    { }
+  };
+
+  struct RenderStats {
+    uint64_t frames;
+    std::vector<double> block_ns; /** Wall time of each unit_render call. */
+    double total_ns;
+
+    RenderStats() : frames(0), total_ns(0) { }
+
+    double nsPerSample() const { return frames ? total_ns / frames : 0; }
+    double meanBlockNs() const { return block_ns.empty() ? 0 : total_ns / block_ns.size(); }
+    double maxBlockNs() const;
+    double percentileBlockNs(double p) const;
+    /** Audio time rendered per unit of CPU time. */
+    double realtimeFactor() const;
+  };
+
+  /** Monotonic time in nanoseconds. */
+  double now_ns();
+
+  /** Gated noise bursts used to drive effects when no input file is given. */
+  void make_excitation(WavData * wav, size_t frames);
+
+  /**
+   * Callbacks render_unit delivers for opt over frames: tempo and parameters at
+   * frame 0, followed by opt.trace or the note, its gate and the 4ppqn clock.
+   */
+  void render_events(const RenderOptions & opt, uint64_t frames, std::vector<TraceEvent> * events);
+
+  /** Make the unit callback described by e. */
+  void deliver_event(HostUnit & unit, const TraceEvent & e);
+
+  /**
+   * Render a unit that has already been initialized. Callbacks from render_events are
+   * delivered before the first block starting at or after their frame, as on the device.
+   *
+   * @param input  Stereo input, may be NULL for silence. Shorter inputs are padded with silence.
+   * @param output Receives the rendered audio, may be NULL when only stats are needed.
+   */
+  void render_unit(HostUnit & unit, const RenderOptions & opt, const WavData * input,
+                   WavData * output, RenderStats * stats);
+
+  /**
+   * Same as above on interleaved buffers, for audio that is not held in a WavData.
+   *
+   * @param input  Interleaved input of input_frames frames, may be NULL for silence.
+   * @param output Room for opt.seconds of audio with unit.outputChannels() channels, may be NULL.
+   */
+  void render_unit(HostUnit & unit, const RenderOptions & opt, const float * input, size_t input_frames,
+                   uint16_t input_channels, float * output, RenderStats * stats);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_RENDER_H_
@@ -0,0 +1,381 @@
+/**
+ *  @file trace.cc
+ *
+ *  @brief Binary automation traces of runtime callbacks
+ *
+ */
+
+#include "trace.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "osc_api.h"
+
+namespace hostsim {
+
+  namespace {
+
+    const char k_trace_magic[4] = { 'H', 'S', 'T', 'R' };
+    const uint16_t k_trace_version = 1;
+    const size_t k_trace_header_size = 24;
+    const size_t k_trace_event_size = 12;
+
+    uint16_t rd16(const uint8_t * p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    uint32_t rd32(const uint8_t * p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+    uint64_t rd64(const uint8_t * p) { return rd32(p) | (static_cast<uint64_t>(rd32(p + 4)) << 32); }
+
+    // Standard MIDI files are big endian
+    uint16_t rd16be(const uint8_t * p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+    uint32_t rd32be(const uint8_t * p) { return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+    void put16(uint8_t * p, uint16_t v) {
+      p[0] = static_cast<uint8_t>(v);
+      p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void put32(uint8_t * p, uint32_t v) {
+      put16(p, static_cast<uint16_t>(v));
+      put16(p + 2, static_cast<uint16_t>(v >> 16));
+    }
+
+    bool fail(std::string * err, const std::string & msg) {
+      if (err)
+        *err = msg;
+      return false;
+    }
+
+    bool read_file(const std::string & path, std::vector<uint8_t> * data, std::string * err) {
+      FILE * fp = fopen(path.c_str(), "rb");
+      if (!fp)
+        return fail(err, "cannot open " + path);
+      uint8_t chunk[4096];
+      size_t n;
+      data->clear();
+      while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+        data->insert(data->end(), chunk, chunk + n);
+      fclose(fp);
+      return true;
+    }
+
+    bool by_frame(const TraceEvent & a, const TraceEvent & b) { return a.frame < b.frame; }
+
+    // ---- Standard MIDI files --------------------------------------------------------------------
+
+    struct MidiEvent {
+      uint32_t tick;
+      uint8_t status;
+      uint8_t d1;
+      uint8_t d2;
+    };
+
+    struct MidiTempo {
+      uint32_t tick;
+      uint32_t us_per_quarter;
+    };
+
+    bool by_tick(const MidiEvent & a, const MidiEvent & b) { return a.tick < b.tick; }
+    bool tempo_by_tick(const MidiTempo & a, const MidiTempo & b) { return a.tick < b.tick; }
+
+    class MidiReader {
+    public:
+      MidiReader(const uint8_t * p, size_t size) : p_(p), end_(p + size), ok_(true) { }
+
+      bool ok() const { return ok_; }
+      bool done() const { return p_ >= end_; }
+
+      uint8_t byte() {
+        if (p_ >= end_) {
+          ok_ = false;
+          return 0;
+        }
+        return *p_++;
+      }
+
+      uint32_t varint() {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) {
+          const uint8_t b = byte();
+          v = (v << 7) | (b & 0x7F);
+          if (!(b & 0x80))
+            return v;
+        }
+        ok_ = false;
+        return v;
+      }
+
+      void skip(uint32_t n) {
+        if (n > static_cast<size_t>(end_ - p_)) {
+          ok_ = false;
+          p_ = end_;
+        }
+        else {
+          p_ += n;
+        }
+      }
+
+      const uint8_t * pos() const { return p_; }
+
+    private:
+      const uint8_t * p_;
+      const uint8_t * end_;
+      bool ok_;
+    };
+
+    bool parse_track(const uint8_t * data, size_t size, std::vector<MidiEvent> * events,
+                     std::vector<MidiTempo> * tempos) {
+      MidiReader r(data, size);
+      uint32_t tick = 0;
+      uint8_t running = 0;
+      while (!r.done() && r.ok()) {
+        tick += r.varint();
+        uint8_t status = r.byte();
+        if (status == 0xFF) {
+          const uint8_t type = r.byte();
+          const uint32_t len = r.varint();
+          if (type == 0x51 && len == 3) {
+            const uint8_t * p = r.pos();
+            r.skip(len);
+            if (r.ok()) {
+              const MidiTempo t = { tick, (static_cast<uint32_t>(p[0]) << 16) | (p[1] << 8) | p[2] };
+              tempos->push_back(t);
+            }
+          }
+          else {
+            r.skip(len);
+            if (type == 0x2F)
+              break;
+          }
+          continue;
+        }
+        if (status == 0xF0 || status == 0xF7) {
+          r.skip(r.varint());
+          continue;
+        }
+        uint8_t d1;
+        if (status & 0x80) {
+          running = status;
+          d1 = r.byte();
+        }
+        else {
+          if (!running)
+            return false;
+          d1 = status;
+          status = running;
+        }
+        const uint8_t kind = status & 0xF0;
+        const uint8_t d2 = (kind == 0xC0 || kind == 0xD0) ? 0 : r.byte();
+        const MidiEvent e = { tick, status, static_cast<uint8_t>(d1 & 0x7F), static_cast<uint8_t>(d2 & 0x7F) };
+        events->push_back(e);
+      }
+      return r.ok();
+    }
+
+    /** Converts MIDI ticks to frames along the tempo map. */
+    class TempoMap {
+    public:
+      TempoMap(const std::vector<MidiTempo> & tempos, uint16_t division) :
+        tempos_(tempos), division_(division)
+      {
+        if (tempos_.empty() || tempos_[0].tick != 0) {
+          const MidiTempo t = { 0, 500000 };
+          tempos_.insert(tempos_.begin(), t);
+        }
+      }
+
+      double seconds(double tick) const {
+        double s = 0;
+        for (size_t i = 0; i < tempos_.size(); ++i) {
+          const double start = tempos_[i].tick;
+          const double end = i + 1 < tempos_.size() ? tempos_[i + 1].tick : tick;
+          if (tick <= start)
+            break;
+          s += (std::min(tick, end) - start) * tempos_[i].us_per_quarter * 1e-6 / division_;
+        }
+        return s;
+      }
+
+      uint32_t frame(double tick) const {
+        return static_cast<uint32_t>(floor(seconds(tick) * k_samplerate + 0.5));
+      }
+
+      const std::vector<MidiTempo> & tempos() const { return tempos_; }
+
+    private:
+      std::vector<MidiTempo> tempos_;
+      uint16_t division_;
+    };
+
+  }  // namespace
+
+  const char * trace_event_name(uint8_t type) {
+    static const char * const k_names[k_num_trace_event_types] = {
+      "?", "param", "note_on", "note_off", "all_note_off", "tempo", "tempo_tick", "pitch_bend",
+      "channel_pressure", "aftertouch"
+    };
+    return type < k_num_trace_event_types ? k_names[type] : "?";
+  }
+
+  bool trace_read(const std::string & path, Trace * trace, std::string * err) {
+    std::vector<uint8_t> file;
+    if (!read_file(path, &file, err))
+      return false;
+    if (file.size() < k_trace_header_size || memcmp(&file[0], k_trace_magic, 4))
+      return fail(err, path + ": not a hostsim trace");
+    if (rd16(&file[4]) != k_trace_version || rd16(&file[6]) != k_trace_event_size)
+      return fail(err, path + ": unsupported trace version");
+    if (rd32(&file[8]) != k_samplerate)
+      return fail(err, path + ": trace was recorded at a different sample rate");
+
+    const uint32_t count = rd32(&file[12]);
+    if (file.size() < k_trace_header_size + static_cast<uint64_t>(count) * k_trace_event_size)
+      return fail(err, path + ": truncated trace");
+    trace->length = rd64(&file[16]);
+    trace->events.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint8_t * p = &file[k_trace_header_size + i * k_trace_event_size];
+      TraceEvent & e = trace->events[i];
+      e.frame = rd32(p);
+      e.type = p[4];
+      e.data = p[5];
+      e.value = static_cast<int32_t>(rd32(p + 8));
+      if (e.type == 0 || e.type >= k_num_trace_event_types)
+        return fail(err, path + ": unknown event type in trace");
+      if (i && e.frame < trace->events[i - 1].frame)
+        return fail(err, path + ": trace events are not sorted by frame");
+    }
+    return true;
+  }
+
+  bool trace_write(const std::string & path, const Trace & trace, std::string * err) {
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (!fp)
+      return fail(err, "cannot create " + path);
+
+    uint8_t header[k_trace_header_size];
+    memcpy(header, k_trace_magic, 4);
+    put16(header + 4, k_trace_version);
+    put16(header + 6, k_trace_event_size);
+    put32(header + 8, k_samplerate);
+    put32(header + 12, static_cast<uint32_t>(trace.events.size()));
+    put32(header + 16, static_cast<uint32_t>(trace.length));
+    put32(header + 20, static_cast<uint32_t>(trace.length >> 32));
+    bool ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header);
+
+    for (size_t i = 0; ok && i < trace.events.size(); ++i) {
+      const TraceEvent & e = trace.events[i];
+      uint8_t rec[k_trace_event_size];
+      put32(rec, e.frame);
+      rec[4] = e.type;
+      rec[5] = e.data;
+      put16(rec + 6, 0);
+      put32(rec + 8, static_cast<uint32_t>(e.value));
+      ok = fwrite(rec, 1, sizeof(rec), fp) == sizeof(rec);
+    }
+    if (fclose(fp) != 0 || !ok)
+      return fail(err, "error writing " + path);
+    return true;
+  }
+
+  bool trace_from_midi(const std::string & path, const MidiTraceOptions & opt, Trace * trace, std::string * err) {
+    std::vector<uint8_t> file;
+    if (!read_file(path, &file, err))
+      return false;
+    if (file.size() < 14 || memcmp(&file[0], "MThd", 4) || rd32be(&file[4]) < 6)
+      return fail(err, path + ": not a standard MIDI file");
+    const uint16_t format = rd16be(&file[8]);
+    const uint16_t division = rd16be(&file[12]);
+    if (format > 1)
+      return fail(err, path + ": only MIDI file formats 0 and 1 are supported");
+    if (division & 0x8000 || division == 0)
+      return fail(err, path + ": SMPTE time division is not supported");
+
+    std::vector<MidiEvent> events;
+    std::vector<MidiTempo> tempos;
+    size_t pos = 8 + rd32be(&file[4]);
+    while (pos + 8 <= file.size()) {
+      const uint32_t len = rd32be(&file[pos + 4]);
+      if (pos + 8 + len > file.size())
+        return fail(err, path + ": truncated track");
+      // Tracks are concatenated, the stable sort below keeps track order for simultaneous events
+      if (!memcmp(&file[pos], "MTrk", 4) && !parse_track(&file[pos + 8], len, &events, &tempos))
+        return fail(err, path + ": malformed track");
+      pos += 8 + len;
+    }
+    std::stable_sort(events.begin(), events.end(), by_tick);
+    std::stable_sort(tempos.begin(), tempos.end(), tempo_by_tick);
+    const TempoMap map(tempos, division);
+
+    trace->events.clear();
+    for (size_t i = 0; i < map.tempos().size(); ++i) {
+      const MidiTempo & t = map.tempos()[i];
+      const double bpm = 60e6 / t.us_per_quarter;
+      trace->events.push_back(TraceEvent(map.frame(t.tick), k_trace_tempo, 0,
+                                         static_cast<int32_t>(floor(bpm * 65536.0 + 0.5))));
+    }
+
+    uint32_t last_tick = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+      const MidiEvent & m = events[i];
+      const uint8_t kind = m.status & 0xF0;
+      if (opt.channel && (m.status & 0x0F) != opt.channel - 1)
+        continue;
+      const uint32_t frame = map.frame(m.tick);
+      last_tick = std::max(last_tick, m.tick);
+      switch (kind) {
+      case 0x90:
+        // Note on with velocity 0 is a note off
+        trace->events.push_back(TraceEvent(frame, m.d2 ? k_trace_note_on : k_trace_note_off, m.d1, m.d2));
+        break;
+      case 0x80:
+        trace->events.push_back(TraceEvent(frame, k_trace_note_off, m.d1, 0));
+        break;
+      case 0xA0:
+        trace->events.push_back(TraceEvent(frame, k_trace_aftertouch, m.d1, m.d2));
+        break;
+      case 0xB0:
+        if (m.d1 == 123) {
+          trace->events.push_back(TraceEvent(frame, k_trace_all_note_off, 0, 0));
+          break;
+        }
+        for (size_t k = 0; k < opt.cc_params.size(); ++k) {
+          if (opt.cc_params[k].first != m.d1)
+            continue;
+          const uint8_t id = opt.cc_params[k].second;
+          int32_t value = m.d2;
+          if (id < opt.param_ranges.size()) {
+            const int64_t lo = opt.param_ranges[id].first, hi = opt.param_ranges[id].second;
+            value = static_cast<int32_t>(lo + ((hi - lo) * m.d2 + 63) / 127);
+          }
+          trace->events.push_back(TraceEvent(frame, k_trace_param, id, value));
+        }
+        break;
+      case 0xD0:
+        trace->events.push_back(TraceEvent(frame, k_trace_channel_pressure, 0, m.d1));
+        break;
+      case 0xE0:
+        trace->events.push_back(TraceEvent(frame, k_trace_pitch_bend, 0, m.d1 | (m.d2 << 7)));
+        break;
+      default:
+        break;
+      }
+    }
+
+    // 4ppqn clock over the whole file, as the device sends it while the sequencer runs
+    if (opt.clock) {
+      const double step = division / 4.0;
+      uint32_t counter = 0;
+      for (double t = 0; t <= last_tick; t += step)
+        trace->events.push_back(TraceEvent(map.frame(t), k_trace_tempo_tick, 0, static_cast<int32_t>(counter++)));
+    }
+
+    std::stable_sort(trace->events.begin(), trace->events.end(), by_frame);
+    const uint32_t end = trace->events.empty() ? 0 : trace->events.back().frame;
+    trace->length = end + static_cast<uint64_t>(opt.tail_seconds * k_samplerate);
+    return true;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,83 @@
+/**
+ *  @file trace.h
+ *
+ *  @brief Binary automation traces of runtime callbacks
+ *
+ */
+
+#ifndef HOSTSIM_TRACE_H_
+#define HOSTSIM_TRACE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hostsim {
+
+  /**
+   * File layout, all fields little endian:
+   *
+   *   header (24 bytes)  "HSTR", u16 version, u16 event size (12), u32 sample rate,
+   *                      u32 event count, u64 length in frames
+   *   events (12 bytes)  u32 frame, u8 type, u8 data, u16 reserved (0), i32 value
+   *
+   * Events are sorted by frame. Events at the same frame are delivered in file order.
+   */
+  enum {
+    k_trace_param = 1,         /** data: parameter id, value: parameter value */
+    k_trace_note_on,           /** data: note, value: velocity */
+    k_trace_note_off,          /** data: note */
+    k_trace_all_note_off,
+    k_trace_tempo,             /** value: tempo in 16.16 fixed point BPM, as passed to unit_set_tempo */
+    k_trace_tempo_tick,        /** value: counter passed to unit_tempo_4ppqn_tick */
+    k_trace_pitch_bend,        /** value: 14-bit bend, 0x2000 is center */
+    k_trace_channel_pressure,  /** value: pressure */
+    k_trace_aftertouch,        /** data: note, value: pressure */
+    k_num_trace_event_types
+  };
+
+  struct TraceEvent {
+    uint32_t frame;
+    uint8_t type;
+    uint8_t data;
+    int32_t value;
+
+    TraceEvent() : frame(0), type(0), data(0), value(0) { }
+    TraceEvent(uint32_t f, uint8_t t, uint8_t d, int32_t v) : frame(f), type(t), data(d), value(v) { }
+  };
+
+  struct Trace {
+    uint64_t length;                  /** Frames to render, at least up to the last event. */
+    std::vector<TraceEvent> events;
+
+    Trace() : length(0) { }
+  };
+
+  const char * trace_event_name(uint8_t type);
+
+  bool trace_read(const std::string & path, Trace * trace, std::string * err);
+  bool trace_write(const std::string & path, const Trace & trace, std::string * err);
+
+  struct MidiTraceOptions {
+    int channel;                      /** MIDI channel 1-16 to convert, 0 for all. */
+    bool clock;                       /** Generate 4ppqn ticks from the tempo map. */
+    double tail_seconds;              /** Added after the last event. */
+    std::vector<std::pair<uint8_t, uint8_t> > cc_params; /** Controller number to parameter id. */
+    std::vector<std::pair<int32_t, int32_t> > param_ranges; /** min/max per parameter id, empty for raw 0-127. */
+
+    MidiTraceOptions() : channel(0), clock(true), tail_seconds(1.0) { }
+  };
+
+  /**
+   * Convert a standard MIDI file (format 0 or 1, PPQ timing) into a trace. Tempo
+   * changes become tempo events, note, pitch bend, channel and key pressure
+   * messages map to their callbacks and mapped controllers to parameter changes
+   * scaled to the parameter range.
+   */
+  bool trace_from_midi(const std::string & path, const MidiTraceOptions & opt, Trace * trace, std::string * err);
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_TRACE_H_
@@ -0,0 +1,251 @@
+/**
+ *  @file wav.cc
+ *
+ *  @brief Minimal RIFF/WAVE reader and writer for interleaved float audio
+ *
+ */
+
+#include "wav.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hostsim {
+
+  namespace {
+
+    enum {
+      k_wav_format_pcm = 1,
+      k_wav_format_float = 3,
+      k_wav_format_extensible = 0xFFFE,
+    };
+
+    uint16_t rd16(const uint8_t * p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    uint32_t rd32(const uint8_t * p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+
+    bool fail(std::string * err, const std::string & msg) {
+      if (err)
+        *err = msg;
+      return false;
+    }
+
+    struct WavLayout {
+      uint16_t format;
+      uint16_t bits;
+      uint16_t channels;
+      uint32_t samplerate;
+      size_t data_offset;
+      size_t data_size;
+    };
+
+    /** Locate the fmt and data chunks of a RIFF/WAVE file held in memory. */
+    bool parse_layout(const std::string & path, const uint8_t * file, size_t file_size, WavLayout * layout,
+                      std::string * err) {
+      if (file_size < 12 || memcmp(file, "RIFF", 4) || memcmp(file + 8, "WAVE", 4))
+        return fail(err, path + ": not a RIFF/WAVE file");
+
+      bool have_fmt = false;
+      size_t pos = 12;
+      while (pos + 8 <= file_size) {
+        const uint8_t * ck = file + pos;
+        const uint32_t size = rd32(ck + 4);
+        const size_t body = pos + 8;
+        if (body + size > file_size)
+          return fail(err, path + ": truncated chunk");
+
+        if (!memcmp(ck, "fmt ", 4) && size >= 16) {
+          layout->format = rd16(file + body);
+          layout->channels = rd16(file + body + 2);
+          layout->samplerate = rd32(file + body + 4);
+          layout->bits = rd16(file + body + 14);
+          if (layout->format == k_wav_format_extensible && size >= 26)
+            layout->format = rd16(file + body + 24);
+          have_fmt = true;
+        }
+        else if (!memcmp(ck, "data", 4)) {
+          if (!have_fmt || !layout->channels)
+            return fail(err, path + ": data chunk before fmt chunk");
+          layout->data_offset = body;
+          layout->data_size = size;
+          return true;
+        }
+        pos = body + size + (size & 1);
+      }
+      return fail(err, path + ": no data chunk");
+    }
+
+    bool decode(const std::string & path, const uint8_t * file, const WavLayout & layout, WavData * wav,
+                std::string * err) {
+      wav->channels = layout.channels;
+      wav->samplerate = layout.samplerate;
+      const uint32_t bytes = layout.bits / 8;
+      const size_t count = bytes ? layout.data_size / bytes : 0;
+      wav->samples.resize(count);
+      const uint8_t * p = file + layout.data_offset;
+      for (size_t i = 0; i < count; ++i, p += bytes) {
+        if (layout.format == k_wav_format_float && layout.bits == 32) {
+          uint32_t u = rd32(p);
+          memcpy(&wav->samples[i], &u, 4);
+        }
+        else if (layout.format == k_wav_format_pcm && layout.bits == 16)
+          wav->samples[i] = static_cast<int16_t>(rd16(p)) / 32768.f;
+        else if (layout.format == k_wav_format_pcm && layout.bits == 24)
+          wav->samples[i] = static_cast<int32_t>((p[0] << 8) | (p[1] << 16) | (static_cast<uint32_t>(p[2]) << 24)) / 2147483648.f;
+        else if (layout.format == k_wav_format_pcm && layout.bits == 32)
+          wav->samples[i] = static_cast<int32_t>(rd32(p)) / 2147483648.f;
+        else
+          return fail(err, path + ": unsupported sample format");
+      }
+      return true;
+    }
+
+    void put16(uint8_t * p, uint16_t v) {
+      p[0] = static_cast<uint8_t>(v);
+      p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void put32(uint8_t * p, uint32_t v) {
+      put16(p, static_cast<uint16_t>(v));
+      put16(p + 2, static_cast<uint16_t>(v >> 16));
+    }
+
+    const size_t k_float_header_size = 44;
+
+    /** Canonical 44 byte header of a 32-bit float file, shared by wav_write and MappedWav. */
+    void float_header(uint8_t * h, uint16_t channels, uint32_t samplerate, uint32_t data_size) {
+      memcpy(h, "RIFF", 4);
+      put32(h + 4, 36 + data_size);
+      memcpy(h + 8, "WAVEfmt ", 8);
+      put32(h + 16, 16);
+      put16(h + 20, k_wav_format_float);
+      put16(h + 22, channels);
+      put32(h + 24, samplerate);
+      put32(h + 28, samplerate * channels * sizeof(float));
+      put16(h + 32, static_cast<uint16_t>(channels * sizeof(float)));
+      put16(h + 34, 32);
+      memcpy(h + 36, "data", 4);
+      put32(h + 40, data_size);
+    }
+
+  }  // namespace
+
+  bool wav_read(const std::string & path, WavData * wav, std::string * err) {
+    FILE * fp = fopen(path.c_str(), "rb");
+    if (!fp)
+      return fail(err, "cannot open " + path);
+
+    std::vector<uint8_t> file;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+      file.insert(file.end(), chunk, chunk + n);
+    fclose(fp);
+
+    WavLayout layout;
+    if (!parse_layout(path, file.data(), file.size(), &layout, err))
+      return false;
+    return decode(path, file.data(), layout, wav, err);
+  }
+
+  bool wav_write(const std::string & path, const WavData & wav, std::string * err) {
+    FILE * fp = fopen(path.c_str(), "wb");
+    if (!fp)
+      return fail(err, "cannot create " + path);
+
+    uint8_t header[k_float_header_size];
+    float_header(header, wav.channels, wav.samplerate, static_cast<uint32_t>(wav.samples.size() * sizeof(float)));
+    fwrite(header, 1, sizeof(header), fp);
+    // Host is little-endian, as is the RIFF format
+    const bool ok = fwrite(wav.samples.data(), sizeof(float), wav.samples.size(), fp) == wav.samples.size();
+    fclose(fp);
+    return ok ? true : fail(err, "short write to " + path);
+  }
+
+  MappedWav::MappedWav() : map_(NULL), map_size_(0), data_(NULL), frames_(0), channels_(0), samplerate_(0) { }
+
+  MappedWav::~MappedWav() {
+    close();
+  }
+
+  void MappedWav::close() {
+    if (map_)
+      munmap(map_, map_size_);
+    map_ = NULL;
+    map_size_ = 0;
+    data_ = NULL;
+    frames_ = 0;
+    decoded_.samples.clear();
+  }
+
+  bool MappedWav::open(const std::string & path, std::string * err) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return fail(err, "cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      ::close(fd);
+      return fail(err, path + ": not a RIFF/WAVE file");
+    }
+    void * map = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+      return fail(err, "cannot map " + path);
+    map_ = map;
+    map_size_ = static_cast<size_t>(st.st_size);
+
+    const uint8_t * file = static_cast<const uint8_t *>(map_);
+    WavLayout layout;
+    if (!parse_layout(path, file, map_size_, &layout, err)) {
+      close();
+      return false;
+    }
+    channels_ = layout.channels;
+    samplerate_ = layout.samplerate;
+    if (layout.format == k_wav_format_float && layout.bits == 32 && !(layout.data_offset & 3)) {
+      // Float files written by hostsim are used in place
+      data_ = reinterpret_cast<float *>(static_cast<uint8_t *>(map_) + layout.data_offset);
+      frames_ = layout.data_size / (sizeof(float) * channels_);
+      return true;
+    }
+    const bool ok = decode(path, file, layout, &decoded_, err);
+    munmap(map_, map_size_);
+    map_ = NULL;
+    map_size_ = 0;
+    if (!ok)
+      return false;
+    data_ = decoded_.samples.data();
+    frames_ = decoded_.frames();
+    return true;
+  }
+
+  bool MappedWav::create(const std::string & path, uint16_t channels, uint32_t samplerate, size_t frames,
+                         std::string * err) {
+    close();
+    const size_t data_size = frames * channels * sizeof(float);
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+      return fail(err, "cannot create " + path);
+    map_size_ = k_float_header_size + data_size;
+    void * map = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(map_size_)) == 0)
+      map = mmap(NULL, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+      map_size_ = 0;
+      return fail(err, "cannot map " + path);
+    }
+    map_ = map;
+    float_header(static_cast<uint8_t *>(map_), channels, samplerate, static_cast<uint32_t>(data_size));
+    data_ = reinterpret_cast<float *>(static_cast<uint8_t *>(map_) + k_float_header_size);
+    frames_ = frames;
+    channels_ = channels;
+    samplerate_ = samplerate;
+    return true;
+  }
+
+}  // namespace hostsim
@@ -0,0 +1,71 @@
+/**
+ *  @file wav.h
+ *
+ *  @brief Minimal RIFF/WAVE reader and writer for interleaved float audio
+ *
+ */
+
+#ifndef HOSTSIM_WAV_H_
+#define HOSTSIM_WAV_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace hostsim {
+
+  struct WavData {
+    uint32_t samplerate;
+    uint16_t channels;
+    std::vector<float> samples; // interleaved
+
+    WavData() : samplerate(48000), channels(2) {}
+
+    size_t frames() const { return channels ? samples.size() / channels : 0; }
+  };
+
+  /** Read 16/24/32-bit PCM or 32-bit float WAV files. */
+  bool wav_read(const std::string & path, WavData * wav, std::string * err);
+
+  /** Write a 32-bit float WAV file. */
+  bool wav_write(const std::string & path, const WavData & wav, std::string * err);
+
+  /**
+   * Interleaved float audio backed by a memory mapped file. 32-bit float inputs are
+   * used in place, so processes reading the same file share its page cache, other
+   * formats are decoded on open. Created files are written through the mapping.
+   */
+  class MappedWav {
+  public:
+    MappedWav();
+    ~MappedWav();
+
+    bool open(const std::string & path, std::string * err);
+    /** Create a 32-bit float file with room for frames, initially silent. */
+    bool create(const std::string & path, uint16_t channels, uint32_t samplerate, size_t frames,
+                std::string * err);
+    void close();
+
+    const float * samples() const { return data_; }
+    float * samples() { return data_; }
+    size_t frames() const { return frames_; }
+    uint16_t channels() const { return channels_; }
+    uint32_t samplerate() const { return samplerate_; }
+
+  private:
+    MappedWav(const MappedWav &);
+    MappedWav & operator=(const MappedWav &);
+
+    void * map_;
+    size_t map_size_;
+    float * data_;
+    size_t frames_;
+    uint16_t channels_;
+    uint32_t samplerate_;
+    WavData decoded_;
+  };
+
+}  // namespace hostsim
+
+#endif  // HOSTSIM_WAV_H_
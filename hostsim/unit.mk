@@ -0,0 +1,59 @@
+##############################################################################
+# Builds one unit as a host shared object, invoked from Makefile.
+#
+# The unit's own config.mk is parsed for sources, include paths and macros, so
+# the same project files used for the device build are used as-is.
+#
+
+UNIT_SRC := $(BUILDDIR)/src/$(UNIT_NAME)
+
+include $(UNIT_SRC)/config.mk
+
+CC  ?= gcc
+CXX ?= g++
+
+HOST_OPT ?= -O2
+
+# Mirror the device build options where they make sense on the host
+COPT := -fPIC -std=c11 -fsingle-precision-constant
+CXXOPT := -fPIC -fno-use-cxa-atexit -std=c++11 -fno-rtti -fno-exceptions -fno-non-call-exceptions -fsingle-precision-constant
+
+CWARN := -W -Wall -Wextra
+CXXWARN :=
+
+CSRC := $(addprefix $(UNIT_SRC)/, $(UCSRC)) $(COMMON_INC_PATH)/_unit_base.c
+CXXSRC := $(addprefix $(UNIT_SRC)/, $(UCXXSRC))
+
+OBJDIR := $(BUILDDIR)/obj/$(UNIT_NAME)
+
+COBJS := $(addprefix $(OBJDIR)/, $(notdir $(CSRC:.c=.o)))
+CXXOBJS := $(addprefix $(OBJDIR)/, $(notdir $(CXXSRC:.cc=.o)))
+
+INCDIR := $(patsubst %,-I%,$(UNIT_SRC) $(COMMON_INC_PATH) $(addprefix $(UNIT_SRC)/, $(UINCDIR)))
+
+DEFS := $(UDEFS) $(HOST_DEFS)
+
+vpath %.c $(sort $(dir $(CSRC)))
+vpath %.cc $(sort $(dir $(CXXSRC)))
+
+PRODUCT := $(BUILDDIR)/units/$(UNIT_NAME).so
+
+all: $(PRODUCT)
+
+$(OBJDIR) $(BUILDDIR)/units:
+	@mkdir -p $@
+
+$(COBJS): $(OBJDIR)/%.o: %.c | $(OBJDIR)
+	@echo Compiling $(UNIT_NAME)/$(<F)
+	@$(CC) -c $(HOST_OPT) $(COPT) $(CWARN) $(DEFS) -MMD -MP $(INCDIR) $< -o $@
+
+$(CXXOBJS): $(OBJDIR)/%.o: %.cc | $(OBJDIR)
+	@echo Compiling $(UNIT_NAME)/$(<F)
+	@$(CXX) -c $(HOST_OPT) $(CXXOPT) $(CXXWARN) $(DEFS) -MMD -MP $(INCDIR) $< -o $@
+
+# -Bsymbolic keeps a unit's own globals bound to itself when several units share the process
+$(PRODUCT): $(COBJS) $(CXXOBJS) | $(BUILDDIR)/units
+	@echo Linking $(@F)
+	@$(CXX) $(HOST_OPT) -shared -Wl,-Bsymbolic $^ $(ULIBS) -lm -o $@
+
+-include $(COBJS:.o=.d) $(CXXOBJS:.o=.d)
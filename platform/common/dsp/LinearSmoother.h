@@ -8,7 +8,9 @@
  */
 
 #include "attributes.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
 #include <arm_neon.h>
+#endif
 #include "utils/common_float_math.h"
 #include "utils/common_fixed_math.h"
 #include "utils/common_int_math.h"
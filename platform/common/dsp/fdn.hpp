@@ -0,0 +1,377 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    fdn.hpp
+ * @brief   Feedback delay network reverb core.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include "utils/float_math.h"
+#include "utils/int_math.h"
+#include "utils/buffer_ops.h"
+#include "dsp/lanes4.hpp"
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Feedback delay network with N lines and an orthogonal feedback matrix.
+   *
+   * Every line ends in a one-pole lowpass for damping and a gain derived from
+   * the decay time and its length, then the lines are mixed back into each
+   * other by a Householder or Hadamard matrix. Both are orthogonal, so the
+   * network decays at the rate set by the gains alone, and both need no
+   * multiplies beyond a normalization: Householder costs 2N adds, Hadamard
+   * N log2 N. One FDN<8> replaces a bank of parallel combs and serial allpasses
+   * with a denser echo pattern.
+   *
+   * State is kept as one array per quantity, and the per-line arithmetic runs
+   * four lines at a time through Lanes4. Only the delay line reads are scalar.
+   *
+   *   s_fdn.setMemory(ram, line_size);  // N * line_size floats, see memorySize()
+   *   s_fdn.spreadDelays(1000.f, 3000.f);
+   *   s_fdn.setDecay(2.f * 48000.f);
+   *   s_fdn.setDamping(0.3f);
+   *   ...
+   *   s_fdn.setModulation(offsets);     // optional, ramped over the next block
+   *   s_fdn.process(in, out, frames);   // stereo interleaved, wet only
+   *
+   * @tparam N Number of lines, 4, 8 or 16
+   */
+  template <uint32_t N>
+  struct FDN {
+    static_assert(N == 4 || N == 8 || N == 16, "FDN supports 4, 8 or 16 lines");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_householder = 0,
+      k_hadamard
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, Householder matrix, lines injected and tapped in
+     * alternating stereo pairs
+     */
+    FDN(void) :
+      mLine(0),
+      mLineSize(0),
+      mMask(0),
+      mWriteIdx(0),
+      mMatrix(k_householder)
+    {
+      const float norm = normalization();
+      for (uint32_t i = 0; i < N; i++) {
+        length[i] = 1.f;
+        mod[i] = modStep[i] = modTarget[i] = 0.f;
+        damp[i] = 0.f;
+        gain[i] = 0.f;
+        z[i] = 0.f;
+        inL[i] = (i & 1) ? 0.f : 1.f;
+        inR[i] = (i & 1) ? 1.f : 0.f;
+        outL[i] = ((i & 2) ? -norm : norm) * ((i & 1) ? 0.5f : 1.f);
+        outR[i] = ((i & 4) ? -norm : norm) * ((i & 1) ? 1.f : 0.5f);
+      }
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Memory needed for lines up to the given delay, in floats
+     *
+     * @param max_delay Longest delay including modulation, in samples
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    size_t memorySize(const uint32_t max_delay) {
+      return N * nextpow2_u32(max_delay + 2);
+    }
+
+    /**
+     * Set the memory area holding the delay lines.
+     *
+     * @param ram Pointer to N * line_size floats
+     * @param line_size Size of each line in floats, must be a power of two
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setMemory(float *ram, const size_t line_size) {
+      mLine = ram;
+      mLineSize = line_size;
+      mMask = line_size - 1;
+      mWriteIdx = 0;
+    }
+
+    /**
+     * Zero clear the delay lines and filter states.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void clear(void) {
+      buf_clr_f32(mLine, N * mLineSize);
+      for (uint32_t i = 0; i < N; i++)
+        z[i] = 0.f;
+    }
+
+    /**
+     * Select the feedback matrix, k_householder or k_hadamard
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setMatrix(const uint8_t matrix) {
+      mMatrix = matrix;
+    }
+
+    /**
+     * Set the length of a line in samples, call setDecay() afterwards
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDelay(const uint32_t i, const float samples) {
+      length[i] = samples;
+    }
+
+    /**
+     * Spread the line lengths geometrically between two lengths.
+     *
+     * Lengths are rounded to odd sample counts and offset from each other so
+     * that no two lines share a common period.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void spreadDelays(const float shortest, const float longest) {
+      const float ratio = fastpow2f(fastlog2f(longest / shortest) / (N - 1));
+      float l = shortest;
+      for (uint32_t i = 0; i < N; i++, l *= ratio)
+        length[i] = (float)(((uint32_t)l | 1) + 2 * i);
+    }
+
+    /**
+     * Set the decay time of the network
+     *
+     * @param rt60 Time to decay by 60dB, in samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDecay(const float rt60) {
+      // -60dB over rt60 samples is a factor of 10^(-3 * length / rt60) per pass
+      const float k = -9.965784f / rt60;
+      for (uint32_t i = 0; i < N; i++)
+        gain[i] = fastpow2f(k * length[i]);
+    }
+
+    /**
+     * Set the damping lowpass of all lines
+     *
+     * @param coef One-pole coefficient, 0 for no damping, towards 1 for darker tails
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDamping(const float coef) {
+      for (uint32_t i = 0; i < N; i++)
+        damp[i] = coef;
+    }
+
+    /**
+     * Set the damping lowpass of one line
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDamping(const uint32_t i, const float coef) {
+      damp[i] = coef;
+    }
+
+    /**
+     * Modulation hook: offset each line's length, in samples.
+     *
+     * The offsets are reached by a linear ramp over the next process() call, so
+     * an LFO evaluated once per block modulates without zipper noise. Lengths
+     * plus offsets must stay at least 1 and below the line size minus 1.
+     *
+     * @param offsets N offsets in samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setModulation(const float *offsets) {
+      for (uint32_t i = 0; i < N; i++)
+        modTarget[i] = offsets[i];
+    }
+
+    /**
+     * Process a block, wet signal only
+     *
+     * @param in Stereo interleaved input
+     * @param out Stereo interleaved output, may be the input buffer
+     * @param frames Number of frames
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float *in, float *out, const uint32_t frames) {
+      typedef Lanes4 L;
+      const float frames_recip = 1.f / frames;
+      for (uint32_t i = 0; i < N; i += 4)
+        L::store(modStep + i, L::mul(L::sub(L::load(modTarget + i), L::load(mod + i)), L::splat(frames_recip)));
+
+      for (uint32_t f = 0; f < frames; f++) {
+        float d[N] __attribute__((aligned(16)));
+        read(d);
+
+        const float in_l = in[2*f];
+        const float in_r = in[2*f+1];
+        L::v4 acc_l = L::splat(0.f);
+        L::v4 acc_r = L::splat(0.f);
+        for (uint32_t i = 0; i < N; i += 4) {
+          // Damping lowpass then decay gain
+          L::v4 zi = L::load(z + i);
+          zi = L::madd(L::load(d + i), L::load(damp + i), L::sub(zi, L::load(d + i)));
+          L::store(z + i, zi);
+          const L::v4 y = L::mul(zi, L::load(gain + i));
+          L::store(d + i, y);
+          acc_l = L::madd(acc_l, y, L::load(outL + i));
+          acc_r = L::madd(acc_r, y, L::load(outR + i));
+          L::store(mod + i, L::add(L::load(mod + i), L::load(modStep + i)));
+        }
+
+        mix(d);
+
+        const L::v4 vl = L::splat(in_l);
+        const L::v4 vr = L::splat(in_r);
+        for (uint32_t i = 0; i < N; i += 4)
+          L::store(d + i, L::madd(L::madd(L::load(d + i), vl, L::load(inL + i)), vr, L::load(inR + i)));
+
+        write(d);
+
+        out[2*f] = L::hsum(acc_l);
+        out[2*f+1] = L::hsum(acc_r);
+      }
+
+      // Land exactly on the targets
+      for (uint32_t i = 0; i < N; i++)
+        mod[i] = modTarget[i];
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    /** 1/sqrt(N) */
+    static inline __attribute__((always_inline))
+    float normalization(void) {
+      return (N == 4) ? 0.5f : (N == 8) ? 0.35355339f : 0.25f;
+    }
+
+    /** Read the output of every line at its modulated length, interpolated linearly. */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void read(float *d) {
+      const float *line = mLine;
+      for (uint32_t i = 0; i < N; i++, line += mLineSize) {
+        const float pos = length[i] + mod[i];
+        const uint32_t base = (uint32_t)pos;
+        const float frac = pos - base;
+        const uint32_t idx = mWriteIdx - base;
+        d[i] = linintf(frac, line[idx & mMask], line[(idx - 1) & mMask]);
+      }
+    }
+
+    /** Write one sample to the head of every line. */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const float *d) {
+      float *line = mLine + (mWriteIdx & mMask);
+      for (uint32_t i = 0; i < N; i++, line += mLineSize)
+        *line = d[i];
+      ++mWriteIdx;
+    }
+
+    /** Apply the feedback matrix in place. */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void mix(float *d) {
+      typedef Lanes4 L;
+      if (mMatrix == k_hadamard) {
+        // Fast Walsh-Hadamard transform, butterflies within each group of four then across groups
+        for (uint32_t i = 0; i < N; i += 4) {
+          const float a = d[i] + d[i+1], b = d[i] - d[i+1];
+          const float c = d[i+2] + d[i+3], e = d[i+2] - d[i+3];
+          d[i] = a + c; d[i+1] = b + e; d[i+2] = a - c; d[i+3] = b - e;
+        }
+        for (uint32_t h = 4; h < N; h <<= 1)
+          for (uint32_t i = 0; i < N; i += 2 * h)
+            for (uint32_t j = i; j < i + h; j += 4) {
+              const L::v4 a = L::load(d + j);
+              const L::v4 b = L::load(d + j + h);
+              L::store(d + j, L::add(a, b));
+              L::store(d + j + h, L::sub(a, b));
+            }
+        const L::v4 norm = L::splat(normalization());
+        for (uint32_t i = 0; i < N; i += 4)
+          L::store(d + i, L::mul(L::load(d + i), norm));
+      }
+      else {
+        // I - 2/N * ones
+        L::v4 acc = L::load(d);
+        for (uint32_t i = 4; i < N; i += 4)
+          acc = L::add(acc, L::load(d + i));
+        const L::v4 s = L::splat(L::hsum(acc) * (2.f / N));
+        for (uint32_t i = 0; i < N; i += 4)
+          L::store(d + i, L::sub(L::load(d + i), s));
+      }
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    float length[N] __attribute__((aligned(16)));    /** Line lengths in samples. */
+    float mod[N] __attribute__((aligned(16)));       /** Current modulation offsets. */
+    float modStep[N] __attribute__((aligned(16)));
+    float modTarget[N] __attribute__((aligned(16)));
+    float damp[N] __attribute__((aligned(16)));      /** Damping lowpass coefficients. */
+    float gain[N] __attribute__((aligned(16)));      /** Decay gains. */
+    float z[N] __attribute__((aligned(16)));         /** Damping lowpass states. */
+    float inL[N] __attribute__((aligned(16)));       /** Input gains per line, left and right. */
+    float inR[N] __attribute__((aligned(16)));
+    float outL[N] __attribute__((aligned(16)));      /** Output gains per line, left and right. */
+    float outR[N] __attribute__((aligned(16)));
+
+    float   *mLine;
+    size_t   mLineSize;
+    size_t   mMask;
+    uint32_t mWriteIdx;
+    uint8_t  mMatrix;
+  };
+}
+
+/** @} */
@@ -0,0 +1,239 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+/**
+ * @file    lanes4.hpp
+ * @brief   Portable four lane float vector.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Four lane float vector for structure-of-arrays processing.
+   *
+   * Maps to NEON, SSE or wasm SIMD when the target has it. Cortex-M7 builds use
+   * the scalar version, which the compiler keeps in FPU registers, so code
+   * written against it costs the same as a hand-unrolled loop there.
+   * load() and store() accept unaligned pointers.
+   *
+   * u4 holds four uint32 phase accumulators that wrap on overflow. unit() maps
+   * them to floats in [0, 1], asfloat() reinterprets their bits as floats.
+   */
+  struct Lanes4 {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    typedef float32x4_t v4;
+    static inline __attribute__((always_inline)) v4 splat(float a) { return vdupq_n_f32(a); }
+    static inline __attribute__((always_inline)) v4 set(float a, float b, float c, float d) {
+      const float v[4] = { a, b, c, d };
+      return vld1q_f32(v);
+    }
+    static inline __attribute__((always_inline)) v4 load(const float * p) { return vld1q_f32(p); }
+    static inline __attribute__((always_inline)) void store(float * p, v4 a) { vst1q_f32(p, a); }
+    static inline __attribute__((always_inline)) v4 add(v4 a, v4 b) { return vaddq_f32(a, b); }
+    static inline __attribute__((always_inline)) v4 sub(v4 a, v4 b) { return vsubq_f32(a, b); }
+    static inline __attribute__((always_inline)) v4 mul(v4 a, v4 b) { return vmulq_f32(a, b); }
+    static inline __attribute__((always_inline)) v4 madd(v4 a, v4 b, v4 c) { return vmlaq_f32(a, b, c); }
+    static inline __attribute__((always_inline)) float hsum(v4 a) {
+      const float32x2_t s = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+      return vget_lane_f32(vpadd_f32(s, s), 0);
+    }
+    static inline __attribute__((always_inline)) v4 min(v4 a, v4 b) { return vminq_f32(a, b); }
+    static inline __attribute__((always_inline)) v4 max(v4 a, v4 b) { return vmaxq_f32(a, b); }
+
+    typedef uint32x4_t u4;
+    static inline __attribute__((always_inline)) u4 splatu(uint32_t a) { return vdupq_n_u32(a); }
+    static inline __attribute__((always_inline)) u4 loadu(const uint32_t * p) { return vld1q_u32(p); }
+    static inline __attribute__((always_inline)) void storeu(uint32_t * p, u4 a) { vst1q_u32(p, a); }
+    static inline __attribute__((always_inline)) u4 addu(u4 a, u4 b) { return vaddq_u32(a, b); }
+    static inline __attribute__((always_inline)) v4 unit(u4 a) { return vmulq_n_f32(vcvtq_f32_u32(a), 2.3283064e-10f); }
+    static inline __attribute__((always_inline)) u4 xoru(u4 a, u4 b) { return veorq_u32(a, b); }
+    static inline __attribute__((always_inline)) u4 oru(u4 a, u4 b) { return vorrq_u32(a, b); }
+    template <int S> static inline __attribute__((always_inline)) u4 shlu(u4 a) { return vshlq_n_u32(a, S); }
+    template <int S> static inline __attribute__((always_inline)) u4 shru(u4 a) { return vshrq_n_u32(a, S); }
+    static inline __attribute__((always_inline)) v4 asfloat(u4 a) { return vreinterpretq_f32_u32(a); }
+#elif defined(__SSE2__)
+    typedef __m128 v4;
+    static inline __attribute__((always_inline)) v4 splat(float a) { return _mm_set1_ps(a); }
+    static inline __attribute__((always_inline)) v4 set(float a, float b, float c, float d) { return _mm_setr_ps(a, b, c, d); }
+    static inline __attribute__((always_inline)) v4 load(const float * p) { return _mm_loadu_ps(p); }
+    static inline __attribute__((always_inline)) void store(float * p, v4 a) { _mm_storeu_ps(p, a); }
+    static inline __attribute__((always_inline)) v4 add(v4 a, v4 b) { return _mm_add_ps(a, b); }
+    static inline __attribute__((always_inline)) v4 sub(v4 a, v4 b) { return _mm_sub_ps(a, b); }
+    static inline __attribute__((always_inline)) v4 mul(v4 a, v4 b) { return _mm_mul_ps(a, b); }
+    static inline __attribute__((always_inline)) v4 madd(v4 a, v4 b, v4 c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); }
+    static inline __attribute__((always_inline)) float hsum(v4 a) {
+      const __m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+      return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    }
+    static inline __attribute__((always_inline)) v4 min(v4 a, v4 b) { return _mm_min_ps(a, b); }
+    static inline __attribute__((always_inline)) v4 max(v4 a, v4 b) { return _mm_max_ps(a, b); }
+
+    typedef __m128i u4;
+    static inline __attribute__((always_inline)) u4 splatu(uint32_t a) { return _mm_set1_epi32(static_cast<int32_t>(a)); }
+    static inline __attribute__((always_inline)) u4 loadu(const uint32_t * p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static inline __attribute__((always_inline)) void storeu(uint32_t * p, u4 a) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static inline __attribute__((always_inline)) u4 addu(u4 a, u4 b) { return _mm_add_epi32(a, b); }
+    static inline __attribute__((always_inline)) v4 unit(u4 a) {
+      // SSE2 only converts signed integers, so convert a - 2^31 and add back 0.5
+      const __m128 f = _mm_cvtepi32_ps(_mm_xor_si128(a, _mm_set1_epi32(static_cast<int32_t>(0x80000000U))));
+      return _mm_add_ps(_mm_mul_ps(f, _mm_set1_ps(2.3283064e-10f)), _mm_set1_ps(0.5f));
+    }
+    static inline __attribute__((always_inline)) u4 xoru(u4 a, u4 b) { return _mm_xor_si128(a, b); }
+    static inline __attribute__((always_inline)) u4 oru(u4 a, u4 b) { return _mm_or_si128(a, b); }
+    template <int S> static inline __attribute__((always_inline)) u4 shlu(u4 a) { return _mm_slli_epi32(a, S); }
+    template <int S> static inline __attribute__((always_inline)) u4 shru(u4 a) { return _mm_srli_epi32(a, S); }
+    static inline __attribute__((always_inline)) v4 asfloat(u4 a) { return _mm_castsi128_ps(a); }
+#elif defined(__wasm_simd128__)
+    typedef v128_t v4;
+    static inline __attribute__((always_inline)) v4 splat(float a) { return wasm_f32x4_splat(a); }
+    static inline __attribute__((always_inline)) v4 set(float a, float b, float c, float d) { return wasm_f32x4_make(a, b, c, d); }
+    static inline __attribute__((always_inline)) v4 load(const float * p) { return wasm_v128_load(p); }
+    static inline __attribute__((always_inline)) void store(float * p, v4 a) { wasm_v128_store(p, a); }
+    static inline __attribute__((always_inline)) v4 add(v4 a, v4 b) { return wasm_f32x4_add(a, b); }
+    static inline __attribute__((always_inline)) v4 sub(v4 a, v4 b) { return wasm_f32x4_sub(a, b); }
+    static inline __attribute__((always_inline)) v4 mul(v4 a, v4 b) { return wasm_f32x4_mul(a, b); }
+    static inline __attribute__((always_inline)) v4 madd(v4 a, v4 b, v4 c) { return wasm_f32x4_add(a, wasm_f32x4_mul(b, c)); }
+    static inline __attribute__((always_inline)) float hsum(v4 a) {
+      return wasm_f32x4_extract_lane(a, 0) + wasm_f32x4_extract_lane(a, 1)
+        + wasm_f32x4_extract_lane(a, 2) + wasm_f32x4_extract_lane(a, 3);
+    }
+    static inline __attribute__((always_inline)) v4 min(v4 a, v4 b) { return wasm_f32x4_min(a, b); }
+    static inline __attribute__((always_inline)) v4 max(v4 a, v4 b) { return wasm_f32x4_max(a, b); }
+
+    typedef v128_t u4;
+    static inline __attribute__((always_inline)) u4 splatu(uint32_t a) { return wasm_u32x4_splat(a); }
+    static inline __attribute__((always_inline)) u4 loadu(const uint32_t * p) { return wasm_v128_load(p); }
+    static inline __attribute__((always_inline)) void storeu(uint32_t * p, u4 a) { wasm_v128_store(p, a); }
+    static inline __attribute__((always_inline)) u4 addu(u4 a, u4 b) { return wasm_i32x4_add(a, b); }
+    static inline __attribute__((always_inline)) v4 unit(u4 a) {
+      return wasm_f32x4_mul(wasm_f32x4_convert_u32x4(a), wasm_f32x4_splat(2.3283064e-10f));
+    }
+    static inline __attribute__((always_inline)) u4 xoru(u4 a, u4 b) { return wasm_v128_xor(a, b); }
+    static inline __attribute__((always_inline)) u4 oru(u4 a, u4 b) { return wasm_v128_or(a, b); }
+    template <int S> static inline __attribute__((always_inline)) u4 shlu(u4 a) { return wasm_i32x4_shl(a, S); }
+    template <int S> static inline __attribute__((always_inline)) u4 shru(u4 a) { return wasm_u32x4_shr(a, S); }
+    static inline __attribute__((always_inline)) v4 asfloat(u4 a) { return a; }
+#else
+    struct v4 { float x0, x1, x2, x3; };
+    static inline __attribute__((always_inline)) v4 splat(float a) { const v4 r = { a, a, a, a }; return r; }
+    static inline __attribute__((always_inline)) v4 set(float a, float b, float c, float d) { const v4 r = { a, b, c, d }; return r; }
+    static inline __attribute__((always_inline)) v4 load(const float * p) { const v4 r = { p[0], p[1], p[2], p[3] }; return r; }
+    static inline __attribute__((always_inline)) void store(float * p, v4 a) {
+      p[0] = a.x0; p[1] = a.x1; p[2] = a.x2; p[3] = a.x3;
+    }
+    static inline __attribute__((always_inline)) v4 add(v4 a, v4 b) {
+      const v4 r = { a.x0 + b.x0, a.x1 + b.x1, a.x2 + b.x2, a.x3 + b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 sub(v4 a, v4 b) {
+      const v4 r = { a.x0 - b.x0, a.x1 - b.x1, a.x2 - b.x2, a.x3 - b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 mul(v4 a, v4 b) {
+      const v4 r = { a.x0 * b.x0, a.x1 * b.x1, a.x2 * b.x2, a.x3 * b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 madd(v4 a, v4 b, v4 c) {
+      const v4 r = { a.x0 + b.x0 * c.x0, a.x1 + b.x1 * c.x1, a.x2 + b.x2 * c.x2, a.x3 + b.x3 * c.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) float hsum(v4 a) { return (a.x0 + a.x1) + (a.x2 + a.x3); }
+    static inline __attribute__((always_inline)) v4 min(v4 a, v4 b) {
+      const v4 r = { a.x0 < b.x0 ? a.x0 : b.x0, a.x1 < b.x1 ? a.x1 : b.x1,
+                     a.x2 < b.x2 ? a.x2 : b.x2, a.x3 < b.x3 ? a.x3 : b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 max(v4 a, v4 b) {
+      const v4 r = { a.x0 > b.x0 ? a.x0 : b.x0, a.x1 > b.x1 ? a.x1 : b.x1,
+                     a.x2 > b.x2 ? a.x2 : b.x2, a.x3 > b.x3 ? a.x3 : b.x3 };
+      return r;
+    }
+
+    struct u4 { uint32_t x0, x1, x2, x3; };
+    static inline __attribute__((always_inline)) u4 splatu(uint32_t a) { const u4 r = { a, a, a, a }; return r; }
+    static inline __attribute__((always_inline)) u4 loadu(const uint32_t * p) { const u4 r = { p[0], p[1], p[2], p[3] }; return r; }
+    static inline __attribute__((always_inline)) void storeu(uint32_t * p, u4 a) {
+      p[0] = a.x0; p[1] = a.x1; p[2] = a.x2; p[3] = a.x3;
+    }
+    static inline __attribute__((always_inline)) u4 addu(u4 a, u4 b) {
+      const u4 r = { a.x0 + b.x0, a.x1 + b.x1, a.x2 + b.x2, a.x3 + b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 unit(u4 a) {
+      const float k = 2.3283064e-10f;
+      const v4 r = { a.x0 * k, a.x1 * k, a.x2 * k, a.x3 * k };
+      return r;
+    }
+    static inline __attribute__((always_inline)) u4 xoru(u4 a, u4 b) {
+      const u4 r = { a.x0 ^ b.x0, a.x1 ^ b.x1, a.x2 ^ b.x2, a.x3 ^ b.x3 };
+      return r;
+    }
+    static inline __attribute__((always_inline)) u4 oru(u4 a, u4 b) {
+      const u4 r = { a.x0 | b.x0, a.x1 | b.x1, a.x2 | b.x2, a.x3 | b.x3 };
+      return r;
+    }
+    template <int S> static inline __attribute__((always_inline)) u4 shlu(u4 a) {
+      const u4 r = { a.x0 << S, a.x1 << S, a.x2 << S, a.x3 << S };
+      return r;
+    }
+    template <int S> static inline __attribute__((always_inline)) u4 shru(u4 a) {
+      const u4 r = { a.x0 >> S, a.x1 >> S, a.x2 >> S, a.x3 >> S };
+      return r;
+    }
+    static inline __attribute__((always_inline)) v4 asfloat(u4 a) {
+      union { u4 u; v4 f; } c;
+      c.u = a;
+      return c.f;
+    }
+#endif
+  };
+}
+
+/** @} */
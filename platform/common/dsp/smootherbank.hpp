@@ -0,0 +1,307 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+#include "dsp/lanes4.hpp"
+
+/**
+ * @file    smootherbank.hpp
+ * @brief   Block based parameter smoothing for a bank of parameters.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Bank of N parameter smoothers advanced together once per block.
+   *
+   * process() writes one ramp buffer per parameter, which the audio loop then
+   * reads instead of calling a smoother per parameter per sample:
+   *
+   *   s_smooth.setTarget(k_cutoff, cutoff);        // from unit_set_param_value()
+   *   ...
+   *   s_smooth.process(frames);                    // once per unit_render()
+   *   const float * cutoff = s_smooth.ramp(k_cutoff);
+   *   for (uint32_t f = 0; f < frames; f++)
+   *     ... cutoff[f] ...
+   *
+   * Each parameter is either linear, reaching the target after a fixed number of
+   * samples, or one-pole, approaching it exponentially. Settled parameters cost
+   * a buffer fill. Ramps are computed four frames at a time in closed form, so
+   * the per-block cost does not depend on a recursion between samples.
+   *
+   * @tparam N Number of parameters
+   * @tparam MaxFrames Ramp buffer length, the largest block process() handles
+   */
+  template <uint32_t N, uint32_t MaxFrames = 64>
+  struct SmootherBank {
+    static_assert(N > 0, "bank needs at least one parameter");
+    static_assert(MaxFrames > 0 && (MaxFrames & 3) == 0, "ramp buffer length must be a multiple of 4");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_linear = 0,
+      k_one_pole
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, all parameters linear over 64 samples and settled at 0
+     */
+    SmootherBank(void)
+    {
+      for (uint32_t i = 0; i < N; i++) {
+        setLinear(i, 64);
+        reset(i, 0.f);
+      }
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Use a linear ramp for a parameter
+     *
+     * @param i Parameter index
+     * @param samples Ramp length in samples, a new target is reached after this many samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setLinear(const uint32_t i, const uint32_t samples)
+    {
+      mode[i] = k_linear;
+      period[i] = samples ? samples : 1;
+      periodRecip[i] = 1.f / period[i];
+    }
+
+    /**
+     * Use a one-pole lowpass for a parameter
+     *
+     * @param i Parameter index
+     * @param samples Time constant in samples, the distance to the target shrinks by 1/e over this many samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setOnePole(const uint32_t i, const float samples)
+    {
+      mode[i] = k_one_pole;
+      coef[i] = (samples > 1.f) ? fastexpf(-1.f / samples) : 0.f;
+    }
+
+    /**
+     * Set a new target, the ramp starts from the current value on the next process()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setTarget(const uint32_t i, const float t)
+    {
+      if (t == target[i])
+        return;
+      target[i] = t;
+      remain[i] = period[i];
+      step[i] = (t - value[i]) * periodRecip[i];
+    }
+
+    /**
+     * Jump to a value without ramping
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void reset(const uint32_t i, const float t)
+    {
+      value[i] = target[i] = t;
+      step[i] = 0.f;
+      remain[i] = 0;
+    }
+
+    /**
+     * Jump all parameters to their targets
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void)
+    {
+      for (uint32_t i = 0; i < N; i++)
+        reset(i, target[i]);
+    }
+
+    /**
+     * Advance all parameters by a block and fill their ramp buffers
+     *
+     * @param frames Block length, clipped to MaxFrames
+     * @return Number of frames written to each ramp buffer
+     */
+    inline __attribute__((optimize("Ofast")))
+    uint32_t process(uint32_t frames)
+    {
+      if (frames > MaxFrames)
+        frames = MaxFrames;
+      if (!frames)
+        return 0;
+      for (uint32_t i = 0; i < N; i++) {
+        if (value[i] == target[i])
+          fill(buf[i], target[i], frames);
+        else if (mode[i] == k_linear)
+          processLinear(i, frames);
+        else
+          processOnePole(i, frames);
+      }
+      return frames;
+    }
+
+    /**
+     * Ramp buffer of a parameter, valid after process() for the frames it returned
+     */
+    inline __attribute__((always_inline))
+    const float * ramp(const uint32_t i) const
+    {
+      return buf[i];
+    }
+
+    /**
+     * Value at the end of the last processed block
+     */
+    inline __attribute__((always_inline))
+    float current(const uint32_t i) const
+    {
+      return value[i];
+    }
+
+    /**
+     * True when a parameter has reached its target
+     */
+    inline __attribute__((always_inline))
+    bool settled(const uint32_t i) const
+    {
+      return value[i] == target[i];
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    void fill(float * __restrict out, const float v, const uint32_t frames)
+    {
+      typedef Lanes4 L;
+      const L::v4 vv = L::splat(v);
+      for (uint32_t f = 0; f < frames; f += 4)
+        L::store(out + f, vv);
+    }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void processLinear(const uint32_t i, const uint32_t frames)
+    {
+      typedef Lanes4 L;
+      float * __restrict out = buf[i];
+      const float s = step[i];
+      const uint32_t n = (remain[i] < frames) ? remain[i] : frames;
+
+      // value + s * (f + 1), four frames at a time
+      L::v4 acc = L::madd(L::splat(value[i]), L::splat(s), L::set(1.f, 2.f, 3.f, 4.f));
+      const L::v4 inc = L::splat(4.f * s);
+      uint32_t f = 0;
+      for (; f + 4 <= n; f += 4) {
+        L::store(out + f, acc);
+        acc = L::add(acc, inc);
+      }
+      for (; f < n; f++)
+        out[f] = value[i] + s * (f + 1);
+
+      remain[i] -= n;
+      if (remain[i] == 0) {
+        // Land exactly on the target regardless of accumulated rounding
+        value[i] = target[i];
+        step[i] = 0.f;
+        if (n)
+          out[n - 1] = target[i];
+        for (; f < frames; f++)
+          out[f] = target[i];
+      }
+      else
+        value[i] += s * n;
+    }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void processOnePole(const uint32_t i, const uint32_t frames)
+    {
+      typedef Lanes4 L;
+      float * __restrict out = buf[i];
+      const float a = coef[i];
+      const float a2 = a * a;
+      const float a4 = a2 * a2;
+      const float t = target[i];
+      const float d = value[i] - t;
+
+      // target + (value - target) * a^(f + 1), four frames at a time
+      const L::v4 vt = L::splat(t);
+      const L::v4 vd = L::splat(d);
+      const L::v4 va4 = L::splat(a4);
+      L::v4 pw = L::set(a, a2, a2 * a, a4);
+      for (uint32_t f = 0; f < frames; f += 4) {
+        L::store(out + f, L::madd(vt, vd, pw));
+        pw = L::mul(pw, va4);
+      }
+
+      const float last = out[frames - 1];
+      // Snap once within float resolution of the target instead of decaying into denormals
+      value[i] = (si_fabsf(last - t) <= 1e-6f * (si_fabsf(t) + 1e-3f)) ? t : last;
+    }
+
+    /*===========================================================================*/
+    /* Members Vars                                                              */
+    /*===========================================================================*/
+
+    float buf[N][MaxFrames] __attribute__((aligned(16)));
+    float value[N];
+    float target[N];
+    float step[N];
+    float periodRecip[N];
+    float coef[N];
+    uint32_t period[N];
+    uint32_t remain[N];
+    uint8_t mode[N];
+  };
+}
+
+/** @} */
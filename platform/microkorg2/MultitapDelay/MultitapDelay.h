@@ -51,7 +51,7 @@
 #include "runtime.h"
 #include "unit_delfx.h"
 #include "macros.h"
-#include "dsp/LinearSmoother.h"
+#include "dsp/smootherbank.hpp"
 #include "dsp/delayline.hpp"
 #include "dsp/mk2_biquad.hpp"
 
@@ -150,15 +150,10 @@ class MultitapDelay {
     delayLine += delayLineSize;
     mDelayLine2.setMemory(delayLine, delayLineSize);
 
-    mMixSmoother.SetTarget(params_[kParamWet] * 0.01);
-    mInputSpreadSmoother.SetTarget(params_[kParamInputMix] * 0.01);
-    mOutputSpreadSmoother.SetTarget(params_[kParamSpread] * 0.01);
-    mFilterMixSmoother.SetTarget(params_[kParamTone] < 0);
-
-    mMixSmoother.Flush();
-    mInputSpreadSmoother.Flush();
-    mOutputSpreadSmoother.Flush();
-    mFilterMixSmoother.Flush();
+    mSmoothers.reset(kSmoothMix, params_[kParamWet] * 0.01);
+    mSmoothers.reset(kSmoothInputSpread, params_[kParamInputMix] * 0.01);
+    mSmoothers.reset(kSmoothOutputSpread, params_[kParamSpread] * 0.01);
+    mSmoothers.reset(kSmoothFilterMix, params_[kParamTone] < 0);
     mCutoffZ = params_[kParamTone] * 0.01;
 
     mDelayTimeZ[kTap1] = mDelayTime[kTap1];
@@ -170,10 +165,8 @@ class MultitapDelay {
 
     CookFilterCoeffs();
 
-    mPrimaryFeedbackSmoother.SetTarget(CalculatePrimaryFeedback(CalculateFeedback(mDelayTime[kTap2] * mDelayTimeRange)));
-    mSecondaryFeedbackSmoother.SetTarget(CalculateSecondaryFeedback(CalculateFeedback(mDelayTime[kTap3] * mDelayTimeRange)));
-    mPrimaryFeedbackSmoother.Flush();
-    mSecondaryFeedbackSmoother.Flush();
+    mSmoothers.reset(kSmoothPrimaryFeedback, CalculatePrimaryFeedback(CalculateFeedback(mDelayTime[kTap2] * mDelayTimeRange)));
+    mSmoothers.reset(kSmoothSecondaryFeedback, CalculateSecondaryFeedback(CalculateFeedback(mDelayTime[kTap3] * mDelayTimeRange)));
   }
 
   inline void Resume() {
@@ -193,7 +186,6 @@ class MultitapDelay {
   {
     const float * __restrict in_p = in;
     float * __restrict out_p = out;
-    const float * out_e = out_p + (frames << 1);  // assuming stereo output
 
     UpdateParameters();
 
@@ -201,72 +193,84 @@ class MultitapDelay {
     float wetSig[4];
     float32x4_t delayTimeZ = f32x4_ld(mDelayTimeZ);
     const float32x4_t delayTimeTarget = f32x4_ld(mDelayTime);
-    for (; out_p != out_e; in_p += 2, out_p += 2) 
-    {      
-      const float dryL = in_p[0];
-      const float dryR = in_p[1];
-
-      delayTimeZ = float32x4_add(delayTimeZ, float32x4_mulscal(float32x4_sub(delayTimeTarget, delayTimeZ), mDelayTimeSmoothingCoeff));
-      f32x4_str(mDelayTimeZ, delayTimeZ);
-      const float tap1 = mDelayLine1.readFrac(mDelayTimeZ[kTap1]);
-      const float tap2 = mDelayLine2.readFrac(mDelayTimeZ[kTap2]);
-      const float tap3 = mDelayLine1.readFrac(mDelayTimeZ[kTap3]);
-      const float tap4 = mDelayLine2.readFrac(mDelayTimeZ[kTap4]);
-      
-      const float inputSpreadMix = mInputSpreadSmoother.Process();
-      const float primaryFeedback = mPrimaryFeedbackSmoother.Process();
-      const float secondaryFeedback = mSecondaryFeedbackSmoother.Process();
-      float tap1Fb = tap1 * primaryFeedback;
-      float tap2Fb = tap2 * (primaryFeedback * inputSpreadMix + secondaryFeedback * (1.f - inputSpreadMix));
-      float tap3Fb = tap3 * secondaryFeedback;
-      float tap4Fb = tap4 * secondaryFeedback;
-
-      float fb1 = (tap1Fb + tap3Fb) * inputSpreadMix;
-      fb1 = (fb1 + (tap2Fb + tap4Fb) * (1.f - inputSpreadMix));
-      fb1 = clipminmaxf(-1.f, fb1 * feedbackScale, 1.f);
-
-      float fb2 = tap2Fb + tap4Fb;
-      fb2 = (fb2 + (tap1Fb + tap3Fb) * (1.f - inputSpreadMix));
-      fb2 = clipminmaxf(-1.f, fb2 * (feedbackScale * inputSpreadMix), 1.f);
-
-      const float delay1LeftMix = (0.5f + 0.5f * inputSpreadMix);
-      const float delay1RightMix = (0.5f - 0.5f * inputSpreadMix);
-      const float delay1OutputMix = 1.f - inputSpreadMix;
-      const float delay2RightMix = inputSpreadMix;
-      const float delay1In = dryL * delay1LeftMix + dryR * delay1RightMix + fb1;
-      const float delay2In = tap1 * delay1OutputMix + dryR * delay2RightMix + fb2;
-
-      mDelayLine1.write(delay1In);
-      mDelayLine2.write(delay2In);
-      
-      const float outputSpread = mOutputSpreadSmoother.Process();
-      const float outputSpreadFast = clipmaxf(outputSpread * 1.5f, 1.f);
-      const float primaryTapLevel = (0.3 + 0.45 * outputSpread);
-      const float primaryTapLevelFast = (0.3 + 0.45 * outputSpreadFast);
-      const float secondaryTapLevel = (0.3 - (outputSpread) * 0.3f);
-      const float secondaryTapLevelFast = (0.3 - (outputSpreadFast) * 0.3f);
-      
-      wetSig[0] = tap1 * primaryTapLevel;
-      wetSig[0] += tap2 * secondaryTapLevel;
-      wetSig[0] += tap3 * primaryTapLevelFast;
-      wetSig[0] += tap4 * secondaryTapLevelFast;
-      wetSig[2] = wetSig[0];
-
-      wetSig[1] = tap1 * secondaryTapLevel;
-      wetSig[1] += tap2 * primaryTapLevel;
-      wetSig[1] += tap3 * secondaryTapLevelFast;
-      wetSig[1] += tap4 * primaryTapLevelFast;
-      wetSig[3] = wetSig[1];
-
-      float32x4_t filterOut = mOutputFilters.process_so_x4(f32x4_ld(out), mOutputFilterCoeffs, 0);
-      const float lpfMix = mFilterMixSmoother.Process();
-      const float hpfMix = 1.f - lpfMix;
-      filterOut = float32x4_mul(filterOut, float32x4(lpfMix, lpfMix, hpfMix, hpfMix));
-      float32x2_t wetSigx2 = float32x2_add(float32x4_high(filterOut), float32x4_low(filterOut));
-
-      const float wet = mMixSmoother.Process();
-      const float dry = (1.f - si_fabsf(wet));
-      f32x2_str(out_p, float32x2_add(float32x2_mulscal(wetSigx2, wet), float32x2_mulscal(float32x2(dryL, dryR), dry)));
+    for (size_t done = 0; done < frames;)
+    {
+      // advance all smoothers once per chunk, the loop below reads their ramps
+      const uint32_t chunk = mSmoothers.process(frames - done);
+      const float * inputSpreadRamp = mSmoothers.ramp(kSmoothInputSpread);
+      const float * outputSpreadRamp = mSmoothers.ramp(kSmoothOutputSpread);
+      const float * primaryFeedbackRamp = mSmoothers.ramp(kSmoothPrimaryFeedback);
+      const float * secondaryFeedbackRamp = mSmoothers.ramp(kSmoothSecondaryFeedback);
+      const float * filterMixRamp = mSmoothers.ramp(kSmoothFilterMix);
+      const float * mixRamp = mSmoothers.ramp(kSmoothMix);
+      for (uint32_t f = 0; f < chunk; f++, in_p += 2, out_p += 2)
+      {
+        const float dryL = in_p[0];
+        const float dryR = in_p[1];
+
+        delayTimeZ = float32x4_add(delayTimeZ, float32x4_mulscal(float32x4_sub(delayTimeTarget, delayTimeZ), mDelayTimeSmoothingCoeff));
+        f32x4_str(mDelayTimeZ, delayTimeZ);
+        const float tap1 = mDelayLine1.readFrac(mDelayTimeZ[kTap1]);
+        const float tap2 = mDelayLine2.readFrac(mDelayTimeZ[kTap2]);
+        const float tap3 = mDelayLine1.readFrac(mDelayTimeZ[kTap3]);
+        const float tap4 = mDelayLine2.readFrac(mDelayTimeZ[kTap4]);
+
+        const float inputSpreadMix = inputSpreadRamp[f];
+        const float primaryFeedback = primaryFeedbackRamp[f];
+        const float secondaryFeedback = secondaryFeedbackRamp[f];
+        float tap1Fb = tap1 * primaryFeedback;
+        float tap2Fb = tap2 * (primaryFeedback * inputSpreadMix + secondaryFeedback * (1.f - inputSpreadMix));
+        float tap3Fb = tap3 * secondaryFeedback;
+        float tap4Fb = tap4 * secondaryFeedback;
+
+        float fb1 = (tap1Fb + tap3Fb) * inputSpreadMix;
+        fb1 = (fb1 + (tap2Fb + tap4Fb) * (1.f - inputSpreadMix));
+        fb1 = clipminmaxf(-1.f, fb1 * feedbackScale, 1.f);
+
+        float fb2 = tap2Fb + tap4Fb;
+        fb2 = (fb2 + (tap1Fb + tap3Fb) * (1.f - inputSpreadMix));
+        fb2 = clipminmaxf(-1.f, fb2 * (feedbackScale * inputSpreadMix), 1.f);
+
+        const float delay1LeftMix = (0.5f + 0.5f * inputSpreadMix);
+        const float delay1RightMix = (0.5f - 0.5f * inputSpreadMix);
+        const float delay1OutputMix = 1.f - inputSpreadMix;
+        const float delay2RightMix = inputSpreadMix;
+        const float delay1In = dryL * delay1LeftMix + dryR * delay1RightMix + fb1;
+        const float delay2In = tap1 * delay1OutputMix + dryR * delay2RightMix + fb2;
+
+        mDelayLine1.write(delay1In);
+        mDelayLine2.write(delay2In);
+
+        const float outputSpread = outputSpreadRamp[f];
+        const float outputSpreadFast = clipmaxf(outputSpread * 1.5f, 1.f);
+        const float primaryTapLevel = (0.3 + 0.45 * outputSpread);
+        const float primaryTapLevelFast = (0.3 + 0.45 * outputSpreadFast);
+        const float secondaryTapLevel = (0.3 - (outputSpread) * 0.3f);
+        const float secondaryTapLevelFast = (0.3 - (outputSpreadFast) * 0.3f);
+
+        wetSig[0] = tap1 * primaryTapLevel;
+        wetSig[0] += tap2 * secondaryTapLevel;
+        wetSig[0] += tap3 * primaryTapLevelFast;
+        wetSig[0] += tap4 * secondaryTapLevelFast;
+        wetSig[2] = wetSig[0];
+
+        wetSig[1] = tap1 * secondaryTapLevel;
+        wetSig[1] += tap2 * primaryTapLevel;
+        wetSig[1] += tap3 * secondaryTapLevelFast;
+        wetSig[1] += tap4 * primaryTapLevelFast;
+        wetSig[3] = wetSig[1];
+
+        float32x4_t filterOut = mOutputFilters.process_so_x4(f32x4_ld(out), mOutputFilterCoeffs, 0);
+        const float lpfMix = filterMixRamp[f];
+        const float hpfMix = 1.f - lpfMix;
+        filterOut = float32x4_mul(filterOut, float32x4(lpfMix, lpfMix, hpfMix, hpfMix));
+        float32x2_t wetSigx2 = float32x2_add(float32x4_high(filterOut), float32x4_low(filterOut));
+
+        const float wet = mixRamp[f];
+        const float dry = (1.f - si_fabsf(wet));
+        f32x2_str(out_p, float32x2_add(float32x2_mulscal(wetSigx2, wet), float32x2_mulscal(float32x2(dryL, dryR), dry)));
+      }
+      done += chunk;
     }
   }
 
@@ -322,9 +326,9 @@ class MultitapDelay {
   {
     const float samplerate = runtime_desc_.samplerate;
 
-    mMixSmoother.SetTarget(params_[kParamWet] * 0.01);
-    mInputSpreadSmoother.SetTarget(params_[kParamInputMix] * 0.01);
-    mOutputSpreadSmoother.SetTarget(params_[kParamSpread] * 0.01);
+    mSmoothers.setTarget(kSmoothMix, params_[kParamWet] * 0.01);
+    mSmoothers.setTarget(kSmoothInputSpread, params_[kParamInputMix] * 0.01);
+    mSmoothers.setTarget(kSmoothOutputSpread, params_[kParamSpread] * 0.01);
 
     const float timeScale = (params_[kParamTapTimeScale] * 0.01f);
     const float primaryTapScale = 0.5f + clipmaxf(timeScale, 0.5f);
@@ -337,8 +341,8 @@ class MultitapDelay {
 
     CookFilterCoeffs();
 
-    mPrimaryFeedbackSmoother.SetTarget(CalculatePrimaryFeedback(CalculateFeedback((delayTime * primaryTapScale - 1) * mDelayTimeRange)));
-    mSecondaryFeedbackSmoother.SetTarget(CalculateSecondaryFeedback(CalculateFeedback((delayTime * secondaryTapScale - 1) * mDelayTimeRange)));
+    mSmoothers.setTarget(kSmoothPrimaryFeedback, CalculatePrimaryFeedback(CalculateFeedback((delayTime * primaryTapScale - 1) * mDelayTimeRange)));
+    mSmoothers.setTarget(kSmoothSecondaryFeedback, CalculateSecondaryFeedback(CalculateFeedback((delayTime * secondaryTapScale - 1) * mDelayTimeRange)));
   }
 
   fast_inline float CalculatePrimaryFeedback(const float feedback)
@@ -356,7 +360,7 @@ class MultitapDelay {
     const float inverseSamplerate = 1.f / runtime_desc_.samplerate;
 
     // exponential smoothing
-    mFilterMixSmoother.SetTarget(params_[kParamTone] < 0);
+    mSmoothers.setTarget(kSmoothFilterMix, params_[kParamTone] < 0);
     float cutoff = params_[kParamTone] * 0.01;
     mCutoffZ += (cutoff - mCutoffZ) * 0.2;
 
@@ -398,12 +402,19 @@ class MultitapDelay {
 
   int32_t params_[kNumParams];
 
-  dsp::LinearSmoother mMixSmoother;
-  dsp::LinearSmoother mInputSpreadSmoother;
-  dsp::LinearSmoother mOutputSpreadSmoother;
-  dsp::LinearSmoother mPrimaryFeedbackSmoother;
-  dsp::LinearSmoother mSecondaryFeedbackSmoother;
-  dsp::LinearSmoother mFilterMixSmoother;
+  enum
+  {
+    kSmoothMix,
+    kSmoothInputSpread,
+    kSmoothOutputSpread,
+    kSmoothPrimaryFeedback,
+    kSmoothSecondaryFeedback,
+    kSmoothFilterMix,
+    kNumSmoothers
+  };
+
+  // linear over 64 samples, as the LinearSmoother default interval
+  dsp::SmootherBank<kNumSmoothers> mSmoothers;
 
   float mCutoffZ;
   float mDelayTimeRange;
@@ -12,6 +12,7 @@
 #include "osc_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
+#include "dsp/noisegen.hpp"
 
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
 #ifndef PI
@@ -478,18 +479,11 @@ static float s_accent_amount = 0.7f;    // 🎁 SURPRISE!
 static DistType s_dist_flavor = DIST_SOFT;  // 🎁 SURPRISE!
 static bool s_lfo_enabled = true;       // 🎁 SURPRISE!
 
-// XORShift random
-static uint32_t s_random_seed = 12345;
-
-inline uint32_t xorshift32() {
-    s_random_seed ^= s_random_seed << 13;
-    s_random_seed ^= s_random_seed >> 17;
-    s_random_seed ^= s_random_seed << 5;
-    return s_random_seed;
-}
+// Random source
+static dsp::NoiseGen s_noise_gen;
 
 inline float random_float() {
-    return (float)(xorshift32() % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // Simple tan approximation for filter (when osc_tanf not available)
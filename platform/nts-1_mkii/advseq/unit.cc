@@ -22,6 +22,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "fx_api.h"
+#include "dsp/noisegen.hpp"
 #include <algorithm>
 
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
@@ -56,21 +57,18 @@ static float s_target_value = 0.5f;      // Target step value
 static uint32_t s_tempo_bpm = 120;
 static float s_prev_level = 0.f;        // For MIDI trigger detection
 
-// Random seed
-static uint32_t s_random_seed = 12345;
+// Random source
+static dsp::NoiseGen s_noise_gen;
 
 // ========== HELPER FUNCTIONS ==========
 
-// XORShift random generator
+// Raw 32 random bits
 inline uint32_t xorshift32() {
-    s_random_seed ^= s_random_seed << 13;
-    s_random_seed ^= s_random_seed >> 17;
-    s_random_seed ^= s_random_seed << 5;
-    return s_random_seed;
+    return s_noise_gen.next();
 }
 
 inline float random_float() {
-    return (float)(xorshift32() % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ========== SEQUENCE OPERATIONS ==========
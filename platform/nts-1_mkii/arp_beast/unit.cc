@@ -8,6 +8,7 @@
 #include "fx_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
+#include "dsp/noisegen.hpp"
 
 // ========== ARP PATTERNS ==========
 
@@ -111,16 +112,13 @@ static uint8_t s_tempo_mult = 3;     // 1×
 static float s_randomize = 0.0f;      // 0%
 static float s_mix = 1.0f;            // 100%
 
-// Random seed
-static uint32_t s_random_seed = 12345;
+// Random source
+static dsp::NoiseGen s_noise_gen;
 
 // ========== RANDOM GENERATOR ==========
 
 inline float random_float() {
-    s_random_seed ^= s_random_seed << 13;
-    s_random_seed ^= s_random_seed >> 17;
-    s_random_seed ^= s_random_seed << 5;
-    return (float)(s_random_seed % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ========== PATTERN GENERATORS ==========
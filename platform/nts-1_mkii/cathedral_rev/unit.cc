@@ -23,12 +23,15 @@
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
 #include "macros.h"
+#include "dsp/controlrate.hpp"
+#include "dsp/multitapdelay.hpp"
 #include <algorithm>
 
 #define NUM_COMBS 4
 #define NUM_ALLPASS 8
 #define NUM_EARLY_TAPS 8
 #define PREDELAY_SIZE 24000  // 500ms @ 48kHz
+#define PREDELAY_LINE_SIZE 32768  // next power of two
 #define REVERSE_SIZE 96000   // 2 seconds @ 48kHz
 
 // Comb filter delays (prime numbers for density)
@@ -49,16 +52,13 @@ static const uint32_t s_early_taps[NUM_EARLY_TAPS] = {
 struct CombFilter {
     uint32_t write_pos;
     uint32_t delay_length;
-    float feedback;
     float damp_z;
-    float damp_coeff;
     float *buffer;
 };
 
 struct AllpassFilter {
     uint32_t write_pos;
     uint32_t delay_length;
-    float feedback;
     float *buffer;
 };
 
@@ -67,11 +67,11 @@ static CombFilter s_combs_r[NUM_COMBS];
 static AllpassFilter s_allpass_l[NUM_ALLPASS];
 static AllpassFilter s_allpass_r[NUM_ALLPASS];
 
-static float *s_predelay_buffer;
+// Pre-delay line, its taps are the early reflections
+static dsp::MultiTapDelay<NUM_EARLY_TAPS> s_predelay;
 static float *s_reverse_buffer_l;
 static float *s_reverse_buffer_r;
 
-static uint32_t s_predelay_write;
 static uint32_t s_reverse_write;
 static uint32_t s_reverse_read;
 static bool s_reverse_recording;
@@ -91,25 +91,30 @@ static uint8_t s_mode;
 
 static uint32_t s_sample_counter;
 
-inline float allpass_process(AllpassFilter *ap, float input) {
+// Parameter derived values, updated once per unit_render and ramped over the buffer
+static dsp::ControlRamp s_comb_feedback;
+static dsp::ControlRamp s_comb_damp;
+static dsp::ControlRamp s_allpass_feedback;
+
+inline float allpass_process(AllpassFilter *ap, float input, float feedback) {
     uint32_t read_pos = (ap->write_pos + 1) % ap->delay_length;
     float delayed = ap->buffer[read_pos];
     
     float output = -input + delayed;
-    ap->buffer[ap->write_pos] = input + delayed * ap->feedback;
+    ap->buffer[ap->write_pos] = input + delayed * feedback;
     
     ap->write_pos = (ap->write_pos + 1) % ap->delay_length;
     return output;
 }
 
-inline float comb_process(CombFilter *cf, float input) {
+inline float comb_process(CombFilter *cf, float input, float feedback, float damp_coeff) {
     uint32_t read_pos = (cf->write_pos + 1) % cf->delay_length;
     float delayed = cf->buffer[read_pos];
     
-    cf->damp_z = delayed * (1.f - cf->damp_coeff) + cf->damp_z * cf->damp_coeff;
+    cf->damp_z = delayed * (1.f - damp_coeff) + cf->damp_z * damp_coeff;
     cf->damp_z = clipminmaxf(-2.0f, cf->damp_z, 2.0f);  // Anti-fluittoon fix!
     
-    cf->buffer[cf->write_pos] = input + cf->damp_z * cf->feedback;
+    cf->buffer[cf->write_pos] = input + cf->damp_z * feedback;
     cf->write_pos = (cf->write_pos + 1) % cf->delay_length;
     
     return delayed;
@@ -120,8 +125,7 @@ inline float process_early_reflections(float input, float level) {
     
     float output = 0.f;
     for (int i = 0; i < NUM_EARLY_TAPS; i++) {
-        uint32_t tap_pos = (s_predelay_write + PREDELAY_SIZE - s_early_taps[i]) % PREDELAY_SIZE;
-        float tap = s_predelay_buffer[tap_pos];
+        float tap = s_predelay.tap(i);
         float decay = 1.f - ((float)i / (float)NUM_EARLY_TAPS) * 0.6f;
         output += tap * decay;
     }
@@ -184,7 +188,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     max_allpass_size = (uint32_t)((float)max_allpass_size * 2.5f);
     
     uint32_t total_size = (NUM_COMBS * max_comb_size + NUM_ALLPASS * max_allpass_size) * sizeof(float) * 2; // L+R
-    total_size += PREDELAY_SIZE * sizeof(float);
+    total_size += PREDELAY_LINE_SIZE * sizeof(float);
     total_size += REVERSE_SIZE * sizeof(float) * 2; // L+R
     
     uint8_t *buffer_base = static_cast<uint8_t *>(desc->hooks.sdram_alloc(total_size));
@@ -201,8 +205,8 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     offset += (NUM_COMBS * max_comb_size + NUM_ALLPASS * max_allpass_size) * sizeof(float);
     
     // Pre-delay buffer
-    s_predelay_buffer = reinterpret_cast<float *>(buffer_base + offset);
-    offset += PREDELAY_SIZE * sizeof(float);
+    s_predelay.setMemory(reinterpret_cast<float *>(buffer_base + offset), PREDELAY_LINE_SIZE);
+    offset += PREDELAY_LINE_SIZE * sizeof(float);
     
     // Reverse buffers
     s_reverse_buffer_l = reinterpret_cast<float *>(buffer_base + offset);
@@ -214,7 +218,9 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     // Clear all buffers
     buf_clr_f32(reverb_buf_l, NUM_COMBS * max_comb_size + NUM_ALLPASS * max_allpass_size);
     buf_clr_f32(reverb_buf_r, NUM_COMBS * max_comb_size + NUM_ALLPASS * max_allpass_size);
-    buf_clr_f32(s_predelay_buffer, PREDELAY_SIZE);
+    s_predelay.clear();
+    for (int i = 0; i < NUM_EARLY_TAPS; i++)
+        s_predelay.setTap(i, (float)s_early_taps[i]);
     buf_clr_f32(s_reverse_buffer_l, REVERSE_SIZE);
     buf_clr_f32(s_reverse_buffer_r, REVERSE_SIZE);
     
@@ -223,16 +229,12 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     for (int i = 0; i < NUM_COMBS; i++) {
         s_combs_l[i].write_pos = 0;
         s_combs_l[i].delay_length = s_comb_delays[i];
-        s_combs_l[i].feedback = 0.84f;
         s_combs_l[i].damp_z = 0.f;
-        s_combs_l[i].damp_coeff = 0.2f;
         s_combs_l[i].buffer = reverb_buf_l + comb_offset;
         
         s_combs_r[i].write_pos = 0;
         s_combs_r[i].delay_length = s_comb_delays[i] + 23;
-        s_combs_r[i].feedback = 0.84f;
         s_combs_r[i].damp_z = 0.f;
-        s_combs_r[i].damp_coeff = 0.2f;
         s_combs_r[i].buffer = reverb_buf_r + comb_offset;
         
         comb_offset += max_comb_size;
@@ -243,18 +245,15 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     for (int i = 0; i < NUM_ALLPASS; i++) {
         s_allpass_l[i].write_pos = 0;
         s_allpass_l[i].delay_length = s_allpass_delays[i];
-        s_allpass_l[i].feedback = 0.5f;
         s_allpass_l[i].buffer = reverb_buf_l + allpass_offset;
         
         s_allpass_r[i].write_pos = 0;
         s_allpass_r[i].delay_length = s_allpass_delays[i] + 17;
-        s_allpass_r[i].feedback = 0.5f;
         s_allpass_r[i].buffer = reverb_buf_r + allpass_offset;
         
         allpass_offset += max_allpass_size;
     }
     
-    s_predelay_write = 0;
     s_reverse_write = 0;
     s_reverse_read = 0;
     s_reverse_recording = true;
@@ -274,6 +273,10 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     
     s_sample_counter = 0;
 
+    s_comb_feedback.reset(0.84f);
+    s_comb_damp.reset(0.2f);
+    s_allpass_feedback.reset(0.5f);
+
     return k_unit_err_none;
 }
 
@@ -291,7 +294,7 @@ __unit_callback void unit_reset()
         s_allpass_l[i].write_pos = 0;
         s_allpass_r[i].write_pos = 0;
     }
-    s_predelay_write = 0;
+    s_predelay.clear();
     s_reverse_write = 0;
     s_reverse_read = 0;
 }
@@ -301,35 +304,37 @@ __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
 {
+    // Parameters only change between render calls, derive the comb and allpass
+    // settings once here instead of for every filter on every sample
+    const float size_scale = 0.7f + s_size * 0.6f;
+    for (int i = 0; i < NUM_COMBS; i++) {
+        s_combs_l[i].delay_length = (uint32_t)((float)s_comb_delays[i] * size_scale);
+        s_combs_r[i].delay_length = (uint32_t)((float)(s_comb_delays[i] + 23) * size_scale);
+    }
+    
+    const float fb = clipminmaxf(0.1f, 0.65f + s_time * 0.20f, 0.85f);
+    const float adaptive_damp = clipminmaxf(0.3f, s_damping + fb * 0.15f, 0.85f);
+    const float ramp_recip = 1.f / (float)frames;
+    // A zero pre-delay read the oldest sample of the old 500ms ring buffer, keep that
+    const uint32_t predelay_samps = (uint32_t)(s_predelay_time * (float)PREDELAY_SIZE);
+    const uint32_t predelay_pos = predelay_samps ? predelay_samps : PREDELAY_SIZE;
+    s_comb_feedback.set(fb, ramp_recip);
+    s_comb_damp.set(adaptive_damp, ramp_recip);
+    s_allpass_feedback.set(0.3f + s_diffusion * 0.4f, ramp_recip);
+    
     for (uint32_t f = 0; f < frames; f++) {
         float in_l = in[f * 2];
         float in_r = in[f * 2 + 1];
         
-        float predelay_time_samps = s_predelay_time * (float)PREDELAY_SIZE;
-        uint32_t predelay_read = (s_predelay_write + PREDELAY_SIZE - (uint32_t)predelay_time_samps) % PREDELAY_SIZE;
-        
-        float predelayed = (s_predelay_buffer[predelay_read] + (in_l + in_r) * 0.5f) * 0.5f;
-        s_predelay_buffer[s_predelay_write] = (in_l + in_r) * 0.5f;
-        s_predelay_write = (s_predelay_write + 1) % PREDELAY_SIZE;
+        float predelayed = (s_predelay.read(predelay_pos) + (in_l + in_r) * 0.5f) * 0.5f;
+        s_predelay.write((in_l + in_r) * 0.5f);
         
         float early_l = process_early_reflections(predelayed, s_early_level);
         float early_r = process_early_reflections(predelayed, s_early_level);
         
-        float size_scale = 0.7f + s_size * 0.6f;
-        for (int i = 0; i < NUM_COMBS; i++) {
-            s_combs_l[i].delay_length = (uint32_t)((float)s_comb_delays[i] * size_scale);
-            s_combs_r[i].delay_length = (uint32_t)((float)(s_comb_delays[i] + 23) * size_scale);
-            
-            float fb = 0.65f + s_time * 0.20f;
-            fb = clipminmaxf(0.1f, fb, 0.85f);
-            s_combs_l[i].feedback = fb;
-            s_combs_r[i].feedback = fb;
-            
-            float adaptive_damp = s_damping + fb * 0.15f;
-            adaptive_damp = clipminmaxf(0.3f, adaptive_damp, 0.85f);
-            s_combs_l[i].damp_coeff = adaptive_damp;
-            s_combs_r[i].damp_coeff = adaptive_damp;
-        }
+        const float comb_fb = s_comb_feedback.process();
+        const float comb_damp = s_comb_damp.process();
+        const float ap_fb = s_allpass_feedback.process();
         
         float comb_input = predelayed;
         
@@ -337,18 +342,15 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         float comb_out_r = 0.f;
         
         for (int i = 0; i < NUM_COMBS; i++) {
-            comb_out_l += comb_process(&s_combs_l[i], comb_input);
-            comb_out_r += comb_process(&s_combs_r[i], comb_input);
+            comb_out_l += comb_process(&s_combs_l[i], comb_input, comb_fb, comb_damp);
+            comb_out_r += comb_process(&s_combs_r[i], comb_input, comb_fb, comb_damp);
         }
         comb_out_l /= (float)NUM_COMBS;
         comb_out_r /= (float)NUM_COMBS;
         
         for (int i = 0; i < NUM_ALLPASS; i++) {
-            s_allpass_l[i].feedback = 0.3f + s_diffusion * 0.4f;
-            s_allpass_r[i].feedback = 0.3f + s_diffusion * 0.4f;
-            
-            comb_out_l = allpass_process(&s_allpass_l[i], comb_out_l);
-            comb_out_r = allpass_process(&s_allpass_r[i], comb_out_r);
+            comb_out_l = allpass_process(&s_allpass_l[i], comb_out_l, ap_fb);
+            comb_out_r = allpass_process(&s_allpass_r[i], comb_out_r, ap_fb);
         }
         
         float depth_curve = s_depth * s_depth;  // Quadratische curve voor subtielere controle
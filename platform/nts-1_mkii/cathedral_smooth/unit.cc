@@ -23,6 +23,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
+#include "utils/fp_guard.h"
 #include "macros.h"
 #include <algorithm>
 
@@ -97,19 +98,10 @@ inline float soft_clip(float x) {
     return x * (27.f + x2) / (27.f + 9.f * x2);
 }
 
-// Denormal prevention
-inline float undenormalize(float x) {
-    if (si_fabsf(x) < 1e-15f) return 0.f;
-    return x;
-}
-
 inline float allpass_process(AllpassFilter *ap, float input) {
     uint32_t read_pos = (ap->write_pos + 1) % ap->delay_length;
     float delayed = ap->buffer[read_pos];
     
-    // Denormal prevention
-    delayed = undenormalize(delayed);
-    
     float output = -input + delayed;
     
     // Soft clip feedback
@@ -128,13 +120,9 @@ inline float comb_process(CombFilter *cf, float input) {
     uint32_t read_pos = (cf->write_pos + 1) % cf->delay_length;
     float delayed = cf->buffer[read_pos];
     
-    // Denormal prevention
-    delayed = undenormalize(delayed);
-    
     // Damping (one-pole lowpass)
     cf->damp_z = delayed * (1.f - cf->damp_coeff) + cf->damp_z * cf->damp_coeff;
     cf->damp_z = clipminmaxf(-2.0f, cf->damp_z, 2.0f);  // Anti-fluittoon fix!
-    cf->damp_z = undenormalize(cf->damp_z);
     
     // Soft clip damped signal
     float damped = soft_clip(cf->damp_z);
@@ -329,6 +317,16 @@ __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
 {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+
+    // Sanitize the comb damping state once per block
+    for (int i = 0; i < NUM_COMBS; i++) {
+        FP_GUARD_WATCH("comb.damp_z", s_combs_l[i].damp_z);
+        FP_GUARD_WATCH("comb.damp_z", s_combs_r[i].damp_z);
+        fp_sanitize_block(&s_combs_l[i].damp_z, 1);
+        fp_sanitize_block(&s_combs_r[i].damp_z, 1);
+    }
+
     for (uint32_t f = 0; f < frames; f++) {
         float in_l = in[f * 2];
         float in_r = in[f * 2 + 1];
@@ -10,6 +10,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "macros.h"
+#include "dsp/approx.hpp"
 
 #define MAX_VOICES 2
 #define CHORUS_BUFFER_SIZE 2048
@@ -93,15 +94,6 @@ inline float poly_blep(float t, float dt) {
     return 0.f;
 }
 
-// ========== FAST TANH ==========
-
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // ========== ENVELOPE PROCESSOR ==========
 
 inline float process_envelope(Voice* v) {
@@ -406,7 +398,7 @@ inline float generate_oscillator() {
     sum = process_chorus(sum, 0);
     
     // Soft clipping
-    sum = fast_tanh(sum * 1.2f);
+    sum = dsp::approx::tanh<dsp::approx::k_faster>(sum * 1.2f);
     
     return sum;
 }
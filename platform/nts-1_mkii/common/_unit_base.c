@@ -38,10 +38,19 @@
  *
  */
 
+#if defined(UNIT_PROFILE) && !defined(__arm__)
+#define _POSIX_C_SOURCE 199309L  // clock_gettime()
+#include <time.h>
+#endif
+
 #include <stddef.h>
 
 #include "unit.h"
 
+#ifdef FP_GUARD_DIAG
+#include "utils/fp_guard.h"
+#endif
+
 // ---- Fallback unit header definition  -----------------------------------------------------------
 
 // Fallback unit header, note that this content is invalid, must be overriden
@@ -115,3 +124,191 @@ __attribute__((weak)) void unit_aftertouch(uint8_t note, uint8_t mod) {
   (void)note;
   (void)mod;
 }
+
+#ifdef UNIT_PROFILE
+
+// ---- Callback profiler --------------------------------------------------------------------------
+
+#undef unit_render
+#undef unit_set_param_value
+#undef unit_note_on
+
+#if defined(__arm__)
+
+#define DWT_CTRL (*(volatile uint32_t *)0xE0001000U)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004U)
+#define DWT_LAR (*(volatile uint32_t *)0xE0001FB0U)
+#define DEMCR (*(volatile uint32_t *)0xE000EDFCU)
+
+static uint8_t s_profile_counter = 0;
+
+static uint32_t profile_privileged(void) {
+  uint32_t ipsr, control;
+  __asm__ volatile ("mrs %0, ipsr" : "=r" (ipsr));
+  __asm__ volatile ("mrs %0, control" : "=r" (control));
+  return ipsr || !(control & 0x1U);  // Handler mode, or thread mode with nPRIV clear
+}
+
+static void profile_counter_enable(void) {
+  // Unprivileged accesses to the DWT and DEMCR raise a BusFault, leave them alone
+  if (!profile_privileged())
+    return;
+  s_profile_counter = 1;
+  if (DWT_CTRL & 0x1U)
+    return;  // Already running
+  DEMCR |= (1U << 24);     // TRCENA
+  DWT_LAR = 0xC5ACCE55U;   // Unlock DWT on Cortex-M7
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= 0x1U;        // CYCCNTENA
+}
+
+uint32_t unit_profile_cycles(void) { return (s_profile_counter) ? DWT_CYCCNT : 0; }
+
+#else
+
+static void profile_counter_enable(void) {}
+
+uint32_t unit_profile_cycles(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000000U + (uint32_t)ts.tv_nsec;
+}
+
+#endif  // defined(__arm__)
+
+static unit_profile_stats_t s_profile_stats[k_num_unit_profile_callbacks];
+static uint8_t s_profile_enabled = 0;
+
+static inline __attribute__((always_inline)) uint32_t profile_start(void) {
+  if (!s_profile_enabled) {
+    profile_counter_enable();
+    s_profile_enabled = 1;
+  }
+  return unit_profile_cycles();
+}
+
+static inline __attribute__((always_inline)) void profile_record(uint8_t callback, uint32_t cycles, uint32_t frames) {
+  unit_profile_stats_t * const stats = &s_profile_stats[callback];
+  const uint32_t per_frame = (frames) ? cycles / frames : cycles;
+  const uint32_t log2 = (per_frame) ? 31U - (uint32_t)__builtin_clz(per_frame) : 0U;
+  const uint32_t bucket = (log2 < UNIT_PROFILE_NUM_BUCKETS) ? log2 : UNIT_PROFILE_NUM_BUCKETS - 1;
+
+  if (stats->calls == 0 || per_frame < stats->min)
+    stats->min = per_frame;
+  if (per_frame > stats->max)
+    stats->max = per_frame;
+  stats->last = per_frame;
+  stats->cycles += cycles;
+  stats->frames += (frames) ? frames : 1;
+  stats->histogram[bucket]++;
+  stats->calls++;
+}
+
+const unit_profile_stats_t * unit_profile_get_stats(uint8_t callback) {
+  return (callback < k_num_unit_profile_callbacks) ? &s_profile_stats[callback] : NULL;
+}
+
+void unit_profile_reset(void) {
+  uint8_t * p = (uint8_t *)s_profile_stats;
+  for (size_t i = 0; i < sizeof(s_profile_stats); ++i)
+    p[i] = 0;
+}
+
+static char * profile_format_uint(char * p, char * end, uint32_t value) {
+  char digits[10];
+  uint32_t n = 0;
+  do {
+    digits[n++] = '0' + (value % 10);
+    value /= 10;
+  } while (value);
+  while (n && p < end)
+    *p++ = digits[--n];
+  return p;
+}
+
+static char * profile_format_short(char * p, char * end, uint32_t value) {
+  if (value >= 10000U) {
+    p = profile_format_uint(p, end, value / 1000U);
+    if (p < end)
+      *p++ = 'k';
+    return p;
+  }
+  return profile_format_uint(p, end, value);
+}
+
+const char * unit_profile_str(uint8_t callback, char * buf, size_t size) {
+  const unit_profile_stats_t * stats = unit_profile_get_stats(callback);
+  if (!buf || !size)
+    return buf;
+  char * p = buf;
+  char * const end = buf + size - 1;
+  if (stats) {
+    p = profile_format_short(p, end, unit_profile_mean(stats));
+    if (p < end)
+      *p++ = '/';
+    p = profile_format_short(p, end, stats->max);
+  }
+  *p = 0;
+  return buf;
+}
+
+void unit_profiled_render(const float * in, float * out, uint32_t frames);
+void unit_profiled_set_param_value(uint8_t id, int32_t value);
+void unit_profiled_note_on(uint8_t note, uint8_t velocity);
+
+__unit_callback void unit_render(const float * in, float * out, uint32_t frames) {
+  const uint32_t start = profile_start();
+  unit_profiled_render(in, out, frames);
+  profile_record(k_unit_profile_render, unit_profile_cycles() - start, frames);
+}
+
+__unit_callback void unit_set_param_value(uint8_t id, int32_t value) {
+  const uint32_t start = profile_start();
+  unit_profiled_set_param_value(id, value);
+  profile_record(k_unit_profile_set_param, unit_profile_cycles() - start, 1);
+}
+
+__unit_callback void unit_note_on(uint8_t note, uint8_t velocity) {
+  const uint32_t start = profile_start();
+  unit_profiled_note_on(note, velocity);
+  profile_record(k_unit_profile_note_on, unit_profile_cycles() - start, 1);
+}
+
+#endif  // UNIT_PROFILE
+
+#ifdef FP_GUARD_DIAG
+
+// ---- Denormal/NaN diagnostics -------------------------------------------------------------------
+
+static fp_guard_diag_entry_t s_fp_diag[FP_GUARD_DIAG_MAX_ENTRIES];
+static uint32_t s_fp_diag_count = 0;
+
+void fp_guard_diag_record(const char * name, float x) {
+  fp_guard_diag_entry_t * e = NULL;
+  // Names are string literals and compared by address
+  for (uint32_t i = s_fp_diag_count; i > 0; --i) {
+    if (s_fp_diag[i - 1].name == name) {
+      e = &s_fp_diag[i - 1];
+      break;
+    }
+  }
+  if (!e) {
+    if (s_fp_diag_count >= FP_GUARD_DIAG_MAX_ENTRIES)
+      return;
+    e = &s_fp_diag[s_fp_diag_count++];
+    e->name = name;
+  }
+  e->checks++;
+  if (fp_is_denormal(x))
+    e->denormals++;
+  else if (!fp_is_finite(x))
+    e->nonfinite++;
+}
+
+const fp_guard_diag_entry_t * fp_guard_diag_entries(uint32_t * count) {
+  if (count)
+    *count = s_fp_diag_count;
+  return s_fp_diag;
+}
+
+#endif  // FP_GUARD_DIAG
@@ -0,0 +1,264 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+
+/**
+ * @file    approx.hpp
+ * @brief   Fast approximations of tanh, exp2, log2, sin, cos, pow and sigmoid in three accuracy tiers.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Branch free approximations, each in three tiers and in scalar and block form:
+   *
+   *   y = approx::tanh<approx::k_fast>(x);
+   *   approx::tanh<approx::k_faster>(buf, buf, frames);   // in place is fine
+   *
+   * The block forms are plain loops over the scalar ones, which compilers
+   * vectorize for NEON, SSE and wasm, and keep tight on the Cortex-M7. Pick
+   * the cheapest tier whose error is below what the signal path can hear.
+   * Max errors, measured on the host with hostsim approx against double libm:
+   *
+   *   function   domain                       k_precise  k_fast   k_faster
+   *   exp2       [-20, 20]               rel  1.8e-7     1.0e-4   2.7e-3
+   *   log2       [1e-6, 1e6]             abs  1.1e-6     1.1e-4   6.1e-3
+   *   sin        [-pi, pi]               abs  2.3e-7     6.8e-5   4.5e-3
+   *   cos        [-pi, pi]               abs  3.5e-7     6.8e-5   4.5e-3
+   *   tanh       [-8, 8]                 abs  3.7e-7     5.2e-5   2.4e-2
+   *   sigmoid    [-16, 16]               abs  1.9e-7     2.6e-5   6.7e-4
+   *   pow        [0.01, 100]^[-3, 3]     rel  1.5e-6     3.3e-4   1.5e-2
+   *
+   * exp2 is continuous across octaves in every tier. log2 and pow expect
+   * x > 0 and normal, exp2 saturates beyond +-126. sin and cos reduce any
+   * argument below 2^31 turns, so the error grows with |x| as float loses
+   * resolution of the phase. The k_faster tanh is the clamped Pade form
+   * x (27 + x^2) / (27 + 9 x^2) that units used to carry, it reaches 1 at +-3
+   * and saturates beyond.
+   */
+  namespace approx {
+
+    /** Accuracy tier, see the table above */
+    enum Tier {
+      k_precise = 0,
+      k_fast,
+      k_faster
+    };
+
+    /*===========================================================================*/
+    /* Scalar Functions.                                                         */
+    /*===========================================================================*/
+
+    /** Branch free floor for |x| < 2^31 */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float floor_approx(const float x) {
+      const float t = (float)(int32_t)x;
+      return t - ((t > x) ? 1.f : 0.f);
+    }
+
+    /** 2^x */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float exp2(float x) {
+      x = clipminmaxf(-126.f, x, 126.f);
+      const float fl = floor_approx(x);
+      const float f = x - fl;
+      // Polynomials pinned to 1 and 2 at the ends of the octave
+      float p;
+      if (T == k_precise)
+        p = 1.f + f * (0.69315174f + f * (0.24015927f + f * (0.055818676f + f * (0.0089909951f + f * 0.0018793187f))));
+      else if (T == k_fast)
+        p = 1.f + f * (0.69542435f + f * (0.22630768f + f * 0.078267970f));
+      else
+        p = 1.f + f * (0.66023397f + f * 0.33976603f);
+      f32_t s;
+      s.i = (uint32_t)((int32_t)fl + 127) << 23;
+      return s.f * p;
+    }
+
+    /** log2(x), x > 0 */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float log2(const float x) {
+      f32_t v;
+      v.f = x;
+      // Exponent that puts the mantissa in [2/3, 4/3)
+      const int32_t e = (int32_t)(v.i - 0x3F2AAAABU) >> 23;
+      v.i -= (uint32_t)e << 23;
+      const float t = v.f - 1.f;
+      float p;
+      if (T == k_precise)
+        p = 1.4426937f + t * (-0.72134738f + t * (0.48105117f + t * (-0.36071916f + t * (0.28398877f
+              + t * (-0.23820066f + t * (0.25527655f + t * -0.21431760f))))));
+      else if (T == k_fast)
+        p = 1.4411653f + t * (-0.72109369f + t * (0.52906851f + t * -0.38463077f));
+      else
+        p = 1.4921425f + t * -0.73369196f;
+      return (float)e + t * p;
+    }
+
+    /** sin(2 pi q), q in cycles */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float sin_cycles(float q) {
+      q -= floor_approx(q + 0.5f);
+      // Fold [-0.5, 0.5] cycles onto [-0.25, 0.25], sin is symmetric around 0.25
+      const float a = ((q < 0.f) ? -0.5f : 0.5f) - q;
+      q = (si_fabsf(q) > 0.25f) ? a : q;
+      const float q2 = q * q;
+      if (T == k_precise)
+        return q * (6.2831853f + q2 * (-41.341692f + q2 * (81.603266f + q2 * (-76.598208f + q2 * 39.873232f))));
+      else if (T == k_fast)
+        return q * (6.2812801f + q2 * (-41.095243f + q2 * 73.585515f));
+      else
+        return q * (6.1922648f + q2 * -35.363707f);
+    }
+
+    /** sin(x), x in radians */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float sin(const float x) {
+      return sin_cycles<T>(x * 0.15915494f);
+    }
+
+    /** cos(x), x in radians */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float cos(const float x) {
+      return sin_cycles<T>(x * 0.15915494f + 0.25f);
+    }
+
+    /** tanh(x) */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float tanh(float x) {
+      if (T == k_faster) {
+        x = clipminmaxf(-3.f, x, 3.f);
+        const float x2 = x * x;
+        return x * (27.f + x2) / (27.f + 9.f * x2);
+      }
+      // 1 - 2 / (e^2x + 1), 2 / ln(2) scales to exp2
+      const float e = exp2<T>(clipminmaxf(-9.f, x, 9.f) * 2.8853901f);
+      return 1.f - 2.f / (e + 1.f);
+    }
+
+    /** 1 / (1 + e^-x) */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float sigmoid(const float x) {
+      return 1.f / (1.f + exp2<T>(x * -1.4426950f));
+    }
+
+    /** x^p, x > 0 */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float pow(const float x, const float p) {
+      return exp2<T>(p * log2<T>(x));
+    }
+
+    /*===========================================================================*/
+    /* Block Functions.                                                          */
+    /*===========================================================================*/
+
+    // Not always_inline: inlined into a caller built at -O2 the loops would take
+    // the caller's vectorizer cost model, which does not version for aliasing.
+
+    /** out[i] = 2^in[i], in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void exp2(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = exp2<T>(in[i]);
+    }
+
+    /** out[i] = log2(in[i]), in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void log2(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = log2<T>(in[i]);
+    }
+
+    /** out[i] = sin(in[i]), in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void sin(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = sin<T>(in[i]);
+    }
+
+    /** out[i] = cos(in[i]), in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void cos(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = cos<T>(in[i]);
+    }
+
+    /** out[i] = tanh(in[i]), in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void tanh(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = tanh<T>(in[i]);
+    }
+
+    /** out[i] = sigmoid(in[i]), in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void sigmoid(const float * in, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = sigmoid<T>(in[i]);
+    }
+
+    /** out[i] = in[i]^p, in place allowed */
+    template <Tier T>
+    static inline __attribute__((optimize("Ofast")))
+    void pow(const float * in, const float p, float * out, const uint32_t frames) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = pow<T>(in[i], p);
+    }
+  }
+}
+
+/** @} */
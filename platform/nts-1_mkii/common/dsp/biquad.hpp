@@ -427,9 +427,9 @@ namespace dsp {
      * Default constructor.
      */
     ExtBiQuad(void) :
-      mZ1(0), mZ2(0),
       mD0(0), mD1(0),
-      mW0(0), mW1(0)
+      mW0(0), mW1(0),
+      mZ1(0), mZ2(0)
     { }
       
     /*=====================================================================*/
@@ -0,0 +1,179 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "dsp/biquad.hpp"
+#include "dsp/kernels.hpp"
+
+/**
+ * @file    biquadcascade.hpp
+ * @brief   Block Bi-Quad cascade with coefficients ramped across the block.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Cascade of transposed form 2 Bi-Quads for modulated filters. New
+   * coefficients are targets: the next process() call moves every stage
+   * linearly from its current coefficients to them across the block, so a
+   * modulated filter computes its coefficients once per block without
+   * zipper noise. Blocks without a change go through BiQuadCascadeDF2T,
+   * that is CMSIS-DSP when DSP_USE_CMSIS is defined.
+   *
+   * The a1, a2 stability region is a triangle, hence convex, so a ramp
+   * between two stable stages only passes through stable stages.
+   */
+  template <uint8_t Stages>
+  struct BiQuadCascade {
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    /**
+     * Default constructor, all stages mute.
+     */
+    BiQuadCascade(void) :
+      target(), mDirty(false)
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      mKernel.flush();
+    }
+
+    /**
+     * Set the target coefficients of one stage.
+     *
+     * @param stage Stage index
+     * @param c     Coefficients, as computed by BiQuad::Coeffs
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setStage(uint32_t stage, const BiQuad::Coeffs & c) {
+      setStage(stage, c.ff0, c.ff1, c.ff2, c.fb1, c.fb2);
+    }
+
+    /**
+     * Set the target coefficients of one stage, H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setStage(uint32_t stage, float b0, float b1, float b2, float a1, float a2) {
+      float * t = &target[5 * stage];
+      mDirty |= (t[0] != b0) | (t[1] != b1) | (t[2] != b2) | (t[3] != -a1) | (t[4] != -a2);
+      t[0] = b0;
+      t[1] = b1;
+      t[2] = b2;
+      t[3] = -a1;
+      t[4] = -a2;
+    }
+
+    /**
+     * Jump to the target coefficients without a ramp, e.g. on note on.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void snap(void) {
+      memcpy(mKernel.coeffs, target, sizeof(target));
+      mDirty = false;
+    }
+
+    /**
+     * Process a block through all stages, in and out may be the same buffer.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, uint32_t frames) {
+      if (!mDirty || frames == 0) {
+        mKernel.process(in, out, frames);
+        return;
+      }
+      const float r = 1.f / frames;
+      const float * src = in;
+      for (uint32_t st = 0; st < Stages; ++st) {
+        const float * c = &mKernel.coeffs[5 * st];
+        const float * t = &target[5 * st];
+        float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        const float db0 = (t[0] - b0) * r, db1 = (t[1] - b1) * r, db2 = (t[2] - b2) * r;
+        const float da1 = (t[3] - a1) * r, da2 = (t[4] - a2) * r;
+        float d1 = mKernel.state[2 * st];
+        float d2 = mKernel.state[2 * st + 1];
+        for (uint32_t i = 0; i < frames; ++i) {
+          b0 += db0;
+          b1 += db1;
+          b2 += db2;
+          a1 += da1;
+          a2 += da2;
+          const float x = src[i];
+          const float y = b0 * x + d1;
+          d1 = b1 * x + a1 * y + d2;
+          d2 = b2 * x + a2 * y;
+          out[i] = y;
+        }
+        mKernel.state[2 * st] = d1;
+        mKernel.state[2 * st + 1] = d2;
+        src = out;
+      }
+      snap();
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+    /** Current coefficients and state */
+    BiQuadCascadeDF2T<Stages> mKernel;
+    /** Target coefficients, CMSIS layout */
+    float target[5 * Stages];
+
+  private:
+
+    bool mDirty;
+  };
+
+}
+
+/** @} */
@@ -0,0 +1,206 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+/**
+ * @file    controlrate.hpp
+ * @brief   Control rate scheduling and ramped control values.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Linear ramp between control rate updates.
+   *
+   * Each set() starts a ramp from the previous target to the new one, so a value
+   * that does not change is returned exactly and costs one add per sample.
+   */
+  struct ControlRamp {
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor
+     */
+    ControlRamp(void) :
+      value(0.f), step(0.f), target(0.f)
+    { }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Ramp to a new target
+     *
+     * @param t Target value, reached after 1/period_recip calls to process()
+     * @param period_recip Reciprocal of the ramp length in samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void set(const float t, const float period_recip)
+    {
+      value = target;
+      target = t;
+      step = (t - value) * period_recip;
+    }
+
+    /**
+     * Jump to a value without ramping
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void reset(const float t)
+    {
+      value = target = t;
+      step = 0.f;
+    }
+
+    /**
+     * Advance one sample and return the ramped value
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float process(void)
+    {
+      value += step;
+      return value;
+    }
+
+    /*===========================================================================*/
+    /* Members Vars                                                              */
+    /*===========================================================================*/
+
+    float value;
+    float step;
+    float target;
+  };
+
+  /**
+   * Control rate scheduler.
+   *
+   * Splits the audio loop into control periods of N frames. Parameter derived
+   * values are computed when tick() returns true and handed to the audio loop
+   * through ControlRamp, instead of being recomputed every sample:
+   *
+   *   for (uint32_t f = 0; f < frames; f++) {
+   *     if (s_ctrl.tick())
+   *       s_cutoff.set(derive_cutoff(), s_ctrl.periodRecip());
+   *     const float cutoff = s_cutoff.process();
+   *     ...
+   *   }
+   *
+   * When derived values only depend on parameters, which change between
+   * unit_render calls, derive once per call instead and ramp over the buffer
+   * with ControlRamp::set(target, 1.f / frames).
+   *
+   * @tparam N Control period in frames
+   */
+  template <uint32_t N>
+  struct ControlRate {
+    static_assert(N > 0, "control period must be at least one frame");
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, the first tick() starts a control period
+     */
+    ControlRate(void) :
+      count(0)
+    { }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Advance one frame
+     *
+     * @return true on the first frame of each control period
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    bool tick(void)
+    {
+      if (count) {
+        --count;
+        return false;
+      }
+      count = N - 1;
+      return true;
+    }
+
+    /**
+     * Start a new control period on the next tick()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void reset(void)
+    {
+      count = 0;
+    }
+
+    /**
+     * Frames left in the current control period after this one
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t remaining(void) const
+    {
+      return count;
+    }
+
+    /**
+     * Reciprocal of the control period, to ramp over one period
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float periodRecip(void)
+    {
+      return 1.f / N;
+    }
+
+    /*===========================================================================*/
+    /* Members Vars                                                              */
+    /*===========================================================================*/
+
+    uint32_t count;
+  };
+}
+
+/** @} */
@@ -0,0 +1,421 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    dattorro.hpp
+ * @brief   Dattorro plate reverb.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include "utils/float_math.h"
+#include "utils/int_math.h"
+#include "utils/buffer_ops.h"
+#include "dsp/simplelfo.hpp"
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Plate reverb after J. Dattorro, "Effect Design Part 1", JAES 1997.
+   *
+   * Input bandwidth filter and four input diffusers feed a figure-eight tank of
+   * two modulated allpasses, four delays, two allpasses and two damping
+   * filters, tapped at seven points per side. The delay lengths of the paper
+   * are given at 29761 Hz and are scaled to the sample rate in init().
+   *
+   * All lines share one power-of-two circular buffer and one pointer that moves
+   * by one sample per frame, each line being a fixed offset into it, so a read
+   * or write costs one add and one mask. The tank delays are allocated for the
+   * largest size and setSize() only moves their read points, so the size can
+   * change while running.
+   *
+   *   const size_t n = DattorroPlate::memorySize(48000.f, 1.5f);
+   *   s_plate.init(sdram_alloc(n * sizeof(float)), 48000.f, 1.5f);
+   *   s_plate.setDecay(0.7f);
+   *   ...
+   *   s_plate.process(in, out, frames);  // stereo interleaved, wet only
+   */
+  struct DattorroPlate {
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_in_ap1 = 0,
+      k_in_ap2,
+      k_in_ap3,
+      k_in_ap4,
+      k_l_mod_ap,
+      k_l_delay1,
+      k_l_ap,
+      k_l_delay2,
+      k_r_mod_ap,
+      k_r_delay1,
+      k_r_ap,
+      k_r_delay2,
+      k_num_lines
+    };
+
+    static const uint32_t k_num_taps = 14;
+
+    /** Modulation excursion the modulated allpasses are allocated for, in samples at 29761 Hz. */
+    static constexpr float k_max_excursion = 32.f;
+
+    /** Reference sample rate of the delay tables. */
+    static constexpr float k_ref_samplerate = 29761.f;
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, parameters from the paper
+     */
+    DattorroPlate(void) :
+      mBuffer(0),
+      mMask(0),
+      mPtr(0),
+      mScale(1.f),
+      mSize(1.f),
+      mMaxSize(1.f),
+      mExcursion(16.f),
+      mBandwidth(0.9995f),
+      mDamping(0.0005f),
+      mDecay(0.5f),
+      mInputDiffusion1(0.75f),
+      mInputDiffusion2(0.625f),
+      mDecayDiffusion1(0.7f),
+      mDecayDiffusion2(0.5f),
+      mBandZ(0.f),
+      mDampZL(0.f),
+      mDampZR(0.f)
+    { }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Buffer size needed, in floats
+     *
+     * @param samplerate Sample rate in Hz
+     * @param max_size Largest value to be passed to setSize()
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    size_t memorySize(const float samplerate, const float max_size) {
+      uint32_t lengths[k_num_lines];
+      return nextpow2_u32(layout(samplerate / k_ref_samplerate, max_size, lengths, 0));
+    }
+
+    /**
+     * Set up the delay lines in the given buffer and clear them
+     *
+     * @param ram Buffer of memorySize(samplerate, max_size) floats
+     * @param samplerate Sample rate in Hz
+     * @param max_size Largest value to be passed to setSize()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void init(float *ram, const float samplerate, const float max_size) {
+      mScale = samplerate / k_ref_samplerate;
+      mBuffer = ram;
+      uint32_t lengths[k_num_lines];
+      mMask = nextpow2_u32(layout(mScale, max_size, lengths, mOffset)) - 1;
+      mPtr = 0;
+      mMaxSize = max_size;
+
+      for (uint32_t i = 0; i < k_num_lines; i++)
+        mRead[i] = (uint32_t)(lineLengths()[i] * mScale);
+      mLfo.reset();
+      setModulation(16.f * mScale, 1.f, samplerate);
+      setSize(1.f);
+      clear();
+    }
+
+    /**
+     * Zero clear the delay lines and filter states
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void clear(void) {
+      buf_clr_f32(mBuffer, mMask + 1);
+      mBandZ = mDampZL = mDampZR = 0.f;
+    }
+
+    /**
+     * Tank size, scales the four tank delays and the output taps into them
+     *
+     * @param size 1 for the lengths of the paper, up to max_size given to init()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setSize(float size) {
+      size = clipminmaxf(0.1f, size, mMaxSize);
+      mSize = size;
+      for (uint32_t i = 0; i < k_num_lines; i++)
+        if (isTankDelay(i))
+          mRead[i] = (uint32_t)(lineLengths()[i] * mScale * size);
+      const float * taps = tapTable();
+      for (uint32_t i = 0; i < k_num_taps; i++)
+        mTap[i] = (uint32_t)(taps[i] * mScale * (isTankDelay(tapLine(i)) ? size : 1.f));
+    }
+
+    /**
+     * Decay of the tank, the gain applied on each half of the figure eight
+     *
+     * @param decay 0 to below 1, the decay diffusion 2 follows as in the paper
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDecay(const float decay) {
+      mDecay = decay;
+      mDecayDiffusion2 = clipminmaxf(0.25f, decay + 0.15f, 0.5f);
+    }
+
+    /**
+     * Damping lowpass in the tank, 0 for none, towards 1 for darker tails
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDamping(const float damping) {
+      mDamping = damping;
+    }
+
+    /**
+     * Input bandwidth lowpass, 1 for full bandwidth
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setBandwidth(const float bandwidth) {
+      mBandwidth = bandwidth;
+    }
+
+    /**
+     * Input diffusion coefficients, 0.75 and 0.625 in the paper
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setInputDiffusion(const float d1, const float d2) {
+      mInputDiffusion1 = d1;
+      mInputDiffusion2 = d2;
+    }
+
+    /**
+     * Modulation of the two tank input allpasses, in quadrature
+     *
+     * @param excursion Peak excursion in samples at the running sample rate
+     * @param rate LFO rate in Hz
+     * @param samplerate Sample rate in Hz
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setModulation(const float excursion, const float rate, const float samplerate) {
+      mExcursion = clipminmaxf(0.f, excursion, k_max_excursion * mScale);
+      mLfo.setF0(rate, 1.f / samplerate);
+    }
+
+    /**
+     * Process a block, wet signal only
+     *
+     * @param in Stereo interleaved input, summed to mono as in the paper
+     * @param out Stereo interleaved output, may be the input buffer
+     * @param frames Number of frames
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float *in, float *out, const uint32_t frames) {
+      const float mod_center_l = mRead[k_l_mod_ap];
+      const float mod_center_r = mRead[k_r_mod_ap];
+
+      for (uint32_t f = 0; f < frames; f++) {
+        const float x = (in[2*f] + in[2*f+1]) * 0.5f;
+
+        // Bandwidth and input diffusion
+        mBandZ += mBandwidth * (x - mBandZ);
+        float d = allpass(k_in_ap1, mBandZ, mInputDiffusion1);
+        d = allpass(k_in_ap2, d, mInputDiffusion1);
+        d = allpass(k_in_ap3, d, mInputDiffusion2);
+        d = allpass(k_in_ap4, d, mInputDiffusion2);
+
+        // Tank outputs of this frame, each half feeds the other
+        const float l_out = read(k_l_delay2, mRead[k_l_delay2]);
+        const float r_out = read(k_r_delay2, mRead[k_r_delay2]);
+        const float l_d1 = read(k_l_delay1, mRead[k_l_delay1]);
+        const float r_d1 = read(k_r_delay1, mRead[k_r_delay1]);
+
+        mLfo.cycle();
+        const float lfo_l = mLfo.sine_bi();
+        const float lfo_r = mLfo.sine_bi_off(0.25f);
+
+        // Left half
+        write(k_l_delay1, modAllpass(k_l_mod_ap, d + mDecay * r_out, mod_center_l + mExcursion * lfo_l));
+        mDampZL = l_d1 + mDamping * (mDampZL - l_d1);
+        write(k_l_delay2, allpass(k_l_ap, mDampZL * mDecay, mDecayDiffusion2));
+
+        // Right half
+        write(k_r_delay1, modAllpass(k_r_mod_ap, d + mDecay * l_out, mod_center_r + mExcursion * lfo_r));
+        mDampZR = r_d1 + mDamping * (mDampZR - r_d1);
+        write(k_r_delay2, allpass(k_r_ap, mDampZR * mDecay, mDecayDiffusion2));
+
+        const uint32_t * t = mTap;
+        const float yl = read(k_r_delay1, t[0]) + read(k_r_delay1, t[1]) - read(k_r_ap, t[2]) + read(k_r_delay2, t[3])
+          - read(k_l_delay1, t[4]) - read(k_l_ap, t[5]) - read(k_l_delay2, t[6]);
+        const float yr = read(k_l_delay1, t[7]) + read(k_l_delay1, t[8]) - read(k_l_ap, t[9]) + read(k_l_delay2, t[10])
+          - read(k_r_delay1, t[11]) - read(k_r_ap, t[12]) - read(k_r_delay2, t[13]);
+
+        out[2*f] = yl * 0.6f;
+        out[2*f+1] = yr * 0.6f;
+
+        --mPtr;
+      }
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    /**
+     * Place the lines one after another with a guard sample in between
+     *
+     * @return Total length in floats
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t layout(const float scale, const float max_size, uint32_t *lengths, uint32_t *offsets) {
+      uint32_t total = 0;
+      for (uint32_t i = 0; i < k_num_lines; i++) {
+        float len = lineLengths()[i] * scale;
+        if (isTankDelay(i))
+          len *= max_size;
+        else if (i == k_l_mod_ap || i == k_r_mod_ap)
+          len += k_max_excursion * scale;
+        lengths[i] = (uint32_t)len + 2;
+        if (offsets)
+          offsets[i] = total;
+        total += lengths[i] + 1;
+      }
+      return total;
+    }
+
+    static inline __attribute__((always_inline))
+    bool isTankDelay(const uint32_t line) {
+      return line == k_l_delay1 || line == k_l_delay2 || line == k_r_delay1 || line == k_r_delay2;
+    }
+
+    /** Line lengths at 29761 Hz, in the order of the line enum. */
+    static inline __attribute__((always_inline))
+    const float * lineLengths(void) {
+      static const float t[k_num_lines] = {
+        142.f, 107.f, 379.f, 277.f,
+        672.f, 4453.f, 1800.f, 3720.f,
+        908.f, 4217.f, 2656.f, 3163.f
+      };
+      return t;
+    }
+
+    /** Output taps at 29761 Hz, left then right, in the order process() sums them. */
+    static inline __attribute__((always_inline))
+    const float * tapTable(void) {
+      static const float t[k_num_taps] = {
+        266.f, 2974.f, 1913.f, 1996.f, 1990.f, 187.f, 1066.f,
+        353.f, 3627.f, 1228.f, 2673.f, 2111.f, 335.f, 121.f
+      };
+      return t;
+    }
+
+    /** Line read by each output tap. */
+    static inline __attribute__((always_inline))
+    uint32_t tapLine(const uint32_t i) {
+      static const uint8_t t[k_num_taps] = {
+        k_r_delay1, k_r_delay1, k_r_ap, k_r_delay2, k_l_delay1, k_l_ap, k_l_delay2,
+        k_l_delay1, k_l_delay1, k_l_ap, k_l_delay2, k_r_delay1, k_r_ap, k_r_delay2
+      };
+      return t[i];
+    }
+
+    /** Read a line at a delay in samples */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float read(const uint32_t line, const uint32_t delay) {
+      return mBuffer[(mPtr + mOffset[line] + delay) & mMask];
+    }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const uint32_t line, const float s) {
+      mBuffer[(mPtr + mOffset[line]) & mMask] = s;
+    }
+
+    /** Allpass over the whole line, coefficient signs as in the paper */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float allpass(const uint32_t line, const float x, const float c) {
+      const float v = read(line, mRead[line]);
+      const float w = x + c * v;
+      write(line, w);
+      return v - c * w;
+    }
+
+    /** Allpass with a fractional, modulated length, decay diffusion 1 */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float modAllpass(const uint32_t line, const float x, const float delay) {
+      const uint32_t base = (uint32_t)delay;
+      const float v = linintf(delay - base, read(line, base), read(line, base + 1));
+      const float w = x - mDecayDiffusion1 * v;
+      write(line, w);
+      return v + mDecayDiffusion1 * w;
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    float    *mBuffer;
+    uint32_t  mMask;
+    uint32_t  mPtr;
+    uint32_t  mOffset[k_num_lines];
+    uint32_t  mRead[k_num_lines];
+    uint32_t  mTap[k_num_taps];
+    float     mScale;
+    float     mSize;
+    float     mMaxSize;
+    float     mExcursion;
+    float     mBandwidth;
+    float     mDamping;
+    float     mDecay;
+    float     mInputDiffusion1;
+    float     mInputDiffusion2;
+    float     mDecayDiffusion1;
+    float     mDecayDiffusion2;
+    float     mBandZ;
+    float     mDampZL;
+    float     mDampZR;
+    SimpleLFO mLfo;
+  };
+}
+
+/** @} */
@@ -45,6 +45,10 @@
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
 
+#if !(defined(__ARM_FP) && (__ARM_FP & 2)) && defined(__F16C__)
+#include <immintrin.h>
+#endif
+
 /**
  * Common DSP Utilities
  */
@@ -391,9 +395,350 @@ namespace dsp {
     uint32_t   mWriteIdx;
       
   };
-    
-    
+
+  /**
+   * Q15 delay line storage.
+   *
+   * Holds -1.0 to 1.0 at 16 bits, louder samples saturate. Writes add TPDF
+   * dither of +/-1 LSB so that decaying feedback tails turn into a constant
+   * noise floor around -96 dBFS rather than into truncation distortion.
+   */
+  struct StorageQ15 {
+    typedef int16_t sample_t;
+
+    StorageQ15(void) :
+      mDither(0x2545F491)
+    { }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    sample_t encode(const float s) {
+      mDither = mDither * 1664525U + 1013904223U;
+      // Difference of the two 16-bit halves is triangular over +/-1 LSB
+      const float d = (float)((int32_t)(mDither >> 16) - (int32_t)(mDither & 0xFFFF)) * (1.f / 65536.f);
+      const float v = clipminmaxf(-32768.f, s * 32768.f + d, 32767.f);
+      // Round to nearest with a positive bias so the float to int conversion truncates toward zero
+      return (sample_t)((int32_t)(v + 32768.5f) - 32768);
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float decode(const sample_t s) {
+      return s * (1.f / 32768.f);
+    }
+
+    uint32_t mDither;
+  };
+
+  /**
+   * IEEE 754 half precision delay line storage.
+   *
+   * 11 bits of precision relative to the sample value over a +/-65504 range,
+   * so quiet passages keep their detail and feedback peaks above 1.0 are kept.
+   * Uses the VFPv4 VCVTB conversions on Cortex-M7 and F16C on x86 when available.
+   */
+  struct StorageF16 {
+    typedef uint16_t sample_t;
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    sample_t encode(float s) {
+      s = clipminmaxf(-65504.f, s, 65504.f);
+#if defined(__ARM_FP) && (__ARM_FP & 2)
+      union { float f; uint32_t u; } h;
+      __asm__("vcvtb.f16.f32 %0, %1" : "=t"(h.f) : "t"(s));
+      return (sample_t)h.u;
+#elif defined(__F16C__)
+      return (sample_t)_cvtss_sh(s, 0);
+#else
+      union { float f; uint32_t u; } x = { s };
+      const uint32_t sign = (x.u >> 16) & 0x8000;
+      const int32_t e = (int32_t)((x.u >> 23) & 0xFF) - 127 + 15;
+      uint32_t m = x.u & 0x7FFFFF;
+      if (e <= 0) {
+        // Subnormal half, round to nearest even on the shifted out bits
+        if (e < -10)
+          return (sample_t)sign;
+        m |= 0x800000;
+        const uint32_t shift = 14 - e;
+        uint32_t h = m >> shift;
+        const uint32_t rem = m & ((1U << shift) - 1);
+        const uint32_t half = 1U << (shift - 1);
+        if (rem > half || (rem == half && (h & 1)))
+          ++h;
+        return (sample_t)(sign | h);
+      }
+      uint32_t h = ((uint32_t)e << 10) | (m >> 13);
+      const uint32_t rem = m & 0x1FFF;
+      if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        ++h;  // a mantissa carry moves into the exponent
+      return (sample_t)(sign | h);
+#endif
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float decode(const sample_t s) {
+#if defined(__ARM_FP) && (__ARM_FP & 2)
+      union { float f; uint32_t u; } h;
+      h.u = s;
+      float r;
+      __asm__("vcvtb.f32.f16 %0, %1" : "=t"(r) : "t"(h.f));
+      return r;
+#elif defined(__F16C__)
+      return _cvtsh_ss(s);
+#else
+      const uint32_t sign = (uint32_t)(s & 0x8000) << 16;
+      const uint32_t e = (s >> 10) & 0x1F;
+      const uint32_t m = s & 0x3FF;
+      union { uint32_t u; float f; } x;
+      if (e == 0) {
+        const float v = m * 5.9604644775390625e-8f;  // 2^-24
+        return sign ? -v : v;
+      }
+      x.u = sign | ((e + 127 - 15) << 23) | (m << 13);
+      return x.f;
+#endif
+    }
+  };
+
+  /**
+   * Delay line with compressed sample storage.
+   *
+   * Same interface and indexing as DelayLine, samples are converted by the
+   * Storage type on write and read. StorageQ15 and StorageF16 halve the memory
+   * footprint and bandwidth of a float line.
+   */
+  template <class Storage>
+  struct PackedDelayLine {
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    typedef typename Storage::sample_t sample_t;
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor
+     */
+    PackedDelayLine(void) :
+      mLine(0),
+      mFracZ(0),
+      mSize(0),
+      mMask(0),
+      mWriteIdx(0)
+    { }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Zero clear the whole delay line.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void clear(void) {
+      for (size_t i = 0; i < mSize; i++)
+        mLine[i] = 0;
+    }
+
+    /**
+     * Set the memory area to use as backing buffer for the delay line.
+     *
+     * @param ram Pointer to memory buffer
+     * @param line_size Size in samples of memory buffer
+     *
+     * @note Will round size to next power of two.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setMemory(sample_t *ram, size_t line_size) {
+      mLine = ram;
+      mSize = nextpow2_u32(line_size); // must be power of 2
+      mMask = (mSize-1);
+      mWriteIdx = 0;
+    }
+
+    /**
+     * Write a single sample to the head of the delay line
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const float s) {
+      mLine[(mWriteIdx--) & mMask] = mStorage.encode(s);
+    }
+
+    /**
+     * Read a single sample at given position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float read(const uint32_t pos) {
+      return Storage::decode(mLine[(mWriteIdx + pos) & mMask]);
+    }
+
+    /**
+     * Read a sample at a fractional position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float readFrac(const float pos) {
+      const uint32_t base = (uint32_t)pos;
+      const float frac = pos - base;
+      return linintf(frac, read(base), read(base+1));
+    }
+
+    /**
+     * Read a sample at a position from current write index with interpolation from last read.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float readFracz(const uint32_t pos, const float frac) {
+      const float s0 = read(pos);
+      const float y = linintf(frac, s0, mFracZ);
+      mFracZ = s0;
+      return y;
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    sample_t *mLine;
+    float     mFracZ;
+    size_t    mSize;
+    size_t    mMask;
+    uint32_t  mWriteIdx;
+    Storage   mStorage;
+  };
+
+  /**
+   * Dual channel delay line with compressed, interleaved sample storage.
+   *
+   * Same interface and indexing as DualDelayLine.
+   */
+  template <class Storage>
+  struct PackedDualDelayLine {
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    typedef typename Storage::sample_t sample_t;
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor
+     */
+    PackedDualDelayLine(void) :
+      mLine(0),
+      mSize(0),
+      mMask(0),
+      mWriteIdx(0)
+    {
+      mFracZ.a = mFracZ.b = 0.f;
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Zero clear the whole delay line.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void clear(void) {
+      for (size_t i = 0; i < 2*mSize; i++)
+        mLine[i] = 0;
+    }
+
+    /**
+     * Set the memory area to use as backing buffer for the delay line.
+     *
+     * @param ram Pointer to memory buffer, 2 * line_size samples
+     * @param line_size Size in sample pairs of memory buffer
+     *
+     * @note Will round size to next power of two.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setMemory(sample_t *ram, size_t line_size) {
+      mLine = ram;
+      mSize = nextpow2_u32(line_size); // must be power of 2
+      mMask = (mSize-1);
+      mWriteIdx = 0;
+    }
+
+    /**
+     * Write a sample pair to the delay line
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const f32pair_t &p) {
+      sample_t *dst = mLine + 2 * ((mWriteIdx--) & mMask);
+      dst[0] = mStorage.encode(p.a);
+      dst[1] = mStorage.encode(p.b);
+    }
+
+    /**
+     * Read a sample pair at given position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    f32pair_t read(const uint32_t pos) {
+      const sample_t *src = mLine + 2 * ((mWriteIdx + pos) & mMask);
+      return f32pair(Storage::decode(src[0]), Storage::decode(src[1]));
+    }
+
+    /**
+     * Read a sample pair at a fractional position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    f32pair_t readFrac(const float pos) {
+      const uint32_t base = (uint32_t)pos;
+      const float frac = pos - base;
+      return f32pair_linint(frac, read(base), read(base+1));
+    }
+
+    /**
+     * Read a sample pair at a position from current write index with interpolation from last read.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    f32pair_t readFracz(const uint32_t pos, const float frac) {
+      const f32pair_t p0 = read(pos);
+      const f32pair_t y = f32pair_linint(frac, p0, mFracZ);
+      mFracZ = p0;
+      return y;
+    }
+
+    /**
+     * Read a single sample from the primary channel at given position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float read0(const uint32_t pos) {
+      return Storage::decode(mLine[2 * ((mWriteIdx + pos) & mMask)]);
+    }
+
+    /**
+     * Read a single sample from the secondary channel at given position from current write index.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float read1(const uint32_t pos) {
+      return Storage::decode(mLine[2 * ((mWriteIdx + pos) & mMask) + 1]);
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    sample_t  *mLine;
+    f32pair_t  mFracZ;
+    size_t     mSize;
+    size_t     mMask;
+    uint32_t   mWriteIdx;
+    Storage    mStorage;
+  };
+
+  typedef PackedDelayLine<StorageQ15> DelayLineQ15;
+  typedef PackedDelayLine<StorageF16> DelayLineF16;
+  typedef PackedDualDelayLine<StorageQ15> DualDelayLineQ15;
+  typedef PackedDualDelayLine<StorageF16> DualDelayLineF16;
+
 }
 
 /** @} */
-
@@ -0,0 +1,6 @@
+#pragma once
+/*
+ * The header is shared with the other platforms, it lives in platform/common/dsp.
+ * NTS-1 mkII builds only put their own common directory on the include path.
+ */
+#include "../../../common/dsp/fdn.hpp"
@@ -0,0 +1,499 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(DSP_USE_CMSIS)
+#include "arm_math.h"
+#endif
+
+#include "utils/float_math.h"
+
+#include "dsp/approx.hpp"
+#include "dsp/biquad.hpp"
+
+/**
+ * @file    kernels.hpp
+ * @brief   Block kernels over CMSIS-DSP with portable fallbacks: biquad cascade, FIR, real FFT, vector multiply-add and clip.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /*
+   * The kernels below follow the CMSIS-DSP semantics and data layouts. With
+   * DSP_USE_CMSIS defined they call into CMSIS-DSP, otherwise into the plain
+   * loops of this file. A unit opting in adds the define and the sources of
+   * the kernels it uses to its config.mk, under a CMSISDIR check since
+   * hostsim parses config.mk too but has no CMSIS and runs the loops:
+   *
+   *   ifneq ($(CMSISDIR),)
+   *   UDEFS += -DDSP_USE_CMSIS
+   *   UCSRC += $(CMSISDIR)/DSP_Lib/Source/FilteringFunctions/arm_biquad_cascade_df2T_f32.c
+   *   endif
+   *
+   * Building from source keeps them position independent like the rest of
+   * the unit, the archives in $(CMSISDIR)/Lib/GCC are not. RealFFT needs
+   * arm_rfft_fast_f32.c, arm_rfft_fast_init_f32.c, arm_cfft_f32.c,
+   * arm_cfft_radix8_f32.c, arm_bitreversal2.S (in UASMXSRC) and the
+   * CommonTables sources, which carry the twiddles of every FFT size: check
+   * the unit footprint with hostsim footprint after adopting it.
+   *
+   * CMSIS-DSP 4 has no fused multiply-add nor clip kernel, vmadd and vclip are
+   * the plain loops in both cases. The loops are not forced inline so that
+   * they vectorize on the host whatever the optimization level of the caller.
+   */
+
+  /*===========================================================================*/
+  /* Vector Operations.                                                        */
+  /*===========================================================================*/
+
+  /** out[i] = a[i] + b[i] */
+  static inline __attribute__((optimize("Ofast")))
+  void vadd(const float * a, const float * b, float * out, uint32_t frames) {
+#if defined(DSP_USE_CMSIS)
+    arm_add_f32(const_cast<float *>(a), const_cast<float *>(b), out, frames);
+#else
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = a[i] + b[i];
+#endif
+  }
+
+  /** out[i] = a[i] * b[i] */
+  static inline __attribute__((optimize("Ofast")))
+  void vmul(const float * a, const float * b, float * out, uint32_t frames) {
+#if defined(DSP_USE_CMSIS)
+    arm_mult_f32(const_cast<float *>(a), const_cast<float *>(b), out, frames);
+#else
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = a[i] * b[i];
+#endif
+  }
+
+  /** out[i] = in[i] * gain */
+  static inline __attribute__((optimize("Ofast")))
+  void vscale(const float * in, float gain, float * out, uint32_t frames) {
+#if defined(DSP_USE_CMSIS)
+    arm_scale_f32(const_cast<float *>(in), gain, out, frames);
+#else
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = in[i] * gain;
+#endif
+  }
+
+  /** out[i] = a[i] * b[i] + c[i], out may be c to accumulate */
+  static inline __attribute__((optimize("Ofast")))
+  void vmadd(const float * a, const float * b, const float * c, float * out, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = a[i] * b[i] + c[i];
+  }
+
+  /** out[i] = in[i] * gain + c[i], out may be c to accumulate */
+  static inline __attribute__((optimize("Ofast")))
+  void vmadd(const float * in, float gain, const float * c, float * out, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = in[i] * gain + c[i];
+  }
+
+  /** out[i] = in[i] clipped to [lo, hi] */
+  static inline __attribute__((optimize("Ofast")))
+  void vclip(const float * in, float lo, float hi, float * out, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i)
+      out[i] = clipminmaxf(lo, in[i], hi);
+  }
+
+  /*===========================================================================*/
+  /* Bi-Quad Cascade.                                                          */
+  /*===========================================================================*/
+
+  /**
+   * Cascade of transposed form 2 Bi-Quads processed a block at a time, stage
+   * after stage (arm_biquad_cascade_df2T_f32). Coefficients are stored per
+   * stage as { b0, b1, b2, -a1, -a2 }, the CMSIS layout.
+   */
+  template <uint8_t Stages>
+  struct BiQuadCascadeDF2T {
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    /**
+     * Default constructor, all stages mute.
+     */
+    BiQuadCascadeDF2T(void) :
+      coeffs(), state()
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      memset(state, 0, sizeof(state));
+    }
+
+    /**
+     * Set the coefficients of one stage.
+     *
+     * @param stage Stage index
+     * @param c     Coefficients, as computed by BiQuad::Coeffs
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setStage(uint32_t stage, const BiQuad::Coeffs & c) {
+      setStage(stage, c.ff0, c.ff1, c.ff2, c.fb1, c.fb2);
+    }
+
+    /**
+     * Set the coefficients of one stage, H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setStage(uint32_t stage, float b0, float b1, float b2, float a1, float a2) {
+      float * c = &coeffs[5 * stage];
+      c[0] = b0;
+      c[1] = b1;
+      c[2] = b2;
+      c[3] = -a1;
+      c[4] = -a2;
+    }
+
+    /**
+     * Process a block through all stages, in and out may be the same buffer.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, uint32_t frames) {
+#if defined(DSP_USE_CMSIS)
+      arm_biquad_cascade_df2T_instance_f32 s = { Stages, state, coeffs };
+      arm_biquad_cascade_df2T_f32(&s, const_cast<float *>(in), out, frames);
+#else
+      const float * src = in;
+      for (uint32_t st = 0; st < Stages; ++st) {
+        const float * c = &coeffs[5 * st];
+        const float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+        float d1 = state[2 * st];
+        float d2 = state[2 * st + 1];
+        for (uint32_t i = 0; i < frames; ++i) {
+          const float x = src[i];
+          const float y = b0 * x + d1;
+          d1 = b1 * x + a1 * y + d2;
+          d2 = b2 * x + a2 * y;
+          out[i] = y;
+        }
+        state[2 * st] = d1;
+        state[2 * st + 1] = d2;
+        src = out;
+      }
+#endif
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+    float coeffs[5 * Stages];
+    float state[2 * Stages];
+  };
+
+  /*===========================================================================*/
+  /* FIR Filter.                                                               */
+  /*===========================================================================*/
+
+  /**
+   * Direct form FIR filter (arm_fir_f32). Blocks longer than BlockSize are
+   * processed in BlockSize chunks, the state holds Taps + BlockSize - 1 floats.
+   */
+  template <uint16_t Taps, uint32_t BlockSize>
+  struct FIRFilter {
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    /**
+     * Default constructor, mute.
+     */
+    FIRFilter(void) :
+      coeffs(), state()
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      memset(state, 0, sizeof(state));
+    }
+
+    /**
+     * Set the impulse response.
+     *
+     * @param h Taps coefficients, h[0] applies to the current sample
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setCoeffs(const float * h) {
+      // CMSIS stores them time reversed
+      for (uint32_t k = 0; k < Taps; ++k)
+        coeffs[k] = h[Taps - 1 - k];
+    }
+
+    /**
+     * Filter a block.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, uint32_t frames) {
+      while (frames > 0) {
+        const uint32_t n = (frames < BlockSize) ? frames : BlockSize;
+        processBlock(in, out, n);
+        in += n;
+        out += n;
+        frames -= n;
+      }
+    }
+
+    /*=========================================================================*/
+    /* Private Methods.                                                        */
+    /*=========================================================================*/
+
+  private:
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void processBlock(const float * in, float * out, uint32_t frames) {
+#if defined(DSP_USE_CMSIS)
+      arm_fir_instance_f32 s = { Taps, state, coeffs };
+      arm_fir_f32(&s, const_cast<float *>(in), out, frames);
+#else
+      // state holds the last Taps - 1 inputs, oldest first, followed by the block
+      memcpy(&state[Taps - 1], in, frames * sizeof(float));
+      for (uint32_t i = 0; i < frames; ++i) {
+        const float * s = &state[i];
+        float acc = 0.f;
+        for (uint32_t k = 0; k < Taps; ++k)
+          acc += coeffs[k] * s[k];
+        out[i] = acc;
+      }
+      memmove(state, &state[frames], (Taps - 1) * sizeof(float));
+#endif
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+  public:
+
+    float coeffs[Taps];
+    float state[Taps + BlockSize - 1];
+  };
+
+  /*===========================================================================*/
+  /* Real FFT.                                                                 */
+  /*===========================================================================*/
+
+  /**
+   * Real FFT of Size points (arm_rfft_fast_f32), Size a power of two from 32
+   * to 4096. Spectra are packed as Size floats: the real parts of bins 0 and
+   * Size/2 first, then the interleaved real and imaginary parts of bins 1 to
+   * Size/2 - 1. forward() is unscaled, inverse() scales by 1/Size so that a
+   * round trip is the identity. Both may overwrite their input, and in and
+   * out must not overlap. Call init() before use, the fallback computes its
+   * twiddles there (Size floats).
+   */
+  template <uint32_t Size>
+  struct RealFFT {
+
+    static_assert(Size >= 32 && Size <= 4096 && !(Size & (Size - 1)),
+                  "RealFFT size must be a power of two from 32 to 4096");
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Prepare the transform.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void init(void) {
+#if defined(DSP_USE_CMSIS)
+      arm_rfft_fast_init_f32(&mInstance, Size);
+#else
+      for (uint32_t k = 0; k < Size / 2; ++k) {
+        const float t = (float)k / Size;
+        twiddles[2 * k] = approx::sin_cycles<approx::k_precise>(t + 0.25f);
+        twiddles[2 * k + 1] = -approx::sin_cycles<approx::k_precise>(t);
+      }
+#endif
+    }
+
+    /**
+     * Time domain to packed spectrum.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void forward(float * in, float * out) {
+#if defined(DSP_USE_CMSIS)
+      arm_rfft_fast_f32(&mInstance, in, out, 0);
+#else
+      // Even and odd samples as one complex sequence of half the length
+      memcpy(out, in, Size * sizeof(float));
+      cfft(out, 1.f);
+
+      const uint32_t m = Size / 2;
+      const float z0r = out[0], z0i = out[1];
+      out[0] = z0r + z0i;
+      out[1] = z0r - z0i;
+      for (uint32_t k = 1; k <= m / 2; ++k) {
+        float * a = &out[2 * k];
+        float * b = &out[2 * (m - k)];
+        // E = (Z[k] + Z*[m-k]) / 2, O = -i (Z[k] - Z*[m-k]) / 2
+        const float er = 0.5f * (a[0] + b[0]), ei = 0.5f * (a[1] - b[1]);
+        const float orr = 0.5f * (a[1] + b[1]), oi = -0.5f * (a[0] - b[0]);
+        const float wr = twiddles[2 * k], wi = twiddles[2 * k + 1];
+        const float tr = wr * orr - wi * oi, ti = wr * oi + wi * orr;
+        // X[k] = E + W^k O, X[m-k] = (E - W^k O)*
+        a[0] = er + tr;
+        a[1] = ei + ti;
+        b[0] = er - tr;
+        b[1] = ti - ei;
+      }
+#endif
+    }
+
+    /**
+     * Packed spectrum to time domain.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void inverse(float * in, float * out) {
+#if defined(DSP_USE_CMSIS)
+      arm_rfft_fast_f32(&mInstance, in, out, 1);
+#else
+      // Undo the split, the 1/Size scaling is folded in here
+      const uint32_t m = Size / 2;
+      const float h = 1.f / Size;
+      out[0] = h * (in[0] + in[1]);
+      out[1] = h * (in[0] - in[1]);
+      for (uint32_t k = 1; k <= m / 2; ++k) {
+        const float * a = &in[2 * k];
+        const float * b = &in[2 * (m - k)];
+        // E = (X[k] + X*[m-k]) / 2, O = (X[k] - X*[m-k]) W^-k / 2
+        const float er = h * (a[0] + b[0]), ei = h * (a[1] - b[1]);
+        const float gr = h * (a[0] - b[0]), gi = h * (a[1] + b[1]);
+        const float wr = twiddles[2 * k], wi = -twiddles[2 * k + 1];
+        const float orr = wr * gr - wi * gi, oi = wr * gi + wi * gr;
+        // Z[k] = E + i O, Z[m-k] = (E - i O)*
+        out[2 * k] = er - oi;
+        out[2 * k + 1] = ei + orr;
+        out[2 * (m - k)] = er + oi;
+        out[2 * (m - k) + 1] = orr - ei;
+      }
+      cfft(out, -1.f);
+#endif
+    }
+
+    /*=========================================================================*/
+    /* Private Methods.                                                        */
+    /*=========================================================================*/
+
+  private:
+
+#if !defined(DSP_USE_CMSIS)
+    /**
+     * In place radix 2 complex FFT of Size / 2 points, unscaled.
+     *
+     * @param sign 1 forward, -1 inverse
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void cfft(float * d, const float sign) {
+      const uint32_t m = Size / 2;
+      for (uint32_t i = 1, j = 0; i < m; ++i) {
+        uint32_t bit = m >> 1;
+        for (; j & bit; bit >>= 1)
+          j ^= bit;
+        j ^= bit;
+        if (i < j) {
+          const float r = d[2 * i], im = d[2 * i + 1];
+          d[2 * i] = d[2 * j];
+          d[2 * i + 1] = d[2 * j + 1];
+          d[2 * j] = r;
+          d[2 * j + 1] = im;
+        }
+      }
+      for (uint32_t len = 2; len <= m; len <<= 1) {
+        const uint32_t half = len >> 1;
+        const uint32_t step = Size / len;
+        for (uint32_t j = 0; j < half; ++j) {
+          const float wr = twiddles[2 * j * step];
+          const float wi = sign * twiddles[2 * j * step + 1];
+          for (uint32_t i = j; i < m; i += len) {
+            float * p = &d[2 * i];
+            float * q = &d[2 * (i + half)];
+            const float tr = q[0] * wr - q[1] * wi;
+            const float ti = q[0] * wi + q[1] * wr;
+            q[0] = p[0] - tr;
+            q[1] = p[1] - ti;
+            p[0] += tr;
+            p[1] += ti;
+          }
+        }
+      }
+    }
+#endif
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+#if defined(DSP_USE_CMSIS)
+    arm_rfft_fast_instance_f32 mInstance;
+#else
+    /** W^k = exp(-2 pi i k / Size) for k < Size / 2, interleaved */
+    float twiddles[Size];
+#endif
+  };
+
+}
+
+/** @} */
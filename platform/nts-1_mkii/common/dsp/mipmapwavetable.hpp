@@ -0,0 +1,111 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+
+/**
+ * @file    mipmapwavetable.hpp
+ * @brief   Reader for band limited mipmapped wavetables generated offline.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Reader for the mipmapped tables written by tools/wavetable-gen.
+   *
+   * A table holds Levels copies of one waveform stored back to back. Level l
+   * has (1 << SizeExp) >> l samples followed by one guard sample equal to the
+   * first, and keeps half the harmonics of level l - 1, so the highest level
+   * that is still alias free for a given fundamental is picked per block:
+   *
+   *   const uint32_t lvl = Table::level(w0, M1_WAVETABLE_W_BASE);
+   *   ...
+   *   out[i] = Table::read(s_m1_wavetable[k], lvl, phase);
+   *
+   * Levels other than the first are only read when the table was generated
+   * with the same size and number of levels.
+   */
+  template <uint32_t SizeExp, uint32_t Levels>
+  struct MipmapWavetable {
+    static const uint32_t kSize = 1U << SizeExp;
+    static const uint32_t kLevels = Levels;
+
+    /**
+     * Mipmap level for a fundamental.
+     *
+     * @param w0     Normalized fundamental (cycles per sample).
+     * @param w_base Highest fundamental of level 0, the generated *_W_BASE.
+     * @return Level index in [0, Levels - 1].
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t level(float w0, float w_base) {
+      uint32_t l = 0;
+      while (l + 1 < Levels && w0 >= w_base) {
+        w_base *= 2.f;
+        ++l;
+      }
+      return l;
+    }
+
+    /**
+     * Linear interpolated read.
+     *
+     * @param table Start of one waveform, all its levels included.
+     * @param level Level from level().
+     * @param phase Phase in [0, 1], 1 reads as 0.
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float read(const float * table, uint32_t level, float phase) {
+      // Levels before l take 2S - 2(S >> l) samples plus l guard samples
+      const uint32_t n = kSize >> level;
+      const float * t = table + (2 * kSize - 2 * n) + level;
+      const float x = phase * n;
+      const uint32_t i = static_cast<uint32_t>(x);
+      const float frac = x - i;
+      // A wrapped phase can round up to exactly 1, keep the index in the level
+      const uint32_t im = i & (n - 1);
+      return linintf(frac, t[im], t[im + 1]);
+    }
+  };
+}
+
+/** @} */
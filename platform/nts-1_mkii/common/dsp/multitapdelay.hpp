@@ -0,0 +1,343 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    multitapdelay.hpp
+ * @brief   Multi-tap delay line with fractional taps and block access.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ *
+ */
+
+#include "utils/float_math.h"
+#include "utils/int_math.h"
+#include "utils/buffer_ops.h"
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Delay line with a power-of-two size, a set of fractional taps and block
+   * read/write.
+   *
+   * Positions follow DelayLine: they are offsets from the write index, so after
+   * a write position 1 is the sample just written, and a read before the write
+   * at position d delays by d samples. Samples of all channels are stored
+   * interleaved, so a stereo read touches one cache line.
+   *
+   * Block access splits at the wrap point and copies the two runs without any
+   * per-sample index arithmetic:
+   *
+   *   s_line.readBlock(delayed, d, frames);  // d >= frames
+   *   s_line.write(in, frames);
+   *
+   * @tparam Taps Number of taps set with setTap()
+   * @tparam Channels 1 for mono, 2 for stereo interleaved
+   */
+  template <uint32_t Taps, uint32_t Channels = 1>
+  struct MultiTapDelay {
+    static_assert(Channels == 1 || Channels == 2, "mono or stereo only");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    struct Tap {
+      uint32_t base;
+      float frac;
+      float eta;               /** Allpass coefficient for frac. */
+      float z[Channels];       /** Allpass state. */
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor
+     */
+    MultiTapDelay(void) :
+      mLine(0),
+      mSize(0),
+      mMask(0),
+      mWriteIdx(0)
+    {
+      for (uint32_t i = 0; i < Taps; i++)
+        setTap(i, 1.f);
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Set the memory area to use as backing buffer for the delay line.
+     *
+     * @param ram Pointer to memory buffer, Channels * line_size floats
+     * @param line_size Size in frames of memory buffer, must be a power of two
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setMemory(float *ram, size_t line_size) {
+      mLine = ram;
+      mSize = line_size;
+      mMask = line_size - 1;
+      mWriteIdx = 0;
+    }
+
+    /**
+     * Memory needed for a delay of at least the given length, in floats
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    size_t memorySize(const uint32_t frames) {
+      return nextpow2_u32(frames) * Channels;
+    }
+
+    /**
+     * Zero clear the whole delay line and the tap states.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void clear(void) {
+      buf_clr_f32(mLine, mSize * Channels);
+      for (uint32_t i = 0; i < Taps; i++)
+        for (uint32_t c = 0; c < Channels; c++)
+          mTaps[i].z[c] = 0.f;
+    }
+
+    /**
+     * Write one frame to the head of the delay line
+     *
+     * @param s Channels samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const float *s) {
+      float *dst = mLine + (mWriteIdx & mMask) * Channels;
+      for (uint32_t c = 0; c < Channels; c++)
+        dst[c] = s[c];
+      ++mWriteIdx;
+    }
+
+    /**
+     * Write one sample to a mono delay line
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const float s) {
+      mLine[(mWriteIdx++ & mMask) * Channels] = s;
+    }
+
+    /**
+     * Write a block of frames
+     *
+     * @param in Interleaved frames
+     * @param frames Number of frames, at most the line size
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void write(const float * __restrict in, const uint32_t frames) {
+      const uint32_t idx = mWriteIdx & mMask;
+      const uint32_t first = (frames < mSize - idx) ? frames : mSize - idx;
+      buf_cpy_f32(in, mLine + idx * Channels, first * Channels);
+      buf_cpy_f32(in + first * Channels, mLine, (frames - first) * Channels);
+      mWriteIdx += frames;
+    }
+
+    /**
+     * Read a sample at given position from current write index.
+     *
+     * @param pos Offset from write index
+     * @param ch Channel
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float read(const uint32_t pos, const uint32_t ch = 0) {
+      return mLine[((mWriteIdx - pos) & mMask) * Channels + ch];
+    }
+
+    /**
+     * Read with linear interpolation at a fractional position from current write index.
+     *
+     * @param pos Offset from write index, at least 1
+     * @param ch Channel
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float readLinear(const float pos, const uint32_t ch = 0) {
+      const uint32_t base = (uint32_t)pos;
+      return linint(base, pos - base, ch);
+    }
+
+    /**
+     * Read with 4-point Hermite interpolation at a fractional position from current write index.
+     *
+     * @param pos Offset from write index, at least 2
+     * @param ch Channel
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float readHermite(const float pos, const uint32_t ch = 0) {
+      const uint32_t base = (uint32_t)pos;
+      return hermite(base, pos - base, ch);
+    }
+
+    /**
+     * Read a block of frames at a fixed position.
+     *
+     * Frame f of the block is what read(pos) returns when called before the f-th
+     * write of the block, provided pos >= frames.
+     *
+     * @param out Interleaved frames
+     * @param pos Offset from write index
+     * @param frames Number of frames, at most the line size
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void readBlock(float * __restrict out, const uint32_t pos, const uint32_t frames) {
+      const uint32_t idx = (mWriteIdx - pos) & mMask;
+      const uint32_t first = (frames < mSize - idx) ? frames : mSize - idx;
+      buf_cpy_f32(mLine + idx * Channels, out, first * Channels);
+      buf_cpy_f32(mLine, out + first * Channels, (frames - first) * Channels);
+    }
+
+    /**
+     * Read a block of frames at a fixed fractional position with linear interpolation.
+     *
+     * @param out Interleaved frames
+     * @param pos Offset from write index, at least frames
+     * @param frames Number of frames
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void readBlockLinear(float * __restrict out, const float pos, const uint32_t frames) {
+      const uint32_t base = (uint32_t)pos;
+      const float frac = pos - base;
+      const float gain0 = 1.f - frac;
+      uint32_t i0 = mWriteIdx - base;
+      for (uint32_t f = 0; f < frames; f++, i0++) {
+        const float *s0 = mLine + (i0 & mMask) * Channels;
+        const float *s1 = mLine + ((i0 - 1) & mMask) * Channels;
+        for (uint32_t c = 0; c < Channels; c++)
+          *(out++) = gain0 * s0[c] + frac * s1[c];
+      }
+    }
+
+    /**
+     * Set the position of a tap.
+     *
+     * The integer and fractional parts and the allpass coefficient are derived
+     * here, so reading a tap costs no conversion.
+     *
+     * @param i Tap index
+     * @param pos Offset from write index, at least 1 for linear and 2 for Hermite and allpass taps
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setTap(const uint32_t i, const float pos) {
+      Tap &t = mTaps[i];
+      t.base = (uint32_t)pos;
+      t.frac = pos - t.base;
+      // Keep the allpass delay within [0.5, 1.5) where its phase delay is flattest
+      const float apfrac = (t.frac < 0.5f && t.base > 1) ? t.frac + 1.f : t.frac;
+      t.eta = (1.f - apfrac) / (1.f + apfrac);
+    }
+
+    /**
+     * Read a tap at the integer part of its position
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float tap(const uint32_t i, const uint32_t ch = 0) {
+      return read(mTaps[i].base, ch);
+    }
+
+    /**
+     * Read a tap with linear interpolation
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float tapLinear(const uint32_t i, const uint32_t ch = 0) {
+      return linint(mTaps[i].base, mTaps[i].frac, ch);
+    }
+
+    /**
+     * Read a tap with 4-point Hermite interpolation
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float tapHermite(const uint32_t i, const uint32_t ch = 0) {
+      return hermite(mTaps[i].base, mTaps[i].frac, ch);
+    }
+
+    /**
+     * Read a tap with first order allpass interpolation.
+     *
+     * Flat magnitude response, suited to taps inside feedback loops. The tap
+     * must be read once per sample and its position changed slowly, since the
+     * interpolator has state.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float tapAllpass(const uint32_t i, const uint32_t ch = 0) {
+      Tap &t = mTaps[i];
+      const uint32_t base = (t.frac < 0.5f && t.base > 1) ? t.base - 1 : t.base;
+      const float y = read(base + 1, ch) + t.eta * (read(base, ch) - t.z[ch]);
+      t.z[ch] = y;
+      return y;
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float linint(const uint32_t base, const float frac, const uint32_t ch) {
+      return linintf(frac, read(base, ch), read(base + 1, ch));
+    }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float hermite(const uint32_t base, const float frac, const uint32_t ch) {
+      const float xm1 = read(base - 1, ch);
+      const float x0 = read(base, ch);
+      const float x1 = read(base + 1, ch);
+      const float x2 = read(base + 2, ch);
+      const float c1 = 0.5f * (x1 - xm1);
+      const float c2 = xm1 - 2.5f * x0 + 2.f * x1 - 0.5f * x2;
+      const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+      return ((c3 * frac + c2) * frac + c1) * frac + x0;
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    float   *mLine;
+    size_t   mSize;
+    size_t   mMask;
+    uint32_t mWriteIdx;
+    Tap      mTaps[Taps];
+  };
+
+}
+
+/** @} */
@@ -0,0 +1,496 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+#include "dsp/lanes4.hpp"
+
+/**
+ * @file    noisegen.hpp
+ * @brief   Uniform, Gaussian, pink and velvet noise without divisions.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Noise generator on a xoshiro128+ core.
+   *
+   * xoshiro128+ is the 32 bit member of the xorshift128+ family: four words of
+   * state, shifts, xors and one add per draw, a period of 2^128 - 1, so noise
+   * never loops audibly the way a short pre-generated buffer does. Its top
+   * bits are the strong ones, and the float conversion only uses the top 23:
+   * they are or'ed into the mantissa of 1.0f, which gives a float in [1, 2)
+   * without an integer division or an int to float conversion.
+   *
+   *   s_noise.seed(k_seed);                // unit_init()
+   *   ...
+   *   s_noise.renderWhite(buf, frames);    // block of noise in [-1, 1)
+   *   x += s_noise.white() * level;        // or one sample at a time
+   *
+   * gaussian() sums four draws (Irwin-Hall), unit variance, bounded to +-3.46.
+   * pink() filters white() with Paul Kellet's economy three pole filter, within
+   * 0.5 dB of -3 dB/octave above 10 Hz, scaled to the RMS of white().
+   * velvet() emits one impulse of random sign at a random position in every
+   * period of 1 / density samples, and zeroes elsewhere.
+   */
+  struct NoiseGen {
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, fixed seed, velvet density of 2000 impulses per second at 48kHz
+     */
+    NoiseGen(void) :
+      mPink0(0.f),
+      mPink1(0.f),
+      mPink2(0.f),
+      mVelvetPeriod(24),
+      mVelvetCount(0),
+      mVelvetPos(0),
+      mVelvetSign(0)
+    {
+      seed(0x1F123BB5U);
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Restart the sequence from a seed, any value including 0 is valid
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void seed(uint32_t s) {
+      for (uint32_t i = 0; i < 4; i++)
+        state[i] = splitmix32(s);
+      mPink0 = mPink1 = mPink2 = 0.f;
+      mVelvetCount = 0;
+    }
+
+    /**
+     * Set the velvet noise density
+     *
+     * @param density Impulses per sample, (0, 1], e.g. 2000.f / 48000.f
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setVelvetDensity(const float density) {
+      const float period = (density > 0.f) ? 1.f / density : 4294967295.f;
+      mVelvetPeriod = (period >= 1.f) ? (uint32_t)period : 1;
+      if (mVelvetCount >= mVelvetPeriod)
+        mVelvetCount = 0;
+    }
+
+    /**
+     * @return Next 32 random bits
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t next(void) {
+      const uint32_t r = state[0] + state[3];
+      const uint32_t t = state[1] << 9;
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+      state[2] ^= t;
+      state[3] = (state[3] << 11) | (state[3] >> 21);
+      return r;
+    }
+
+    /**
+     * @return Uniform float in [0, 1)
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float uniform(void) {
+      f32_t f;
+      f.i = 0x3F800000U | (next() >> 9);
+      return f.f - 1.f;
+    }
+
+    /**
+     * @return Uniform float in [-1, 1)
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float white(void) {
+      f32_t f;
+      f.i = 0x40000000U | (next() >> 9);
+      return f.f - 3.f;
+    }
+
+    /**
+     * @return Approximately normal float, zero mean, unit variance
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float gaussian(void) {
+      // Each white() has variance 1/3
+      return (white() + white() + white() + white()) * 0.8660254f;
+    }
+
+    /**
+     * @return Pink noise sample, same RMS as white()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float pink(void) {
+      const float w = white();
+      mPink0 = 0.99765f * mPink0 + w * 0.0990460f;
+      mPink1 = 0.96300f * mPink1 + w * 0.2965164f;
+      mPink2 = 0.57000f * mPink2 + w * 1.0526913f;
+      return (mPink0 + mPink1 + mPink2 + w * 0.1848f) * k_pink_gain;
+    }
+
+    /**
+     * @return Velvet noise sample, -1, 0 or 1
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float velvet(void) {
+      if (mVelvetCount == 0) {
+        const uint32_t r = next();
+        // Position in [0, period) from the top bits, no modulo
+        mVelvetPos = (uint32_t)(((uint64_t)(r >> 1) * mVelvetPeriod) >> 31);
+        mVelvetSign = r & 1;
+      }
+      const float out = (mVelvetCount == mVelvetPos) ? (mVelvetSign ? -1.f : 1.f) : 0.f;
+      if (++mVelvetCount >= mVelvetPeriod)
+        mVelvetCount = 0;
+      return out;
+    }
+
+    /**
+     * Fill a block with uniform noise in [0, 1) times gain
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderUniform(float * out, const uint32_t frames, const float gain = 1.f) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = uniform() * gain;
+    }
+
+    /**
+     * Fill a block with white noise in [-1, 1) times gain
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderWhite(float * out, const uint32_t frames, const float gain = 1.f) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = white() * gain;
+    }
+
+    /**
+     * Fill a block with Gaussian noise times gain
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderGaussian(float * out, const uint32_t frames, const float gain = 1.f) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = gaussian() * gain;
+    }
+
+    /**
+     * Fill a block with pink noise times gain
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderPink(float * out, const uint32_t frames, const float gain = 1.f) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = pink() * gain;
+    }
+
+    /**
+     * Fill a block with velvet noise times gain
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderVelvet(float * out, const uint32_t frames, const float gain = 1.f) {
+      for (uint32_t i = 0; i < frames; i++)
+        out[i] = velvet() * gain;
+    }
+
+    /*===========================================================================*/
+    /* Public Static Methods.                                                    */
+    /*===========================================================================*/
+
+    /**
+     * splitmix32 step, spreads a seed or a counter over all 32 bits
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t splitmix32(uint32_t & s) {
+      uint32_t z = (s += 0x9E3779B9U);
+      z = (z ^ (z >> 16)) * 0x85EBCA6BU;
+      z = (z ^ (z >> 13)) * 0xC2B2AE35U;
+      return z ^ (z >> 16);
+    }
+
+    /*===========================================================================*/
+    /* Constants.                                                                */
+    /*===========================================================================*/
+
+    /** Brings the pink filter output to the RMS of white(). */
+    static constexpr float k_pink_gain = 0.3358f;
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    uint32_t state[4];
+
+    float    mPink0;
+    float    mPink1;
+    float    mPink2;
+    uint32_t mVelvetPeriod;
+    uint32_t mVelvetCount;
+    uint32_t mVelvetPos;
+    uint32_t mVelvetSign;
+  };
+
+  /**
+   * Four independent xoshiro128+ streams, one per lane of Lanes4.
+   *
+   * The memoryless outputs can fill a mono block four samples at a time, the
+   * pink filter keeps one state per lane, so pink() is four independent pink
+   * streams, e.g. one per voice or per FDN line:
+   *
+   *   s_noise4.renderWhite(buf, frames);   // frames a multiple of 4
+   *   L::v4 p = s_noise4.pink();           // four voices
+   */
+  struct NoiseGen4 {
+    typedef Lanes4 L;
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, fixed seed
+     */
+    NoiseGen4(void)
+    {
+      seed(0x1F123BB5U);
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Restart the four sequences from a seed, any value including 0 is valid
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void seed(uint32_t s) {
+      for (uint32_t w = 0; w < 4; w++)
+        for (uint32_t i = 0; i < 4; i++)
+          state[w][i] = NoiseGen::splitmix32(s);
+      for (uint32_t i = 0; i < 4; i++)
+        pink0[i] = pink1[i] = pink2[i] = 0.f;
+    }
+
+    /**
+     * @return Next 32 random bits of each lane
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    L::u4 next(void) {
+      L::u4 s0 = L::loadu(state[0]);
+      L::u4 s1 = L::loadu(state[1]);
+      L::u4 s2 = L::loadu(state[2]);
+      L::u4 s3 = L::loadu(state[3]);
+      const L::u4 r = step(s0, s1, s2, s3);
+      L::storeu(state[0], s0);
+      L::storeu(state[1], s1);
+      L::storeu(state[2], s2);
+      L::storeu(state[3], s3);
+      return r;
+    }
+
+    /**
+     * @return Uniform floats in [0, 1)
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 uniform(void) {
+      return toUniform(next());
+    }
+
+    /**
+     * @return Uniform floats in [-1, 1)
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 white(void) {
+      return toWhite(next());
+    }
+
+    /**
+     * @return Approximately normal floats, zero mean, unit variance
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 gaussian(void) {
+      L::u4 s0 = L::loadu(state[0]);
+      L::u4 s1 = L::loadu(state[1]);
+      L::u4 s2 = L::loadu(state[2]);
+      L::u4 s3 = L::loadu(state[3]);
+      const L::v4 g = gaussian(s0, s1, s2, s3);
+      L::storeu(state[0], s0);
+      L::storeu(state[1], s1);
+      L::storeu(state[2], s2);
+      L::storeu(state[3], s3);
+      return g;
+    }
+
+    /**
+     * @return One pink noise sample per lane, same RMS as white()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 pink(void) {
+      const L::v4 w = white();
+      L::v4 b0 = L::load(pink0);
+      L::v4 b1 = L::load(pink1);
+      L::v4 b2 = L::load(pink2);
+      b0 = L::madd(L::mul(b0, L::splat(0.99765f)), w, L::splat(0.0990460f));
+      b1 = L::madd(L::mul(b1, L::splat(0.96300f)), w, L::splat(0.2965164f));
+      b2 = L::madd(L::mul(b2, L::splat(0.57000f)), w, L::splat(1.0526913f));
+      L::store(pink0, b0);
+      L::store(pink1, b1);
+      L::store(pink2, b2);
+      const L::v4 sum = L::madd(L::add(L::add(b0, b1), b2), w, L::splat(0.1848f));
+      return L::mul(sum, L::splat(NoiseGen::k_pink_gain));
+    }
+
+    /**
+     * Fill a block with uniform noise in [0, 1) times gain
+     *
+     * @param frames Multiple of 4
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderUniform(float * out, const uint32_t frames, const float gain = 1.f) {
+      L::u4 s0 = L::loadu(state[0]);
+      L::u4 s1 = L::loadu(state[1]);
+      L::u4 s2 = L::loadu(state[2]);
+      L::u4 s3 = L::loadu(state[3]);
+      const L::v4 g = L::splat(gain);
+      for (uint32_t i = 0; i < frames; i += 4)
+        L::store(out + i, L::mul(toUniform(step(s0, s1, s2, s3)), g));
+      L::storeu(state[0], s0);
+      L::storeu(state[1], s1);
+      L::storeu(state[2], s2);
+      L::storeu(state[3], s3);
+    }
+
+    /**
+     * Fill a block with white noise in [-1, 1) times gain
+     *
+     * @param frames Multiple of 4
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderWhite(float * out, const uint32_t frames, const float gain = 1.f) {
+      L::u4 s0 = L::loadu(state[0]);
+      L::u4 s1 = L::loadu(state[1]);
+      L::u4 s2 = L::loadu(state[2]);
+      L::u4 s3 = L::loadu(state[3]);
+      const L::v4 g = L::splat(gain);
+      for (uint32_t i = 0; i < frames; i += 4)
+        L::store(out + i, L::mul(toWhite(step(s0, s1, s2, s3)), g));
+      L::storeu(state[0], s0);
+      L::storeu(state[1], s1);
+      L::storeu(state[2], s2);
+      L::storeu(state[3], s3);
+    }
+
+    /**
+     * Fill a block with Gaussian noise times gain
+     *
+     * @param frames Multiple of 4
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void renderGaussian(float * out, const uint32_t frames, const float gain = 1.f) {
+      L::u4 s0 = L::loadu(state[0]);
+      L::u4 s1 = L::loadu(state[1]);
+      L::u4 s2 = L::loadu(state[2]);
+      L::u4 s3 = L::loadu(state[3]);
+      const L::v4 g = L::splat(gain);
+      for (uint32_t i = 0; i < frames; i += 4)
+        L::store(out + i, L::mul(gaussian(s0, s1, s2, s3), g));
+      L::storeu(state[0], s0);
+      L::storeu(state[1], s1);
+      L::storeu(state[2], s2);
+      L::storeu(state[3], s3);
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    L::u4 step(L::u4 & s0, L::u4 & s1, L::u4 & s2, L::u4 & s3) {
+      const L::u4 r = L::addu(s0, s3);
+      const L::u4 t = L::shlu<9>(s1);
+      s2 = L::xoru(s2, s0);
+      s3 = L::xoru(s3, s1);
+      s1 = L::xoru(s1, s2);
+      s0 = L::xoru(s0, s3);
+      s2 = L::xoru(s2, t);
+      s3 = L::oru(L::shlu<11>(s3), L::shru<21>(s3));
+      return r;
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 toUniform(const L::u4 r) {
+      const L::v4 f = L::asfloat(L::oru(L::shru<9>(r), L::splatu(0x3F800000U)));
+      return L::sub(f, L::splat(1.f));
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 toWhite(const L::u4 r) {
+      const L::v4 f = L::asfloat(L::oru(L::shru<9>(r), L::splatu(0x40000000U)));
+      return L::sub(f, L::splat(3.f));
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    L::v4 gaussian(L::u4 & s0, L::u4 & s1, L::u4 & s2, L::u4 & s3) {
+      const L::v4 a = L::add(toWhite(step(s0, s1, s2, s3)), toWhite(step(s0, s1, s2, s3)));
+      const L::v4 b = L::add(toWhite(step(s0, s1, s2, s3)), toWhite(step(s0, s1, s2, s3)));
+      return L::mul(L::add(a, b), L::splat(0.8660254f));
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    uint32_t state[4][4] __attribute__((aligned(16)));
+    float pink0[4] __attribute__((aligned(16)));
+    float pink1[4] __attribute__((aligned(16)));
+    float pink2[4] __attribute__((aligned(16)));
+  };
+}
+
+/** @} */
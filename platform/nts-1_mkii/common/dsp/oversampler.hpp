@@ -0,0 +1,360 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+
+/**
+ * @file    oversampler.hpp
+ * @brief   Polyphase half-band oversampling for nonlinear stages.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * One polyphase IIR half-band stage, converting between a rate and twice that rate.
+   *
+   * The filter is the sum of two chains of first order allpasses in z^-2, one
+   * per polyphase branch, so each output sample of the upsampler and each input
+   * sample pair of the downsampler costs NumCoefs multiplies. Phase is not linear:
+   * the group delay is a few samples at low frequencies and rises towards the
+   * band edge, which is inaudible for a distortion stage. An instance keeps the
+   * state of one direction of one channel.
+   *
+   * @tparam NumCoefs Number of allpass coefficients, even
+   */
+  template <uint32_t NumCoefs>
+  struct HalfBand {
+    static_assert(NumCoefs >= 2 && (NumCoefs & 1) == 0, "half-band stage needs an even number of coefficients");
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    HalfBand(void) : coefs(0)
+    {
+      clear();
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Set the allpass coefficients, the table must outlive the stage
+     */
+    inline __attribute__((always_inline))
+    void setCoefs(const float * c)
+    {
+      coefs = c;
+    }
+
+    inline __attribute__((always_inline))
+    void clear(void)
+    {
+      for (uint32_t i = 0; i < NumCoefs; i++)
+        x[i] = y[i] = 0.f;
+    }
+
+    /**
+     * Upsample a block
+     *
+     * @param in Input, frames samples
+     * @param out Output, 2 * frames samples, may not alias in
+     * @param frames Number of input samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void upsample(const float * __restrict in, float * __restrict out, const uint32_t frames)
+    {
+      float c[NumCoefs], sx[NumCoefs], sy[NumCoefs];
+      load(c, sx, sy);
+      for (uint32_t f = 0; f < frames; f++) {
+        float even = in[f];
+        float odd = in[f];
+        branches(c, sx, sy, even, odd);
+        out[2 * f] = even;
+        out[2 * f + 1] = odd;
+      }
+      store(sx, sy);
+    }
+
+    /**
+     * Downsample a block
+     *
+     * @param in Input, 2 * frames samples
+     * @param out Output, frames samples, may alias the start of in
+     * @param frames Number of output samples
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void downsample(const float * in, float * out, const uint32_t frames)
+    {
+      float c[NumCoefs], sx[NumCoefs], sy[NumCoefs];
+      load(c, sx, sy);
+      for (uint32_t f = 0; f < frames; f++) {
+        float even = in[2 * f + 1];
+        float odd = in[2 * f];
+        branches(c, sx, sy, even, odd);
+        out[f] = 0.5f * (even + odd);
+      }
+      store(sx, sy);
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    // State is copied to locals around the sample loop so it stays in registers
+    inline __attribute__((always_inline))
+    void load(float * c, float * sx, float * sy) const
+    {
+      for (uint32_t i = 0; i < NumCoefs; i++) {
+        c[i] = coefs[i];
+        sx[i] = x[i];
+        sy[i] = y[i];
+      }
+    }
+
+    // Flushes decaying state once per block before it reaches denormals
+    inline __attribute__((always_inline))
+    void store(const float * sx, const float * sy)
+    {
+      for (uint32_t i = 0; i < NumCoefs; i++) {
+        x[i] = (si_fabsf(sx[i]) < 1e-15f) ? 0.f : sx[i];
+        y[i] = (si_fabsf(sy[i]) < 1e-15f) ? 0.f : sy[i];
+      }
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    void branches(const float * c, float * sx, float * sy, float & even, float & odd)
+    {
+      for (uint32_t i = 0; i < NumCoefs; i += 2) {
+        const float e = (even - sy[i]) * c[i] + sx[i];
+        const float o = (odd - sy[i + 1]) * c[i + 1] + sx[i + 1];
+        sx[i] = even;
+        sx[i + 1] = odd;
+        sy[i] = even = e;
+        sy[i + 1] = odd = o;
+      }
+    }
+
+    /*===========================================================================*/
+    /* Members Vars                                                              */
+    /*===========================================================================*/
+
+    const float * coefs;
+    float x[NumCoefs];
+    float y[NumCoefs];
+  };
+
+  /**
+   * Runs a nonlinear function at 2x or 4x the sample rate, leaving the rest of
+   * the unit at 48kHz.
+   *
+   * A block is upsampled, the function is applied to every oversampled sample,
+   * and the result is filtered and decimated back, so harmonics above the
+   * original Nyquist frequency are removed instead of folding back as aliases:
+   *
+   *   dsp::Oversampler<2> s_os;
+   *   ...
+   *   s_os.process(buf, buf, frames, [](float x) { return fastertanhf(2.f * x); });
+   *
+   * The 2x filters are flat up to 22kHz and reject images and aliases by more
+   * than 80dB. The 4x variant adds a cheaper second stage on the outside, whose
+   * transition band only has to cover the gap the first stage leaves. See
+   * hostsim oversample for the cost of each factor and the alias rejection.
+   *
+   * One instance handles one channel, use one per channel for stereo.
+   *
+   * @tparam Factor Oversampling factor, 2 or 4
+   * @tparam MaxFrames Internal block length, longer blocks are processed in chunks
+   */
+  template <uint32_t Factor, uint32_t MaxFrames = 64>
+  struct Oversampler {
+    static_assert(Factor == 2 || Factor == 4, "oversampling factor must be 2 or 4");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_inner_coefs = 8,
+      k_outer_coefs = 4
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    Oversampler(void)
+    {
+      mInnerUp.setCoefs(innerCoefs());
+      mInnerDown.setCoefs(innerCoefs());
+      mOuterUp.setCoefs(outerCoefs());
+      mOuterDown.setCoefs(outerCoefs());
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    inline __attribute__((always_inline))
+    void clear(void)
+    {
+      mInnerUp.clear();
+      mInnerDown.clear();
+      mOuterUp.clear();
+      mOuterDown.clear();
+    }
+
+    /**
+     * Apply a function at the oversampled rate
+     *
+     * @param in Input, frames samples
+     * @param out Output, frames samples, may alias in
+     * @param frames Number of samples at the base rate
+     * @param func Callable taking and returning a float, called Factor * frames times in order
+     */
+    template <typename F>
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, uint32_t frames, F && func)
+    {
+      while (frames) {
+        const uint32_t n = (frames < MaxFrames) ? frames : MaxFrames;
+        float * os = upsample(in, n);
+        for (uint32_t i = 0; i < n * Factor; i++)
+          os[i] = func(os[i]);
+        downsample(out, n);
+        in += n;
+        out += n;
+        frames -= n;
+      }
+    }
+
+    /**
+     * Upsample a block into the internal buffer, for stages that are not a per sample function
+     *
+     * @param in Input, at most MaxFrames samples
+     * @param frames Number of samples at the base rate
+     * @return Buffer of Factor * frames samples, to be processed in place before downsample()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float * upsample(const float * in, const uint32_t frames)
+    {
+      if (Factor == 2) {
+        mInnerUp.upsample(in, mBuf, frames);
+      }
+      else {
+        mInnerUp.upsample(in, mHalf, frames);
+        mOuterUp.upsample(mHalf, mBuf, 2 * frames);
+      }
+      return mBuf;
+    }
+
+    /**
+     * Downsample the internal buffer after upsample()
+     *
+     * @param out Output, frames samples
+     * @param frames Number of samples at the base rate, as passed to upsample()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void downsample(float * out, const uint32_t frames)
+    {
+      if (Factor == 2) {
+        mInnerDown.downsample(mBuf, out, frames);
+      }
+      else {
+        mOuterDown.downsample(mBuf, mHalf, 2 * frames);
+        mInnerDown.downsample(mHalf, out, frames);
+      }
+    }
+
+    /**
+     * Delay added by the round trip at low frequencies, in base rate samples
+     */
+    static inline __attribute__((always_inline))
+    float latency(void)
+    {
+      return (Factor == 2) ? 2.6f : 3.7f;
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    /**
+     * Coefficients of the base to 2x stage, transition band 0.0213 of the 2x rate
+     */
+    static inline __attribute__((always_inline))
+    const float * innerCoefs(void)
+    {
+      static const float c[k_inner_coefs] = {
+        0.0558662146f, 0.2006679259f, 0.3838755943f, 0.5599183279f,
+        0.7052844515f, 0.8162825908f, 0.9000779747f, 0.9679985470f
+      };
+      return c;
+    }
+
+    /**
+     * Coefficients of the 2x to 4x stage, transition band 0.25 of the 4x rate
+     */
+    static inline __attribute__((always_inline))
+    const float * outerCoefs(void)
+    {
+      static const float c[k_outer_coefs] = {
+        0.0424547099f, 0.1707398505f, 0.3933198932f, 0.7457135887f
+      };
+      return c;
+    }
+
+    /*===========================================================================*/
+    /* Members Vars                                                              */
+    /*===========================================================================*/
+
+    float mBuf[MaxFrames * Factor];
+    float mHalf[(Factor == 4) ? MaxFrames * 2 : 1];
+    HalfBand<k_inner_coefs> mInnerUp;
+    HalfBand<k_inner_coefs> mInnerDown;
+    HalfBand<k_outer_coefs> mOuterUp;
+    HalfBand<k_outer_coefs> mOuterDown;
+  };
+}
+
+/** @} */
@@ -0,0 +1,304 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "utils/float_math.h"
+
+#include "dsp/kernels.hpp"
+
+/**
+ * @file    partitionedconvolver.hpp
+ * @brief   Uniformly partitioned overlap-save FFT convolution, for cabinet and short IR reverbs.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * Convolution with an impulse response of up to a few seconds, split into
+   * partitions of Partition samples (uniformly partitioned overlap-save).
+   *
+   * Each block of Partition input samples is transformed once, with the block
+   * before it, by a RealFFT of 2 * Partition points and pushed into a
+   * frequency domain delay line (FDL) holding the spectra of the last P
+   * blocks. The output spectrum is the sum of the FDL spectra times the
+   * spectra of the P impulse response partitions, and the second half of its
+   * inverse transform is the output block. The cost per sample is two
+   * transforms of 2 * Partition points divided by Partition, plus P complex
+   * multiply-adds per bin: it falls with larger partitions while the length
+   * stays the same, where a direct form FIR costs one multiply-add per tap
+   * per sample.
+   *
+   * Partition should equal frames_per_buffer of the runtime: the output of a
+   * render call then depends on its own input and the convolver adds no delay
+   * beyond the buffer the runtime already has. A larger Partition would need
+   * its own buffering and add latency, a smaller one only costs more.
+   * `hostsim convolve` reports the cost per partition size and IR length.
+   *
+   * The impulse response spectra and the FDL live in SDRAM, memorySize()
+   * floats for the longest response, and are streamed once per block. Both
+   * transforms use RealFFT, over CMSIS-DSP when the unit opts in (see
+   * kernels.hpp). The complex multiply-add loop is plain C in both cases.
+   *
+   *   if (desc->frames_per_buffer != Convolver::k_partition) return k_unit_err_geometry;
+   *   const uint32_t parts = Convolver::partitionsFor(ir_length);
+   *   float * ram = (float *)desc->hooks.sdram_alloc(Convolver::memorySize(ir_length) * sizeof(float));
+   *   if (!ram) return k_unit_err_memory;
+   *   s_conv.init();
+   *   s_conv.setMemory(ram, parts);
+   *   s_conv.setImpulse(ir_l, ir_length, 0);
+   *   s_conv.setImpulse(ir_r, ir_length, 1);
+   *   ...
+   *   s_conv.process(in, out, frames);   // interleaved, frames a multiple of Partition
+   *
+   * @tparam Partition Partition size in samples, a power of two from 16 to 2048
+   * @tparam Channels Number of interleaved channels, each with its own response
+   */
+  template <uint32_t Partition, uint8_t Channels = 1>
+  struct PartitionedConvolver {
+
+    static_assert(Partition >= 16 && Partition <= 2048 && !(Partition & (Partition - 1)),
+                  "Partition must be a power of two from 16 to 2048");
+    static_assert(Channels >= 1, "PartitionedConvolver needs at least one channel");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_partition = Partition,
+      k_fft_size = 2 * Partition
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, no memory and no response
+     */
+    PartitionedConvolver(void) :
+      history(),
+      buffer(),
+      spectrum(),
+      partitions(),
+      mIr(0),
+      mFdl(0),
+      mMaxPartitions(0),
+      mHead(0)
+    {}
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Number of partitions holding a response of the given length
+     *
+     * @param length Response length in samples
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    uint32_t partitionsFor(const uint32_t length) {
+      return (length + Partition - 1) / Partition;
+    }
+
+    /**
+     * Memory needed for responses up to the given length, in floats
+     *
+     * @param max_length Longest response, in samples
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    size_t memorySize(const uint32_t max_length) {
+      return (size_t)2 * Channels * partitionsFor(max_length) * k_fft_size;
+    }
+
+    /**
+     * Prepare the transform, once before use.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void init(void) {
+      mFft.init();
+    }
+
+    /**
+     * Set the memory area holding the response spectra and the FDL. Clears
+     * the responses of all channels.
+     *
+     * @param ram Pointer to memorySize() floats
+     * @param max_partitions Number of partitions the memory holds, see partitionsFor()
+     */
+    inline __attribute__((optimize("Ofast")))
+    void setMemory(float * ram, const uint32_t max_partitions) {
+      mIr = ram;
+      mFdl = ram + (size_t)Channels * max_partitions * k_fft_size;
+      mMaxPartitions = max_partitions;
+      for (uint32_t ch = 0; ch < Channels; ++ch)
+        partitions[ch] = 0;
+      clear();
+    }
+
+    /**
+     * Load the impulse response of a channel. Transforms every partition,
+     * call from init or outside of render. Longer responses are truncated to
+     * the memory given to setMemory().
+     *
+     * @param ir Response samples
+     * @param length Response length in samples
+     * @param ch Channel
+     * @return Number of partitions in use
+     */
+    inline __attribute__((optimize("Ofast")))
+    uint32_t setImpulse(const float * ir, const uint32_t length, const uint8_t ch = 0) {
+      uint32_t n = partitionsFor(length);
+      if (n > mMaxPartitions)
+        n = mMaxPartitions;
+      float * h = spectra(mIr, ch);
+      for (uint32_t p = 0; p < n; ++p) {
+        const uint32_t offset = p * Partition;
+        const uint32_t count = (length - offset < Partition) ? length - offset : Partition;
+        memcpy(buffer, ir + offset, count * sizeof(float));
+        memset(buffer + count, 0, (k_fft_size - count) * sizeof(float));
+        mFft.forward(buffer, h + p * k_fft_size);
+      }
+      partitions[ch] = n;
+      return n;
+    }
+
+    /**
+     * Clear the FDL and the input history, keeps the responses.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void clear(void) {
+      if (mFdl)
+        memset(mFdl, 0, (size_t)Channels * mMaxPartitions * k_fft_size * sizeof(float));
+      memset(history, 0, sizeof(history));
+      mHead = 0;
+    }
+
+    /**
+     * Convolve a block of interleaved frames, in place allowed.
+     *
+     * @param in Input frames
+     * @param out Output frames
+     * @param frames Number of frames, a multiple of Partition
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, const uint32_t frames) {
+      if (!mMaxPartitions)
+        return;
+      for (uint32_t offset = 0; offset + Partition <= frames; offset += Partition) {
+        mHead = (mHead + 1 < mMaxPartitions) ? mHead + 1 : 0;
+        for (uint32_t ch = 0; ch < Channels; ++ch) {
+          const float * x = in + offset * Channels + ch;
+          float * y = out + offset * Channels + ch;
+          float * hist = history + ch * Partition;
+
+          // Previous block then this one, this one becomes the history
+          memcpy(buffer, hist, Partition * sizeof(float));
+          for (uint32_t i = 0; i < Partition; ++i)
+            buffer[Partition + i] = hist[i] = x[i * Channels];
+
+          float * fdl = spectra(mFdl, ch);
+          mFft.forward(buffer, fdl + mHead * k_fft_size);
+
+          // Newest input spectrum against the first partition, and so on
+          const float * h = spectra(mIr, ch);
+          memset(spectrum, 0, sizeof(spectrum));
+          uint32_t slot = mHead;
+          for (uint32_t p = 0; p < partitions[ch]; ++p) {
+            cmac(fdl + slot * k_fft_size, h + p * k_fft_size, spectrum);
+            slot = slot ? slot - 1 : mMaxPartitions - 1;
+          }
+
+          // The first half of the inverse is circular wrap around
+          mFft.inverse(spectrum, buffer);
+          for (uint32_t i = 0; i < Partition; ++i)
+            y[i * Channels] = buffer[Partition + i];
+        }
+      }
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+  private:
+
+    /** First spectrum of a channel in the responses or the FDL */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float * spectra(float * base, const uint32_t ch) const {
+      return base + (size_t)ch * mMaxPartitions * k_fft_size;
+    }
+
+    /**
+     * acc += x * h over packed spectra, bins 0 and Partition are real.
+     */
+    static inline __attribute__((optimize("Ofast")))
+    void cmac(const float * __restrict x, const float * __restrict h, float * __restrict acc) {
+      acc[0] += x[0] * h[0];
+      acc[1] += x[1] * h[1];
+      for (uint32_t k = 2; k < k_fft_size; k += 2) {
+        const float xr = x[k], xi = x[k + 1];
+        const float hr = h[k], hi = h[k + 1];
+        acc[k] += xr * hr - xi * hi;
+        acc[k + 1] += xr * hi + xi * hr;
+      }
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    float history[Channels * Partition];    /** Previous input block per channel. */
+    float buffer[k_fft_size];               /** Time domain scratch. */
+    float spectrum[k_fft_size];             /** Output spectrum accumulator. */
+    uint32_t partitions[Channels];          /** Response partitions in use per channel. */
+
+    RealFFT<k_fft_size> mFft;
+    float   *mIr;                           /** Response spectra, Channels x mMaxPartitions. */
+    float   *mFdl;                          /** Input spectra, Channels x mMaxPartitions, circular. */
+    uint32_t mMaxPartitions;
+    uint32_t mHead;                         /** FDL slot of the newest input spectrum. */
+  };
+
+}
+
+/** @} */
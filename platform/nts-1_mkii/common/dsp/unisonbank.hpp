@@ -0,0 +1,359 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+#include "dsp/lanes4.hpp"
+
+/**
+ * @file    unisonbank.hpp
+ * @brief   Bank of detuned PolyBLEP oscillators for unison and supersaw sounds.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /**
+   * N detuned saw or square oscillators rendered together, four at a time.
+   *
+   * Each voice has a spread position, scaled by the detune amount in cents,
+   * and a fixed frequency ratio, for example 0.5 for a sub oscillator. The
+   * resulting frequency ratios are only recomputed when the detune changes,
+   * and the phase increments only when the pitch changes, so the render loop
+   * is adds, multiplies and max() on uint32 phases and floats:
+   *
+   *   s_bank.setSpread(i, -1.f .. 1.f);      // once, per voice
+   *   s_bank.setLevel(i, 1.f / N);
+   *   ...
+   *   s_bank.setDetune(cents);              // on parameter change
+   *   s_bank.setPitch(w0);                  // once per block, ramped over the block
+   *   s_bank.renderSaw(out, frames);
+   *
+   * Phases are uint32 accumulators that wrap for free. Saw and square use a
+   * branch free form of the two sample PolyBLEP, so all lanes run the same
+   * instructions. Lanes4 maps this to NEON, SSE or wasm SIMD, and to an
+   * unrolled scalar loop on the Cortex-M7.
+   *
+   * @tparam N Number of voices
+   */
+  template <uint32_t N>
+  struct UnisonBank {
+    static_assert(N > 0, "bank needs at least one voice");
+
+    /*===========================================================================*/
+    /* Types and Data Structures.                                                */
+    /*===========================================================================*/
+
+    enum {
+      k_groups = (N + 3) / 4,
+      k_lanes = k_groups * 4
+    };
+
+    /*===========================================================================*/
+    /* Constructor / Destructor.                                                 */
+    /*===========================================================================*/
+
+    /**
+     * Default constructor, voices evenly spread, equal levels, centered, at pitch 0
+     */
+    UnisonBank(void)
+    {
+      for (uint32_t i = 0; i < k_lanes; i++) {
+        spread[i] = (N > 1 && i < N) ? (2.f * i / (N - 1) - 1.f) : 0.f;
+        base[i] = 1.f;
+        level[i] = (i < N) ? 1.f / N : 0.f;
+        gainL[i] = gainR[i] = 0.5f * level[i];
+        ratio[i] = 1.f;
+        phase[i] = inc[i] = incTarget[i] = 0;
+        rdt[i] = 0.f;
+      }
+      mDetune = 0.f;
+      mPitch = 0.f;
+      mPulse = 0x80000000U;
+      mJump = true;
+    }
+
+    /*===========================================================================*/
+    /* Public Methods.                                                           */
+    /*===========================================================================*/
+
+    /**
+     * Set the spread position of a voice, its detune is position * cents
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setSpread(const uint32_t i, const float position)
+    {
+      spread[i] = position;
+      updateRatio(i);
+      updateIncrements();
+    }
+
+    /**
+     * Set a fixed frequency ratio for a voice, applied on top of the detune
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setRatio(const uint32_t i, const float r)
+    {
+      base[i] = r;
+      updateRatio(i);
+      updateIncrements();
+    }
+
+    /**
+     * Set the level of a voice, and its position for stereo rendering
+     *
+     * @param i Voice index
+     * @param l Level
+     * @param pan 0 left, 0.5 center, 1 right, linear
+     */
+    inline __attribute__((always_inline))
+    void setLevel(const uint32_t i, const float l, const float pan = 0.5f)
+    {
+      level[i] = l;
+      gainL[i] = l * (1.f - pan);
+      gainR[i] = l * pan;
+    }
+
+    /**
+     * Set the detune amount, voices are detuned by their spread position times this
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setDetune(const float cents)
+    {
+      if (cents == mDetune)
+        return;
+      mDetune = cents;
+      for (uint32_t i = 0; i < N; i++)
+        updateRatio(i);
+      updateIncrements();
+    }
+
+    /**
+     * Set the base pitch, reached by the end of the next rendered block
+     *
+     * @param w0 Frequency in cycles per sample, as returned by osc_w0f_for_note()
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setPitch(const float w0)
+    {
+      if (w0 == mPitch)
+        return;
+      mPitch = w0;
+      updateIncrements();
+    }
+
+    /**
+     * Set the pulse width of renderSquare()
+     *
+     * @param pw High part of the cycle, 0.5 for a square
+     */
+    inline __attribute__((always_inline))
+    void setPulseWidth(const float pw)
+    {
+      mPulse = static_cast<uint32_t>(clipminmaxf(0.01f, pw, 0.99f) * 4294967296.f);
+    }
+
+    /**
+     * Restart all voices, the pitch jumps instead of ramping on the next block
+     *
+     * @param phases Start phases in [0, 1), or null to start all at 0
+     */
+    inline __attribute__((always_inline))
+    void reset(const float * phases = 0)
+    {
+      for (uint32_t i = 0; i < N; i++)
+        phase[i] = phases ? static_cast<uint32_t>(phases[i] * 4294967296.f) : 0;
+      mJump = true;
+    }
+
+    /**
+     * Render the sum of all voices as saws, weighted by their levels
+     */
+    inline __attribute__((optimize("Ofast")))
+    void renderSaw(float * out, const uint32_t frames)
+    {
+      render<false, false>(out, 0, frames);
+    }
+
+    /**
+     * Render the sum of all voices as saws, panned
+     */
+    inline __attribute__((optimize("Ofast")))
+    void renderSaw(float * outL, float * outR, const uint32_t frames)
+    {
+      render<false, true>(outL, outR, frames);
+    }
+
+    /**
+     * Render the sum of all voices as pulses, weighted by their levels
+     */
+    inline __attribute__((optimize("Ofast")))
+    void renderSquare(float * out, const uint32_t frames)
+    {
+      render<true, false>(out, 0, frames);
+    }
+
+    /**
+     * Render the sum of all voices as pulses, panned
+     */
+    inline __attribute__((optimize("Ofast")))
+    void renderSquare(float * outL, float * outR, const uint32_t frames)
+    {
+      render<true, true>(outL, outR, frames);
+    }
+
+    /*===========================================================================*/
+    /* Private Methods.                                                          */
+    /*===========================================================================*/
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void updateRatio(const uint32_t i)
+    {
+      ratio[i] = base[i] * fastpow2f(spread[i] * mDetune * (1.f / 1200.f));
+    }
+
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void updateIncrements(void)
+    {
+      for (uint32_t i = 0; i < N; i++) {
+        const float w = clipminmaxf(0.f, mPitch * ratio[i], 0.45f);
+        incTarget[i] = static_cast<uint32_t>(w * 4294967296.f);
+        rdt[i] = (w > 1e-7f) ? 1.f / w : 1e7f;
+      }
+    }
+
+    /**
+     * PolyBLEP saw at phase t in [0, 1] with 1 / increment rdt.
+     * -(1 - t / dt)^2 after the wrap and (1 - (1 - t) / dt)^2 before it, in
+     * branch free form: the clamped terms are zero away from the discontinuity.
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    Lanes4::v4 blepSaw(const Lanes4::v4 t, const Lanes4::v4 rdt)
+    {
+      typedef Lanes4 L;
+      const L::v4 one = L::splat(1.f);
+      const L::v4 zero = L::splat(0.f);
+      const L::v4 trdt = L::mul(t, rdt);
+      const L::v4 u = L::max(L::sub(one, trdt), zero);
+      const L::v4 v = L::max(L::add(L::sub(one, rdt), trdt), zero);
+      const L::v4 naive = L::sub(L::add(t, t), one);
+      return L::sub(L::madd(naive, u, u), L::mul(v, v));
+    }
+
+    template <bool Square, bool Stereo>
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void render(float * outL, float * outR, const uint32_t frames)
+    {
+      typedef Lanes4 L;
+      if (!frames)
+        return;
+
+      // Ramp the increments to their targets over the block
+      uint32_t step[k_lanes];
+      for (uint32_t i = 0; i < k_lanes; i++) {
+        if (mJump)
+          inc[i] = incTarget[i];
+        step[i] = static_cast<uint32_t>(static_cast<int32_t>(incTarget[i] - inc[i]) / static_cast<int32_t>(frames));
+      }
+      mJump = false;
+
+      L::u4 ph[k_groups], dp[k_groups], ds[k_groups];
+      L::v4 r[k_groups], gl[k_groups], gr[k_groups];
+      for (uint32_t g = 0; g < k_groups; g++) {
+        ph[g] = L::loadu(phase + 4 * g);
+        dp[g] = L::loadu(inc + 4 * g);
+        ds[g] = L::loadu(step + 4 * g);
+        r[g] = L::load(rdt + 4 * g);
+        gl[g] = L::load(Stereo ? gainL + 4 * g : level + 4 * g);
+        if (Stereo)
+          gr[g] = L::load(gainR + 4 * g);
+      }
+      const L::u4 pulse = L::splatu(mPulse);
+      const L::v4 offset = L::splat(2.f * mPulse * 2.3283064e-10f - 1.f);
+
+      for (uint32_t f = 0; f < frames; f++) {
+        L::v4 accL = L::splat(0.f);
+        L::v4 accR = L::splat(0.f);
+        for (uint32_t g = 0; g < k_groups; g++) {
+          L::v4 s = blepSaw(L::unit(ph[g]), r[g]);
+          if (Square) {
+            // Difference of two saws a pulse width apart
+            s = L::add(L::sub(s, blepSaw(L::unit(L::addu(ph[g], pulse)), r[g])), offset);
+          }
+          accL = L::madd(accL, s, gl[g]);
+          if (Stereo)
+            accR = L::madd(accR, s, gr[g]);
+          ph[g] = L::addu(ph[g], dp[g]);
+          dp[g] = L::addu(dp[g], ds[g]);
+        }
+        outL[f] = L::hsum(accL);
+        if (Stereo)
+          outR[f] = L::hsum(accR);
+      }
+
+      for (uint32_t g = 0; g < k_groups; g++)
+        L::storeu(phase + 4 * g, ph[g]);
+      for (uint32_t i = 0; i < k_lanes; i++)
+        inc[i] = incTarget[i];
+    }
+
+    /*===========================================================================*/
+    /* Member Variables.                                                         */
+    /*===========================================================================*/
+
+    uint32_t phase[k_lanes] __attribute__((aligned(16)));
+    uint32_t inc[k_lanes] __attribute__((aligned(16)));
+    uint32_t incTarget[k_lanes] __attribute__((aligned(16)));
+    float rdt[k_lanes] __attribute__((aligned(16)));
+    float spread[k_lanes] __attribute__((aligned(16)));
+    float base[k_lanes] __attribute__((aligned(16)));
+    float ratio[k_lanes] __attribute__((aligned(16)));
+    float level[k_lanes] __attribute__((aligned(16)));
+    float gainL[k_lanes] __attribute__((aligned(16)));
+    float gainR[k_lanes] __attribute__((aligned(16)));
+
+    float    mDetune;
+    float    mPitch;
+    uint32_t mPulse;
+    bool     mJump;
+  };
+}
+
+/** @} */
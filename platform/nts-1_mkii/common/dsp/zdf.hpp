@@ -0,0 +1,700 @@
+#pragma once
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+#include <stdint.h>
+
+#include "utils/float_math.h"
+#include "utils/fp_guard.h"
+
+#include "dsp/approx.hpp"
+
+/**
+ * @file    zdf.hpp
+ * @brief   Zero delay feedback (TPT) state variable, ladder and diode ladder filters.
+ *
+ * @addtogroup dsp DSP
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  /** tan(pi x) provided by the runtime, see osc_tanpif and fx_tanpif */
+  extern const float tanpi_lut_f[];
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * Common DSP Utilities
+ */
+namespace dsp {
+
+  /*
+   * Topology preserving transform filters: trapezoidal integrators with the
+   * zero delay feedback loop solved per sample, so cutoff and resonance can
+   * move at audio rate without the detuning and instability of the naive
+   * forms. Each filter takes a Channels count and processes interleaved
+   * frames, ZdfSvf<2> runs a stereo pair on one set of coefficients:
+   *
+   *   dsp::ZdfSvf<2>::Coeffs c;
+   *   c.set(fc / 48000.f, res, dsp::ZdfSvf<2>::k_lp);
+   *   s_svf.setCoeffs(c);                   // once per block
+   *   s_svf.process(in, out, frames);       // ramps to c across the block
+   *
+   * setCoeffs() sets a target reached linearly across the next block
+   * process(), snap() jumps to it. The per sample process(x, ch) uses the
+   * current coefficients as is, call snap() after setCoeffs() to modulate
+   * per sample. The block process() flushes states below 1e-15 to zero once
+   * per block, so decaying tails do not run on denormals. The ladders
+   * saturate their input with tanh, the feedback loop through it is solved
+   * with a fixed count of Newton steps, Newton = 0 gives the linear filter
+   * without any tanh, to be kept below res 1.
+   */
+  namespace zdf {
+
+    /*===========================================================================*/
+    /* Helpers.                                                                  */
+    /*===========================================================================*/
+
+    /**
+     * Prewarped integrator gain tan(pi wc) from the runtime table.
+     *
+     * The table holds tan(pi x) at x = 0.49 i / 255 for i in [0, 255], one
+     * step closer than the 0.49 / 256 of osc_tanpif, which reads it 0.4% low.
+     *
+     * @param wc Cutoff over sampling rate, clipped to [0.0001, 0.489]
+     */
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float prewarp(float wc) {
+      wc = clipminmaxf(0.0001f, wc, 0.489f);
+      const float idxf = wc * 520.408163f;   // 255 / 0.49
+      const uint32_t idx = (uint32_t)idxf;
+      return linintf(idxf - idx, tanpi_lut_f[idx], tanpi_lut_f[idx + 1]);
+    }
+
+    /**
+     * Coefficient set C, a struct of floats, ramped linearly across a block
+     * from its current value to the last one set.
+     */
+    template <class C>
+    struct Ramp {
+      static const uint32_t k_count = sizeof(C) / sizeof(float);
+
+      Ramp(void) :
+        mDirty(false)
+      { }
+
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void set(const C & c) {
+        const float * s = reinterpret_cast<const float *>(&c);
+        float * t = reinterpret_cast<float *>(&target);
+        for (uint32_t i = 0; i < k_count; ++i) {
+          mDirty |= (t[i] != s[i]);
+          t[i] = s[i];
+        }
+      }
+
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void snap(void) {
+        cur = target;
+        mDirty = false;
+      }
+
+      /** Compute the steps for a block of frames, false when there is nothing to ramp */
+      inline __attribute__((optimize("Ofast"),always_inline))
+      bool begin(uint32_t frames) {
+        if (!mDirty || frames == 0)
+          return false;
+        const float r = 1.f / frames;
+        const float * c = reinterpret_cast<const float *>(&cur);
+        const float * t = reinterpret_cast<const float *>(&target);
+        float * s = reinterpret_cast<float *>(&step);
+        for (uint32_t i = 0; i < k_count; ++i)
+          s[i] = (t[i] - c[i]) * r;
+        return true;
+      }
+
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void tick(void) {
+        float * c = reinterpret_cast<float *>(&cur);
+        const float * s = reinterpret_cast<const float *>(&step);
+        for (uint32_t i = 0; i < k_count; ++i)
+          c[i] += s[i];
+      }
+
+      C cur;
+      C target;
+      C step;
+      bool mDirty;
+    };
+
+    /**
+     * Solve u = tanh(xs - kg u) with Newton steps from the linear guess.
+     */
+    template <uint8_t Newton>
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float solve_tanh(const float xs, const float kg, const float norm) {
+      if (Newton == 0)
+        return xs * norm;
+      float u = approx::tanh<approx::k_fast>(xs * norm);
+      for (uint32_t n = 0; n < Newton; ++n) {
+        const float t = approx::tanh<approx::k_fast>(xs - kg * u);
+        u -= (u - t) / (1.f + kg * (1.f - t * t));
+      }
+      return u;
+    }
+
+  }
+
+  /*===========================================================================*/
+  /* State Variable Filter.                                                    */
+  /*===========================================================================*/
+
+  /**
+   * Two pole state variable filter with low, band, high pass, notch and a
+   * continuous low to band to high morph.
+   */
+  template <uint8_t Channels = 1>
+  struct ZdfSvf {
+
+    /*=========================================================================*/
+    /* Types and Data Structures.                                              */
+    /*=========================================================================*/
+
+    enum Mode {
+      k_lp = 0,
+      k_bp,
+      k_hp,
+      k_notch,
+      k_morph
+    };
+
+    /**
+     * Filter coefficients
+     */
+    struct Coeffs {
+      float a1, a2, a3;
+      /** Output mix of input, band and low pass */
+      float m0, m1, m2;
+
+      Coeffs() :
+        a1(0), a2(0), a3(0),
+        m0(0), m1(0), m2(0)
+      { }
+
+      /**
+       * @param wc    Cutoff over sampling rate, [0.0001, 0.489]
+       * @param res   Resonance in [-0.5, 0.99], Q from 1/3 to 50, overdamped below 0
+       * @param mode  Output
+       * @param morph Low pass at 0, band pass at 0.5, high pass at 1, for k_morph
+       */
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void set(const float wc, const float res, const Mode mode, const float morph = 0.f) {
+        const float g = zdf::prewarp(wc);
+        const float k = 2.f - 2.f * clipminmaxf(-0.5f, res, 0.99f);
+        a1 = 1.f / (1.f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+        switch (mode) {
+        case k_lp:
+          m0 = 0.f; m1 = 0.f; m2 = 1.f;
+          break;
+        case k_bp:
+          m0 = 0.f; m1 = 1.f; m2 = 0.f;
+          break;
+        case k_hp:
+          m0 = 1.f; m1 = -k; m2 = -1.f;
+          break;
+        case k_notch:
+          m0 = 1.f; m1 = -k; m2 = 0.f;
+          break;
+        default:
+          {
+            const float m = clipminmaxf(0.f, morph, 1.f);
+            const float wl = clipminf(0.f, 1.f - 2.f * m);
+            const float wh = clipminf(0.f, 2.f * m - 1.f);
+            m0 = wh;
+            m1 = (1.f - wl - wh) - k * wh;
+            m2 = wl - wh;
+          }
+          break;
+        }
+      }
+    };
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    ZdfSvf(void) :
+      ic1(), ic2()
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      for (uint32_t ch = 0; ch < Channels; ++ch)
+        ic1[ch] = ic2[ch] = 0.f;
+    }
+
+    /**
+     * Set the target coefficients, reached across the next block.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setCoeffs(const Coeffs & c) {
+      mRamp.set(c);
+    }
+
+    /**
+     * Jump to the target coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void snap(void) {
+      mRamp.snap();
+    }
+
+    /**
+     * Process one sample of one channel with the current coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float process(const float x, const uint32_t ch = 0) {
+      return tick(mRamp.cur, x, ic1[ch], ic2[ch]);
+    }
+
+    /**
+     * Process a block of interleaved frames, in and out may be the same buffer.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, const uint32_t frames) {
+      float s1[Channels], s2[Channels];
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        s1[ch] = ic1[ch];
+        s2[ch] = ic2[ch];
+      }
+      if (mRamp.begin(frames)) {
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels) {
+          mRamp.tick();
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(mRamp.cur, in[ch], s1[ch], s2[ch]);
+        }
+        mRamp.snap();
+      }
+      else {
+        const Coeffs c = mRamp.cur;
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels)
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(c, in[ch], s1[ch], s2[ch]);
+      }
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        ic1[ch] = fp_flush(s1[ch]);
+        ic2[ch] = fp_flush(s2[ch]);
+      }
+    }
+
+    /*=========================================================================*/
+    /* Private Methods.                                                        */
+    /*=========================================================================*/
+
+  private:
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float tick(const Coeffs & c, const float x, float & ic1, float & ic2) {
+      const float v3 = x - ic2;
+      const float v1 = c.a1 * ic1 + c.a2 * v3;
+      const float v2 = ic2 + c.a2 * ic1 + c.a3 * v3;
+      ic1 = 2.f * v1 - ic1;
+      ic2 = 2.f * v2 - ic2;
+      return c.m0 * x + c.m1 * v1 + c.m2 * v2;
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+    zdf::Ramp<Coeffs> mRamp;
+    float ic1[Channels];
+    float ic2[Channels];
+  };
+
+  /*===========================================================================*/
+  /* Ladder Filter.                                                            */
+  /*===========================================================================*/
+
+  /**
+   * Four pole transistor ladder low pass, 24 dB/oct. The pass band gain is
+   * 1 / (1 + 4 res), scale the input to compensate if needed.
+   */
+  template <uint8_t Channels = 1, uint8_t Newton = 1>
+  struct ZdfLadder {
+
+    /*=========================================================================*/
+    /* Types and Data Structures.                                              */
+    /*=========================================================================*/
+
+    /**
+     * Filter coefficients
+     */
+    struct Coeffs {
+      /** One pole gain g / (1 + g) and 1 / (1 + g) */
+      float G, beta;
+      /** Feedback, k G^4 and 1 / (1 + k G^4) */
+      float k, kG4, norm;
+
+      Coeffs() :
+        G(0), beta(1),
+        k(0), kG4(0), norm(1)
+      { }
+
+      /**
+       * @param wc    Cutoff over sampling rate, [0.0001, 0.489]
+       * @param res   Resonance in [0, 1], self oscillation at 1
+       */
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void set(const float wc, const float res) {
+        const float g = zdf::prewarp(wc);
+        beta = 1.f / (1.f + g);
+        G = g * beta;
+        k = 4.f * clipminmaxf(0.f, res, 1.f);
+        const float G2 = G * G;
+        kG4 = k * G2 * G2;
+        norm = 1.f / (1.f + kG4);
+      }
+    };
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    ZdfLadder(void) :
+      s1(), s2(), s3(), s4()
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      for (uint32_t ch = 0; ch < Channels; ++ch)
+        s1[ch] = s2[ch] = s3[ch] = s4[ch] = 0.f;
+    }
+
+    /**
+     * Set the target coefficients, reached across the next block.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setCoeffs(const Coeffs & c) {
+      mRamp.set(c);
+    }
+
+    /**
+     * Jump to the target coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void snap(void) {
+      mRamp.snap();
+    }
+
+    /**
+     * Process one sample of one channel with the current coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float process(const float x, const uint32_t ch = 0) {
+      return tick(mRamp.cur, x, s1[ch], s2[ch], s3[ch], s4[ch]);
+    }
+
+    /**
+     * Process a block of interleaved frames, in and out may be the same buffer.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, const uint32_t frames) {
+      float z1[Channels], z2[Channels], z3[Channels], z4[Channels];
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        z1[ch] = s1[ch];
+        z2[ch] = s2[ch];
+        z3[ch] = s3[ch];
+        z4[ch] = s4[ch];
+      }
+      if (mRamp.begin(frames)) {
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels) {
+          mRamp.tick();
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(mRamp.cur, in[ch], z1[ch], z2[ch], z3[ch], z4[ch]);
+        }
+        mRamp.snap();
+      }
+      else {
+        const Coeffs c = mRamp.cur;
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels)
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(c, in[ch], z1[ch], z2[ch], z3[ch], z4[ch]);
+      }
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        s1[ch] = fp_flush(z1[ch]);
+        s2[ch] = fp_flush(z2[ch]);
+        s3[ch] = fp_flush(z3[ch]);
+        s4[ch] = fp_flush(z4[ch]);
+      }
+    }
+
+    /*=========================================================================*/
+    /* Private Methods.                                                        */
+    /*=========================================================================*/
+
+  private:
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float stage(const float G, const float x, float & s) {
+      const float v = G * (x - s);
+      const float y = v + s;
+      s = y + v;
+      return y;
+    }
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float tick(const Coeffs & c, const float x, float & s1, float & s2, float & s3, float & s4) {
+      // y4 = G^4 u + S, with S the contribution of the stage states
+      const float G = c.G;
+      const float S = c.beta * (G * (G * (G * s1 + s2) + s3) + s4);
+      const float u = zdf::solve_tanh<Newton>(x - c.k * S, c.kG4, c.norm);
+      const float y1 = stage(G, u, s1);
+      const float y2 = stage(G, y1, s2);
+      const float y3 = stage(G, y2, s3);
+      return stage(G, y3, s4);
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+    zdf::Ramp<Coeffs> mRamp;
+    float s1[Channels];
+    float s2[Channels];
+    float s3[Channels];
+    float s4[Channels];
+  };
+
+  /*===========================================================================*/
+  /* Diode Ladder Filter.                                                      */
+  /*===========================================================================*/
+
+  /**
+   * Four pole diode ladder low pass, the coupled stages of the TB-303 style
+   * filter: each stage is loaded by the next one, the first integrates at
+   * full rate and the others at half. Unity gain at DC without feedback,
+   * self oscillation at k = 22.13 around 0.73 of the cutoff.
+   */
+  template <uint8_t Channels = 1, uint8_t Newton = 1>
+  struct ZdfDiodeLadder {
+
+    /*=========================================================================*/
+    /* Types and Data Structures.                                              */
+    /*=========================================================================*/
+
+    /**
+     * Filter coefficients
+     */
+    struct Coeffs {
+      /** Integrator gain and its half */
+      float g, h;
+      /** Stage solve, y[i] = a[i] y[i-1] + b[i] with b[i] = (s[i] + . b[i+1]) r[i] */
+      float r1, r2, r3, r4;
+      float a1, a2, a3, a4;
+      /** Feedback, k A and 1 / (1 + k A) with A = a1 a2 a3 a4 */
+      float k, kA, norm;
+
+      Coeffs() :
+        g(0), h(0),
+        r1(1), r2(1), r3(1), r4(1),
+        a1(0), a2(0), a3(0), a4(0),
+        k(0), kA(0), norm(1)
+      { }
+
+      /**
+       * @param wc    Cutoff over sampling rate, [0.0001, 0.489]
+       * @param res   Resonance in [0, 1], self oscillation at 1
+       */
+      inline __attribute__((optimize("Ofast"),always_inline))
+      void set(const float wc, const float res) {
+        g = zdf::prewarp(wc);
+        h = 0.5f * g;
+        r4 = 1.f / (1.f + h);
+        a4 = h * r4;
+        r3 = 1.f / (1.f + g - h * a4);
+        a3 = h * r3;
+        r2 = 1.f / (1.f + g - h * a3);
+        a2 = h * r2;
+        r1 = 1.f / (1.f + 2.f * g - g * a2);
+        a1 = g * r1;
+        k = k_max * clipminmaxf(0.f, res, 1.f);
+        kA = k * a1 * a2 * a3 * a4;
+        norm = 1.f / (1.f + kA);
+      }
+    };
+
+    /*=========================================================================*/
+    /* Constructor / Destructor.                                               */
+    /*=========================================================================*/
+
+    ZdfDiodeLadder(void) :
+      s1(), s2(), s3(), s4()
+    { }
+
+    /*=========================================================================*/
+    /* Public Methods.                                                         */
+    /*=========================================================================*/
+
+    /**
+     * Flush internal delays
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void flush(void) {
+      for (uint32_t ch = 0; ch < Channels; ++ch)
+        s1[ch] = s2[ch] = s3[ch] = s4[ch] = 0.f;
+    }
+
+    /**
+     * Set the target coefficients, reached across the next block.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void setCoeffs(const Coeffs & c) {
+      mRamp.set(c);
+    }
+
+    /**
+     * Jump to the target coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    void snap(void) {
+      mRamp.snap();
+    }
+
+    /**
+     * Process one sample of one channel with the current coefficients.
+     */
+    inline __attribute__((optimize("Ofast"),always_inline))
+    float process(const float x, const uint32_t ch = 0) {
+      return tick(mRamp.cur, x, s1[ch], s2[ch], s3[ch], s4[ch]);
+    }
+
+    /**
+     * Process a block of interleaved frames, in and out may be the same buffer.
+     */
+    inline __attribute__((optimize("Ofast")))
+    void process(const float * in, float * out, const uint32_t frames) {
+      float z1[Channels], z2[Channels], z3[Channels], z4[Channels];
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        z1[ch] = s1[ch];
+        z2[ch] = s2[ch];
+        z3[ch] = s3[ch];
+        z4[ch] = s4[ch];
+      }
+      if (mRamp.begin(frames)) {
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels) {
+          mRamp.tick();
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(mRamp.cur, in[ch], z1[ch], z2[ch], z3[ch], z4[ch]);
+        }
+        mRamp.snap();
+      }
+      else {
+        const Coeffs c = mRamp.cur;
+        for (uint32_t i = 0; i < frames; ++i, in += Channels, out += Channels)
+          for (uint32_t ch = 0; ch < Channels; ++ch)
+            out[ch] = tick(c, in[ch], z1[ch], z2[ch], z3[ch], z4[ch]);
+      }
+      for (uint32_t ch = 0; ch < Channels; ++ch) {
+        s1[ch] = fp_flush(z1[ch]);
+        s2[ch] = fp_flush(z2[ch]);
+        s3[ch] = fp_flush(z3[ch]);
+        s4[ch] = fp_flush(z4[ch]);
+      }
+    }
+
+    /** Feedback at the self oscillation threshold */
+    static const float k_max;
+
+    /*=========================================================================*/
+    /* Private Methods.                                                        */
+    /*=========================================================================*/
+
+  private:
+
+    static inline __attribute__((optimize("Ofast"),always_inline))
+    float tick(const Coeffs & c, const float x, float & s1, float & s2, float & s3, float & s4) {
+      // Back substitution from the last stage, y4 = A u + B
+      const float b4 = s4 * c.r4;
+      const float b3 = (s3 + c.h * b4) * c.r3;
+      const float b2 = (s2 + c.h * b3) * c.r2;
+      const float b1 = (s1 + c.g * b2) * c.r1;
+      const float B = c.a4 * (c.a3 * (c.a2 * b1 + b2) + b3) + b4;
+      const float u = zdf::solve_tanh<Newton>(x - c.k * B, c.kA, c.norm);
+      const float y1 = c.a1 * u + b1;
+      const float y2 = c.a2 * y1 + b2;
+      const float y3 = c.a3 * y2 + b3;
+      const float y4 = c.a4 * y3 + b4;
+      s1 = 2.f * y1 - s1;
+      s2 = 2.f * y2 - s2;
+      s3 = 2.f * y3 - s3;
+      s4 = 2.f * y4 - s4;
+      return y4;
+    }
+
+    /*=========================================================================*/
+    /* Member Variables.                                                       */
+    /*=========================================================================*/
+
+    zdf::Ramp<Coeffs> mRamp;
+    float s1[Channels];
+    float s2[Channels];
+    float s3[Channels];
+    float s4[Channels];
+  };
+
+  template <uint8_t Channels, uint8_t Newton>
+  const float ZdfDiodeLadder<Channels, Newton>::k_max = 22.13f;
+
+}
+
+/** @} */
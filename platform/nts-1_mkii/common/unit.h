@@ -47,6 +47,15 @@
 #include "macros.h"
 #include "runtime.h"
 
+#ifdef UNIT_PROFILE
+#include "unit_profile.h"
+
+// Unit implementations are wrapped by the profiler in _unit_base.c
+#define unit_render unit_profiled_render
+#define unit_set_param_value unit_profiled_set_param_value
+#define unit_note_on unit_profiled_note_on
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -0,0 +1,109 @@
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ *  @file unit_profile.h
+ *
+ *  @brief Opt-in callback profiler
+ *
+ *  Define UNIT_PROFILE (e.g. UDEFS = -DUNIT_PROFILE in config.mk) to have
+ *  _unit_base.c time unit_render, unit_set_param_value and unit_note_on.
+ *  The unit's own implementations are renamed by unit.h and called from
+ *  timing wrappers, so no change to the callbacks themselves is needed.
+ *
+ *  Times are core clock cycles (DWT CYCCNT) on the device and nanoseconds on
+ *  the host. The DWT is only accessible in privileged mode, an unprivileged
+ *  access raises a BusFault. The profiler checks the mode before touching it
+ *  and, if the unit runs unprivileged, leaves the counter alone and reports
+ *  zero cycles.
+ */
+
+#ifndef UNIT_PROFILE_H_
+#define UNIT_PROFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of histogram buckets, bucket i counts calls of [2^i, 2^(i+1)) cycles per frame. */
+#define UNIT_PROFILE_NUM_BUCKETS 16
+
+enum {
+  k_unit_profile_render = 0U,
+  k_unit_profile_set_param,
+  k_unit_profile_note_on,
+  k_num_unit_profile_callbacks,
+};
+
+typedef struct unit_profile_stats {
+  uint32_t calls;   // Number of timed calls
+  uint32_t min;     // Lowest cycles per frame of a single call
+  uint32_t max;     // Highest cycles per frame of a single call
+  uint32_t last;    // Cycles per frame of the latest call
+  uint64_t cycles;  // Total cycles
+  uint64_t frames;  // Total frames, one per call for callbacks other than render
+  uint32_t histogram[UNIT_PROFILE_NUM_BUCKETS];
+} unit_profile_stats_t;
+
+/** Statistics of a callback, one of k_unit_profile_*. NULL if out of range. */
+const unit_profile_stats_t * unit_profile_get_stats(uint8_t callback);
+
+/** Clear statistics of all callbacks. */
+void unit_profile_reset(void);
+
+/** Current value of the cycle counter. */
+uint32_t unit_profile_cycles(void);
+
+/** Mean cycles per frame. */
+static inline __attribute__((always_inline))
+uint32_t unit_profile_mean(const unit_profile_stats_t * stats) {
+  return (stats->frames) ? (uint32_t)(stats->cycles / stats->frames) : 0;
+}
+
+/**
+ * Format "mean/max" cycles per frame of a callback into buf, e.g. for
+ * unit_get_param_str_value() of a hidden parameter. Large values are
+ * shortened with a k suffix to fit small displays.
+ *
+ * @return buf
+ */
+const char * unit_profile_str(uint8_t callback, char * buf, size_t size);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // UNIT_PROFILE_H_
@@ -45,6 +45,8 @@
 #ifndef __cortexm_h
 #define __cortexm_h
 
+#if defined(__arm__)
+
 #include "arm_math.h" // CMSIS
 
 /**
@@ -186,6 +188,98 @@
 
 /** @} */
 
+#else // !defined(__arm__)
+
+/**
+ * @name    Host Fill-ins
+ * @note    Portable C versions of the intrinsics used by fixed_math.h, for host builds (e.g.: hostsim).
+ *          The GE flags read by sel() are emulated for sadd16() and ssub16(), the only fill-ins that set them on
+ *          target. As on target, the saturating qadd16() and qsub16() leave them unchanged.
+ * @{
+ */
+
+#include <stdint.h>
+
+typedef int32_t simd32_t;
+
+#ifndef PI
+#define PI 3.14159265358979f // Normally provided by arm_math.h
+#endif
+
+static uint32_t host_apsr_ge;
+
+static inline __attribute__((always_inline))
+int32_t host_ssat(int32_t x, uint32_t bits) {
+  const int32_t max = (int32_t)((1UL << (bits - 1)) - 1);
+  const int32_t min = -max - 1;
+  return (x > max) ? max : (x < min) ? min : x;
+}
+
+static inline __attribute__((always_inline))
+uint32_t host_usat(int32_t x, uint32_t bits) {
+  const int32_t max = (int32_t)((1UL << bits) - 1);
+  return (x > max) ? (uint32_t)max : (x < 0) ? 0U : (uint32_t)x;
+}
+
+static inline __attribute__((always_inline))
+int32_t host_qadd(int32_t a, int32_t b) {
+  const int64_t r = (int64_t)a + b;
+  return (r > INT32_MAX) ? INT32_MAX : (r < INT32_MIN) ? INT32_MIN : (int32_t)r;
+}
+
+static inline __attribute__((always_inline))
+int32_t host_qsub(int32_t a, int32_t b) {
+  const int64_t r = (int64_t)a - b;
+  return (r > INT32_MAX) ? INT32_MAX : (r < INT32_MIN) ? INT32_MIN : (int32_t)r;
+}
+
+static inline __attribute__((always_inline))
+uint32_t host_qaddsub16(uint32_t a, uint32_t b, int32_t sign) {
+  uint32_t r = 0;
+  for (uint32_t h = 0; h < 2; ++h) {
+    const int32_t x = (int16_t)(a >> (16 * h)) + sign * (int16_t)(b >> (16 * h));
+    r |= ((uint32_t)host_ssat(x, 16) & 0xFFFFU) << (16 * h);
+  }
+  return r;
+}
+
+static inline __attribute__((always_inline))
+uint32_t host_addsub16(uint32_t a, uint32_t b, int32_t sign) {
+  uint32_t r = 0;
+  host_apsr_ge = 0;
+  for (uint32_t h = 0; h < 2; ++h) {
+    const int32_t x = (int16_t)(a >> (16 * h)) + sign * (int16_t)(b >> (16 * h));
+    if (x >= 0)
+      host_apsr_ge |= 0x3U << (2 * h);
+    r |= ((uint32_t)x & 0xFFFFU) << (16 * h);
+  }
+  return r;
+}
+
+static inline __attribute__((always_inline))
+uint32_t host_sel(uint32_t a, uint32_t b) {
+  uint32_t r = 0;
+  for (uint32_t i = 0; i < 4; ++i)
+    r |= (((host_apsr_ge >> i) & 1) ? a : b) & (0xFFU << (8 * i));
+  return r;
+}
+
+#define clz(x)      ((x) ? (uint32_t)__builtin_clz(x) : 32U)
+#define nop()       do { } while (0)
+#define ssat(x, n)  host_ssat((int32_t)(x), (n))
+#define usat(x, n)  host_usat((int32_t)(x), (n))
+#define qadd(a, b)  host_qadd((int32_t)(a), (int32_t)(b))
+#define qsub(a, b)  host_qsub((int32_t)(a), (int32_t)(b))
+#define qadd16(a, b) ((int32_t)host_qaddsub16((uint32_t)(a), (uint32_t)(b), 1))
+#define qsub16(a, b) ((int32_t)host_qaddsub16((uint32_t)(a), (uint32_t)(b), -1))
+#define sadd16(a, b) ((int32_t)host_addsub16((uint32_t)(a), (uint32_t)(b), 1))
+#define ssub16(a, b) ((int32_t)host_addsub16((uint32_t)(a), (uint32_t)(b), -1))
+#define sel(a, b)   ((int32_t)host_sel((uint32_t)(a), (uint32_t)(b)))
+
+/** @} */
+
+#endif // defined(__arm__)
+
 #endif // __cortexm_h
 
 /** @} @} */
@@ -0,0 +1,273 @@
+/*
+    BSD 3-Clause License
+
+    Copyright (c) 2018-2023, KORG INC.
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived from
+      this software without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+//*/
+
+/**
+ * @file    fp_guard.h
+ * @brief   Denormal and NaN protection for recursive DSP state.
+ *
+ * @addtogroup utils Utils
+ * @{
+ *
+ * @addtogroup utils_fp_guard Denormal/NaN Guard
+ * @{
+ *
+ * Denormals appear in decaying feedback paths (reverb tails, filter states
+ * after the input stops) and are slow on x86 and wasm. Instead of testing every
+ * sample, enable flush-to-zero around the render callback with fp_guard_begin()
+ * / fp_guard_end() and sanitize recursive state once per block with
+ * fp_sanitize_block().
+ *
+ * Checks are done on the bit pattern: units are built with fast-math, which
+ * lets the compiler remove isfinite() and (x != x) tests.
+ *
+ * Define FP_GUARD_DIAG in a host build (e.g. hostsim HOST_DEFS=-DFP_GUARD_DIAG)
+ * to count denormal and non-finite values per watched variable with
+ * FP_GUARD_WATCH(). Flush-to-zero is not enabled in that mode, so that denormals
+ * are observed as they would be without it. The counters live in _unit_base.c.
+ */
+
+#ifndef __fp_guard_h
+#define __fp_guard_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(__arm__) && (defined(__SSE__) || defined(__x86_64__))
+#include <xmmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*===========================================================================*/
+/* Floating-Point Control.                                                   */
+/*===========================================================================*/
+
+/**
+ * @name    Floating-Point Control
+ * @{
+ */
+
+/** Saved floating-point control state. */
+typedef uint32_t fp_guard_t;
+
+/** Read the floating-point control register (FPSCR, MXCSR or FPCR).
+ */
+static inline __attribute__((always_inline))
+fp_guard_t fp_guard_get(void) {
+#if defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+  uint32_t r;
+  __asm__ volatile ("vmrs %0, fpscr" : "=r" (r));
+  return r;
+#elif defined(__aarch64__)
+  uint64_t r;
+  __asm__ volatile ("mrs %0, fpcr" : "=r" (r));
+  return (uint32_t)r;
+#elif defined(__SSE__) || defined(__x86_64__)
+  return _mm_getcsr();
+#else
+  return 0;  // No control register, e.g. wasm which always supports denormals
+#endif
+}
+
+/** Write the floating-point control register.
+ */
+static inline __attribute__((always_inline))
+void fp_guard_set(fp_guard_t state) {
+#if defined(__arm__) && defined(__VFP_FP__) && !defined(__SOFTFP__)
+  __asm__ volatile ("vmsr fpscr, %0" : : "r" (state) : "memory");
+#elif defined(__aarch64__)
+  __asm__ volatile ("msr fpcr, %0" : : "r" ((uint64_t)state) : "memory");
+#elif defined(__SSE__) || defined(__x86_64__)
+  _mm_setcsr(state);
+#else
+  (void)state;
+#endif
+}
+
+/** Enable flush-to-zero and default NaN (FPSCR FZ/DN on ARM, MXCSR FTZ/DAZ on x86).
+ *  @return Previous state, to be passed to fp_guard_end().
+ */
+static inline __attribute__((always_inline))
+fp_guard_t fp_guard_begin(void) {
+  const fp_guard_t prev = fp_guard_get();
+#if !defined(FP_GUARD_DIAG)
+#if defined(__arm__) || defined(__aarch64__)
+  fp_guard_set(prev | (1U << 24) | (1U << 25));  // FZ | DN
+#elif defined(__SSE__) || defined(__x86_64__)
+  fp_guard_set(prev | 0x8040U);                   // FTZ | DAZ
+#endif
+#endif
+  return prev;
+}
+
+/** Restore the state saved by fp_guard_begin().
+ */
+static inline __attribute__((always_inline))
+void fp_guard_end(fp_guard_t prev) {
+#if !defined(FP_GUARD_DIAG)
+  fp_guard_set(prev);
+#else
+  (void)prev;
+#endif
+}
+
+/** @} */
+
+/*===========================================================================*/
+/* Classification and Sanitizers.                                            */
+/*===========================================================================*/
+
+/**
+ * @name    Classification and Sanitizers
+ * @{
+ */
+
+/** Raw IEEE754 bits of a float.
+ */
+static inline __attribute__((always_inline))
+uint32_t fp_bits(float x) {
+  union { float f; uint32_t i; } u;
+  u.f = x;
+  return u.i;
+}
+
+/** True unless x is infinite or NaN.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+int fp_is_finite(float x) {
+  return (fp_bits(x) & 0x7F800000U) != 0x7F800000U;
+}
+
+/** True if x is a non-zero denormal.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+int fp_is_denormal(float x) {
+  const uint32_t b = fp_bits(x);
+  return (b & 0x7F800000U) == 0 && (b & 0x007FFFFFU) != 0;
+}
+
+/** Replace infinite or NaN values by 0.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float fp_sanitize(float x) {
+  return fp_is_finite(x) ? x : 0.f;
+}
+
+/** Replace values below 1e-15 in magnitude, well before the denormal range, by 0.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+float fp_flush(float x) {
+  return ((fp_bits(x) & 0x7FFFFFFFU) < 0x26901D7DU) ? 0.f : x;  // 0x26901D7D = 1e-15f
+}
+
+/** Sanitize a block of recursive state, e.g. filter memories, once per render call.
+ *  Non-finite values and values below 1e-15 in magnitude are set to 0.
+ *  @return Number of non-finite values that were reset.
+ */
+static inline __attribute__((optimize("Ofast"), always_inline))
+uint32_t fp_sanitize_block(float * state, size_t n) {
+  uint32_t bad = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t b = fp_bits(state[i]);
+    const uint32_t mag = b & 0x7FFFFFFFU;
+    if (mag >= 0x7F800000U)
+      ++bad;
+    if (mag >= 0x7F800000U || mag < 0x26901D7DU)
+      state[i] = 0.f;
+  }
+  return bad;
+}
+
+/** @} */
+
+/*===========================================================================*/
+/* Host Diagnostics.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Host Diagnostics
+ * @{
+ */
+
+/** Maximum number of distinct watched variables. */
+#define FP_GUARD_DIAG_MAX_ENTRIES 64
+
+typedef struct fp_guard_diag_entry {
+  const char * name;    // Name given to FP_GUARD_WATCH
+  uint32_t checks;      // Number of values seen
+  uint32_t denormals;   // Non-zero denormal values
+  uint32_t nonfinite;   // Infinite and NaN values
+} fp_guard_diag_entry_t;
+
+#if defined(FP_GUARD_DIAG)
+
+/** Count value x under name, which must be a string literal. */
+void fp_guard_diag_record(const char * name, float x);
+
+/** Watched variables, *count receives the number of entries. */
+const fp_guard_diag_entry_t * fp_guard_diag_entries(uint32_t * count);
+
+#define FP_GUARD_WATCH(name, x) fp_guard_diag_record((name), (x))
+#define FP_GUARD_WATCH_BLOCK(name, p, n)                        \
+  do {                                                          \
+    for (size_t fp_guard_i = 0; fp_guard_i < (size_t)(n); ++fp_guard_i) \
+      fp_guard_diag_record((name), (p)[fp_guard_i]);            \
+  } while (0)
+
+#else
+
+#define FP_GUARD_WATCH(name, x) do { (void)(name); } while (0)
+#define FP_GUARD_WATCH_BLOCK(name, p, n) do { (void)(name); } while (0)
+
+#endif  // defined(FP_GUARD_DIAG)
+
+/** @} */
+
+#ifdef __cplusplus
+}  // extern "C"
+
+/** Enables flush-to-zero for the lifetime of the object, typically the body of unit_render. */
+struct FpGuardScope {
+  FpGuardScope() : prev_(fp_guard_begin()) { }
+  ~FpGuardScope() { fp_guard_end(prev_); }
+
+ private:
+  fp_guard_t prev_;
+};
+#endif
+
+#endif // __fp_guard_h
+
+/** @} @} */
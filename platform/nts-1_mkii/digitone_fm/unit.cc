@@ -9,14 +9,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "fx_api.h"
-
-// ✅ FIX: Custom fast_tanh implementation (fastertanh2f doesn't exist)
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
+#include "dsp/approx.hpp"
 
 // ========== SEQUENCER STRUCTURE ==========
 
@@ -170,8 +163,8 @@ inline float process_operator(Operator* op, float modulation) {
     // Generate sine wave
     float output = osc_sinf(mod_phase);
     
-    // ✅ FIX: Soft limiting on output (using fast_tanh)
-    output = fast_tanh(output * 0.9f);
+    // ✅ FIX: Soft limiting on output (dsp::approx::tanh)
+    output = dsp::approx::tanh<dsp::approx::k_faster>(output * 0.9f);
     
     // Apply envelope
     output *= op->amp_env;
@@ -564,8 +557,8 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         // ✅ FIX: Increased output gain (was 1.5f, now 2.5f)
         sample *= 2.5f;
         
-        // ✅ FIX: Soft limiting (using fast_tanh)
-        sample = fast_tanh(sample * 0.7f) * 1.4f;
+        // ✅ FIX: Soft limiting (dsp::approx::tanh)
+        sample = dsp::approx::tanh<dsp::approx::k_faster>(sample * 0.7f) * 1.4f;
         
         // Hard limit
         sample = clipminmaxf(-1.f, sample, 1.f);
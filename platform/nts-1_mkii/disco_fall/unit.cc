@@ -9,9 +9,13 @@
 #include "fx_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
+#include "utils/fp_guard.h"
+#include "dsp/unisonbank.hpp"
 
 #define MAX_VOICES 4
 #define SUPERSAW_VOICES 7
+#define SUB_VOICE SUPERSAW_VOICES
+#define BLOCK_SIZE 64
 #define CHORUS_BUFFER_SIZE 2048
 
 static const unit_runtime_osc_context_t *s_context;
@@ -40,8 +44,8 @@ static const float s_pan_positions[SUPERSAW_VOICES] = {
 };
 
 struct Voice {
-    float phases[SUPERSAW_VOICES];
-    float phase_sub;
+    // 7 detuned saws plus the sub oscillator
+    dsp::UnisonBank<SUPERSAW_VOICES + 1> saws;
     
     float pitch_fall_env;
     float amp_env;
@@ -58,6 +62,14 @@ struct Voice {
 
 static Voice s_voices[MAX_VOICES];
 
+// Per block buffers
+static float s_voice_l[BLOCK_SIZE];
+static float s_voice_r[BLOCK_SIZE];
+static float s_gain[BLOCK_SIZE];
+static float s_mix_l[BLOCK_SIZE];
+static float s_mix_r[BLOCK_SIZE];
+static uint8_t s_active_count[BLOCK_SIZE];
+
 // Chorus buffers
 static float s_chorus_buffer_l[CHORUS_BUFFER_SIZE];
 static float s_chorus_buffer_r[CHORUS_BUFFER_SIZE];
@@ -77,18 +89,6 @@ static float s_release_time = 0.4f;
 static float s_chorus_depth = 0.4f;
 static float s_portamento = 0.2f;
 
-// PolyBLEP anti-aliasing
-inline float poly_blep(float t, float dt) {
-    if (t < dt) {
-        t /= dt;
-        return t + t - t * t - 1.f;
-    } else if (t > 1.f - dt) {
-        t = (t - 1.f) / dt;
-        return t * t + t + t + 1.f;
-    }
-    return 0.f;
-}
-
 // Envelope processor
 inline void process_envelope(Voice* v) {
     float attack_samples = (0.01f + s_attack_time * 0.49f) * 48000.f;
@@ -113,7 +113,7 @@ inline void process_envelope(Voice* v) {
             
             // Pitch fall envelope (exponential)
             float t_sec = (float)v->env_counter / 48000.f;
-            v->pitch_fall_env = fx_pow2f(-t_sec / fall_time * 6.f);
+            v->pitch_fall_env = fastpow2f(-t_sec / fall_time * 6.f);
             break;
         }
         case 2: { // Release
@@ -157,70 +157,34 @@ inline void process_portamento(Voice* v) {
     }
 }
 
-// SuperSaw generator
-inline void generate_supersaw(Voice* v, float* out_l, float* out_r) {
-    float sum_l = 0.f;
-    float sum_r = 0.f;
+// SuperSaw voice setup, levels and pans are fixed
+inline void init_supersaw(Voice* v) {
+    for (int i = 0; i < SUPERSAW_VOICES; i++) {
+        v->saws.setSpread(i, s_detune_offsets[i]);
+        v->saws.setLevel(i, s_detune_mix[i], s_pan_positions[i]);
+    }
     
+    // Sub oscillator (mono, -1 octave), 0.25 on each side
+    v->saws.setSpread(SUB_VOICE, 0.f);
+    v->saws.setRatio(SUB_VOICE, 0.5f);
+    v->saws.setLevel(SUB_VOICE, 0.5f, 0.5f);
+}
+
+// SuperSaw generator, pitch is updated once per block
+inline void generate_supersaw(Voice* v, float* out_l, float* out_r, uint32_t frames) {
     // Calculate base frequency with pitch fall
     float base_w0 = v->current_pitch;
     float fall_semitones = s_fall_depth * 12.f;
-    float pitch_mod = fx_pow2f(-fall_semitones * v->pitch_fall_env / 12.f);
+    float pitch_mod = fastpow2f(-fall_semitones * v->pitch_fall_env / 12.f);
     base_w0 *= pitch_mod;
     
     // Clamp base_w0
     base_w0 = clipminmaxf(0.0001f, base_w0, 0.45f);
     
-    // Generate 7 detuned saws
-    for (int i = 0; i < SUPERSAW_VOICES; i++) {
-        float detune_cents = s_detune_offsets[i] * s_detune_amount * 50.f;
-        float detune_ratio = fx_pow2f(detune_cents / 1200.f);
-        float w = base_w0 * detune_ratio;
-        w = clipminmaxf(0.0001f, w, 0.45f);
-        
-        // Generate sawtooth with PolyBLEP
-        float p = v->phases[i];
-        float saw = 2.f * p - 1.f;
-        saw -= poly_blep(p, w);
-        
-        // Safety check
-        if (p != p) p = 0.f;  // NaN check
-        if (saw != saw) saw = 0.f;
-        
-        // Apply mix and pan
-        float level = s_detune_mix[i];
-        float pan = s_pan_positions[i];
-        
-        sum_l += saw * level * (1.f - pan);
-        sum_r += saw * level * pan;
-        
-        // Advance phase
-        v->phases[i] += w;
-        while (v->phases[i] >= 1.f) v->phases[i] -= 1.f;
-        while (v->phases[i] < 0.f) v->phases[i] += 1.f;
-    }
-    
-    // Add sub oscillator (mono, -1 octave)
-    float sub_w = base_w0 * 0.5f;
-    sub_w = clipminmaxf(0.0001f, sub_w, 0.45f);
-    
-    float sub_p = v->phase_sub;
-    float sub = 2.f * sub_p - 1.f;
-    sub -= poly_blep(sub_p, sub_w);
-    sub *= 0.25f;
-    
-    // Safety check
-    if (sub != sub) sub = 0.f;
-    
-    sum_l += sub;
-    sum_r += sub;
-    
-    v->phase_sub += sub_w;
-    while (v->phase_sub >= 1.f) v->phase_sub -= 1.f;
-    while (v->phase_sub < 0.f) v->phase_sub += 1.f;
-    
-    *out_l = sum_l;
-    *out_r = sum_r;
+    // Detune ratios are only recomputed when the amount changes
+    v->saws.setDetune(s_detune_amount * 50.f);
+    v->saws.setPitch(base_w0);
+    v->saws.renderSaw(out_l, out_r, frames);
 }
 
 // High-pass filter (30Hz cutoff)
@@ -238,10 +202,6 @@ inline void process_hpf(float* in_l, float* in_r) {
     s_hpf_z1_l = alpha * (*in_l - s_hpf_z1_l) + s_hpf_z1_l;
     s_hpf_z1_r = alpha * (*in_r - s_hpf_z1_r) + s_hpf_z1_r;
     
-    // Denormal kill
-    if (si_fabsf(s_hpf_z1_l) < 1e-15f) s_hpf_z1_l = 0.f;
-    if (si_fabsf(s_hpf_z1_r) < 1e-15f) s_hpf_z1_r = 0.f;
-    
     *in_l = *in_l - s_hpf_z1_l;
     *in_r = *in_r - s_hpf_z1_r;
 }
@@ -267,10 +227,6 @@ inline void process_chorus(float* in_l, float* in_r) {
     float wet_l = s_chorus_buffer_l[read_pos];
     float wet_r = s_chorus_buffer_r[read_pos];
     
-    // Safety check
-    if (wet_l != wet_l) wet_l = 0.f;
-    if (wet_r != wet_r) wet_r = 0.f;
-    
     float mix = s_chorus_depth * 0.3f;
     *in_l = *in_l * (1.f - mix) + wet_l * mix;
     *in_r = *in_r * (1.f - mix) + wet_r * mix;
@@ -289,10 +245,8 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     
     // Init voices
     for (int v = 0; v < MAX_VOICES; v++) {
-        for (int i = 0; i < SUPERSAW_VOICES; i++) {
-            s_voices[v].phases[i] = 0.f;
-        }
-        s_voices[v].phase_sub = 0.f;
+        init_supersaw(&s_voices[v]);
+        s_voices[v].saws.reset();
         s_voices[v].pitch_fall_env = 0.f;
         s_voices[v].amp_env = 0.f;
         s_voices[v].env_stage = 3;
@@ -332,76 +286,91 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
     (void)in;
     
-    for (uint32_t f = 0; f < frames; f++) {
-        float sum_l = 0.f;
-        float sum_r = 0.f;
-        int active_count = 0;
+    // Sanitize the high-pass state once per block
+    FP_GUARD_WATCH("hpf.z1_l", s_hpf_z1_l);
+    FP_GUARD_WATCH("hpf.z1_r", s_hpf_z1_r);
+    fp_sanitize_block(&s_hpf_z1_l, 1);
+    fp_sanitize_block(&s_hpf_z1_r, 1);
+    
+    while (frames) {
+        const uint32_t n = (frames < BLOCK_SIZE) ? frames : BLOCK_SIZE;
+        
+        for (uint32_t f = 0; f < n; f++) {
+            s_mix_l[f] = 0.f;
+            s_mix_r[f] = 0.f;
+            s_active_count[f] = 0;
+        }
         
         for (int v = 0; v < MAX_VOICES; v++) {
             Voice* voice = &s_voices[v];
             if (!voice->active) continue;
             
-            process_envelope(voice);
-            process_portamento(voice);
+            // Envelope and velocity gain per sample
+            float vel_scale = (float)voice->velocity / 127.f;
+            vel_scale = 0.5f + vel_scale * 0.5f;
             
-            if (voice->amp_env < 0.001f && voice->env_stage >= 2) {
-                voice->active = false;
-                continue;
+            for (uint32_t f = 0; f < n; f++) {
+                if (!voice->active) {
+                    s_gain[f] = 0.f;
+                    continue;
+                }
+                
+                process_envelope(voice);
+                process_portamento(voice);
+                
+                if (voice->amp_env < 0.001f && voice->env_stage >= 2) {
+                    voice->active = false;
+                    s_gain[f] = 0.f;
+                    continue;
+                }
+                
+                s_gain[f] = voice->amp_env * vel_scale;
+                s_active_count[f]++;
             }
             
-            float voice_l = 0.f;
-            float voice_r = 0.f;
-            generate_supersaw(voice, &voice_l, &voice_r);
+            generate_supersaw(voice, s_voice_l, s_voice_r, n);
             
-            // Safety check
-            if (voice_l != voice_l) voice_l = 0.f;
-            if (voice_r != voice_r) voice_r = 0.f;
+            for (uint32_t f = 0; f < n; f++) {
+                float voice_l = s_voice_l[f];
+                float voice_r = s_voice_r[f];
+                
+                s_mix_l[f] += voice_l * s_gain[f];
+                s_mix_r[f] += voice_r * s_gain[f];
+            }
+        }
+        
+        for (uint32_t f = 0; f < n; f++) {
+            float sum_l = s_mix_l[f];
+            float sum_r = s_mix_r[f];
             
-            // Apply envelope
-            voice_l *= voice->amp_env;
-            voice_r *= voice->amp_env;
+            if (s_active_count[f] > 0) {
+                sum_l /= (float)s_active_count[f];
+                sum_r /= (float)s_active_count[f];
+            }
             
-            // Velocity sensitivity
-            float vel_scale = (float)voice->velocity / 127.f;
-            vel_scale = 0.5f + vel_scale * 0.5f;
-            voice_l *= vel_scale;
-            voice_r *= vel_scale;
+            // High-pass filter
+            process_hpf(&sum_l, &sum_r);
             
-            sum_l += voice_l;
-            sum_r += voice_r;
-            active_count++;
-        }
-        
-        if (active_count > 0) {
-            sum_l /= (float)active_count;
-            sum_r /= (float)active_count;
+            // Chorus
+            process_chorus(&sum_l, &sum_r);
+            
+            // Mono mix
+            float mono = (sum_l + sum_r) * 0.5f;
+            
+            // Output gain
+            mono *= 2.2f;
+            
+            // Hard limit
+            out[f] = clipminmaxf(-1.f, mono, 1.f);
+            
+            s_chorus_write = (s_chorus_write + 1) % CHORUS_BUFFER_SIZE;
         }
         
-        // Safety check
-        if (sum_l != sum_l) sum_l = 0.f;
-        if (sum_r != sum_r) sum_r = 0.f;
-        
-        // High-pass filter
-        process_hpf(&sum_l, &sum_r);
-        
-        // Chorus
-        process_chorus(&sum_l, &sum_r);
-        
-        // Mono mix
-        float mono = (sum_l + sum_r) * 0.5f;
-        
-        // Safety check
-        if (mono != mono) mono = 0.f;
-        
-        // Output gain
-        mono *= 2.2f;
-        
-        // Hard limit
-        out[f] = clipminmaxf(-1.f, mono, 1.f);
-        
-        s_chorus_write = (s_chorus_write + 1) % CHORUS_BUFFER_SIZE;
+        out += n;
+        frames -= n;
     }
 }
 
@@ -422,10 +391,7 @@ __unit_callback void unit_note_on(uint8_t note, uint8_t velocity) {
     voice->active = true;
     
     // Reset phases
-    for (int i = 0; i < SUPERSAW_VOICES; i++) {
-        voice->phases[i] = 0.f;
-    }
-    voice->phase_sub = 0.f;
+    voice->saws.reset();
     
     // Set pitch
     voice->target_pitch = osc_w0f_for_note(note, 0);
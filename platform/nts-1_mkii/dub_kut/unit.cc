@@ -13,11 +13,8 @@
 #include "fx_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
-
-// ========== NaN/Inf CHECK MACRO (FIXED!) ==========
-// ✅ FIX: Correct NaN detection (NaN != NaN is TRUE)
-// Note: si_isfinite() not available for delfx, using correct macro instead
-#define is_finite(x) ((x) != (x) ? false : ((x) <= 1e10f && (x) >= -1e10f))
+#include "dsp/approx.hpp"
+#include "utils/fp_guard.h"
 
 // ========== DELAY MODES ==========
 enum DelayMode {
@@ -77,20 +74,10 @@ static bool s_freeze = false;
 
 static float s_tempo_bpm = 120.f;
 
-// ========== FAST TANH ==========
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // ========== ONE-POLE FILTER ==========
 inline float one_pole_lp(float input, float cutoff, float *z1) {
     float g = clipminmaxf(0.01f, cutoff, 0.99f);
     *z1 = *z1 + g * (input - *z1);
-    
-    if (si_fabsf(*z1) < 1e-15f) *z1 = 0.f;
     return *z1;
 }
 
@@ -98,7 +85,7 @@ inline float one_pole_lp(float input, float cutoff, float *z1) {
 inline float saturate(float input, float amount) {
     if (amount < 0.01f) return input;
     float drive = 1.f + amount * 4.f;
-    return fast_tanh(input * drive);
+    return dsp::approx::tanh<dsp::approx::k_faster>(input * drive);
 }
 
 // ========== BIT CRUSHER ==========
@@ -106,7 +93,7 @@ inline float bit_crush(float input, float amount) {
     if (amount < 0.01f) return input;
     
     float bits = 16.f - amount * 14.f;
-    float steps = fx_pow2f(bits);
+    float steps = fastpow2f(bits);
     
     int32_t quantized = (int32_t)(input * steps);
     return (float)quantized / steps;
@@ -116,7 +103,7 @@ inline float bit_crush(float input, float amount) {
 inline float pitch_shift_sample(float input, int8_t semitones) {
     if (semitones == 0) return input;
     
-    float ratio = fx_pow2f((float)semitones / 12.f);
+    float ratio = fastpow2f((float)semitones / 12.f);
     return input * (0.7f + 0.3f * ratio);
 }
 
@@ -130,8 +117,6 @@ inline float delay_read(float *buffer, uint32_t delay_samples) {
     
     float sample = buffer[read_pos];
     
-    if (!is_finite(sample)) sample = 0.f;
-    
     return sample;
 }
 
@@ -235,6 +220,8 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+    
     if (!s_delay_buffer_l || !s_delay_buffer_r) {
         // Safety: passthrough if no buffer
         for (uint32_t f = 0; f < frames; f++) {
@@ -244,6 +231,12 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         return;
     }
     
+    // Sanitize the feedback filter state once per block
+    FP_GUARD_WATCH("filter.z1_l", s_filter_z1_l);
+    FP_GUARD_WATCH("filter.z1_r", s_filter_z1_r);
+    fp_sanitize_block(&s_filter_z1_l, 1);
+    fp_sanitize_block(&s_filter_z1_r, 1);
+    
     // Calculate delay time
     float beats_per_second = s_tempo_bpm / 60.f;
     float delay_time = tempo_divisions[s_time_div] / beats_per_second;
@@ -268,9 +261,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float in_l = in[f * 2];
         float in_r = in[f * 2 + 1];
         
-        if (!is_finite(in_l)) in_l = 0.f;
-        if (!is_finite(in_r)) in_r = 0.f;
-        
         in_l = clipminmaxf(-1.f, in_l, 1.f);
         in_r = clipminmaxf(-1.f, in_r, 1.f);
         
@@ -330,15 +320,12 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
             write_r = in_r + delayed_r * feedback_amount;
         }
         
-        write_l = fast_tanh(write_l * 0.7f) * 1.4f;
-        write_r = fast_tanh(write_r * 0.7f) * 1.4f;
+        write_l = dsp::approx::tanh<dsp::approx::k_faster>(write_l * 0.7f) * 1.4f;
+        write_r = dsp::approx::tanh<dsp::approx::k_faster>(write_r * 0.7f) * 1.4f;
         
         write_l = clipminmaxf(-2.f, write_l, 2.f);
         write_r = clipminmaxf(-2.f, write_r, 2.f);
         
-        if (!is_finite(write_l)) write_l = 0.f;
-        if (!is_finite(write_r)) write_r = 0.f;
-        
         s_delay_buffer_l[s_write_pos] = write_l;
         s_delay_buffer_r[s_write_pos] = write_r;
         
@@ -351,9 +338,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float out_l = in_l * dry_gain + delayed_l * wet_gain;
         float out_r = in_r * dry_gain + delayed_r * wet_gain;
         
-        if (!is_finite(out_l)) out_l = in_l;
-        if (!is_finite(out_r)) out_r = in_r;
-        
         out[f * 2] = clipminmaxf(-1.f, out_l, 1.f);
         out[f * 2 + 1] = clipminmaxf(-1.f, out_r, 1.f);
     }
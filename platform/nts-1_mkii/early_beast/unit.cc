@@ -14,6 +14,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
+#include "dsp/noisegen.hpp"
 
 #define NUM_EARLY_TAPS 16
 #define NUM_LATE_TAPS 4
@@ -84,7 +85,7 @@ static float s_low_z1_r = 0.f;
 
 // ========== RANDOM STATE ==========
 
-static uint32_t s_rand_state = 12345;
+static dsp::NoiseGen s_noise_gen;
 
 // ✅ FIX: Pre-calculated random offsets (updated slowly)
 static float s_tap_random_offsets_l[NUM_EARLY_TAPS];
@@ -107,10 +108,7 @@ static float s_late_mix = 0.3f;
 // ========== RANDOM GENERATOR ==========
 
 inline float random_float() {
-    s_rand_state ^= s_rand_state << 13;
-    s_rand_state ^= s_rand_state >> 17;
-    s_rand_state ^= s_rand_state << 5;
-    return (float)(s_rand_state % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ✅ FIX: Update random offsets slowly (not per sample!)
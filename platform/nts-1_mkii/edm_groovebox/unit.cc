@@ -41,6 +41,9 @@ PARAMETERS:
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "osc_api.h"
+#include "dsp/approx.hpp"
+
+#include "wavetables.h"
 
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
 #ifndef PI
@@ -49,12 +52,10 @@ PARAMETERS:
 
 #define MAX_VOICES 3
 #define SEQUENCER_STEPS 16
-#define SINE_TABLE_SIZE 256
 
 static const unit_runtime_osc_context_t *s_context;
 
-// Sine table
-static float s_sine_table[SINE_TABLE_SIZE];
+// Sine table, s_sine_table[] from wavetables.h (tools/wavetable-gen)
 
 // ========== KICK DRUM SYNTHESIS ==========
 struct KickDrum {
@@ -155,21 +156,16 @@ static bool s_latch_mode = true;          // Latch mode enabled (keeps running)
 
 // ========== HELPER FUNCTIONS ==========
 
-void init_sine_table() {
-    for (int i = 0; i < SINE_TABLE_SIZE; i++) {
-        float phase = (float)i / (float)SINE_TABLE_SIZE;
-        s_sine_table[i] = osc_sinf(phase);
-    }
-}
-
 inline float sine_lookup(float phase) {
     phase -= (int32_t)phase;
     if (phase < 0.f) phase += 1.f;
-    float idx_f = phase * (float)(SINE_TABLE_SIZE - 1);
+    // The table carries a guard sample, no wrap needed for idx0 + 1. A tiny
+    // negative phase rounds to exactly 1 above, the mask folds it back to 0.
+    float idx_f = phase * (float)SINE_TABLE_SIZE;
     uint32_t idx0 = (uint32_t)idx_f;
-    uint32_t idx1 = (idx0 + 1) % SINE_TABLE_SIZE;
     float frac = idx_f - (float)idx0;
-    return s_sine_table[idx0] * (1.f - frac) + s_sine_table[idx1] * frac;
+    idx0 &= SINE_TABLE_SIZE - 1;
+    return s_sine_table[idx0] * (1.f - frac) + s_sine_table[idx0 + 1] * frac;
 }
 
 // FIXED: Use fastpow2f (correct SDK function from utils/float_math.h)
@@ -188,14 +184,6 @@ inline float white_noise() {
     return ((float)(s_noise_seed >> 16) / 32768.f) - 1.f;
 }
 
-// FIXED: Add fast_tanh function (like in tr909)
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // ========== KICK DRUM SYNTHESIS ==========
 inline void trigger_kick() {
     s_kick.phase = 0.f;
@@ -410,8 +398,6 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     
     s_context = static_cast<const unit_runtime_osc_context_t*>(desc->hooks.runtime_context);
     
-    init_sine_table();
-    
     // Init kick
     s_kick.active = false;
     
@@ -483,7 +469,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float sig = kick_sig + clap_sig + hat_sig + chord_sig;
         
         // Soft clip
-        sig = fast_tanh(sig * 1.5f);
+        sig = dsp::approx::tanh<dsp::approx::k_faster>(sig * 1.5f);
         
         // FIXED: Increased output volume from 2.5f to 16.0f (like tr909)
         out[f] = clipminmaxf(-1.f, sig * 16.0f, 1.f);
@@ -19,14 +19,7 @@
 #include "osc_api.h"
 #include "utils/float_math.h"
 #include "fx_api.h"
-
-// ========== FAST TANH ==========
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
+#include "dsp/approx.hpp"
 
 // ========== NaN/Inf CHECK MACRO ==========
 #define is_finite(x) ((x) == (x) && (x) <= 1e10f && (x) >= -1e10f)
@@ -161,7 +154,7 @@ inline float generate_waveshape() {
     float saw = osc_saw(s_voice.phase_master);
     
     // Soft fold
-    float fold = fast_tanh(saw * (1.f + s_character * 4.f));
+    float fold = dsp::approx::tanh<dsp::approx::k_faster>(saw * (1.f + s_character * 4.f));
     
     // Bit crush
     float bits = 8.f + (1.f - s_character) * 8.f;
@@ -200,7 +193,7 @@ inline float add_harmonics(float base) {
 inline float apply_drive(float input) {
     if (s_drive < 0.01f) return input;
     
-    float driven = fast_tanh(input * (1.f + s_drive * 3.f));
+    float driven = dsp::approx::tanh<dsp::approx::k_faster>(input * (1.f + s_drive * 3.f));
     return input * (1.f - s_drive * 0.6f) + driven * s_drive * 0.6f;
 }
 
@@ -12,10 +12,7 @@
 #include "unit_modfx.h"
 #include "fx_api.h"
 #include "utils/float_math.h"
-
-// ========== NaN/Inf CHECK MACRO (FIXED!) ==========
-// ✅ FIX: Correct NaN detection (NaN != NaN is TRUE)
-#define is_finite(x) ((x) == (x) && (x) <= 1e10f && (x) >= -1e10f)
+#include "utils/fp_guard.h"
 
 // ========== DIRECTION MODES ==========
 
@@ -122,9 +119,6 @@ inline float delay_read(float *buffer, float delay_samples) {
     
     float result = buffer[read_pos_0] * (1.f - frac) + buffer[read_pos_1] * frac;
     
-    // ✅ FIX: Validate read result
-    if (!is_finite(result)) result = 0.f;
-    
     return result;
 }
 
@@ -136,9 +130,6 @@ inline void apply_tone(float *l, float *r) {
     s_tone_z1_l += coeff * (*l - s_tone_z1_l);
     s_tone_z1_r += coeff * (*r - s_tone_z1_r);
     
-    if (si_fabsf(s_tone_z1_l) < 1e-15f) s_tone_z1_l = 0.f;
-    if (si_fabsf(s_tone_z1_r) < 1e-15f) s_tone_z1_r = 0.f;
-    
     *l = s_tone_z1_l * (1.f - s_tone * 0.3f) + *l * (0.7f + s_tone * 0.3f);
     *r = s_tone_z1_r * (1.f - s_tone * 0.3f) + *r * (0.7f + s_tone * 0.3f);
 }
@@ -159,10 +150,6 @@ inline void apply_stereo(float *l, float *r) {
 // ========== MAIN PROCESSOR ==========
 
 inline void process_eternal_flanger(float in_l, float in_r, float *out_l, float *out_r) {
-    // Input validation
-    if (!is_finite(in_l)) in_l = 0.f;
-    if (!is_finite(in_r)) in_r = 0.f;
-    
     in_l = clipminmaxf(-1.f, in_l, 1.f);
     in_r = clipminmaxf(-1.f, in_r, 1.f);
     
@@ -195,9 +182,6 @@ inline void process_eternal_flanger(float in_l, float in_r, float *out_l, float
         float delayed_l = delay_read(s_delay_buffer_l, delay_samples);
         float delayed_r = delay_read(s_delay_buffer_r, delay_samples);
         
-        if (!is_finite(delayed_l)) delayed_l = 0.f;
-        if (!is_finite(delayed_r)) delayed_r = 0.f;
-        
         // ✅ FIX: Safe feedback (max 0.85!)
         if (s_feedback > 0.01f) {
             float fb_amt = clipminmaxf(0.f, s_feedback, 0.85f) * 0.6f;
@@ -208,9 +192,6 @@ inline void process_eternal_flanger(float in_l, float in_r, float *out_l, float
             stage->feedback_state_l = clipminmaxf(-2.f, stage->feedback_state_l, 2.f);
             stage->feedback_state_r = clipminmaxf(-2.f, stage->feedback_state_r, 2.f);
             
-            if (si_fabsf(stage->feedback_state_l) < 1e-15f) stage->feedback_state_l = 0.f;
-            if (si_fabsf(stage->feedback_state_r) < 1e-15f) stage->feedback_state_r = 0.f;
-            
             delayed_l = stage->feedback_state_l;
             delayed_r = stage->feedback_state_r;
         }
@@ -246,9 +227,6 @@ inline void process_eternal_flanger(float in_l, float in_r, float *out_l, float
     apply_tone(&wet_l, &wet_r);
     apply_stereo(&wet_l, &wet_r);
     
-    if (!is_finite(wet_l)) wet_l = 0.f;
-    if (!is_finite(wet_r)) wet_r = 0.f;
-    
     // Mix
     *out_l = in_l * (1.f - s_mix) + wet_l * s_mix;
     *out_r = in_r * (1.f - s_mix) + wet_r * s_mix;
@@ -336,6 +314,20 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+    
+    // Sanitize the recursive state once per block
+    for (uint8_t i = 0; i < NUM_STAGES; i++) {
+        FP_GUARD_WATCH("stage.feedback_l", s_stages[i].feedback_state_l);
+        FP_GUARD_WATCH("stage.feedback_r", s_stages[i].feedback_state_r);
+        fp_sanitize_block(&s_stages[i].feedback_state_l, 1);
+        fp_sanitize_block(&s_stages[i].feedback_state_r, 1);
+    }
+    FP_GUARD_WATCH("tone.z1_l", s_tone_z1_l);
+    FP_GUARD_WATCH("tone.z1_r", s_tone_z1_r);
+    fp_sanitize_block(&s_tone_z1_l, 1);
+    fp_sanitize_block(&s_tone_z1_r, 1);
+    
     const float *in_ptr = in;
     float *out_ptr = out;
     
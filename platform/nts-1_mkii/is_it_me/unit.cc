@@ -27,6 +27,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
+#include "utils/fp_guard.h"
 #include "macros.h"
 #include <algorithm>
 
@@ -105,9 +106,6 @@ struct BiquadFilter {
         z2 = z1;
         z1 = input;
 
-        // Anti-denormal
-        if (si_fabsf(output) < 1e-15f) output = 0.f;
-
         return clipminmaxf(-2.f, output, 2.f);
     }
 };
@@ -128,15 +126,10 @@ struct CombFilter {
         uint32_t read_pos = (write_pos + 1) % delay_length;
         float delayed = buffer[read_pos];
 
-        // Anti-denormal
-        if (si_fabsf(delayed) < 1e-15f) delayed = 0.f;
-
         // One-pole lowpass damping
         damp_z = delayed * (1.f - damp_coeff) + damp_z * damp_coeff;
         damp_z = clipminmaxf(-2.f, damp_z, 2.f);
 
-        if (si_fabsf(damp_z) < 1e-15f) damp_z = 0.f;
-
         // Feedback with soft clip
         float fb_signal = input + damp_z * feedback;
         fb_signal = fastertanhf(fb_signal * 0.5f) * 2.f;
@@ -162,8 +155,6 @@ struct AllpassFilter {
         uint32_t read_pos = (write_pos + 1) % delay_length;
         float delayed = buffer[read_pos];
 
-        if (si_fabsf(delayed) < 1e-15f) delayed = 0.f;
-
         float output = -input + delayed;
 
         float fb_signal = input + delayed * feedback;
@@ -362,6 +353,16 @@ __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
 {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+
+    // The comb damping state is the only recursive filter memory, sanitize it once per block
+    for (int i = 0; i < NUM_COMBS; i++) {
+        FP_GUARD_WATCH("comb.damp_z", s_combs_l[i].damp_z);
+        FP_GUARD_WATCH("comb.damp_z", s_combs_r[i].damp_z);
+        fp_sanitize_block(&s_combs_l[i].damp_z, 1);
+        fp_sanitize_block(&s_combs_r[i].damp_z, 1);
+    }
+
     // Mode-specific scaling
     float size_scale, feedback_scale, damping_scale;
 
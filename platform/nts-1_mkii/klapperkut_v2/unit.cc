@@ -20,11 +20,6 @@
 #define PI 3.14159265359f
 #endif
 
-// ========== NaN/Inf CHECK MACRO (FIXED!) ==========
-// ✅ FIX: Correct NaN detection (NaN != NaN is TRUE)
-// Note: si_isfinite() not available for modfx, using correct macro instead
-#define is_finite(x) ((x) != (x) ? false : ((x) <= 1e10f && (x) >= -1e10f))
-
 // ========== MEMORY ==========
 #define MAX_DELAY_SAMPLES 480
 #define NUM_ALLPASS 4
@@ -118,8 +113,6 @@ inline float delay_read(float *buffer, float delay_samples, uint32_t write_pos,
     
     float sample = buffer[read_pos_0] * (1.f - frac) + buffer[read_pos_1] * frac;
     
-    if (!is_finite(sample)) sample = 0.f;
-    
     return sample;
 }
 
@@ -304,9 +297,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float in_l = in_ptr[0];
         float in_r = in_ptr[1];
         
-        if (!is_finite(in_l)) in_l = 0.f;
-        if (!is_finite(in_r)) in_r = 0.f;
-        
         in_l = clipminmaxf(-1.f, in_l, 1.f);
         in_r = clipminmaxf(-1.f, in_r, 1.f);
         
@@ -350,9 +340,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
             default:            wet_l = in_l; wet_r = in_r; break;
         }
         
-        if (!is_finite(wet_l)) wet_l = 0.f;
-        if (!is_finite(wet_r)) wet_r = 0.f;
-        
         // ✅ FIX: Apply fade during mode transition
         wet_l *= (1.f - fade);
         wet_r *= (1.f - fade);
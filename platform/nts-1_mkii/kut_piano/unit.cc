@@ -8,17 +8,19 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "macros.h"
+#include "dsp/approx.hpp"
+#include "dsp/mipmapwavetable.hpp"
+
+#include "wavetables.h"
 
-#define WAVETABLE_SIZE 512
-#define NUM_WAVETABLES 4
 #define MAX_VOICES 4
 #define CHORUS_BUFFER_SIZE 1024
 #define MAX_CHORD_NOTES 4
 
 static const unit_runtime_osc_context_t *s_context;
 
-// Wavetables (procedurally generated in init)
-static float s_wavetable[NUM_WAVETABLES][WAVETABLE_SIZE];
+// Band limited wavetables, generated from wavetables.txt by tools/wavetable-gen
+typedef dsp::MipmapWavetable<M1_WAVETABLE_SIZE_EXP, M1_WAVETABLE_LEVELS> M1Wavetable;
 
 // Wavetable indices:
 // 0 = LOW (warm, full body)
@@ -110,79 +112,11 @@ static const M1Preset s_m1_presets[8] = {
     {0.88f, 0.50f, 0.65f, 0.70f, 0.40f, "TRANCE"}
 };
 
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
-void generate_m1_wavetables() {
-    // WAVETABLE 0: LOW (Warm, full-bodied)
-    for (int i = 0; i < WAVETABLE_SIZE; i++) {
-        float phase = (float)i / (float)WAVETABLE_SIZE;
-        float fundamental = osc_sinf(phase);
-        float h2 = osc_sinf(phase * 2.f) * 0.6f;
-        float h3 = osc_sinf(phase * 3.f) * 0.4f;
-        float h4 = osc_sinf(phase * 4.f) * 0.2f;
-        float h5 = osc_sinf(phase * 5.f) * 0.15f;
-        s_wavetable[0][i] = (fundamental + h2 + h3 + h4 + h5) / 2.35f;
-    }
-    
-    // WAVETABLE 1: MID (Classic M1 - bright, percussive)
-    for (int i = 0; i < WAVETABLE_SIZE; i++) {
-        float phase = (float)i / (float)WAVETABLE_SIZE;
-        float fundamental = osc_sinf(phase);
-        float h2 = osc_sinf(phase * 2.f) * 0.4f;
-        float h3 = osc_sinf(phase * 3.f) * 0.8f;  // Strong 3rd!
-        float h4 = osc_sinf(phase * 4.f) * 0.3f;
-        float h5 = osc_sinf(phase * 5.f) * 0.6f; // Strong 5th!
-        float h7 = osc_sinf(phase * 7.f) * 0.4f;
-        float h9 = osc_sinf(phase * 9.f) * 0.25f;
-        
-        float sum = fundamental + h2 + h3 + h4 + h5 + h7 + h9;
-        
-        float metallic = osc_sinf(phase * 11.f) * 0.15f;
-        float bell = osc_sinf(phase * 13.f) * 0.12f;
-        
-        s_wavetable[1][i] = (sum + metallic + bell) / 3.2f;
-    }
-    
-    // WAVETABLE 2: HIGH (Thin, glassy, trebly)
-    for (int i = 0; i < WAVETABLE_SIZE; i++) {
-        float phase = (float)i / (float)WAVETABLE_SIZE;
-        float fundamental = osc_sinf(phase) * 0.5f;
-        float h3 = osc_sinf(phase * 3.f) * 0.7f;
-        float h5 = osc_sinf(phase * 5.f) * 0.6f;
-        float h7 = osc_sinf(phase * 7.f) * 0.5f;
-        float h9 = osc_sinf(phase * 9.f) * 0.4f;
-        float h11 = osc_sinf(phase * 11.f) * 0.3f;
-        
-        s_wavetable[2][i] = (fundamental + h3 + h5 + h7 + h9 + h11) / 3.0f;
-    }
-    
-    // WAVETABLE 3: SOFT (Mellow velocity layer)
-    for (int i = 0; i < WAVETABLE_SIZE; i++) {
-        float phase = (float)i / (float)WAVETABLE_SIZE;
-        float fundamental = osc_sinf(phase);
-        float h2 = osc_sinf(phase * 2.f) * 0.5f;
-        float h3 = osc_sinf(phase * 3.f) * 0.3f;
-        float h4 = osc_sinf(phase * 4.f) * 0.15f;
-        s_wavetable[3][i] = (fundamental + h2 + h3 + h4) / 1.95f;
-    }
-}
-
-inline float wavetable_read(int table_idx, float phase) {
+inline float wavetable_read(int table_idx, uint32_t level, float phase) {
     phase = phase - (int32_t)phase;
     if (phase < 0.f) phase += 1.f;
     
-    float idx_f = phase * (float)(WAVETABLE_SIZE - 1);
-    uint32_t idx0 = (uint32_t)idx_f;
-    uint32_t idx1 = (idx0 + 1) % WAVETABLE_SIZE;
-    float frac = idx_f - (float)idx0;
-    
-    return s_wavetable[table_idx][idx0] * (1.f - frac) + 
-           s_wavetable[table_idx][idx1] * frac;
+    return M1Wavetable::read(s_m1_wavetable[table_idx], level, phase);
 }
 
 inline int select_wavetable(uint8_t note, uint8_t velocity) {
@@ -324,8 +258,6 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
 
     s_context = static_cast<const unit_runtime_osc_context_t *>(desc->hooks.runtime_context);
 
-    generate_m1_wavetables();
-    
     for (int i = 0; i < MAX_VOICES; i++) {
         s_voices[i].phase = 0.f;
         s_voices[i].active = false;
@@ -399,6 +331,9 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
             
             int wave_idx = select_wavetable(voice->note, voice->velocity);
             
+            float w0 = osc_w0f_for_note(voice->note, mod);
+            uint32_t level = M1Wavetable::level(w0, M1_WAVETABLE_W_BASE);
+            
             float brightness_mod = s_brightness;
             if (voice->velocity > 90) {
                 brightness_mod += 0.15f;
@@ -406,8 +341,8 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
             
             if (brightness_mod > 0.5f && wave_idx == 1) {
                 float morph = (brightness_mod - 0.5f) * 2.f;
-                float w1 = wavetable_read(1, voice->phase);
-                float w2 = wavetable_read(2, voice->phase);
+                float w1 = wavetable_read(1, level, voice->phase);
+                float w2 = wavetable_read(2, level, voice->phase);
                 float sig = w1 * (1.f - morph) + w2 * morph;
                 
                 float attack_transient = 0.f;
@@ -425,10 +360,10 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
                 float phase_r = voice->phase + detune_amount;
                 if (phase_r >= 1.f) phase_r -= 1.f;
                 
-                sig_l += wavetable_read(wave_idx, phase_l) * env * velocity_scale;
-                sig_r += wavetable_read(wave_idx, phase_r) * env * velocity_scale;
+                sig_l += wavetable_read(wave_idx, level, phase_l) * env * velocity_scale;
+                sig_r += wavetable_read(wave_idx, level, phase_r) * env * velocity_scale;
             } else {
-                float sig = wavetable_read(wave_idx, voice->phase);
+                float sig = wavetable_read(wave_idx, level, voice->phase);
                 
                 float attack_transient = 0.f;
                 if (voice->env_stage == 0 && s_attack_click > 0.5f) {
@@ -448,7 +383,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
                 sig_r += sig * env * velocity_scale;
             }
             
-            float w0 = osc_w0f_for_note(voice->note, mod);
             voice->phase += w0;
             voice->phase -= (uint32_t)voice->phase;
             
@@ -467,7 +401,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         sig_r = chorus_process(sig_r, 1);
         
         float mono = (sig_l + sig_r) * 0.5f;
-        mono = fast_tanh(mono * 1.3f);
+        mono = dsp::approx::tanh<dsp::approx::k_faster>(mono * 1.3f);
         
         out[f] = clipminmaxf(-1.f, mono * 1.8f, 1.f);  // Volume boost!
         
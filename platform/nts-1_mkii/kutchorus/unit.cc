@@ -8,15 +8,9 @@
 #include "fx_api.h"  // ✅ For fx_pow2f() and fx_sinf()
 #include "utils/float_math.h"  // ✅ For si_fabsf(), si_floorf()
 #include "utils/int_math.h"
-
-// ========== FAST TANH (for effects) ==========
-
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
+#include "dsp/controlrate.hpp"
+#include "dsp/noisegen.hpp"
+#include "dsp/approx.hpp"
 
 // ========== IS FINITE CHECK ==========
 
@@ -82,16 +76,20 @@ static float s_bass_cut = 0.3f;
 static uint8_t s_voice_count = 3;
 static float s_feedback = 0.1f;
 
-// Random state for motion
-static uint32_t s_rand_state = 12345;
+// ========== CONTROL RATE ==========
+
+// Parameter derived values, updated once per unit_render and ramped over the buffer
+static dsp::ControlRamp s_fb_ramp;          // Voice feedback amount
+static dsp::ControlRamp s_width_ramp;       // Half the stereo width
+static dsp::ControlRamp s_lfo_inc_ramp;     // LFO phase increment per sample
+
+// Random source for motion
+static dsp::NoiseGen s_noise_gen;
 
 // ========== RANDOM GENERATOR ==========
 
 inline float random_float() {
-    s_rand_state ^= s_rand_state << 13;
-    s_rand_state ^= s_rand_state >> 17;
-    s_rand_state ^= s_rand_state << 5;
-    return (float)(s_rand_state % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ========== CHORUS TYPE CONFIGURATION (FIXED!) ==========
@@ -319,7 +317,8 @@ inline void process_tone(float *wet_l, float *wet_r) {
 
 // ========== CHORUS PROCESSOR ==========
 
-inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
+inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r,
+                           float fb, float width_half, float lfo_inc, float voice_norm) {
     // ✅ FIX: Input validation
     if (!is_finite(in_l)) in_l = 0.f;
     if (!is_finite(in_r)) in_r = 0.f;
@@ -327,9 +326,6 @@ inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
     float wet_l = 0.f;
     float wet_r = 0.f;
     
-    // ✅ FIX: Safe voice count (minimum 1)
-    uint8_t active_voices = clipminmaxu32(1, s_voice_count, NUM_VOICES);
-    
     // Process each voice
     for (uint8_t v = 0; v < NUM_VOICES; v++) {
         if (s_voices[v].level < 0.01f) continue;
@@ -363,7 +359,6 @@ inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
         if (!is_finite(delayed_r)) delayed_r = 0.f;
         
         // Apply feedback
-        float fb = clipminmaxf(0.f, s_feedback * 0.5f, 0.5f);
         delayed_l += voice->feedback_state_l * fb;
         delayed_r += voice->feedback_state_r * fb;
         
@@ -372,8 +367,8 @@ inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
         voice->feedback_state_r = delayed_r * 0.5f;
         
         // Apply pan and width
-        float pan_l = 0.5f - voice->pan * s_width * 0.5f;
-        float pan_r = 0.5f + voice->pan * s_width * 0.5f;
+        float pan_l = 0.5f - voice->pan * width_half;
+        float pan_r = 0.5f + voice->pan * width_half;
         
         pan_l = clipminmaxf(0.f, pan_l, 1.f);
         pan_r = clipminmaxf(0.f, pan_r, 1.f);
@@ -382,14 +377,13 @@ inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
         wet_r += delayed_r * pan_r * voice->level;
         
         // Advance LFO phase
-        float lfo_rate = 0.05f + s_rate * 7.95f;  // 0.05-8 Hz
-        voice->lfo_phase += lfo_rate / 48000.f;
+        voice->lfo_phase += lfo_inc;
         if (voice->lfo_phase >= 1.f) voice->lfo_phase -= 1.f;
     }
     
     // ✅ FIX: Safe normalization
-    wet_l /= (float)active_voices;
-    wet_r /= (float)active_voices;
+    wet_l *= voice_norm;
+    wet_r *= voice_norm;
     
     // Apply bass cut
     process_bass_cut(&wet_l, &wet_r);
@@ -399,9 +393,9 @@ inline void process_chorus(float in_l, float in_r, float *out_l, float *out_r) {
     
     // Add dirty character for DIRTY mode
     if (s_chorus_type == TYPE_DIRTY) {
-        // ✅ FIX: Use fast_tanh() (custom implementation, NOT fastertanh2f!)
-        wet_l = fast_tanh(wet_l * 1.2f) * 0.9f;
-        wet_r = fast_tanh(wet_r * 1.2f) * 0.9f;
+        // Clamped Pade tanh, the coarse tier is fine for deliberate dirt
+        wet_l = dsp::approx::tanh<dsp::approx::k_faster>(wet_l * 1.2f) * 0.9f;
+        wet_r = dsp::approx::tanh<dsp::approx::k_faster>(wet_r * 1.2f) * 0.9f;
         
         // Gentle bit crush
         float bits = 12.f;  // 12-bit
@@ -488,6 +482,10 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     // Configure chorus type
     configure_chorus_type();
     
+    s_fb_ramp.reset(clipminmaxf(0.f, s_feedback * 0.5f, 0.5f));
+    s_width_ramp.reset(s_width * 0.5f);
+    s_lfo_inc_ramp.reset((0.05f + s_rate * 7.95f) / 48000.f);
+    
     return k_unit_err_none;
 }
 
@@ -516,9 +514,17 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
     const float *in_ptr = in;
     float *out_ptr = out;
     
+    // Parameters only change between render calls, derive once per buffer
+    const float ramp_recip = 1.f / (float)frames;
+    s_fb_ramp.set(clipminmaxf(0.f, s_feedback * 0.5f, 0.5f), ramp_recip);
+    s_width_ramp.set(s_width * 0.5f, ramp_recip);
+    s_lfo_inc_ramp.set((0.05f + s_rate * 7.95f) / 48000.f, ramp_recip);  // 0.05-8 Hz
+    const float voice_norm = 1.f / (float)clipminmaxu32(1, s_voice_count, NUM_VOICES);
+    
     for (uint32_t f = 0; f < frames; f++) {
         float out_l, out_r;
-        process_chorus(in_ptr[0], in_ptr[1], &out_l, &out_r);
+        process_chorus(in_ptr[0], in_ptr[1], &out_l, &out_r,
+                       s_fb_ramp.process(), s_width_ramp.process(), s_lfo_inc_ramp.process(), voice_norm);
         
         // Output limiting
         out_ptr[0] = clipminmaxf(-1.f, out_l, 1.f);
@@ -62,6 +62,10 @@
 #include "unit_osc.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
+#include "dsp/approx.hpp"
+#include "dsp/biquadcascade.hpp"
+
+#include "wavetables.h"
 
 // SDK compatibility - NO math.h!
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
@@ -69,13 +73,12 @@
 
 #define MAX_VOICES 3
 #define MAX_DELAY_LENGTH 512    // Reduced from 2048
-#define SINE_TABLE_SIZE 256     // Reduced from 1024
 #define CHORUS_BUFFER_SIZE 1024 // Reduced from 4096
+#define RENDER_BLOCK 64
 
 static const unit_runtime_osc_context_t *s_context;
 
-// Pre-computed sine table (optimization)
-static float s_sine_table[SINE_TABLE_SIZE];
+// Sine table, s_sine_table[] from wavetables.h (tools/wavetable-gen)
 
 struct DelayLine {
   float buffer[MAX_DELAY_LENGTH];
@@ -109,7 +112,7 @@ struct Voice {
   uint32_t comb_write;
 
   // Post EQ
-  float peak_z1, peak_z2;
+  dsp::BiQuadCascade<1> peak;
 
   // Release envelope
   float release_env;
@@ -167,33 +170,19 @@ static const M1PianoPreset s_presets[8] = {
     {0.70f, 0.60f, 0.75f, 0.70f, 0.75f, 0.50f, 0.60f, 0.45f, "DETUNE"},
     {0.50f, 0.50f, 0.70f, 0.15f, 0.40f, 0.35f, 0.15f, 0.35f, "LOFI"}};
 
-void init_sine_table() {
-  for (int i = 0; i < SINE_TABLE_SIZE; i++) {
-    float phase = (float)i / (float)SINE_TABLE_SIZE;
-    s_sine_table[i] = osc_sinf(phase);
-  }
-}
-
 inline float sine_lookup(float phase) {
   phase -= (int32_t)phase;
   if (phase < 0.f)
     phase += 1.f;
 
-  float idx_f = phase * (float)(SINE_TABLE_SIZE - 1);
+  // The table carries a guard sample, no wrap needed for idx0 + 1. A tiny
+  // negative phase rounds to exactly 1 above, the mask folds it back to 0.
+  float idx_f = phase * (float)SINE_TABLE_SIZE;
   uint32_t idx0 = (uint32_t)idx_f;
-  uint32_t idx1 = (idx0 + 1) % SINE_TABLE_SIZE;
   float frac = idx_f - (float)idx0;
+  idx0 &= SINE_TABLE_SIZE - 1;
 
-  return s_sine_table[idx0] * (1.f - frac) + s_sine_table[idx1] * frac;
-}
-
-inline float fast_tanh(float x) {
-  if (x < -3.f)
-    return -1.f;
-  if (x > 3.f)
-    return 1.f;
-  float x2 = x * x;
-  return x * (27.f + x2) / (27.f + 9.f * x2);
+  return s_sine_table[idx0] * (1.f - frac) + s_sine_table[idx0 + 1] * frac;
 }
 
 // 2-OP FM EXCITER (Metallic hammer strike)
@@ -323,43 +312,24 @@ inline float comb_filter(Voice *v, float input) {
 }
 
 // PEAKING EQ (Body resonance)
-inline float peaking_eq(Voice *v, float input, float freq, float q,
-                        float gain) {
-  // 2nd-order peaking filter
-  float w0 = 2.f * PI * freq / 48000.f;
-  float phase_norm = w0 / (2.f * PI);
-  // Normalize phase to [0,1] for osc_sinf/osc_cosf
-  phase_norm = phase_norm - (int32_t)phase_norm;
-  if (phase_norm < 0.f)
-    phase_norm += 1.f;
-  if (phase_norm >= 1.f)
-    phase_norm -= 1.f;
+// Coefficients once per block, the voice filters ramp to them across the block
+inline void update_body_eq(float freq, float q, float gain) {
+  // 2nd-order peaking filter, freq below Nyquist
+  float phase_norm = freq / 48000.f;
   float alpha = osc_sinf(phase_norm) / (2.f * q);
   float A = fastpow2f(gain / 2.f);
-
-  float b0 = 1.f + alpha * A;
   float cos_phase = osc_cosf(phase_norm);
-  float b1 = -2.f * cos_phase;
-  float b2 = 1.f - alpha * A;
-  float a0 = 1.f + alpha / A;
-  float a1 = -2.f * cos_phase;
-  float a2 = 1.f - alpha / A;
 
   // Normalize
-  b0 /= a0;
-  b1 /= a0;
-  b2 /= a0;
-  a1 /= a0;
-  a2 /= a0;
-
-  // Process
-  float output = b0 * input + b1 * v->peak_z1 + b2 * v->peak_z2 -
-                 a1 * v->peak_z1 - a2 * v->peak_z2;
-
-  v->peak_z2 = v->peak_z1;
-  v->peak_z1 = input;
-
-  return output;
+  float a0_recip = 1.f / (1.f + alpha / A);
+  float b0 = (1.f + alpha * A) * a0_recip;
+  float b1 = -2.f * cos_phase * a0_recip;
+  float b2 = (1.f - alpha * A) * a0_recip;
+  float a1 = b1;
+  float a2 = (1.f - alpha / A) * a0_recip;
+
+  for (int v = 0; v < MAX_VOICES; v++)
+    s_voices[v].peak.setStage(0, b0, b1, b2, a1, a2);
 }
 
 // CHORUS EFFECT
@@ -418,8 +388,6 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
   s_context = static_cast<const unit_runtime_osc_context_t *>(
       desc->hooks.runtime_context);
 
-  init_sine_table();
-
   for (int v = 0; v < MAX_VOICES; v++) {
     Voice *voice = &s_voices[v];
 
@@ -447,7 +415,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     }
     voice->comb_write = 0;
 
-    voice->peak_z1 = voice->peak_z2 = 0.f;
+    voice->peak.flush();
 
     voice->release_env = 1.f;
     voice->release_stage = 0;
@@ -476,6 +444,11 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
 
   s_sample_counter = 0;
 
+  update_body_eq(800.f + s_body_resonance * 1200.f, 2.f,
+                 s_body_resonance * 0.5f);
+  for (int v = 0; v < MAX_VOICES; v++)
+    s_voices[v].peak.snap();
+
   return k_unit_err_none;
 }
 
@@ -492,12 +465,25 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
-  uint8_t base_note = (s_context->pitch >> 8) & 0xFF;
   uint8_t mod = s_context->pitch & 0xFF;
 
-  for (uint32_t f = 0; f < frames; f++) {
-    float sig = 0.f;
-    int active_count = 0;
+  // PEAKING EQ (Body resonance)
+  float peak_freq = 800.f + s_body_resonance * 1200.f;
+  float peak_gain = s_body_resonance * 0.5f;
+  update_body_eq(peak_freq, 2.f, peak_gain);
+
+  // Voices render a block at a time so the body EQ runs as a block filter
+  float sig[RENDER_BLOCK];
+  float active_count[RENDER_BLOCK];
+  float voice_out[RENDER_BLOCK];
+
+  while (frames > 0) {
+    const uint32_t n = (frames < RENDER_BLOCK) ? frames : RENDER_BLOCK;
+
+    for (uint32_t f = 0; f < n; f++) {
+      sig[f] = 0.f;
+      active_count[f] = 0.f;
+    }
 
     for (int v = 0; v < MAX_VOICES; v++) {
       Voice *voice = &s_voices[v];
@@ -519,96 +505,103 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
           base_length = MAX_DELAY_LENGTH - 10;
       }
 
-      // 2-OP FM EXCITER (hammer strike)
-      float exciter = fm_exciter(voice, s_hardness);
+      for (uint32_t f = 0; f < n; f++) {
+        // 2-OP FM EXCITER (hammer strike)
+        float exciter = fm_exciter(voice, s_hardness);
 
-      // Update exciter phases
-      if (voice->exciter_active) {
-        voice->exciter_phase_carrier += w0;
-        voice->exciter_phase_carrier -= (uint32_t)voice->exciter_phase_carrier;
-        voice->exciter_phase_mod += w0;
-        voice->exciter_phase_mod -= (uint32_t)voice->exciter_phase_mod;
-      }
-
-      // DETUNE processing (always use 2 delay lines for stereo/detune)
-      float mixed = 0.f;
-      int num_strings = 2; // Fixed: always use 2 delay lines
-
-      for (int d = 0; d < num_strings; d++) {
-        DelayLine *dl = &voice->delay_line[d];
-
-        // Detune each string slightly
-        float detune_factor = 1.f;
-        if (d > 0) {
-          float detune_cents = ((float)d - 0.5f) * s_detune_amount * 20.f;
-          detune_factor = fastpow2f(detune_cents / 1200.f);
+        // Update exciter phases
+        if (voice->exciter_active) {
+          voice->exciter_phase_carrier += w0;
+          voice->exciter_phase_carrier -= (uint32_t)voice->exciter_phase_carrier;
+          voice->exciter_phase_mod += w0;
+          voice->exciter_phase_mod -= (uint32_t)voice->exciter_phase_mod;
         }
 
-        dl->length = (uint32_t)((float)base_length * detune_factor);
-        if (dl->length < 10)
-          dl->length = 10;
-        if (dl->length > MAX_DELAY_LENGTH - 1)
-          dl->length = MAX_DELAY_LENGTH - 1;
-
-        // Set stiffness allpass coefficient
-        // Higher stiffness = more inharmonicity
-        // Fixed: use positive coefficients (0.1 to 0.9) for stability
-        dl->allpass_coeff =
-            0.1f + s_stiffness * 0.8f; // 0.1 to 0.9 (was -0.9 to -0.1)
-
-        // Set feedback (decay time)
-        // Fixed: reduced max feedback to prevent instability
-        dl->feedback =
-            0.90f + s_decay_time * 0.09f; // 0.90-0.99 (was 0.95-0.9999)
-
-        // Damping cutoff (brightness) - FIXED: now in Hz, not normalized!
-        // Range: 200 Hz (dark) to 8000 Hz (bright)
-        float damping_cutoff = 200.f + s_brightness * 7800.f;
+        // DETUNE processing (always use 2 delay lines for stereo/detune)
+        float mixed = 0.f;
+        int num_strings = 2; // Fixed: always use 2 delay lines
+
+        for (int d = 0; d < num_strings; d++) {
+          DelayLine *dl = &voice->delay_line[d];
+
+          // Detune each string slightly
+          float detune_factor = 1.f;
+          if (d > 0) {
+            float detune_cents = ((float)d - 0.5f) * s_detune_amount * 20.f;
+            detune_factor = fastpow2f(detune_cents / 1200.f);
+          }
+
+          dl->length = (uint32_t)((float)base_length * detune_factor);
+          if (dl->length < 10)
+            dl->length = 10;
+          if (dl->length > MAX_DELAY_LENGTH - 1)
+            dl->length = MAX_DELAY_LENGTH - 1;
+
+          // Set stiffness allpass coefficient
+          // Higher stiffness = more inharmonicity
+          // Fixed: use positive coefficients (0.1 to 0.9) for stability
+          dl->allpass_coeff =
+              0.1f + s_stiffness * 0.8f; // 0.1 to 0.9 (was -0.9 to -0.1)
+
+          // Set feedback (decay time)
+          // Fixed: reduced max feedback to prevent instability
+          dl->feedback =
+              0.90f + s_decay_time * 0.09f; // 0.90-0.99 (was 0.95-0.9999)
+
+          // Damping cutoff (brightness) - FIXED: now in Hz, not normalized!
+          // Range: 200 Hz (dark) to 8000 Hz (bright)
+          float damping_cutoff = 200.f + s_brightness * 7800.f;
+
+          // KARPLUS-STRONG with STIFFNESS
+          float string_out =
+              karplus_strong_process(dl, exciter, s_stiffness, damping_cutoff);
+
+          mixed += string_out;
+        }
 
-        // KARPLUS-STRONG with STIFFNESS
-        float string_out =
-            karplus_strong_process(dl, exciter, s_stiffness, damping_cutoff);
+        mixed /= (float)num_strings;
 
-        mixed += string_out;
+        // COMB FILTER (M1 DAC character)
+        voice_out[f] = comb_filter(voice, mixed);
       }
 
-      mixed /= (float)num_strings;
-
-      // COMB FILTER (M1 DAC character)
-      mixed = comb_filter(voice, mixed);
-
       // PEAKING EQ (Body resonance)
-      float peak_freq = 800.f + s_body_resonance * 1200.f;
-      float peak_gain = s_body_resonance * 0.5f;
-      mixed = peaking_eq(voice, mixed, peak_freq, 2.f, peak_gain);
+      voice->peak.process(voice_out, voice_out, n);
 
-      // RELEASE ENVELOPE
-      float release = process_release(voice);
-      mixed *= release;
+      for (uint32_t f = 0; f < n; f++) {
+        // RELEASE ENVELOPE
+        float release = process_release(voice);
 
-      if (release < 0.001f && voice->release_stage > 0) {
-        voice->active = false;
-        continue;
-      }
+        if (release < 0.001f && voice->release_stage > 0) {
+          voice->active = false;
+          break;
+        }
 
-      sig += mixed;
-      active_count++;
+        sig[f] += voice_out[f] * release;
+        active_count[f] += 1.f;
+      }
     }
 
-    if (active_count > 0) {
-      sig /= (float)active_count;
-    }
+    for (uint32_t f = 0; f < n; f++) {
+      float x = sig[f];
+      if (active_count[f] > 0.f) {
+        x /= active_count[f];
+      }
 
-    // CHORUS
-    sig = chorus_process(sig, 0);
+      // CHORUS
+      x = chorus_process(x, 0);
 
-    // Gentle saturation
-    sig = fast_tanh(sig * 1.2f);
+      // Gentle saturation
+      x = dsp::approx::tanh<dsp::approx::k_faster>(x * 1.2f);
 
-    out[f] = clipminmaxf(-1.f, sig * 3.5f, 1.f); // Volume boost!
+      out[f] = clipminmaxf(-1.f, x * 3.5f, 1.f); // Volume boost!
+
+      s_chorus_write = (s_chorus_write + 1) % CHORUS_BUFFER_SIZE;
+      s_sample_counter++;
+    }
 
-    s_chorus_write = (s_chorus_write + 1) % CHORUS_BUFFER_SIZE;
-    s_sample_counter++;
+    out += n;
+    frames -= n;
   }
 }
 
@@ -0,0 +1,539 @@
+/*
+ * Generated by tools/wavetable-gen from wavetables.txt, do not edit.
+ */
+
+#pragma once
+
+#define M1_WAVETABLE_SIZE_EXP    (9)
+#define M1_WAVETABLE_SIZE        (512)
+#define M1_WAVETABLE_LEVELS      (4)
+#define M1_WAVETABLE_STRIDE      (964)
+#define M1_WAVETABLE_W_BASE      (0.0320512839f)  // 1538.5 Hz, highest fundamental of level 0
+#define M1_WAVETABLE_COUNT       (4)
+#define M1_WAVETABLE_LOW         (0)
+#define M1_WAVETABLE_MID         (1)
+#define M1_WAVETABLE_HIGH        (2)
+#define M1_WAVETABLE_SOFT        (3)
+
+static const float s_m1_wavetable[M1_WAVETABLE_COUNT][M1_WAVETABLE_STRIDE] __attribute__((aligned(4))) = {
+  { // low
+    // level 0, 512 samples, harmonics up to 13, fundamentals below 1538 Hz
+    0.0f, 0.0258428976f, 0.0516479537f, 0.0773774162f, 0.102993719f, 0.128459588f, 0.153738096f, 0.178792819f,
+    0.20358783f, 0.228087887f, 0.25225845f, 0.276065797f, 0.2994771f, 0.322460502f, 0.344985127f, 0.367021322f,
+    0.388540536f, 0.40951553f, 0.429920286f, 0.449730247f, 0.468922257f, 0.48747462f, 0.50536716f, 0.52258122f,
+    0.539099813f, 0.55490756f, 0.569990695f, 0.584337115f, 0.597936511f, 0.61078012f, 0.622861028f, 0.634173989f,
+    0.644715428f, 0.654483497f, 0.663477957f, 0.671700478f, 0.679154038f, 0.685843587f, 0.691775322f, 0.69695729f,
+    0.701398849f, 0.705110908f, 0.708105862f, 0.710397363f, 0.71200037f, 0.712931216f, 0.713207364f, 0.712847412f,
+    0.711871028f, 0.710298896f, 0.708152533f, 0.70545435f, 0.702227652f, 0.698496282f, 0.694284797f, 0.68961823f,
+    0.684522092f, 0.679022312f, 0.673145056f, 0.666916788f, 0.660364032f, 0.653513372f, 0.646391511f, 0.639024854f,
+    0.631439805f, 0.623662353f, 0.615718365f, 0.607633114f, 0.599431634f, 0.591138244f, 0.582776785f, 0.574370384f,
+    0.565941513f, 0.557511926f, 0.549102426f, 0.540733099f, 0.532423139f, 0.524190605f, 0.516052842f, 0.508026004f,
+    0.500125229f, 0.492364734f, 0.484757483f, 0.477315426f, 0.470049411f, 0.462969124f, 0.456083149f, 0.449398935f,
+    0.44292286f, 0.436660111f, 0.430614859f, 0.424790114f, 0.419187903f, 0.413809091f, 0.408653647f, 0.403720468f,
+    0.399007529f, 0.394511878f, 0.390229702f, 0.386156261f, 0.382286102f, 0.378612965f, 0.375129879f, 0.371829271f,
+    0.368702918f, 0.365741968f, 0.362937212f, 0.360278845f, 0.357756764f, 0.355360478f, 0.35307923f, 0.350902051f,
+    0.348817736f, 0.34681502f, 0.344882578f, 0.343009025f, 0.341183066f, 0.339393526f, 0.337629318f, 0.335879594f,
+    0.334133744f, 0.332381427f, 0.330612719f, 0.328817964f, 0.326987982f, 0.325114071f, 0.323187977f, 0.32120198f,
+    0.319148928f, 0.317022234f, 0.314815909f, 0.312524587f, 0.31014353f, 0.307668716f, 0.305096656f, 0.302424699f,
+    0.299650759f, 0.296773434f, 0.293792069f, 0.290706635f, 0.287517756f, 0.284226745f, 0.280835539f, 0.27734673f,
+    0.273763508f, 0.270089656f, 0.266329497f, 0.262487888f, 0.258570284f, 0.254582524f, 0.250530899f, 0.246422216f,
+    0.242263556f, 0.238062382f, 0.233826473f, 0.229563847f, 0.225282758f, 0.220991656f, 0.216699123f, 0.212413818f,
+    0.208144501f, 0.203899905f, 0.199688762f, 0.19551973f, 0.191401318f, 0.187341943f, 0.183349788f, 0.179432824f,
+    0.175598711f, 0.171854869f, 0.168208316f, 0.164665744f, 0.16123338f, 0.157917082f, 0.154722184f, 0.151653558f,
+    0.148715571f, 0.145912021f, 0.143246204f, 0.14072077f, 0.138337865f, 0.136098996f, 0.13400507f, 0.13205637f,
+    0.1302526f, 0.128592834f, 0.127075508f, 0.125698507f, 0.124459058f, 0.123353824f, 0.122378901f, 0.121529788f,
+    0.120801479f, 0.120188408f, 0.119684532f, 0.119283296f, 0.118977726f, 0.1187604f, 0.118623503f, 0.118558861f,
+    0.118557975f, 0.118612029f, 0.118711963f, 0.118848488f, 0.11901214f, 0.119193293f, 0.119382218f, 0.119569115f,
+    0.119744174f, 0.119897589f, 0.120019585f, 0.120100521f, 0.120130852f, 0.120101243f, 0.120002531f, 0.119825833f,
+    0.119562529f, 0.11920435f, 0.118743345f, 0.11817199f, 0.117483146f, 0.116670154f, 0.115726814f, 0.114647433f,
+    0.113426857f, 0.112060457f, 0.11054419f, 0.108874604f, 0.107048832f, 0.105064623f, 0.102920353f, 0.100615039f,
+    0.0981483087f, 0.0955204368f, 0.0927323475f, 0.0897855759f, 0.0866822973f, 0.0834253207f, 0.0800180286f, 0.0764644369f,
+    0.0727691203f, 0.0689372271f, 0.0649744347f, 0.0608869568f, 0.0566814914f, 0.0523652099f, 0.0479457304f, 0.0434310697f,
+    0.0388296358f, 0.034150172f, 0.0294017419f, 0.0245936774f, 0.0197355505f, 0.01483713f, 0.00990835018f, 0.00495926198f,
+    0.0f, -0.00495926198f, -0.00990835018f, -0.01483713f, -0.0197355505f, -0.0245936774f, -0.0294017419f, -0.034150172f,
+    -0.0388296358f, -0.0434310697f, -0.0479457304f, -0.0523652099f, -0.0566814914f, -0.0608869568f, -0.0649744347f, -0.0689372271f,
+    -0.0727691203f, -0.0764644369f, -0.0800180286f, -0.0834253207f, -0.0866822973f, -0.0897855759f, -0.0927323475f, -0.0955204368f,
+    -0.0981483087f, -0.100615039f, -0.102920353f, -0.105064623f, -0.107048832f, -0.108874604f, -0.11054419f, -0.112060457f,
+    -0.113426857f, -0.114647433f, -0.115726814f, -0.116670154f, -0.117483146f, -0.11817199f, -0.118743345f, -0.11920435f,
+    -0.119562529f, -0.119825833f, -0.120002531f, -0.120101243f, -0.120130852f, -0.120100521f, -0.120019585f, -0.119897589f,
+    -0.119744174f, -0.119569115f, -0.119382218f, -0.119193293f, -0.11901214f, -0.118848488f, -0.118711963f, -0.118612029f,
+    -0.118557975f, -0.118558861f, -0.118623503f, -0.1187604f, -0.118977726f, -0.119283296f, -0.119684532f, -0.120188408f,
+    -0.120801479f, -0.121529788f, -0.122378901f, -0.123353824f, -0.124459058f, -0.125698507f, -0.127075508f, -0.128592834f,
+    -0.1302526f, -0.13205637f, -0.13400507f, -0.136098996f, -0.138337865f, -0.14072077f, -0.143246204f, -0.145912021f,
+    -0.148715571f, -0.151653558f, -0.154722184f, -0.157917082f, -0.16123338f, -0.164665744f, -0.168208316f, -0.171854869f,
+    -0.175598711f, -0.179432824f, -0.183349788f, -0.187341943f, -0.191401318f, -0.19551973f, -0.199688762f, -0.203899905f,
+    -0.208144501f, -0.212413818f, -0.216699123f, -0.220991656f, -0.225282758f, -0.229563847f, -0.233826473f, -0.238062382f,
+    -0.242263556f, -0.246422216f, -0.250530899f, -0.254582524f, -0.258570284f, -0.262487888f, -0.266329497f, -0.270089656f,
+    -0.273763508f, -0.27734673f, -0.280835539f, -0.284226745f, -0.287517756f, -0.290706635f, -0.293792069f, -0.296773434f,
+    -0.299650759f, -0.302424699f, -0.305096656f, -0.307668716f, -0.31014353f, -0.312524587f, -0.314815909f, -0.317022234f,
+    -0.319148928f, -0.32120198f, -0.323187977f, -0.325114071f, -0.326987982f, -0.328817964f, -0.330612719f, -0.332381427f,
+    -0.334133744f, -0.335879594f, -0.337629318f, -0.339393526f, -0.341183066f, -0.343009025f, -0.344882578f, -0.34681502f,
+    -0.348817736f, -0.350902051f, -0.35307923f, -0.355360478f, -0.357756764f, -0.360278845f, -0.362937212f, -0.365741968f,
+    -0.368702918f, -0.371829271f, -0.375129879f, -0.378612965f, -0.382286102f, -0.386156261f, -0.390229702f, -0.394511878f,
+    -0.399007529f, -0.403720468f, -0.408653647f, -0.413809091f, -0.419187903f, -0.424790114f, -0.430614859f, -0.436660111f,
+    -0.44292286f, -0.449398935f, -0.456083149f, -0.462969124f, -0.470049411f, -0.477315426f, -0.484757483f, -0.492364734f,
+    -0.500125229f, -0.508026004f, -0.516052842f, -0.524190605f, -0.532423139f, -0.540733099f, -0.549102426f, -0.557511926f,
+    -0.565941513f, -0.574370384f, -0.582776785f, -0.591138244f, -0.599431634f, -0.607633114f, -0.615718365f, -0.623662353f,
+    -0.631439805f, -0.639024854f, -0.646391511f, -0.653513372f, -0.660364032f, -0.666916788f, -0.673145056f, -0.679022312f,
+    -0.684522092f, -0.68961823f, -0.694284797f, -0.698496282f, -0.702227652f, -0.70545435f, -0.708152533f, -0.710298896f,
+    -0.711871028f, -0.712847412f, -0.713207364f, -0.712931216f, -0.71200037f, -0.710397363f, -0.708105862f, -0.705110908f,
+    -0.701398849f, -0.69695729f, -0.691775322f, -0.685843587f, -0.679154038f, -0.671700478f, -0.663477957f, -0.654483497f,
+    -0.644715428f, -0.634173989f, -0.622861028f, -0.61078012f, -0.597936511f, -0.584337115f, -0.569990695f, -0.55490756f,
+    -0.539099813f, -0.52258122f, -0.50536716f, -0.48747462f, -0.468922257f, -0.449730247f, -0.429920286f, -0.40951553f,
+    -0.388540536f, -0.367021322f, -0.344985127f, -0.322460502f, -0.2994771f, -0.276065797f, -0.25225845f, -0.228087887f,
+    -0.20358783f, -0.178792819f, -0.153738096f, -0.128459588f, -0.102993719f, -0.0773774162f, -0.0516479537f, -0.0258428976f,
+    0.0f,
+    // level 1, 256 samples, harmonics up to 6, fundamentals below 3077 Hz
+    0.0f, 0.0516479537f, 0.102993719f, 0.153738096f, 0.20358783f, 0.25225845f, 0.2994771f, 0.344985127f,
+    0.388540536f, 0.429920286f, 0.468922257f, 0.50536716f, 0.539099813f, 0.569990695f, 0.597936511f, 0.622861028f,
+    0.644715428f, 0.663477957f, 0.679154038f, 0.691775322f, 0.701398849f, 0.708105862f, 0.71200037f, 0.713207364f,
+    0.711871028f, 0.708152533f, 0.702227652f, 0.694284797f, 0.684522092f, 0.673145056f, 0.660364032f, 0.646391511f,
+    0.631439805f, 0.615718365f, 0.599431634f, 0.582776785f, 0.565941513f, 0.549102426f, 0.532423139f, 0.516052842f,
+    0.500125229f, 0.484757483f, 0.470049411f, 0.456083149f, 0.44292286f, 0.430614859f, 0.419187903f, 0.408653647f,
+    0.399007529f, 0.390229702f, 0.382286102f, 0.375129879f, 0.368702918f, 0.362937212f, 0.357756764f, 0.35307923f,
+    0.348817736f, 0.344882578f, 0.341183066f, 0.337629318f, 0.334133744f, 0.330612719f, 0.326987982f, 0.323187977f,
+    0.319148928f, 0.314815909f, 0.31014353f, 0.305096656f, 0.299650759f, 0.293792069f, 0.287517756f, 0.280835539f,
+    0.273763508f, 0.266329497f, 0.258570284f, 0.250530899f, 0.242263556f, 0.233826473f, 0.225282758f, 0.216699123f,
+    0.208144501f, 0.199688762f, 0.191401318f, 0.183349788f, 0.175598711f, 0.168208316f, 0.16123338f, 0.154722184f,
+    0.148715571f, 0.143246204f, 0.138337865f, 0.13400507f, 0.1302526f, 0.127075508f, 0.124459058f, 0.122378901f,
+    0.120801479f, 0.119684532f, 0.118977726f, 0.118623503f, 0.118557975f, 0.118711963f, 0.11901214f, 0.119382218f,
+    0.119744174f, 0.120019585f, 0.120130852f, 0.120002531f, 0.119562529f, 0.118743345f, 0.117483146f, 0.115726814f,
+    0.113426857f, 0.11054419f, 0.107048832f, 0.102920353f, 0.0981483087f, 0.0927323475f, 0.0866822973f, 0.0800180286f,
+    0.0727691203f, 0.0649744347f, 0.0566814914f, 0.0479457304f, 0.0388296358f, 0.0294017419f, 0.0197355505f, 0.00990835018f,
+    0.0f, -0.00990835018f, -0.0197355505f, -0.0294017419f, -0.0388296358f, -0.0479457304f, -0.0566814914f, -0.0649744347f,
+    -0.0727691203f, -0.0800180286f, -0.0866822973f, -0.0927323475f, -0.0981483087f, -0.102920353f, -0.107048832f, -0.11054419f,
+    -0.113426857f, -0.115726814f, -0.117483146f, -0.118743345f, -0.119562529f, -0.120002531f, -0.120130852f, -0.120019585f,
+    -0.119744174f, -0.119382218f, -0.11901214f, -0.118711963f, -0.118557975f, -0.118623503f, -0.118977726f, -0.119684532f,
+    -0.120801479f, -0.122378901f, -0.124459058f, -0.127075508f, -0.1302526f, -0.13400507f, -0.138337865f, -0.143246204f,
+    -0.148715571f, -0.154722184f, -0.16123338f, -0.168208316f, -0.175598711f, -0.183349788f, -0.191401318f, -0.199688762f,
+    -0.208144501f, -0.216699123f, -0.225282758f, -0.233826473f, -0.242263556f, -0.250530899f, -0.258570284f, -0.266329497f,
+    -0.273763508f, -0.280835539f, -0.287517756f, -0.293792069f, -0.299650759f, -0.305096656f, -0.31014353f, -0.314815909f,
+    -0.319148928f, -0.323187977f, -0.326987982f, -0.330612719f, -0.334133744f, -0.337629318f, -0.341183066f, -0.344882578f,
+    -0.348817736f, -0.35307923f, -0.357756764f, -0.362937212f, -0.368702918f, -0.375129879f, -0.382286102f, -0.390229702f,
+    -0.399007529f, -0.408653647f, -0.419187903f, -0.430614859f, -0.44292286f, -0.456083149f, -0.470049411f, -0.484757483f,
+    -0.500125229f, -0.516052842f, -0.532423139f, -0.549102426f, -0.565941513f, -0.582776785f, -0.599431634f, -0.615718365f,
+    -0.631439805f, -0.646391511f, -0.660364032f, -0.673145056f, -0.684522092f, -0.694284797f, -0.702227652f, -0.708152533f,
+    -0.711871028f, -0.713207364f, -0.71200037f, -0.708105862f, -0.701398849f, -0.691775322f, -0.679154038f, -0.663477957f,
+    -0.644715428f, -0.622861028f, -0.597936511f, -0.569990695f, -0.539099813f, -0.50536716f, -0.468922257f, -0.429920286f,
+    -0.388540536f, -0.344985127f, -0.2994771f, -0.25225845f, -0.20358783f, -0.153738096f, -0.102993719f, -0.0516479537f,
+    0.0f,
+    // level 2, 128 samples, harmonics up to 3, fundamentals below 6154 Hz
+    0.0f, 0.0708809122f, 0.140929878f, 0.209329069f, 0.275288701f, 0.338060349f, 0.396949351f, 0.451326489f,
+    0.500638008f, 0.544414401f, 0.582277596f, 0.613946259f, 0.639239192f, 0.658077061f, 0.670482099f, 0.676575661f,
+    0.67657423f, 0.670783699f, 0.659591615f, 0.643458605f, 0.622907877f, 0.598514259f, 0.570891976f, 0.540682316f,
+    0.508540511f, 0.475122958f, 0.44107455f, 0.407016516f, 0.373535097f, 0.341170907f, 0.310409695f, 0.281674534f,
+    0.255319148f, 0.231623217f, 0.210789099f, 0.192940414f, 0.178122282f, 0.166303307f, 0.157379106f, 0.151177451f,
+    0.147464722f, 0.145953596f, 0.14631176f, 0.148171455f, 0.151139587f, 0.154808193f, 0.158765092f, 0.162604257f,
+    0.165935948f, 0.16839622f, 0.169655576f, 0.169426695f, 0.167470902f, 0.16360347f, 0.157697394f, 0.149685666f,
+    0.139562204f, 0.127380997f, 0.113253921f, 0.097347118f, 0.0798758939f, 0.0610985979f, 0.0413092859f, 0.0208296087f,
+    0.0f, -0.0208296087f, -0.0413092859f, -0.0610985979f, -0.0798758939f, -0.097347118f, -0.113253921f, -0.127380997f,
+    -0.139562204f, -0.149685666f, -0.157697394f, -0.16360347f, -0.167470902f, -0.169426695f, -0.169655576f, -0.16839622f,
+    -0.165935948f, -0.162604257f, -0.158765092f, -0.154808193f, -0.151139587f, -0.148171455f, -0.14631176f, -0.145953596f,
+    -0.147464722f, -0.151177451f, -0.157379106f, -0.166303307f, -0.178122282f, -0.192940414f, -0.210789099f, -0.231623217f,
+    -0.255319148f, -0.281674534f, -0.310409695f, -0.341170907f, -0.373535097f, -0.407016516f, -0.44107455f, -0.475122958f,
+    -0.508540511f, -0.540682316f, -0.570891976f, -0.598514259f, -0.622907877f, -0.643458605f, -0.659591615f, -0.670783699f,
+    -0.67657423f, -0.676575661f, -0.670482099f, -0.658077061f, -0.639239192f, -0.613946259f, -0.582277596f, -0.544414401f,
+    -0.500638008f, -0.451326489f, -0.396949351f, -0.338060349f, -0.275288701f, -0.209329069f, -0.140929878f, -0.0708809122f,
+    0.0f,
+    // level 3, 64 samples, harmonics up to 1, higher fundamentals
+    0.0f, 0.0417094231f, 0.0830171555f, 0.123525396f, 0.162844017f, 0.200594351f, 0.236412868f, 0.269954592f,
+    0.300896496f, 0.32894063f, 0.353816867f, 0.375285655f, 0.393140227f, 0.407208651f, 0.417355448f, 0.423482865f,
+    0.425531924f, 0.423482865f, 0.417355448f, 0.407208651f, 0.393140227f, 0.375285655f, 0.353816867f, 0.32894063f,
+    0.300896496f, 0.269954592f, 0.236412868f, 0.200594351f, 0.162844017f, 0.123525396f, 0.0830171555f, 0.0417094231f,
+    0.0f, -0.0417094231f, -0.0830171555f, -0.123525396f, -0.162844017f, -0.200594351f, -0.236412868f, -0.269954592f,
+    -0.300896496f, -0.32894063f, -0.353816867f, -0.375285655f, -0.393140227f, -0.407208651f, -0.417355448f, -0.423482865f,
+    -0.425531924f, -0.423482865f, -0.417355448f, -0.407208651f, -0.393140227f, -0.375285655f, -0.353816867f, -0.32894063f,
+    -0.300896496f, -0.269954592f, -0.236412868f, -0.200594351f, -0.162844017f, -0.123525396f, -0.0830171555f, -0.0417094231f,
+    0.0f,
+  },
+  { // mid
+    // level 0, 512 samples, harmonics up to 13, fundamentals below 1538 Hz
+    0.0f, 0.0638034716f, 0.127087593f, 0.189340994f, 0.250068188f, 0.308797002f, 0.36508581f, 0.418529868f,
+    0.468767196f, 0.515483499f, 0.558416069f, 0.597357213f, 0.632155836f, 0.662718654f, 0.689010084f, 0.711050987f,
+    0.728916585f, 0.7427333f, 0.752674878f, 0.758957624f, 0.761834681f, 0.7615906f, 0.758534551f, 0.752993882f,
+    0.745307446f, 0.735818565f, 0.724869013f, 0.712792099f, 0.699907303f, 0.686514854f, 0.672890902f, 0.659283638f,
+    0.645910144f, 0.632954001f, 0.620563567f, 0.608851612f, 0.597895265f, 0.587737083f, 0.578386605f, 0.569823086f,
+    0.561998069f, 0.554839253f, 0.54825443f, 0.542135477f, 0.536362886f, 0.530810416f, 0.525349319f, 0.519852757f,
+    0.514199674f, 0.508278847f, 0.501991749f, 0.49525544f, 0.488004863f, 0.480194271f, 0.47179839f, 0.462812603f,
+    0.453252852f, 0.443154603f, 0.432571679f, 0.421574205f, 0.410246283f, 0.398683488f, 0.386989743f, 0.375274301f,
+    0.363648534f, 0.352222651f, 0.34110266f, 0.330387324f, 0.320165634f, 0.310514271f, 0.30149579f, 0.293156952f,
+    0.285527736f, 0.27862075f, 0.272431165f, 0.266937107f, 0.262100667f, 0.257869124f, 0.254176795f, 0.250947118f,
+    0.24809505f, 0.245529652f, 0.243156865f, 0.240882307f, 0.238614053f, 0.236265361f, 0.233757183f, 0.231020406f,
+    0.227997944f, 0.224646211f, 0.220936462f, 0.2168556f, 0.212406397f, 0.207607538f, 0.202492952f, 0.197110891f,
+    0.191522464f, 0.185799927f, 0.180024609f, 0.174284548f, 0.168671995f, 0.163280845f, 0.158203855f, 0.153530061f,
+    0.149342209f, 0.145714417f, 0.14271003f, 0.140379727f, 0.13876012f, 0.137872562f, 0.137722522f, 0.138299271f,
+    0.139576107f, 0.141510934f, 0.144047335f, 0.147115931f, 0.150636211f, 0.15451853f, 0.158666492f, 0.162979379f,
+    0.167354718f, 0.17169103f, 0.175890297f, 0.179860547f, 0.183518142f, 0.1867899f, 0.189614862f, 0.191945732f,
+    0.193749994f, 0.195010602f, 0.195726156f, 0.195910737f, 0.195593297f, 0.194816664f, 0.193636045f, 0.192117393f,
+    0.190335289f, 0.188370645f, 0.186308339f, 0.184234604f, 0.182234451f, 0.180389121f, 0.178773612f, 0.177454486f,
+    0.176487774f, 0.175917283f, 0.175773203f, 0.176071137f, 0.176811486f, 0.17797929f, 0.179544583f, 0.181463003f,
+    0.183677062f, 0.186117515f, 0.18870534f, 0.191353813f, 0.193970919f, 0.196461931f, 0.198732004f, 0.200688943f,
+    0.202245772f, 0.203323275f, 0.203852311f, 0.203775927f, 0.203051031f, 0.201649845f, 0.199560896f, 0.196789518f,
+    0.193357944f, 0.189305007f, 0.18468526f, 0.179567724f, 0.174034283f, 0.168177634f, 0.162099004f, 0.15590556f,
+    0.14970769f, 0.143616229f, 0.137739524f, 0.132180706f, 0.127035007f, 0.122387372f, 0.118310243f, 0.114861809f,
+    0.112084575f, 0.110004403f, 0.108630054f, 0.107953183f, 0.107948884f, 0.108576678f, 0.109781995f, 0.11149814f,
+    0.113648541f, 0.116149418f, 0.11891266f, 0.121848904f, 0.124870665f, 0.127895519f, 0.130849183f, 0.133668363f,
+    0.13630338f, 0.138720497f, 0.140903696f, 0.142855987f, 0.144600347f, 0.14617978f, 0.147656992f, 0.149113372f,
+    0.150647298f, 0.152371958f, 0.154412553f, 0.156902954f, 0.159982041f, 0.163789615f, 0.168462053f, 0.174127892f,
+    0.180903226f, 0.188887343f, 0.198158428f, 0.208769605f, 0.220745414f, 0.234078795f, 0.248728633f, 0.264618069f,
+    0.281633466f, 0.299624354f, 0.318404019f, 0.337751061f, 0.357411742f, 0.377103329f, 0.396517843f, 0.415327042f,
+    0.433187455f, 0.44974649f, 0.464648634f, 0.477541924f, 0.488084942f, 0.495953351f, 0.500846684f, 0.502494633f,
+    0.500663161f, 0.495159924f, 0.48583889f, 0.472604632f, 0.455415279f, 0.434284776f, 0.409284174f, 0.380541593f,
+    0.348241478f, 0.312622547f, 0.273974806f, 0.232635543f, 0.188984454f, 0.143437892f, 0.0964424536f, 0.0484679751f,
+    0.0f, -0.0484679751f, -0.0964424536f, -0.143437892f, -0.188984454f, -0.232635543f, -0.273974806f, -0.312622547f,
+    -0.348241478f, -0.380541593f, -0.409284174f, -0.434284776f, -0.455415279f, -0.472604632f, -0.48583889f, -0.495159924f,
+    -0.500663161f, -0.502494633f, -0.500846684f, -0.495953351f, -0.488084942f, -0.477541924f, -0.464648634f, -0.44974649f,
+    -0.433187455f, -0.415327042f, -0.396517843f, -0.377103329f, -0.357411742f, -0.337751061f, -0.318404019f, -0.299624354f,
+    -0.281633466f, -0.264618069f, -0.248728633f, -0.234078795f, -0.220745414f, -0.208769605f, -0.198158428f, -0.188887343f,
+    -0.180903226f, -0.174127892f, -0.168462053f, -0.163789615f, -0.159982041f, -0.156902954f, -0.154412553f, -0.152371958f,
+    -0.150647298f, -0.149113372f, -0.147656992f, -0.14617978f, -0.144600347f, -0.142855987f, -0.140903696f, -0.138720497f,
+    -0.13630338f, -0.133668363f, -0.130849183f, -0.127895519f, -0.124870665f, -0.121848904f, -0.11891266f, -0.116149418f,
+    -0.113648541f, -0.11149814f, -0.109781995f, -0.108576678f, -0.107948884f, -0.107953183f, -0.108630054f, -0.110004403f,
+    -0.112084575f, -0.114861809f, -0.118310243f, -0.122387372f, -0.127035007f, -0.132180706f, -0.137739524f, -0.143616229f,
+    -0.14970769f, -0.15590556f, -0.162099004f, -0.168177634f, -0.174034283f, -0.179567724f, -0.18468526f, -0.189305007f,
+    -0.193357944f, -0.196789518f, -0.199560896f, -0.201649845f, -0.203051031f, -0.203775927f, -0.203852311f, -0.203323275f,
+    -0.202245772f, -0.200688943f, -0.198732004f, -0.196461931f, -0.193970919f, -0.191353813f, -0.18870534f, -0.186117515f,
+    -0.183677062f, -0.181463003f, -0.179544583f, -0.17797929f, -0.176811486f, -0.176071137f, -0.175773203f, -0.175917283f,
+    -0.176487774f, -0.177454486f, -0.178773612f, -0.180389121f, -0.182234451f, -0.184234604f, -0.186308339f, -0.188370645f,
+    -0.190335289f, -0.192117393f, -0.193636045f, -0.194816664f, -0.195593297f, -0.195910737f, -0.195726156f, -0.195010602f,
+    -0.193749994f, -0.191945732f, -0.189614862f, -0.1867899f, -0.183518142f, -0.179860547f, -0.175890297f, -0.17169103f,
+    -0.167354718f, -0.162979379f, -0.158666492f, -0.15451853f, -0.150636211f, -0.147115931f, -0.144047335f, -0.141510934f,
+    -0.139576107f, -0.138299271f, -0.137722522f, -0.137872562f, -0.13876012f, -0.140379727f, -0.14271003f, -0.145714417f,
+    -0.149342209f, -0.153530061f, -0.158203855f, -0.163280845f, -0.168671995f, -0.174284548f, -0.180024609f, -0.185799927f,
+    -0.191522464f, -0.197110891f, -0.202492952f, -0.207607538f, -0.212406397f, -0.2168556f, -0.220936462f, -0.224646211f,
+    -0.227997944f, -0.231020406f, -0.233757183f, -0.236265361f, -0.238614053f, -0.240882307f, -0.243156865f, -0.245529652f,
+    -0.24809505f, -0.250947118f, -0.254176795f, -0.257869124f, -0.262100667f, -0.266937107f, -0.272431165f, -0.27862075f,
+    -0.285527736f, -0.293156952f, -0.30149579f, -0.310514271f, -0.320165634f, -0.330387324f, -0.34110266f, -0.352222651f,
+    -0.363648534f, -0.375274301f, -0.386989743f, -0.398683488f, -0.410246283f, -0.421574205f, -0.432571679f, -0.443154603f,
+    -0.453252852f, -0.462812603f, -0.47179839f, -0.480194271f, -0.488004863f, -0.49525544f, -0.501991749f, -0.508278847f,
+    -0.514199674f, -0.519852757f, -0.525349319f, -0.530810416f, -0.536362886f, -0.542135477f, -0.54825443f, -0.554839253f,
+    -0.561998069f, -0.569823086f, -0.578386605f, -0.587737083f, -0.597895265f, -0.608851612f, -0.620563567f, -0.632954001f,
+    -0.645910144f, -0.659283638f, -0.672890902f, -0.686514854f, -0.699907303f, -0.712792099f, -0.724869013f, -0.735818565f,
+    -0.745307446f, -0.752993882f, -0.758534551f, -0.7615906f, -0.761834681f, -0.758957624f, -0.752674878f, -0.7427333f,
+    -0.728916585f, -0.711050987f, -0.689010084f, -0.662718654f, -0.632155836f, -0.597357213f, -0.558416069f, -0.515483499f,
+    -0.468767196f, -0.418529868f, -0.36508581f, -0.308797002f, -0.250068188f, -0.189340994f, -0.127087593f, -0.0638034716f,
+    0.0f,
+    // level 1, 256 samples, harmonics up to 6, fundamentals below 3077 Hz
+    0.0f, 0.0643348396f, 0.128116906f, 0.190800056f, 0.25185129f, 0.310757101f, 0.367029637f, 0.420212388f,
+    0.469885528f, 0.515670717f, 0.55723542f, 0.594296634f, 0.62662369f, 0.654040873f, 0.676428616f, 0.693724751f,
+    0.705924213f, 0.713078737f, 0.715295136f, 0.712733388f, 0.705603838f, 0.69416362f, 0.678712964f, 0.659590364f,
+    0.637167633f, 0.611844838f, 0.584044099f, 0.554204285f, 0.522774577f, 0.490208417f, 0.456957608f, 0.423466235f,
+    0.390165031f, 0.357465804f, 0.325756311f, 0.295395702f, 0.266710222f, 0.239989489f, 0.215483502f, 0.193400115f,
+    0.173903272f, 0.157111809f, 0.143098995f, 0.131892785f, 0.123476647f, 0.117791057f, 0.114735678f, 0.114172027f,
+    0.115926698f, 0.119795077f, 0.125545412f, 0.13292329f, 0.141656324f, 0.151459098f, 0.162038147f, 0.173097089f,
+    0.18434158f, 0.195484281f, 0.20624955f, 0.216377884f, 0.225630105f, 0.233791009f, 0.240672737f, 0.246117532f,
+    0.25f, 0.252228826f, 0.252747893f, 0.251536757f, 0.24861066f, 0.244019732f, 0.23784779f, 0.230210558f,
+    0.221253246f, 0.21114777f, 0.200089514f, 0.188293636f, 0.175991178f, 0.163424775f, 0.150844336f, 0.138502479f,
+    0.126650006f, 0.115531377f, 0.105380304f, 0.0964154825f, 0.088836655f, 0.0828208774f, 0.0785192326f, 0.0760539398f,
+    0.075515911f, 0.0769628435f, 0.0804178342f, 0.0858685672f, 0.0932670534f, 0.102529965f, 0.113539562f, 0.126145139f,
+    0.140165046f, 0.155389175f, 0.171581984f, 0.188485906f, 0.205825105f, 0.223309606f, 0.240639612f, 0.257510066f,
+    0.273615241f, 0.288653582f, 0.302332103f, 0.314371258f, 0.324508995f, 0.332505167f, 0.338145256f, 0.341243804f,
+    0.341647506f, 0.339237839f, 0.333933055f, 0.325689703f, 0.314503729f, 0.300410688f, 0.283485681f, 0.263842463f,
+    0.241632149f, 0.217041194f, 0.19028905f, 0.161625162f, 0.131325558f, 0.099689059f, 0.067033194f, 0.0336897112f,
+    0.0f, -0.0336897112f, -0.067033194f, -0.099689059f, -0.131325558f, -0.161625162f, -0.19028905f, -0.217041194f,
+    -0.241632149f, -0.263842463f, -0.283485681f, -0.300410688f, -0.314503729f, -0.325689703f, -0.333933055f, -0.339237839f,
+    -0.341647506f, -0.341243804f, -0.338145256f, -0.332505167f, -0.324508995f, -0.314371258f, -0.302332103f, -0.288653582f,
+    -0.273615241f, -0.257510066f, -0.240639612f, -0.223309606f, -0.205825105f, -0.188485906f, -0.171581984f, -0.155389175f,
+    -0.140165046f, -0.126145139f, -0.113539562f, -0.102529965f, -0.0932670534f, -0.0858685672f, -0.0804178342f, -0.0769628435f,
+    -0.075515911f, -0.0760539398f, -0.0785192326f, -0.0828208774f, -0.088836655f, -0.0964154825f, -0.105380304f, -0.115531377f,
+    -0.126650006f, -0.138502479f, -0.150844336f, -0.163424775f, -0.175991178f, -0.188293636f, -0.200089514f, -0.21114777f,
+    -0.221253246f, -0.230210558f, -0.23784779f, -0.244019732f, -0.24861066f, -0.251536757f, -0.252747893f, -0.252228826f,
+    -0.25f, -0.246117532f, -0.240672737f, -0.233791009f, -0.225630105f, -0.216377884f, -0.20624955f, -0.195484281f,
+    -0.18434158f, -0.173097089f, -0.162038147f, -0.151459098f, -0.141656324f, -0.13292329f, -0.125545412f, -0.119795077f,
+    -0.115926698f, -0.114172027f, -0.114735678f, -0.117791057f, -0.123476647f, -0.131892785f, -0.143098995f, -0.157111809f,
+    -0.173903272f, -0.193400115f, -0.215483502f, -0.239989489f, -0.266710222f, -0.295395702f, -0.325756311f, -0.357465804f,
+    -0.390165031f, -0.423466235f, -0.456957608f, -0.490208417f, -0.522774577f, -0.554204285f, -0.584044099f, -0.611844838f,
+    -0.637167633f, -0.659590364f, -0.678712964f, -0.69416362f, -0.705603838f, -0.712733388f, -0.715295136f, -0.713078737f,
+    -0.705924213f, -0.693724751f, -0.676428616f, -0.654040873f, -0.62662369f, -0.594296634f, -0.55723542f, -0.515670717f,
+    -0.469885528f, -0.420212388f, -0.367029637f, -0.310757101f, -0.25185129f, -0.190800056f, -0.128116906f, -0.0643348396f,
+    0.0f,
+    // level 2, 128 samples, harmonics up to 3, fundamentals below 6154 Hz
+    0.0f, 0.0642684102f, 0.12758781f, 0.189027637f, 0.247693717f, 0.30274564f, 0.353412867f, 0.399009407f,
+    0.438946813f, 0.472745091f, 0.500041366f, 0.520596147f, 0.53429693f, 0.54115957f, 0.541326404f, 0.535062134f,
+    0.522747576f, 0.504870117f, 0.482013106f, 0.454842359f, 0.424091786f, 0.390547276f, 0.355029821f, 0.318377912f,
+    0.281429857f, 0.245005995f, 0.209891811f, 0.176821575f, 0.146463424f, 0.119405918f, 0.0961464345f, 0.0770815983f,
+    0.0625f, 0.0525773093f, 0.0473738536f, 0.046834752f, 0.0507925674f, 0.0589723922f, 0.0709992573f, 0.0864076763f,
+    0.10465315f, 0.125125304f, 0.147162408f, 0.170066953f, 0.193121895f, 0.215607271f, 0.236816794f, 0.256073952f,
+    0.272747576f, 0.286265969f, 0.296130061f, 0.301924497f, 0.303327084f, 0.300115824f, 0.292173952f, 0.279492468f,
+    0.262170106f, 0.240411073f, 0.21452029f, 0.184896454f, 0.152022853f, 0.116456464f, 0.0788152367f, 0.0397641249f,
+    0.0f, -0.0397641249f, -0.0788152367f, -0.116456464f, -0.152022853f, -0.184896454f, -0.21452029f, -0.240411073f,
+    -0.262170106f, -0.279492468f, -0.292173952f, -0.300115824f, -0.303327084f, -0.301924497f, -0.296130061f, -0.286265969f,
+    -0.272747576f, -0.256073952f, -0.236816794f, -0.215607271f, -0.193121895f, -0.170066953f, -0.147162408f, -0.125125304f,
+    -0.10465315f, -0.0864076763f, -0.0709992573f, -0.0589723922f, -0.0507925674f, -0.046834752f, -0.0473738536f, -0.0525773093f,
+    -0.0625f, -0.0770815983f, -0.0961464345f, -0.119405918f, -0.146463424f, -0.176821575f, -0.209891811f, -0.245005995f,
+    -0.281429857f, -0.318377912f, -0.355029821f, -0.390547276f, -0.424091786f, -0.454842359f, -0.482013106f, -0.504870117f,
+    -0.522747576f, -0.535062134f, -0.541326404f, -0.54115957f, -0.53429693f, -0.520596147f, -0.500041366f, -0.472745091f,
+    -0.438946813f, -0.399009407f, -0.353412867f, -0.30274564f, -0.247693717f, -0.189027637f, -0.12758781f, -0.0642684102f,
+    0.0f,
+    // level 3, 64 samples, harmonics up to 1, higher fundamentals
+    0.0f, 0.0306303557f, 0.0609657243f, 0.0907139629f, 0.119588576f, 0.147311479f, 0.173615694f, 0.198247895f,
+    0.220970869f, 0.241565764f, 0.25983426f, 0.275600404f, 0.288712353f, 0.299043864f, 0.306495398f, 0.310995221f,
+    0.3125f, 0.310995221f, 0.306495398f, 0.299043864f, 0.288712353f, 0.275600404f, 0.25983426f, 0.241565764f,
+    0.220970869f, 0.198247895f, 0.173615694f, 0.147311479f, 0.119588576f, 0.0907139629f, 0.0609657243f, 0.0306303557f,
+    0.0f, -0.0306303557f, -0.0609657243f, -0.0907139629f, -0.119588576f, -0.147311479f, -0.173615694f, -0.198247895f,
+    -0.220970869f, -0.241565764f, -0.25983426f, -0.275600404f, -0.288712353f, -0.299043864f, -0.306495398f, -0.310995221f,
+    -0.3125f, -0.310995221f, -0.306495398f, -0.299043864f, -0.288712353f, -0.275600404f, -0.25983426f, -0.241565764f,
+    -0.220970869f, -0.198247895f, -0.173615694f, -0.147311479f, -0.119588576f, -0.0907139629f, -0.0609657243f, -0.0306303557f,
+    0.0f,
+  },
+  { // high
+    // level 0, 512 samples, harmonics up to 13, fundamentals below 1538 Hz
+    0.0f, 0.0653516725f, 0.130115822f, 0.193712547f, 0.255577028f, 0.315166771f, 0.371968687f, 0.42550531f,
+    0.475341022f, 0.521087289f, 0.562407196f, 0.599019468f, 0.630701542f, 0.657291532f, 0.678689778f, 0.694859147f,
+    0.705824554f, 0.711671591f, 0.712544143f, 0.708641708f, 0.70021522f, 0.687562644f, 0.671024144f, 0.650976002f,
+    0.627824903f, 0.602001369f, 0.573953092f, 0.544138432f, 0.513019204f, 0.481054395f, 0.448693424f, 0.416370064f,
+    0.38449654f, 0.353458166f, 0.323608696f, 0.295265853f, 0.26870814f, 0.244171664f, 0.221848398f, 0.201884672f,
+    0.18438068f, 0.169390723f, 0.156924173f, 0.146947116f, 0.139384672f, 0.134124026f, 0.131017834f, 0.129888207f,
+    0.130531147f, 0.132721141f, 0.136216134f, 0.140762508f, 0.146100283f, 0.151968032f, 0.158107877f, 0.164270163f,
+    0.170217872f, 0.175730616f, 0.180608332f, 0.184674338f, 0.187777922f, 0.189796448f, 0.190636754f, 0.190235958f,
+    0.188561812f, 0.185612231f, 0.181414485f, 0.176023647f, 0.169520676f, 0.162009999f, 0.153616652f, 0.144483194f,
+    0.134766221f, 0.124632776f, 0.114256606f, 0.103814371f, 0.0934818611f, 0.0834303498f, 0.0738230869f, 0.0648120195f,
+    0.0565348305f, 0.0491123199f, 0.0426461659f, 0.0372171067f, 0.0328836106f, 0.0296810158f, 0.0276211258f, 0.0266923383f,
+    0.0268602241f, 0.0280685723f, 0.0302408654f, 0.0332821608f, 0.0370813124f, 0.0415135063f, 0.0464430302f, 0.051726263f,
+    0.057214763f, 0.0627584308f, 0.0682086721f, 0.0734215006f, 0.0782604888f, 0.0825995803f, 0.0863256082f, 0.0893405601f,
+    0.0915634781f, 0.092932038f, 0.0934036747f, 0.092956312f, 0.0915886834f, 0.0893201828f, 0.0861902907f, 0.0822576433f,
+    0.077598609f, 0.0723056123f, 0.0664850399f, 0.0602549501f, 0.0537424758f, 0.0470811017f, 0.0404078104f, 0.0338601507f,
+    0.0275733173f, 0.0216772966f, 0.0162941087f, 0.0115352524f, 0.00749934139f, 0.00427004835f, 0.00191434054f, 0.000481080235f,
+    0.0f, 0.000481080235f, 0.00191434054f, 0.00427004835f, 0.00749934139f, 0.0115352524f, 0.0162941087f, 0.0216772966f,
+    0.0275733173f, 0.0338601507f, 0.0404078104f, 0.0470811017f, 0.0537424758f, 0.0602549501f, 0.0664850399f, 0.0723056123f,
+    0.077598609f, 0.0822576433f, 0.0861902907f, 0.0893201828f, 0.0915886834f, 0.092956312f, 0.0934036747f, 0.092932038f,
+    0.0915634781f, 0.0893405601f, 0.0863256082f, 0.0825995803f, 0.0782604888f, 0.0734215006f, 0.0682086721f, 0.0627584308f,
+    0.057214763f, 0.051726263f, 0.0464430302f, 0.0415135063f, 0.0370813124f, 0.0332821608f, 0.0302408654f, 0.0280685723f,
+    0.0268602241f, 0.0266923383f, 0.0276211258f, 0.0296810158f, 0.0328836106f, 0.0372171067f, 0.0426461659f, 0.0491123199f,
+    0.0565348305f, 0.0648120195f, 0.0738230869f, 0.0834303498f, 0.0934818611f, 0.103814371f, 0.114256606f, 0.124632776f,
+    0.134766221f, 0.144483194f, 0.153616652f, 0.162009999f, 0.169520676f, 0.176023647f, 0.181414485f, 0.185612231f,
+    0.188561812f, 0.190235958f, 0.190636754f, 0.189796448f, 0.187777922f, 0.184674338f, 0.180608332f, 0.175730616f,
+    0.170217872f, 0.164270163f, 0.158107877f, 0.151968032f, 0.146100283f, 0.140762508f, 0.136216134f, 0.132721141f,
+    0.130531147f, 0.129888207f, 0.131017834f, 0.134124026f, 0.139384672f, 0.146947116f, 0.156924173f, 0.169390723f,
+    0.18438068f, 0.201884672f, 0.221848398f, 0.244171664f, 0.26870814f, 0.295265853f, 0.323608696f, 0.353458166f,
+    0.38449654f, 0.416370064f, 0.448693424f, 0.481054395f, 0.513019204f, 0.544138432f, 0.573953092f, 0.602001369f,
+    0.627824903f, 0.650976002f, 0.671024144f, 0.687562644f, 0.70021522f, 0.708641708f, 0.712544143f, 0.711671591f,
+    0.705824554f, 0.694859147f, 0.678689778f, 0.657291532f, 0.630701542f, 0.599019468f, 0.562407196f, 0.521087289f,
+    0.475341022f, 0.42550531f, 0.371968687f, 0.315166771f, 0.255577028f, 0.193712547f, 0.130115822f, 0.0653516725f,
+    0.0f, -0.0653516725f, -0.130115822f, -0.193712547f, -0.255577028f, -0.315166771f, -0.371968687f, -0.42550531f,
+    -0.475341022f, -0.521087289f, -0.562407196f, -0.599019468f, -0.630701542f, -0.657291532f, -0.678689778f, -0.694859147f,
+    -0.705824554f, -0.711671591f, -0.712544143f, -0.708641708f, -0.70021522f, -0.687562644f, -0.671024144f, -0.650976002f,
+    -0.627824903f, -0.602001369f, -0.573953092f, -0.544138432f, -0.513019204f, -0.481054395f, -0.448693424f, -0.416370064f,
+    -0.38449654f, -0.353458166f, -0.323608696f, -0.295265853f, -0.26870814f, -0.244171664f, -0.221848398f, -0.201884672f,
+    -0.18438068f, -0.169390723f, -0.156924173f, -0.146947116f, -0.139384672f, -0.134124026f, -0.131017834f, -0.129888207f,
+    -0.130531147f, -0.132721141f, -0.136216134f, -0.140762508f, -0.146100283f, -0.151968032f, -0.158107877f, -0.164270163f,
+    -0.170217872f, -0.175730616f, -0.180608332f, -0.184674338f, -0.187777922f, -0.189796448f, -0.190636754f, -0.190235958f,
+    -0.188561812f, -0.185612231f, -0.181414485f, -0.176023647f, -0.169520676f, -0.162009999f, -0.153616652f, -0.144483194f,
+    -0.134766221f, -0.124632776f, -0.114256606f, -0.103814371f, -0.0934818611f, -0.0834303498f, -0.0738230869f, -0.0648120195f,
+    -0.0565348305f, -0.0491123199f, -0.0426461659f, -0.0372171067f, -0.0328836106f, -0.0296810158f, -0.0276211258f, -0.0266923383f,
+    -0.0268602241f, -0.0280685723f, -0.0302408654f, -0.0332821608f, -0.0370813124f, -0.0415135063f, -0.0464430302f, -0.051726263f,
+    -0.057214763f, -0.0627584308f, -0.0682086721f, -0.0734215006f, -0.0782604888f, -0.0825995803f, -0.0863256082f, -0.0893405601f,
+    -0.0915634781f, -0.092932038f, -0.0934036747f, -0.092956312f, -0.0915886834f, -0.0893201828f, -0.0861902907f, -0.0822576433f,
+    -0.077598609f, -0.0723056123f, -0.0664850399f, -0.0602549501f, -0.0537424758f, -0.0470811017f, -0.0404078104f, -0.0338601507f,
+    -0.0275733173f, -0.0216772966f, -0.0162941087f, -0.0115352524f, -0.00749934139f, -0.00427004835f, -0.00191434054f, -0.000481080235f,
+    0.0f, -0.000481080235f, -0.00191434054f, -0.00427004835f, -0.00749934139f, -0.0115352524f, -0.0162941087f, -0.0216772966f,
+    -0.0275733173f, -0.0338601507f, -0.0404078104f, -0.0470811017f, -0.0537424758f, -0.0602549501f, -0.0664850399f, -0.0723056123f,
+    -0.077598609f, -0.0822576433f, -0.0861902907f, -0.0893201828f, -0.0915886834f, -0.092956312f, -0.0934036747f, -0.092932038f,
+    -0.0915634781f, -0.0893405601f, -0.0863256082f, -0.0825995803f, -0.0782604888f, -0.0734215006f, -0.0682086721f, -0.0627584308f,
+    -0.057214763f, -0.051726263f, -0.0464430302f, -0.0415135063f, -0.0370813124f, -0.0332821608f, -0.0302408654f, -0.0280685723f,
+    -0.0268602241f, -0.0266923383f, -0.0276211258f, -0.0296810158f, -0.0328836106f, -0.0372171067f, -0.0426461659f, -0.0491123199f,
+    -0.0565348305f, -0.0648120195f, -0.0738230869f, -0.0834303498f, -0.0934818611f, -0.103814371f, -0.114256606f, -0.124632776f,
+    -0.134766221f, -0.144483194f, -0.153616652f, -0.162009999f, -0.169520676f, -0.176023647f, -0.181414485f, -0.185612231f,
+    -0.188561812f, -0.190235958f, -0.190636754f, -0.189796448f, -0.187777922f, -0.184674338f, -0.180608332f, -0.175730616f,
+    -0.170217872f, -0.164270163f, -0.158107877f, -0.151968032f, -0.146100283f, -0.140762508f, -0.136216134f, -0.132721141f,
+    -0.130531147f, -0.129888207f, -0.131017834f, -0.134124026f, -0.139384672f, -0.146947116f, -0.156924173f, -0.169390723f,
+    -0.18438068f, -0.201884672f, -0.221848398f, -0.244171664f, -0.26870814f, -0.295265853f, -0.323608696f, -0.353458166f,
+    -0.38449654f, -0.416370064f, -0.448693424f, -0.481054395f, -0.513019204f, -0.544138432f, -0.573953092f, -0.602001369f,
+    -0.627824903f, -0.650976002f, -0.671024144f, -0.687562644f, -0.70021522f, -0.708641708f, -0.712544143f, -0.711671591f,
+    -0.705824554f, -0.694859147f, -0.678689778f, -0.657291532f, -0.630701542f, -0.599019468f, -0.562407196f, -0.521087289f,
+    -0.475341022f, -0.42550531f, -0.371968687f, -0.315166771f, -0.255577028f, -0.193712547f, -0.130115822f, -0.0653516725f,
+    0.0f,
+    // level 1, 256 samples, harmonics up to 6, fundamentals below 3077 Hz
+    0.0f, 0.0457374044f, 0.0910110921f, 0.135363385f, 0.178348631f, 0.219538927f, 0.258529723f, 0.294945002f,
+    0.328442037f, 0.358715773f, 0.385502607f, 0.408583552f, 0.427786827f, 0.442989856f, 0.454120278f, 0.461156726f,
+    0.464128375f, 0.463114202f, 0.458241314f, 0.449682742f, 0.437654555f, 0.422412276f, 0.404247075f, 0.383481175f,
+    0.360462993f, 0.335562021f, 0.309163302f, 0.281661838f, 0.25345692f, 0.22494638f, 0.196521029f, 0.168559164f,
+    0.141421363f, 0.115445562f, 0.0909426361f, 0.0681923032f, 0.0474395789f, 0.0288918503f, 0.0127164628f, -0.000960979087f,
+    -0.0120577123f, -0.0205342174f, -0.0263939667f, -0.0296825003f, -0.0304858796f, -0.0289284997f, -0.0251703542f, -0.0194037519f,
+    -0.0118495654f, -0.00275306194f, 0.0076206089f, 0.0189912058f, 0.0310683846f, 0.0435567982f, 0.0561612509f, 0.0685917884f,
+    0.0805686861f, 0.0918272138f, 0.102122143f, 0.111231901f, 0.118962295f, 0.125149801f, 0.129664302f, 0.132411271f,
+    0.13333334f, 0.132411271f, 0.129664302f, 0.125149801f, 0.118962295f, 0.111231901f, 0.102122143f, 0.0918272138f,
+    0.0805686861f, 0.0685917884f, 0.0561612509f, 0.0435567982f, 0.0310683846f, 0.0189912058f, 0.0076206089f, -0.00275306194f,
+    -0.0118495654f, -0.0194037519f, -0.0251703542f, -0.0289284997f, -0.0304858796f, -0.0296825003f, -0.0263939667f, -0.0205342174f,
+    -0.0120577123f, -0.000960979087f, 0.0127164628f, 0.0288918503f, 0.0474395789f, 0.0681923032f, 0.0909426361f, 0.115445562f,
+    0.141421363f, 0.168559164f, 0.196521029f, 0.22494638f, 0.25345692f, 0.281661838f, 0.309163302f, 0.335562021f,
+    0.360462993f, 0.383481175f, 0.404247075f, 0.422412276f, 0.437654555f, 0.449682742f, 0.458241314f, 0.463114202f,
+    0.464128375f, 0.461156726f, 0.454120278f, 0.442989856f, 0.427786827f, 0.408583552f, 0.385502607f, 0.358715773f,
+    0.328442037f, 0.294945002f, 0.258529723f, 0.219538927f, 0.178348631f, 0.135363385f, 0.0910110921f, 0.0457374044f,
+    0.0f, -0.0457374044f, -0.0910110921f, -0.135363385f, -0.178348631f, -0.219538927f, -0.258529723f, -0.294945002f,
+    -0.328442037f, -0.358715773f, -0.385502607f, -0.408583552f, -0.427786827f, -0.442989856f, -0.454120278f, -0.461156726f,
+    -0.464128375f, -0.463114202f, -0.458241314f, -0.449682742f, -0.437654555f, -0.422412276f, -0.404247075f, -0.383481175f,
+    -0.360462993f, -0.335562021f, -0.309163302f, -0.281661838f, -0.25345692f, -0.22494638f, -0.196521029f, -0.168559164f,
+    -0.141421363f, -0.115445562f, -0.0909426361f, -0.0681923032f, -0.0474395789f, -0.0288918503f, -0.0127164628f, 0.000960979087f,
+    0.0120577123f, 0.0205342174f, 0.0263939667f, 0.0296825003f, 0.0304858796f, 0.0289284997f, 0.0251703542f, 0.0194037519f,
+    0.0118495654f, 0.00275306194f, -0.0076206089f, -0.0189912058f, -0.0310683846f, -0.0435567982f, -0.0561612509f, -0.0685917884f,
+    -0.0805686861f, -0.0918272138f, -0.102122143f, -0.111231901f, -0.118962295f, -0.125149801f, -0.129664302f, -0.132411271f,
+    -0.13333334f, -0.132411271f, -0.129664302f, -0.125149801f, -0.118962295f, -0.111231901f, -0.102122143f, -0.0918272138f,
+    -0.0805686861f, -0.0685917884f, -0.0561612509f, -0.0435567982f, -0.0310683846f, -0.0189912058f, -0.0076206089f, 0.00275306194f,
+    0.0118495654f, 0.0194037519f, 0.0251703542f, 0.0289284997f, 0.0304858796f, 0.0296825003f, 0.0263939667f, 0.0205342174f,
+    0.0120577123f, 0.000960979087f, -0.0127164628f, -0.0288918503f, -0.0474395789f, -0.0681923032f, -0.0909426361f, -0.115445562f,
+    -0.141421363f, -0.168559164f, -0.196521029f, -0.22494638f, -0.25345692f, -0.281661838f, -0.309163302f, -0.335562021f,
+    -0.360462993f, -0.383481175f, -0.404247075f, -0.422412276f, -0.437654555f, -0.449682742f, -0.458241314f, -0.463114202f,
+    -0.464128375f, -0.461156726f, -0.454120278f, -0.442989856f, -0.427786827f, -0.408583552f, -0.385502607f, -0.358715773f,
+    -0.328442037f, -0.294945002f, -0.258529723f, -0.219538927f, -0.178348631f, -0.135363385f, -0.0910110921f, -0.0457374044f,
+    0.0f,
+    // level 2, 128 samples, harmonics up to 3, fundamentals below 6154 Hz
+    0.0f, 0.0424150564f, 0.0840692818f, 0.124217935f, 0.162148103f, 0.197193787f, 0.228749886f, 0.256284982f,
+    0.279352456f, 0.297599822f, 0.310775906f, 0.318736076f, 0.321444929f, 0.31897682f, 0.311513841f, 0.299341589f,
+    0.282842726f, 0.262488365f, 0.238827646f, 0.212475553f, 0.184099346f, 0.154403895f, 0.124116212f, 0.093969509f,
+    0.0646871179f, 0.0369667038f, 0.0114649562f, -0.0112167206f, -0.0305453632f, -0.0460680835f, -0.0574219562f, -0.06434194f,
+    -0.0666666701f, -0.06434194f, -0.0574219562f, -0.0460680835f, -0.0305453632f, -0.0112167206f, 0.0114649562f, 0.0369667038f,
+    0.0646871179f, 0.093969509f, 0.124116212f, 0.154403895f, 0.184099346f, 0.212475553f, 0.238827646f, 0.262488365f,
+    0.282842726f, 0.299341589f, 0.311513841f, 0.31897682f, 0.321444929f, 0.318736076f, 0.310775906f, 0.297599822f,
+    0.279352456f, 0.256284982f, 0.228749886f, 0.197193787f, 0.162148103f, 0.124217935f, 0.0840692818f, 0.0424150564f,
+    0.0f, -0.0424150564f, -0.0840692818f, -0.124217935f, -0.162148103f, -0.197193787f, -0.228749886f, -0.256284982f,
+    -0.279352456f, -0.297599822f, -0.310775906f, -0.318736076f, -0.321444929f, -0.31897682f, -0.311513841f, -0.299341589f,
+    -0.282842726f, -0.262488365f, -0.238827646f, -0.212475553f, -0.184099346f, -0.154403895f, -0.124116212f, -0.093969509f,
+    -0.0646871179f, -0.0369667038f, -0.0114649562f, 0.0112167206f, 0.0305453632f, 0.0460680835f, 0.0574219562f, 0.06434194f,
+    0.0666666701f, 0.06434194f, 0.0574219562f, 0.0460680835f, 0.0305453632f, 0.0112167206f, -0.0114649562f, -0.0369667038f,
+    -0.0646871179f, -0.093969509f, -0.124116212f, -0.154403895f, -0.184099346f, -0.212475553f, -0.238827646f, -0.262488365f,
+    -0.282842726f, -0.299341589f, -0.311513841f, -0.31897682f, -0.321444929f, -0.318736076f, -0.310775906f, -0.297599822f,
+    -0.279352456f, -0.256284982f, -0.228749886f, -0.197193787f, -0.162148103f, -0.124217935f, -0.0840692818f, -0.0424150564f,
+    0.0f,
+    // level 3, 64 samples, harmonics up to 1, higher fundamentals
+    0.0f, 0.0163361896f, 0.0325150527f, 0.048380781f, 0.0637805685f, 0.0785661265f, 0.0925950408f, 0.105732217f,
+    0.117851131f, 0.128835082f, 0.138578266f, 0.146986872f, 0.153979927f, 0.159490049f, 0.163464218f, 0.165864125f,
+    0.166666672f, 0.165864125f, 0.163464218f, 0.159490049f, 0.153979927f, 0.146986872f, 0.138578266f, 0.128835082f,
+    0.117851131f, 0.105732217f, 0.0925950408f, 0.0785661265f, 0.0637805685f, 0.048380781f, 0.0325150527f, 0.0163361896f,
+    0.0f, -0.0163361896f, -0.0325150527f, -0.048380781f, -0.0637805685f, -0.0785661265f, -0.0925950408f, -0.105732217f,
+    -0.117851131f, -0.128835082f, -0.138578266f, -0.146986872f, -0.153979927f, -0.159490049f, -0.163464218f, -0.165864125f,
+    -0.166666672f, -0.165864125f, -0.163464218f, -0.159490049f, -0.153979927f, -0.146986872f, -0.138578266f, -0.128835082f,
+    -0.117851131f, -0.105732217f, -0.0925950408f, -0.0785661265f, -0.0637805685f, -0.048380781f, -0.0325150527f, -0.0163361896f,
+    0.0f,
+  },
+  { // soft
+    // level 0, 512 samples, harmonics up to 13, fundamentals below 1538 Hz
+    0.0f, 0.0220228061f, 0.0440241061f, 0.0659824312f, 0.0878763795f, 0.109684654f, 0.131386086f, 0.152959704f,
+    0.174384728f, 0.195640609f, 0.216707066f, 0.237564161f, 0.258192241f, 0.278572053f, 0.298684746f, 0.318511873f,
+    0.338035434f, 0.357237965f, 0.376102477f, 0.394612491f, 0.412752151f, 0.43050611f, 0.447859704f, 0.464798868f,
+    0.481310189f, 0.497380883f, 0.512998939f, 0.528152943f, 0.542832255f, 0.557026982f, 0.570727944f, 0.583926737f,
+    0.596615732f, 0.608788013f, 0.620437443f, 0.631558776f, 0.642147422f, 0.652199686f, 0.661712527f, 0.670683861f,
+    0.679112256f, 0.686997116f, 0.69433862f, 0.701137722f, 0.70739615f, 0.713116288f, 0.718301356f, 0.722955346f,
+    0.727082849f, 0.730689228f, 0.733780503f, 0.736363411f, 0.738445222f, 0.740033984f, 0.741138279f, 0.741767287f,
+    0.741930664f, 0.741638839f, 0.740902483f, 0.739732981f, 0.738142133f, 0.736142039f, 0.733745396f, 0.730965197f,
+    0.727814794f, 0.724307895f, 0.720458508f, 0.716280937f, 0.711789608f, 0.706999302f, 0.70192498f, 0.696581602f,
+    0.690984428f, 0.685148656f, 0.679089725f, 0.672822893f, 0.666363657f, 0.659727275f, 0.652929068f, 0.645984232f,
+    0.638907909f, 0.631715059f, 0.624420404f, 0.617038667f, 0.609584153f, 0.602071047f, 0.594513178f, 0.586924255f,
+    0.579317451f, 0.571705759f, 0.564101756f, 0.55651772f, 0.548965454f, 0.541456401f, 0.534001589f, 0.526611507f,
+    0.519296348f, 0.512065709f, 0.504928827f, 0.497894257f, 0.490970314f, 0.484164596f, 0.477484256f, 0.470936f,
+    0.464525908f, 0.458259583f, 0.45214209f, 0.446177959f, 0.440371215f, 0.434725285f, 0.429243177f, 0.423927277f,
+    0.418779522f, 0.413801342f, 0.408993572f, 0.404356658f, 0.399890512f, 0.395594597f, 0.391467839f, 0.38750878f,
+    0.38371551f, 0.380085707f, 0.376616597f, 0.373305023f, 0.370147437f, 0.367139995f, 0.364278436f, 0.361558169f,
+    0.358974367f, 0.356521815f, 0.354195088f, 0.351988494f, 0.349896133f, 0.347911865f, 0.346029371f, 0.344242156f,
+    0.342543572f, 0.340926886f, 0.339385182f, 0.337911546f, 0.336498946f, 0.335140288f, 0.333828509f, 0.332556546f,
+    0.331317276f, 0.330103695f, 0.328908831f, 0.327725768f, 0.326547682f, 0.325367898f, 0.324179858f, 0.322977126f,
+    0.321753412f, 0.320502698f, 0.319219023f, 0.317896783f, 0.316530466f, 0.315114826f, 0.313644946f, 0.312116027f,
+    0.310523659f, 0.30886361f, 0.307131976f, 0.30532518f, 0.303439885f, 0.301473081f, 0.299422055f, 0.297284424f,
+    0.295058072f, 0.292741269f, 0.290332556f, 0.28783083f, 0.285235256f, 0.282545328f, 0.279760867f, 0.276882023f,
+    0.273909211f, 0.270843178f, 0.267684937f, 0.264435798f, 0.261097372f, 0.257671505f, 0.254160374f, 0.250566304f,
+    0.246891975f, 0.243140221f, 0.239314139f, 0.235417023f, 0.231452361f, 0.227423832f, 0.223335266f, 0.219190702f,
+    0.214994267f, 0.210750237f, 0.206463024f, 0.202137113f, 0.197777078f, 0.193387583f, 0.188973308f, 0.18453902f,
+    0.180089489f, 0.175629482f, 0.171163782f, 0.166697145f, 0.162234262f, 0.157779843f, 0.153338447f, 0.14891465f,
+    0.144512832f, 0.140137374f, 0.135792449f, 0.131482139f, 0.127210408f, 0.122981027f, 0.118797615f, 0.114663608f,
+    0.11058227f, 0.106556661f, 0.102589644f, 0.0986838713f, 0.0948417708f, 0.0910655484f, 0.0873571783f, 0.0837184042f,
+    0.080150716f, 0.0766553804f, 0.0732334033f, 0.0698855445f, 0.0666123107f, 0.0634139627f, 0.0602905042f, 0.0572417006f,
+    0.05426706f, 0.0513658486f, 0.0485370867f, 0.0457795635f, 0.0430918224f, 0.0404721946f, 0.0379187688f, 0.0354294404f,
+    0.0330018774f, 0.0306335539f, 0.0283217579f, 0.0260635857f, 0.0238559637f, 0.0216956567f, 0.0195792746f, 0.0175032876f,
+    0.0154640349f, 0.0134577369f, 0.0114805112f, 0.00952837896f, 0.00759728113f, 0.00568309333f, 0.00378163555f, 0.00188868702f,
+    0.0f, -0.00188868702f, -0.00378163555f, -0.00568309333f, -0.00759728113f, -0.00952837896f, -0.0114805112f, -0.0134577369f,
+    -0.0154640349f, -0.0175032876f, -0.0195792746f, -0.0216956567f, -0.0238559637f, -0.0260635857f, -0.0283217579f, -0.0306335539f,
+    -0.0330018774f, -0.0354294404f, -0.0379187688f, -0.0404721946f, -0.0430918224f, -0.0457795635f, -0.0485370867f, -0.0513658486f,
+    -0.05426706f, -0.0572417006f, -0.0602905042f, -0.0634139627f, -0.0666123107f, -0.0698855445f, -0.0732334033f, -0.0766553804f,
+    -0.080150716f, -0.0837184042f, -0.0873571783f, -0.0910655484f, -0.0948417708f, -0.0986838713f, -0.102589644f, -0.106556661f,
+    -0.11058227f, -0.114663608f, -0.118797615f, -0.122981027f, -0.127210408f, -0.131482139f, -0.135792449f, -0.140137374f,
+    -0.144512832f, -0.14891465f, -0.153338447f, -0.157779843f, -0.162234262f, -0.166697145f, -0.171163782f, -0.175629482f,
+    -0.180089489f, -0.18453902f, -0.188973308f, -0.193387583f, -0.197777078f, -0.202137113f, -0.206463024f, -0.210750237f,
+    -0.214994267f, -0.219190702f, -0.223335266f, -0.227423832f, -0.231452361f, -0.235417023f, -0.239314139f, -0.243140221f,
+    -0.246891975f, -0.250566304f, -0.254160374f, -0.257671505f, -0.261097372f, -0.264435798f, -0.267684937f, -0.270843178f,
+    -0.273909211f, -0.276882023f, -0.279760867f, -0.282545328f, -0.285235256f, -0.28783083f, -0.290332556f, -0.292741269f,
+    -0.295058072f, -0.297284424f, -0.299422055f, -0.301473081f, -0.303439885f, -0.30532518f, -0.307131976f, -0.30886361f,
+    -0.310523659f, -0.312116027f, -0.313644946f, -0.315114826f, -0.316530466f, -0.317896783f, -0.319219023f, -0.320502698f,
+    -0.321753412f, -0.322977126f, -0.324179858f, -0.325367898f, -0.326547682f, -0.327725768f, -0.328908831f, -0.330103695f,
+    -0.331317276f, -0.332556546f, -0.333828509f, -0.335140288f, -0.336498946f, -0.337911546f, -0.339385182f, -0.340926886f,
+    -0.342543572f, -0.344242156f, -0.346029371f, -0.347911865f, -0.349896133f, -0.351988494f, -0.354195088f, -0.356521815f,
+    -0.358974367f, -0.361558169f, -0.364278436f, -0.367139995f, -0.370147437f, -0.373305023f, -0.376616597f, -0.380085707f,
+    -0.38371551f, -0.38750878f, -0.391467839f, -0.395594597f, -0.399890512f, -0.404356658f, -0.408993572f, -0.413801342f,
+    -0.418779522f, -0.423927277f, -0.429243177f, -0.434725285f, -0.440371215f, -0.446177959f, -0.45214209f, -0.458259583f,
+    -0.464525908f, -0.470936f, -0.477484256f, -0.484164596f, -0.490970314f, -0.497894257f, -0.504928827f, -0.512065709f,
+    -0.519296348f, -0.526611507f, -0.534001589f, -0.541456401f, -0.548965454f, -0.55651772f, -0.564101756f, -0.571705759f,
+    -0.579317451f, -0.586924255f, -0.594513178f, -0.602071047f, -0.609584153f, -0.617038667f, -0.624420404f, -0.631715059f,
+    -0.638907909f, -0.645984232f, -0.652929068f, -0.659727275f, -0.666363657f, -0.672822893f, -0.679089725f, -0.685148656f,
+    -0.690984428f, -0.696581602f, -0.70192498f, -0.706999302f, -0.711789608f, -0.716280937f, -0.720458508f, -0.724307895f,
+    -0.727814794f, -0.730965197f, -0.733745396f, -0.736142039f, -0.738142133f, -0.739732981f, -0.740902483f, -0.741638839f,
+    -0.741930664f, -0.741767287f, -0.741138279f, -0.740033984f, -0.738445222f, -0.736363411f, -0.733780503f, -0.730689228f,
+    -0.727082849f, -0.722955346f, -0.718301356f, -0.713116288f, -0.70739615f, -0.701137722f, -0.69433862f, -0.686997116f,
+    -0.679112256f, -0.670683861f, -0.661712527f, -0.652199686f, -0.642147422f, -0.631558776f, -0.620437443f, -0.608788013f,
+    -0.596615732f, -0.583926737f, -0.570727944f, -0.557026982f, -0.542832255f, -0.528152943f, -0.512998939f, -0.497380883f,
+    -0.481310189f, -0.464798868f, -0.447859704f, -0.43050611f, -0.412752151f, -0.394612491f, -0.376102477f, -0.357237965f,
+    -0.338035434f, -0.318511873f, -0.298684746f, -0.278572053f, -0.258192241f, -0.237564161f, -0.216707066f, -0.195640609f,
+    -0.174384728f, -0.152959704f, -0.131386086f, -0.109684654f, -0.0878763795f, -0.0659824312f, -0.0440241061f, -0.0220228061f,
+    0.0f,
+    // level 1, 256 samples, harmonics up to 6, fundamentals below 3077 Hz
+    0.0f, 0.0440241061f, 0.0878763795f, 0.131386086f, 0.174384728f, 0.216707066f, 0.258192241f, 0.298684746f,
+    0.338035434f, 0.376102477f, 0.412752151f, 0.447859704f, 0.481310189f, 0.512998939f, 0.542832255f, 0.570727944f,
+    0.596615732f, 0.620437443f, 0.642147422f, 0.661712527f, 0.679112256f, 0.69433862f, 0.70739615f, 0.718301356f,
+    0.727082849f, 0.733780503f, 0.738445222f, 0.741138279f, 0.741930664f, 0.740902483f, 0.738142133f, 0.733745396f,
+    0.727814794f, 0.720458508f, 0.711789608f, 0.70192498f, 0.690984428f, 0.679089725f, 0.666363657f, 0.652929068f,
+    0.638907909f, 0.624420404f, 0.609584153f, 0.594513178f, 0.579317451f, 0.564101756f, 0.548965454f, 0.534001589f,
+    0.519296348f, 0.504928827f, 0.490970314f, 0.477484256f, 0.464525908f, 0.45214209f, 0.440371215f, 0.429243177f,
+    0.418779522f, 0.408993572f, 0.399890512f, 0.391467839f, 0.38371551f, 0.376616597f, 0.370147437f, 0.364278436f,
+    0.358974367f, 0.354195088f, 0.349896133f, 0.346029371f, 0.342543572f, 0.339385182f, 0.336498946f, 0.333828509f,
+    0.331317276f, 0.328908831f, 0.326547682f, 0.324179858f, 0.321753412f, 0.319219023f, 0.316530466f, 0.313644946f,
+    0.310523659f, 0.307131976f, 0.303439885f, 0.299422055f, 0.295058072f, 0.290332556f, 0.285235256f, 0.279760867f,
+    0.273909211f, 0.267684937f, 0.261097372f, 0.254160374f, 0.246891975f, 0.239314139f, 0.231452361f, 0.223335266f,
+    0.214994267f, 0.206463024f, 0.197777078f, 0.188973308f, 0.180089489f, 0.171163782f, 0.162234262f, 0.153338447f,
+    0.144512832f, 0.135792449f, 0.127210408f, 0.118797615f, 0.11058227f, 0.102589644f, 0.0948417708f, 0.0873571783f,
+    0.080150716f, 0.0732334033f, 0.0666123107f, 0.0602905042f, 0.05426706f, 0.0485370867f, 0.0430918224f, 0.0379187688f,
+    0.0330018774f, 0.0283217579f, 0.0238559637f, 0.0195792746f, 0.0154640349f, 0.0114805112f, 0.00759728113f, 0.00378163555f,
+    0.0f, -0.00378163555f, -0.00759728113f, -0.0114805112f, -0.0154640349f, -0.0195792746f, -0.0238559637f, -0.0283217579f,
+    -0.0330018774f, -0.0379187688f, -0.0430918224f, -0.0485370867f, -0.05426706f, -0.0602905042f, -0.0666123107f, -0.0732334033f,
+    -0.080150716f, -0.0873571783f, -0.0948417708f, -0.102589644f, -0.11058227f, -0.118797615f, -0.127210408f, -0.135792449f,
+    -0.144512832f, -0.153338447f, -0.162234262f, -0.171163782f, -0.180089489f, -0.188973308f, -0.197777078f, -0.206463024f,
+    -0.214994267f, -0.223335266f, -0.231452361f, -0.239314139f, -0.246891975f, -0.254160374f, -0.261097372f, -0.267684937f,
+    -0.273909211f, -0.279760867f, -0.285235256f, -0.290332556f, -0.295058072f, -0.299422055f, -0.303439885f, -0.307131976f,
+    -0.310523659f, -0.313644946f, -0.316530466f, -0.319219023f, -0.321753412f, -0.324179858f, -0.326547682f, -0.328908831f,
+    -0.331317276f, -0.333828509f, -0.336498946f, -0.339385182f, -0.342543572f, -0.346029371f, -0.349896133f, -0.354195088f,
+    -0.358974367f, -0.364278436f, -0.370147437f, -0.376616597f, -0.38371551f, -0.391467839f, -0.399890512f, -0.408993572f,
+    -0.418779522f, -0.429243177f, -0.440371215f, -0.45214209f, -0.464525908f, -0.477484256f, -0.490970314f, -0.504928827f,
+    -0.519296348f, -0.534001589f, -0.548965454f, -0.564101756f, -0.579317451f, -0.594513178f, -0.609584153f, -0.624420404f,
+    -0.638907909f, -0.652929068f, -0.666363657f, -0.679089725f, -0.690984428f, -0.70192498f, -0.711789608f, -0.720458508f,
+    -0.727814794f, -0.733745396f, -0.738142133f, -0.740902483f, -0.741930664f, -0.741138279f, -0.738445222f, -0.733780503f,
+    -0.727082849f, -0.718301356f, -0.70739615f, -0.69433862f, -0.679112256f, -0.661712527f, -0.642147422f, -0.620437443f,
+    -0.596615732f, -0.570727944f, -0.542832255f, -0.512998939f, -0.481310189f, -0.447859704f, -0.412752151f, -0.376102477f,
+    -0.338035434f, -0.298684746f, -0.258192241f, -0.216707066f, -0.174384728f, -0.131386086f, -0.0878763795f, -0.0440241061f,
+    0.0f,
+    // level 2, 128 samples, harmonics up to 3, fundamentals below 6154 Hz
+    0.0f, 0.0728694275f, 0.144947544f, 0.215456069f, 0.28364262f, 0.34879294f, 0.410242528f, 0.467387229f,
+    0.519692659f, 0.566702425f, 0.608044624f, 0.643436909f, 0.672690034f, 0.69570905f, 0.712493479f, 0.723135173f,
+    0.727814794f, 0.726796567f, 0.720421612f, 0.709099829f, 0.693300784f, 0.673543334f, 0.650385082f, 0.62441051f,
+    0.59621942f, 0.56641531f, 0.535593569f, 0.504330397f, 0.473172367f, 0.442626685f, 0.413152725f, 0.385154396f,
+    0.358974367f, 0.334889203f, 0.313106388f, 0.293762773f, 0.276924461f, 0.262588471f, 0.250685751f, 0.24108544f,
+    0.233600572f, 0.227994874f, 0.223990425f, 0.221276045f, 0.219516382f, 0.218361184f, 0.217454791f, 0.216445416f,
+    0.214994267f, 0.212784022f, 0.209526673f, 0.204970434f, 0.198905662f, 0.19116962f, 0.181649923f, 0.17028679f,
+    0.157073796f, 0.142057329f, 0.12533471f, 0.107051022f, 0.0873947069f, 0.0665921345f, 0.044901222f, 0.0226042289f,
+    0.0f, -0.0226042289f, -0.044901222f, -0.0665921345f, -0.0873947069f, -0.107051022f, -0.12533471f, -0.142057329f,
+    -0.157073796f, -0.17028679f, -0.181649923f, -0.19116962f, -0.198905662f, -0.204970434f, -0.209526673f, -0.212784022f,
+    -0.214994267f, -0.216445416f, -0.217454791f, -0.218361184f, -0.219516382f, -0.221276045f, -0.223990425f, -0.227994874f,
+    -0.233600572f, -0.24108544f, -0.250685751f, -0.262588471f, -0.276924461f, -0.293762773f, -0.313106388f, -0.334889203f,
+    -0.358974367f, -0.385154396f, -0.413152725f, -0.442626685f, -0.473172367f, -0.504330397f, -0.535593569f, -0.56641531f,
+    -0.59621942f, -0.62441051f, -0.650385082f, -0.673543334f, -0.693300784f, -0.709099829f, -0.720421612f, -0.726796567f,
+    -0.727814794f, -0.723135173f, -0.712493479f, -0.69570905f, -0.672690034f, -0.643436909f, -0.608044624f, -0.566702425f,
+    -0.519692659f, -0.467387229f, -0.410242528f, -0.34879294f, -0.28364262f, -0.215456069f, -0.144947544f, -0.0728694275f,
+    0.0f,
+    // level 3, 64 samples, harmonics up to 1, higher fundamentals
+    0.0f, 0.0502652004f, 0.100046322f, 0.148863941f, 0.19624792f, 0.241741911f, 0.284907818f, 0.3253299f,
+    0.362618864f, 0.396415621f, 0.426394671f, 0.452267319f, 0.473784387f, 0.49073863f, 0.502966821f, 0.510351121f,
+    0.512820542f, 0.510351121f, 0.502966821f, 0.49073863f, 0.473784387f, 0.452267319f, 0.426394671f, 0.396415621f,
+    0.362618864f, 0.3253299f, 0.284907818f, 0.241741911f, 0.19624792f, 0.148863941f, 0.100046322f, 0.0502652004f,
+    0.0f, -0.0502652004f, -0.100046322f, -0.148863941f, -0.19624792f, -0.241741911f, -0.284907818f, -0.3253299f,
+    -0.362618864f, -0.396415621f, -0.426394671f, -0.452267319f, -0.473784387f, -0.49073863f, -0.502966821f, -0.510351121f,
+    -0.512820542f, -0.510351121f, -0.502966821f, -0.49073863f, -0.473784387f, -0.452267319f, -0.426394671f, -0.396415621f,
+    -0.362618864f, -0.3253299f, -0.284907818f, -0.241741911f, -0.19624792f, -0.148863941f, -0.100046322f, -0.0502652004f,
+    0.0f,
+  },
+};
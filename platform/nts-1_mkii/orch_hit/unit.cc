@@ -57,9 +57,11 @@
 #include "macros.h"
 #include <math.h>
 
+#include "dsp/noisegen.hpp"
+#include "dsp/approx.hpp"
+
 #define MAX_VOICES 4
 #define STRING_SAWS 5
-#define NOISE_BUFFER_SIZE 1024  // Reduced from 2048
 #define CHORUS_BUFFER_SIZE 2048  // Reduced from 4096
 
 static const unit_runtime_osc_context_t *s_context;
@@ -113,9 +115,8 @@ struct Voice {
 
 static Voice s_voices[MAX_VOICES];
 
-// Noise buffer (pre-generated white noise)
-static float s_noise_buffer[NOISE_BUFFER_SIZE];
-static uint32_t s_noise_seed;
+// White noise source
+static dsp::NoiseGen s_noise_gen;
 
 // Chorus buffer
 static float s_chorus_buffer_l[CHORUS_BUFFER_SIZE];
@@ -177,26 +178,8 @@ inline float poly_blep(float t, float dt) {
     return 0.f;
 }
 
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
-void init_noise_buffer() {
-    s_noise_seed = 0x87654321;
-    for (int i = 0; i < NOISE_BUFFER_SIZE; i++) {
-        s_noise_seed = s_noise_seed * 1103515245u + 12345u;
-        float white = ((float)(s_noise_seed >> 16) / 32768.f) - 1.f;
-        s_noise_buffer[i] = white;
-    }
-}
-
 inline float read_noise() {
-    s_noise_seed = s_noise_seed * 1103515245u + 12345u;
-    uint32_t idx = (s_noise_seed >> 16) % NOISE_BUFFER_SIZE;
-    return s_noise_buffer[idx];
+    return s_noise_gen.white();
 }
 
 // LAYER 1: BRASS OSCILLATOR with formant filter
@@ -469,7 +452,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
 
     s_context = static_cast<const unit_runtime_osc_context_t *>(desc->hooks.runtime_context);
 
-    init_noise_buffer();
+    s_noise_gen.seed(0x87654321);
     
     for (int v = 0; v < MAX_VOICES; v++) {
         Voice *voice = &s_voices[v];
@@ -622,7 +605,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         mono = chorus_process(mono, 0);
         
         // Analog saturation
-        mono = fast_tanh(mono * (1.f + s_vintage_amount));
+        mono = dsp::approx::tanh<dsp::approx::k_faster>(mono * (1.f + s_vintage_amount));
         
         out[f] = clipminmaxf(-1.f, mono * 3.5f, 1.f);  // ✅ Increased output gain (was 3.0f)
         
@@ -57,6 +57,7 @@
 #include "utils/int_math.h"
 #include "macros.h"
 #include <math.h>
+#include "dsp/approx.hpp"
 
 #define MAX_VOICES 4
 #define CHORUS_BUFFER_SIZE 2048  // Reduced from 4096
@@ -133,13 +134,6 @@ static const Organ2Preset s_presets[8] = {
     {0.80f, 0.95f, 0.90f, 0.60f, 0.70f, 0.45f, 0.60f, 0.35f, "EPIC"}     // Epic
 };
 
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // 2-Operator FM synthesis
 inline float fm_operator(float carrier_phase, float modulator_phase, 
                          float mod_index, float fm_ratio) {
@@ -287,7 +281,7 @@ inline float apply_dirt(float x, float amount) {
     if (amount < 0.01f) return x;
     
     float drive = 1.f + amount * 4.f;
-    return fast_tanh(x * drive) / drive;
+    return dsp::approx::tanh<dsp::approx::k_faster>(x * drive) / drive;
 }
 
 __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
@@ -19,6 +19,7 @@
 #include "osc_api.h"
 #include "fx_api.h"
 #include "utils/float_math.h"
+#include "dsp/noisegen.hpp"
 
 // ========== VOICE STATE ==========
 
@@ -37,13 +38,10 @@ static Voice s_voice;
 
 // ========== NOISE GENERATOR ==========
 
-static uint32_t s_noise_state = 12345;
+static dsp::NoiseGen s_noise_gen;
 
 inline float generate_noise() {
-    s_noise_state ^= s_noise_state << 13;
-    s_noise_state ^= s_noise_state >> 17;
-    s_noise_state ^= s_noise_state << 5;
-    return ((float)(s_noise_state % 10000) / 10000.f) * 2.f - 1.f;
+    return s_noise_gen.white();
 }
 
 // ========== PARAMETERS ==========
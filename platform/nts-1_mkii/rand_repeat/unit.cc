@@ -69,6 +69,7 @@
 #include "utils/float_math.h"
 #include "osc_api.h"
 #include "fx_api.h"
+#include "dsp/noisegen.hpp"
 
 #define MAX_GRAINS 32
 #define GRAIN_BUFFER_SIZE 2048
@@ -129,8 +130,8 @@ static float s_state_crossfade;
 // Pattern memory
 static float s_pattern_snapshots[8][PROB_MATRIX_SIZE][PROB_MATRIX_SIZE];
 
-// Random state
-static uint32_t s_random_seed;
+// Random source
+static dsp::NoiseGen s_noise_gen;
 
 // Mutation
 static uint32_t s_mutation_counter;
@@ -151,29 +152,19 @@ static bool s_freeze;
 static uint32_t s_sample_counter;
 static uint32_t s_trigger_counter;  // FIXED: Rate limit grain triggering
 
-// Fast random (Xorshift)
+// Raw 32 random bits
 inline uint32_t xorshift32() {
-    s_random_seed ^= s_random_seed << 13;
-    s_random_seed ^= s_random_seed >> 17;
-    s_random_seed ^= s_random_seed << 5;
-    return s_random_seed;
+    return s_noise_gen.next();
 }
 
 inline float random_float() {
-    return (float)(xorshift32() % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 inline float random_range(float min, float max) {
     return min + random_float() * (max - min);
 }
 
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // Hann window envelope (osc_cosf expects phase in [0,1] range)
 inline float hann_window(float phase) {
     if (phase < 0.f) phase = 0.f;
@@ -439,7 +430,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     }
     
     // Init random
-    s_random_seed = 0x12345678;
+    s_noise_gen.seed(0x12345678);
     
     // Init probability states
     s_current_state = 0;
@@ -486,6 +477,11 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
     const float *in_ptr = in;
     float *out_ptr = out;
     
+    // Parameters only change between render calls, derive the intervals once per buffer
+    s_mutation_interval = (uint32_t)(2400.f + (1.f - s_mutation_rate) * 45600.f);
+    // Trigger interval based on density (10-1000 samples = 48Hz - 0.48Hz)
+    const uint32_t trigger_interval = (uint32_t)(10.f + (1.f - s_density) * 990.f);
+    
     for (uint32_t f = 0; f < frames; f++) {
         float in_l = in_ptr[0];
         float in_r = in_ptr[1];
@@ -498,7 +494,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         // Mutation (state evolution)
         if (!s_freeze) {
             s_mutation_counter++;
-            s_mutation_interval = (uint32_t)(2400.f + (1.f - s_mutation_rate) * 45600.f);
             
             if (s_mutation_counter >= s_mutation_interval) {
                 s_mutation_counter = 0;
@@ -520,8 +515,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         
         // Trigger new grains (FIXED: Rate-limited to prevent feedback/whistle)
         s_trigger_counter++;
-        // Calculate trigger interval based on density (10-1000 samples = 48Hz - 0.48Hz)
-        uint32_t trigger_interval = (uint32_t)(10.f + (1.f - s_density) * 990.f);
         
         if (s_trigger_counter >= trigger_interval) {
             s_trigger_counter = 0;
@@ -33,6 +33,7 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "osc_api.h"
+#include "dsp/approx.hpp"
 
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
 // const float PI = 3.14159265359f; // Removed - conflicts with CMSIS
@@ -141,13 +142,6 @@ static uint8_t s_preset;
 static uint32_t s_sample_counter;
 
 // Fast math
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 // PolyBLEP antialiasing
 inline float poly_blep(float t, float dt) {
     if (t < dt) {
@@ -520,7 +514,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
             
             // Drive/distortion
             if (s_drive > 0.01f) {
-                sample = fast_tanh(sample * (1.f + s_drive * 3.f));
+                sample = dsp::approx::tanh<dsp::approx::k_faster>(sample * (1.f + s_drive * 3.f));
             }
             
             sig += sample;
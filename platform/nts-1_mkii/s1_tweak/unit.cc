@@ -9,6 +9,7 @@
 #include "fx_api.h"  // ✅ For fx_pow2f() in oscillators
 #include "utils/float_math.h"  // ✅ For fastertanh2f()
 #include "utils/int_math.h"
+#include "dsp/noisegen.hpp"
 
 // ========== MODES ==========
 
@@ -77,7 +78,7 @@ static float s_motion_phase = 0.f;
 
 // ========== NOISE STATE ==========
 
-static uint32_t s_noise_state = 12345;
+static dsp::NoiseGen s_noise_gen;
 static float s_noise_envelope = 0.f;
 
 // ========== PARAMETERS ==========
@@ -100,10 +101,7 @@ static uint8_t s_current_velocity = 100;
 // ========== RANDOM GENERATOR ==========
 
 inline float random_float() {
-    s_noise_state ^= s_noise_state << 13;
-    s_noise_state ^= s_noise_state >> 17;
-    s_noise_state ^= s_noise_state << 5;
-    return (float)(s_noise_state % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ========== POLY BLEP (ANTI-ALIASING) ==========
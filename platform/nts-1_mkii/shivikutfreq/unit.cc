@@ -24,19 +24,8 @@
 #include "unit_delfx.h"
 #include "fx_api.h"
 #include "utils/float_math.h"
-
-// ========== NaN/Inf CHECK MACRO (FIXED!) ==========
-// ✅ FIX: Correct NaN detection (NaN != NaN is TRUE)
-// Note: si_isfinite() not available for delfx, using correct macro instead
-#define is_finite(x) ((x) != (x) ? false : ((x) <= 1e10f && (x) >= -1e10f))
-
-// ========== FAST TANH ==========
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
+#include "dsp/approx.hpp"
+#include "utils/fp_guard.h"
 
 // ========== MEMORY BUDGET ==========
 
@@ -116,9 +105,6 @@ inline float hilbert_process(HilbertTransform *h, float input) {
     h->z2 = h->z1;
     h->z1 = input;
     
-    // Denormal kill
-    if (si_fabsf(output) < 1e-15f) output = 0.f;
-    
     return output;
 }
 
@@ -162,8 +148,6 @@ inline float delay_read(float *buffer, float delay_samples) {
     float sample = buffer[read_pos_0] * (1.f - frac) + 
                    buffer[read_pos_1] * frac;
     
-    if (!is_finite(sample)) sample = 0.f;
-    
     return sample;
 }
 
@@ -174,8 +158,6 @@ inline float apply_tone(float input, float *z1) {
     
     *z1 += coeff * (input - *z1);
     
-    if (si_fabsf(*z1) < 1e-15f) *z1 = 0.f;
-    
     // Tilt EQ: dark = more LP, bright = more HP
     if (s_tone < 0.5f) {
         return *z1;  // Lowpass
@@ -192,8 +174,8 @@ inline float apply_lofi(float input) {
     
     // Bit crushing
     float bits = 16.f - s_lofi * 12.f;  // 16-bit to 4-bit
-    float scale = fx_pow2f(bits);
-    float crushed = si_floorf(input * scale + 0.5f) / scale;
+    float scale = fastpow2f(bits);
+    float crushed = si_roundf(input * scale) / scale;
     
     // Sample rate reduction effect
     static uint32_t lofi_counter = 0;
@@ -226,10 +208,6 @@ inline float get_wander_mod() {
 // ========== MAIN PROCESSOR ==========
 
 inline void process_shivikutfreq(float in_l, float in_r, float *out_l, float *out_r) {
-    // Input validation
-    if (!is_finite(in_l)) in_l = 0.f;
-    if (!is_finite(in_r)) in_r = 0.f;
-    
     // Calculate delay time
     float delay_time = s_time;
     
@@ -256,9 +234,6 @@ inline void process_shivikutfreq(float in_l, float in_r, float *out_l, float *ou
     float delayed_l = delay_read(s_delay_buffer_l, delay_samples);
     float delayed_r = delay_read(s_delay_buffer_r, delay_samples);
     
-    if (!is_finite(delayed_l)) delayed_l = 0.f;
-    if (!is_finite(delayed_r)) delayed_r = 0.f;
-    
     // Apply frequency shift to delayed signal
     if (s_direction != DIR_OFF && si_fabsf(s_shift_hz) > 0.01f) {
         // Generate Hilbert transform (90° phase shift)
@@ -292,15 +267,12 @@ inline void process_shivikutfreq(float in_l, float in_r, float *out_l, float *ou
     float write_r = in_r + delayed_r * fb;
     
     // Soft clip feedback
-    write_l = fast_tanh(write_l * 0.5f) * 2.f;
-    write_r = fast_tanh(write_r * 0.5f) * 2.f;
+    write_l = dsp::approx::tanh<dsp::approx::k_faster>(write_l * 0.5f) * 2.f;
+    write_r = dsp::approx::tanh<dsp::approx::k_faster>(write_r * 0.5f) * 2.f;
     
     write_l = clipminmaxf(-2.f, write_l, 2.f);
     write_r = clipminmaxf(-2.f, write_r, 2.f);
     
-    if (!is_finite(write_l)) write_l = 0.f;
-    if (!is_finite(write_r)) write_r = 0.f;
-    
     if (s_delay_buffer_l && s_delay_buffer_r) {
         s_delay_buffer_l[s_write_pos] = write_l;
         s_delay_buffer_r[s_write_pos] = write_r;
@@ -318,10 +290,6 @@ inline void process_shivikutfreq(float in_l, float in_r, float *out_l, float *ou
         delayed_r = mid - side;
     }
     
-    // Validate output
-    if (!is_finite(delayed_l)) delayed_l = 0.f;
-    if (!is_finite(delayed_r)) delayed_r = 0.f;
-    
     // Mix
     float dry_gain = 1.f - si_fabsf(s_mix);
     float wet_gain = (s_mix + 1.f) * 0.5f;
@@ -421,6 +389,14 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+    
+    // Sanitize the tone filter state once per block
+    FP_GUARD_WATCH("tone.z1_l", s_tone_z1_l);
+    FP_GUARD_WATCH("tone.z1_r", s_tone_z1_r);
+    fp_sanitize_block(&s_tone_z1_l, 1);
+    fp_sanitize_block(&s_tone_z1_r, 1);
+    
     const float *in_ptr = in;
     float *out_ptr = out;
     
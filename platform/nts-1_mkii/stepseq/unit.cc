@@ -59,6 +59,8 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "fx_api.h"
+#include "dsp/zdf.hpp"
+#include "dsp/noisegen.hpp"
 #include <algorithm>
 
 // SDK compatibility - PI is already defined in CMSIS arm_math.h
@@ -67,6 +69,7 @@
 #endif
 
 #define NUM_STEPS 16
+#define RENDER_BLOCK 64
 #define NUM_PATTERNS 8
 
 // Step data structure
@@ -115,89 +118,49 @@ static uint8_t s_direction_mode;  // 0=FWD, 1=REV, 2=PING, 3=RANDOM
 // ✅ ADD: Play/Stop state
 static bool s_sequencer_playing = true;  // ON by default!
 
-// State-variable filter
-static float s_svf_z1_l, s_svf_z2_l;
-static float s_svf_z1_r, s_svf_z2_r;
+// State-variable filter (stereo, LP output)
+typedef dsp::ZdfSvf<2> StepFilter;
+static StepFilter s_svf;
 
 // Envelope
 static float s_amp_envelope;
 
-// Random seed
-static uint32_t s_random_seed;
+// Random source
+static dsp::NoiseGen s_noise_gen;
 
 static uint32_t s_sample_counter;
 
-// XORShift random
+// Raw 32 random bits
 inline uint32_t xorshift32() {
-    s_random_seed ^= s_random_seed << 13;
-    s_random_seed ^= s_random_seed >> 17;
-    s_random_seed ^= s_random_seed << 5;
-    return s_random_seed;
+    return s_noise_gen.next();
 }
 
 inline float random_float() {
-    return (float)(xorshift32() % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
-// State-variable filter (LP output)
-inline float svf_process(float input, float cutoff, float resonance, 
-                         float *z1, float *z2) {
-    // ✅ Safety: Clip input
-    input = clipminmaxf(-2.f, input, 2.f);
-    
-    // ✅ FIX: Safe cutoff range (100Hz - 12kHz)
-    cutoff = clipminmaxf(0.15f, cutoff, 0.85f);
-    float freq = 100.f + cutoff * 11900.f;
-    freq = clipminmaxf(100.f, freq, 12000.f);
-    
-    float w = 2.f * PI * freq / 48000.f;
-    w = clipminmaxf(0.001f, w, PI * 0.95f);  // Prevent aliasing
-    float phase = (w * 0.5f) / (2.f * PI);
-    phase = clipminmaxf(0.f, phase, 0.5f);
-    
-    // ✅ CRITICAL: Limit resonance to prevent fluittoon!
-    resonance = clipminmaxf(0.3f, resonance, 0.707f);  // NEVER > 0.707!
-    
-    float sin_w = fx_sinf(phase);
-    float cos_w = fx_cosf(phase);
-    
-    float alpha = sin_w / (2.f * resonance);
-    alpha = clipminmaxf(0.001f, alpha, 0.99f);  // Safety
-    
-    // Biquad coefficients
-    float b0 = (1.f - cos_w) / 2.f;
-    float b1 = 1.f - cos_w;
-    float b2 = (1.f - cos_w) / 2.f;
-    float a0 = 1.f + alpha;
-    float a1 = -2.f * cos_w;
-    float a2 = 1.f - alpha;
-    
-    b0 /= a0; b1 /= a0; b2 /= a0;
-    a1 /= a0; a2 /= a0;
-    
-    // Process
-    float output = b0 * input + b1 * (*z1) + b2 * (*z2) - a1 * (*z1) - a2 * (*z2);
-    
-    // ✅ Update states
-    *z2 = *z1;
-    *z1 = input;
-    
-    // ✅ CRITICAL: Denormal kill!
-    if (si_fabsf(*z1) < 1e-15f) *z1 = 0.f;
-    if (si_fabsf(*z2) < 1e-15f) *z2 = 0.f;
-    
-    // ✅ Output limiting
-    output = clipminmaxf(-2.f, output, 2.f);
-    
-    return output;
+// State-variable filter coefficients for a step
+inline StepFilter::Coeffs svf_coeffs(float filter_mod) {
+    // ✅ MORE DRAMATIC: Wider filter range (50Hz - 15kHz)
+    float filter_cutoff = clipminmaxf(0.05f, filter_mod, 0.95f);  // 5%-95%
+    float freq = 50.f + filter_cutoff * 14950.f;
+
+    // ✅ FIX: Safe Q-range to prevent fluittoon (0.4-0.707 max!)
+    float q = 0.4f + filter_mod * 0.3f;  // 0.4-0.7
+    q = clipminmaxf(0.3f, q, 0.707f);  // MAX 0.707!
+
+    // ZDF SVF damping is 1/Q = 2 - 2 res, negative res reaches Q below 0.5
+    StepFilter::Coeffs c;
+    c.set(freq / 48000.f, 1.f - 0.5f / q, StepFilter::k_lp);
+    return c;
 }
 
 // Pitch shifter (simple ring modulation)
 inline float pitch_shift(float input, int8_t semitones) {
     if (semitones == 0) return input;
     
-    // ✅ FIXED: Use fx_pow2f (NOT fastpow2f - doesn't exist!)
-    float ratio = fx_pow2f((float)semitones / 12.f);
+    // fx_pow2f indexes its table out of range for negative arguments
+    float ratio = fastpow2f((float)semitones / 12.f);
     ratio = clipminmaxf(0.25f, ratio, 4.f);  // Limit range for safety
     
     float phase = (float)(s_sample_counter % 48000) / 48000.f;
@@ -381,11 +344,12 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
     s_step_probability = 1.0f;
     s_direction_mode = 0;
     
-    s_svf_z1_l = s_svf_z2_l = 0.f;
-    s_svf_z1_r = s_svf_z2_r = 0.f;
+    s_svf.flush();
+    s_svf.setCoeffs(svf_coeffs(get_current_step()->filter_mod));
+    s_svf.snap();
     s_amp_envelope = 0.f;
     
-    s_random_seed = 12345;
+    s_noise_gen.seed(12345);
     s_sample_counter = 0;
 
     return k_unit_err_none;
@@ -403,8 +367,7 @@ __unit_callback void unit_reset()
     s_step_direction = 1;  // ✅ Reset to forward
     
     // ✅ FIX: Reset filter states to prevent clicks and fluittoon
-    s_svf_z1_l = s_svf_z2_l = 0.f;
-    s_svf_z1_r = s_svf_z2_r = 0.f;
+    s_svf.flush();
 }
 
 __unit_callback void unit_resume() {}
@@ -412,122 +375,132 @@ __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
 {
-    for (uint32_t f = 0; f < frames; f++) {
-        float in_l = clipminmaxf(-1.f, in[f * 2], 1.f);
-        float in_r = clipminmaxf(-1.f, in[f * 2 + 1], 1.f);
-        
-        // ✅ CHECK: Is sequencer playing?
-        if (!s_sequencer_playing) {
-            // ✅ PASS-THROUGH mode when stopped
-            out[f * 2] = in_l;
-            out[f * 2 + 1] = in_r;
-            continue;  // Skip all processing!
+    // ✅ CHECK: Is sequencer playing?
+    if (!s_sequencer_playing) {
+        // ✅ PASS-THROUGH mode when stopped
+        for (uint32_t f = 0; f < frames * 2; f++) {
+            out[f] = clipminmaxf(-1.f, in[f], 1.f);
         }
+        return;
+    }
+
+    // Sequencer and envelope per sample, the filter a block at a time
+    float pitched[RENDER_BLOCK * 2];
+    float envelope[RENDER_BLOCK];
+    float filter_mod = 0.f;
+
+    while (frames > 0) {
+        const uint32_t n = (frames < RENDER_BLOCK) ? frames : RENDER_BLOCK;
+
+        for (uint32_t f = 0; f < n; f++) {
+            float in_l = clipminmaxf(-1.f, in[f * 2], 1.f);
+            float in_r = clipminmaxf(-1.f, in[f * 2 + 1], 1.f);
+
+            // ✅ Sequencer is playing - get current step
+            Step *current_step_data = get_current_step();
         
-        // ✅ Sequencer is playing - get current step
-        Step *current_step_data = get_current_step();
-        
-        // Update step position (only when playing)
-        s_step_counter++;
+            // Update step position (only when playing)
+            s_step_counter++;
         
-        // Calculate samples per step (with ratcheting)
-        uint8_t ratchet_div = current_step_data->ratchet_count;
-        uint32_t step_length = s_samples_per_step / ratchet_div;
+            // Calculate samples per step (with ratcheting)
+            uint8_t ratchet_div = current_step_data->ratchet_count;
+            uint32_t step_length = s_samples_per_step / ratchet_div;
         
-        // Apply swing offset (only to odd steps)
-        if (s_current_step % 2 == 1) {
-            float swing_offset = calc_swing_offset(s_current_step);
-            step_length = (uint32_t)((float)step_length * (1.f + swing_offset));
-        }
+            // Apply swing offset (only to odd steps)
+            if (s_current_step % 2 == 1) {
+                float swing_offset = calc_swing_offset(s_current_step);
+                step_length = (uint32_t)((float)step_length * (1.f + swing_offset));
+            }
         
-        // Check if we need to advance to next step
-        if (s_step_counter >= step_length) {
-            s_step_counter = 0;
-            s_ratchet_index++;
+            // Check if we need to advance to next step
+            if (s_step_counter >= step_length) {
+                s_step_counter = 0;
+                s_ratchet_index++;
             
-            if (s_ratchet_index >= current_step_data->ratchet_count) {
-                // Move to next step
-                advance_sequencer();
-                current_step_data = get_current_step();
-                s_ratchet_index = 0;
-            }
+                if (s_ratchet_index >= current_step_data->ratchet_count) {
+                    // Move to next step
+                    advance_sequencer();
+                    current_step_data = get_current_step();
+                    s_ratchet_index = 0;
+                }
             
-            s_gate_phase = 0.f;
-        }
+                s_gate_phase = 0.f;
+            }
         
-        // Update gate phase (0.0 to 1.0 within step)
-        s_gate_phase = (float)s_step_counter / (float)step_length;
+            // Update gate phase (0.0 to 1.0 within step)
+            s_gate_phase = (float)s_step_counter / (float)step_length;
         
-        // Calculate gate (amplitude envelope)
-        float gate_length = current_step_data->gate_length;
-        float gate = 0.f;
+            // Calculate gate (amplitude envelope)
+            float gate_length = current_step_data->gate_length;
+            float gate = 0.f;
         
-        if (s_gate_phase < gate_length) {
-            // Attack phase
-            if (s_gate_phase < 0.01f) {
-                gate = s_gate_phase / 0.01f;  // Fast attack (10ms)
+            if (s_gate_phase < gate_length) {
+                // Attack phase
+                if (s_gate_phase < 0.01f) {
+                    gate = s_gate_phase / 0.01f;  // Fast attack (10ms)
+                } else {
+                    gate = 1.f;
+                }
             } else {
-                gate = 1.f;
+                // Release phase
+                float release_phase = (s_gate_phase - gate_length) / (1.f - gate_length);
+                gate = 1.f - release_phase;
             }
-        } else {
-            // Release phase
-            float release_phase = (s_gate_phase - gate_length) / (1.f - gate_length);
-            gate = 1.f - release_phase;
-        }
-        
-        gate = clipminmaxf(0.f, gate, 1.f);
-        
-        // ✅ SNAPPIER: Faster envelope response (3x faster!)
-        float envelope_speed = 0.3f;  // Was 0.1f
-        if (gate_length < 0.3f) {
-            // Short gates: even snappier attack/release
-            envelope_speed = 0.5f;
-        }
-        s_amp_envelope += (gate - s_amp_envelope) * envelope_speed;
-        
-        // Apply pitch offset (ring modulation style)
-        float pitched_l = pitch_shift(in_l, current_step_data->pitch_offset);
-        float pitched_r = pitch_shift(in_r, current_step_data->pitch_offset);
         
-        // ✅ MORE DRAMATIC: Wider filter range (50Hz - 15kHz)
-        float filter_cutoff = current_step_data->filter_mod;  // 0%-100% (full range!)
-        filter_cutoff = clipminmaxf(0.05f, filter_cutoff, 0.95f);  // 5%-95%
+            gate = clipminmaxf(0.f, gate, 1.f);
         
-        // Map to frequency: 50Hz - 15kHz (dramatic!)
-        float freq = 50.f + filter_cutoff * 14950.f;
-        freq = clipminmaxf(50.f, freq, 15000.f);
-        
-        // Convert back to normalized cutoff for SVF (0-1 range)
-        // SVF expects normalized frequency: f / sample_rate
-        filter_cutoff = freq / 48000.f;
-        filter_cutoff = clipminmaxf(0.001f, filter_cutoff, 0.48f);  // Prevent aliasing
-        
-        // ✅ FIX: Safe Q-range to prevent fluittoon (0.4-0.707 max!)
-        float filter_resonance = 0.4f + current_step_data->filter_mod * 0.3f;  // 0.4-0.7
-        filter_resonance = clipminmaxf(0.3f, filter_resonance, 0.707f);  // MAX 0.707!
-        
-        float filtered_l = svf_process(pitched_l, filter_cutoff, filter_resonance, 
-                                       &s_svf_z1_l, &s_svf_z2_l);
-        float filtered_r = svf_process(pitched_r, filter_cutoff, filter_resonance, 
-                                       &s_svf_z1_r, &s_svf_z2_r);
-        
-        // Apply gate envelope
-        float modulated_l = filtered_l * s_amp_envelope;
-        float modulated_r = filtered_r * s_amp_envelope;
+            // ✅ SNAPPIER: Faster envelope response (3x faster!)
+            float envelope_speed = 0.3f;  // Was 0.1f
+            if (gate_length < 0.3f) {
+                // Short gates: even snappier attack/release
+                envelope_speed = 0.5f;
+            }
+            s_amp_envelope += (gate - s_amp_envelope) * envelope_speed;
         
-        // ✅ MORE WET: 30/70 mix (effect more audible!)
-        out[f * 2] = in_l * 0.3f + modulated_l * 0.7f;
-        out[f * 2 + 1] = in_r * 0.3f + modulated_r * 0.7f;
+            // Apply pitch offset (ring modulation style)
+            float pitched_l = pitch_shift(in_l, current_step_data->pitch_offset);
+            float pitched_r = pitch_shift(in_r, current_step_data->pitch_offset);
+
+            // ✅ Safety: Clip filter input
+            pitched[f * 2] = clipminmaxf(-2.f, pitched_l, 2.f);
+            pitched[f * 2 + 1] = clipminmaxf(-2.f, pitched_r, 2.f);
+            envelope[f] = s_amp_envelope;
+            filter_mod = current_step_data->filter_mod;
+
+            // pitch_shift() reads the counter, it advances here per frame
+            s_sample_counter++;
+        }
+
+        // Filter sweeps to the step playing at the end of the block
+        s_svf.setCoeffs(svf_coeffs(filter_mod));
+        s_svf.process(pitched, pitched, n);
+
+        for (uint32_t f = 0; f < n; f++) {
+            float in_l = clipminmaxf(-1.f, in[f * 2], 1.f);
+            float in_r = clipminmaxf(-1.f, in[f * 2 + 1], 1.f);
+            float filtered_l = pitched[f * 2];
+            float filtered_r = pitched[f * 2 + 1];
+
+            // Apply gate envelope
+            float modulated_l = filtered_l * envelope[f];
+            float modulated_r = filtered_r * envelope[f];
         
-        // ✅ Boost output slightly for more presence
-        out[f * 2] *= 1.2f;
-        out[f * 2 + 1] *= 1.2f;
+            // ✅ MORE WET: 30/70 mix (effect more audible!)
+            out[f * 2] = in_l * 0.3f + modulated_l * 0.7f;
+            out[f * 2 + 1] = in_r * 0.3f + modulated_r * 0.7f;
         
-        // Output limiting
-        out[f * 2] = clipminmaxf(-1.f, out[f * 2], 1.f);
-        out[f * 2 + 1] = clipminmaxf(-1.f, out[f * 2 + 1], 1.f);
+            // ✅ Boost output slightly for more presence
+            out[f * 2] *= 1.2f;
+            out[f * 2 + 1] *= 1.2f;
         
-        s_sample_counter++;
+            // Output limiting
+            out[f * 2] = clipminmaxf(-1.f, out[f * 2], 1.f);
+            out[f * 2 + 1] = clipminmaxf(-1.f, out[f * 2 + 1], 1.f);
+        }
+
+        in += n * 2;
+        out += n * 2;
+        frames -= n;
     }
 }
 
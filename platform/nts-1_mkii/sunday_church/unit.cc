@@ -2,10 +2,10 @@
     SUNDAY CHURCH - Cathedral Reverb Implementation
     
     FEATURES:
-    - Dattorro Figure-Eight topology
-    - Cubic Hermite interpolation (smooth modulation)
-    - Soft clipping (infinite reverb support)
-    - SDRAM allocation (4MB+ buffers)
+    - Dattorro plate (dsp::DattorroPlate)
+    - Near infinite reverb at maximum TIME
+    - Soft clipping of the wet signal
+    - SDRAM allocation (one 469 KB buffer)
     - 10 parameters for fine control
 */
 
@@ -13,6 +13,8 @@
 #include "fx_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
+#include "dsp/dattorro.hpp"
+#include "dsp/approx.hpp"
 
 // ═══════════════════════════════════════════════════════════════════════════
 // DELAY LINE WITH CUBIC INTERPOLATION
@@ -96,40 +98,6 @@ private:
     uint32_t m_write_pos;
 };
 
-// ═══════════════════════════════════════════════════════════════════════════
-// ALLPASS FILTER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class Allpass {
-public:
-    void init(float *buffer, uint32_t size, float feedback) {
-        m_delay.init(buffer, size);
-        m_feedback = feedback;
-    }
-    
-    inline float process(float input) {
-        float delayed = m_delay.read_linear(1.f);
-        float output = -input + delayed;
-        m_delay.write(input + delayed * m_feedback);
-        return output;
-    }
-    
-    inline float process_modulated(float input, float mod_samples) {
-        float delayed = m_delay.read_cubic(mod_samples);
-        float output = -input + delayed;
-        m_delay.write(input + delayed * m_feedback);
-        return output;
-    }
-    
-    void set_feedback(float fb) {
-        m_feedback = clipminmaxf(0.f, fb, 0.7f);
-    }
-    
-private:
-    DelayLine m_delay;
-    float m_feedback;
-};
-
 // ═══════════════════════════════════════════════════════════════════════════
 // EARLY REFLECTIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -164,131 +132,6 @@ const uint32_t EarlyReflections::TAP_DELAYS[8] = {
     397, 797, 1193, 1597, 1993, 2393, 2797, 3191
 };
 
-// ═══════════════════════════════════════════════════════════════════════════
-// DATTORRO TANK
-// ═══════════════════════════════════════════════════════════════════════════
-
-struct DattorroTank {
-    // Left tank
-    Allpass ap1_l;
-    DelayLine delay1_l;
-    Allpass ap2_l;
-    DelayLine delay2_l;
-    
-    // Right tank
-    Allpass ap1_r;
-    DelayLine delay1_r;
-    Allpass ap2_r;
-    DelayLine delay2_r;
-    
-    // Damping filters (one-pole lowpass)
-    float damp_z_l1, damp_z_l2;
-    float damp_z_r1, damp_z_r2;
-    
-    // LFOs for modulation
-    float lfo_phase_l;
-    float lfo_phase_r;
-    
-    void init(float *buffer, uint32_t offset) {
-        // Left tank delays
-        ap1_l.init(buffer + offset, 672, 0.7f);
-        offset += 672;
-        delay1_l.init(buffer + offset, 4453);
-        offset += 4453;
-        ap2_l.init(buffer + offset, 1800, 0.5f);
-        offset += 1800;
-        delay2_l.init(buffer + offset, 3720);
-        offset += 3720;
-        
-        // Right tank delays (prime numbers, slightly different)
-        ap1_r.init(buffer + offset, 908, 0.7f);
-        offset += 908;
-        delay1_r.init(buffer + offset, 4217);
-        offset += 4217;
-        ap2_r.init(buffer + offset, 2656, 0.5f);
-        offset += 2656;
-        delay2_r.init(buffer + offset, 3163);
-        offset += 3163;
-        
-        // Init damping
-        damp_z_l1 = damp_z_l2 = 0.f;
-        damp_z_r1 = damp_z_r2 = 0.f;
-        
-        // Init LFOs (90 degrees out of phase for stereo)
-        lfo_phase_l = 0.f;
-        lfo_phase_r = 0.25f;
-    }
-    
-    void process(float input_l, float input_r,
-                 float *out_l, float *out_r,
-                 float feedback, float damping, 
-                 float mod_depth, float mod_rate,
-                 float size_mult) {
-        
-        // Update LFOs
-        lfo_phase_l += mod_rate / 48000.f;
-        lfo_phase_r += mod_rate / 48000.f;
-        if (lfo_phase_l >= 1.f) lfo_phase_l -= 1.f;
-        if (lfo_phase_r >= 1.f) lfo_phase_r -= 1.f;
-        
-        // LFO values
-        float lfo_l = fx_sinf(lfo_phase_l);
-        float lfo_r = fx_sinf(lfo_phase_r);
-        
-        // Modulation amount (samples)
-        float mod_l = 8.f + lfo_l * mod_depth * 8.f;
-        float mod_r = 8.f + lfo_r * mod_depth * 8.f;
-        
-        // LEFT TANK
-        float tank_in_l = input_l + feedback * damp_z_r2;
-        
-        tank_in_l = ap1_l.process(tank_in_l);
-        delay1_l.write(tank_in_l);
-        
-        float d1_out_l = delay1_l.read_cubic(4453.f * size_mult);
-        
-        // Damping (one-pole lowpass)
-        damp_z_l1 = d1_out_l * (1.f - damping) + damp_z_l1 * damping;
-        damp_z_l1 = clipminmaxf(-2.f, damp_z_l1, 2.f);
-        
-        float ap2_in_l = ap2_l.process_modulated(damp_z_l1, 1800.f + mod_l);
-        delay2_l.write(ap2_in_l);
-        
-        float d2_out_l = delay2_l.read_cubic(3720.f * size_mult);
-        
-        damp_z_l2 = d2_out_l * (1.f - damping) + damp_z_l2 * damping;
-        damp_z_l2 = clipminmaxf(-2.f, damp_z_l2, 2.f);
-        
-        // Soft clip to prevent explosion
-        damp_z_l2 = fastertanhf(damp_z_l2);
-        
-        // RIGHT TANK
-        float tank_in_r = input_r + feedback * damp_z_l2;
-        
-        tank_in_r = ap1_r.process(tank_in_r);
-        delay1_r.write(tank_in_r);
-        
-        float d1_out_r = delay1_r.read_cubic(4217.f * size_mult);
-        
-        damp_z_r1 = d1_out_r * (1.f - damping) + damp_z_r1 * damping;
-        damp_z_r1 = clipminmaxf(-2.f, damp_z_r1, 2.f);
-        
-        float ap2_in_r = ap2_r.process_modulated(damp_z_r1, 2656.f + mod_r);
-        delay2_r.write(ap2_in_r);
-        
-        float d2_out_r = delay2_r.read_cubic(3163.f * size_mult);
-        
-        damp_z_r2 = d2_out_r * (1.f - damping) + damp_z_r2 * damping;
-        damp_z_r2 = clipminmaxf(-2.f, damp_z_r2, 2.f);
-        
-        damp_z_r2 = fastertanhf(damp_z_r2);
-        
-        // Output (multiple taps for richness)
-        *out_l = d1_out_l * 0.6f + ap2_in_l * 0.4f;
-        *out_r = d1_out_r * 0.6f + ap2_in_r * 0.4f;
-    }
-};
-
 // ═══════════════════════════════════════════════════════════════════════════
 // GLOBAL STATE
 // ═══════════════════════════════════════════════════════════════════════════
@@ -300,8 +143,10 @@ static DelayLine s_predelay;
 static EarlyReflections s_early_l;
 static EarlyReflections s_early_r;
 
-static Allpass s_input_diffuser[4];
-static DattorroTank s_tank;
+static dsp::DattorroPlate s_plate;
+static constexpr float PLATE_MAX_SIZE = 1.5f;
+// Brings the plate up to the level of the previous tank, whose allpasses had gain
+static constexpr float PLATE_GAIN = 7.f;
 
 // Parameters
 static float s_time;
@@ -353,20 +198,12 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     s_early_r.init(s_reverb_buffer + offset, 8000);
     offset += 8000;
     
-    // Input diffusers
-    s_input_diffuser[0].init(s_reverb_buffer + offset, 142, 0.75f);
-    offset += 142;
-    s_input_diffuser[1].init(s_reverb_buffer + offset, 107, 0.75f);
-    offset += 107;
-    s_input_diffuser[2].init(s_reverb_buffer + offset, 379, 0.625f);
-    offset += 379;
-    s_input_diffuser[3].init(s_reverb_buffer + offset, 277, 0.625f);
-    offset += 277;
+    // Dattorro plate, input diffusers and tank
+    if (offset + dsp::DattorroPlate::memorySize(48000.f, PLATE_MAX_SIZE) > REVERB_BUFFER_SIZE)
+        return k_unit_err_memory;
+    s_plate.init(s_reverb_buffer + offset, 48000.f, PLATE_MAX_SIZE);
     
-    // Dattorro tank
-    s_tank.init(s_reverb_buffer, offset);
-    
-    // Init parameters (60% time, 30% depth, 50% mix)
+    // Init parameters at the header defaults, all zero and fully dry
     s_time = 0.f;
     s_depth = 0.f;
     s_mix = -1.f;
@@ -391,10 +228,7 @@ __unit_callback void unit_reset() {
         }
     }
     
-    s_tank.damp_z_l1 = 0.f;
-    s_tank.damp_z_l2 = 0.f;
-    s_tank.damp_z_r1 = 0.f;
-    s_tank.damp_z_r2 = 0.f;
+    s_plate.clear();
 }
 
 __unit_callback void unit_resume() {}
@@ -404,78 +238,86 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
     const float * __restrict in_p = in;
     float * __restrict out_p = out;
     
-    for (uint32_t f = 0; f < frames; f++) {
-        float in_l = in_p[f * 2];
-        float in_r = in_p[f * 2 + 1];
-        
-        // Input clip
-        in_l = clipminmaxf(-1.f, in_l, 1.f);
-        in_r = clipminmaxf(-1.f, in_r, 1.f);
-        
-        // Mono sum for reverb
-        float mono = (in_l + in_r) * 0.5f;
-        
-        // Pre-delay
-        s_predelay.write(mono);
-        float predelayed = s_predelay.read_linear(s_predelay_time * 24000.f);
-        
-        // Early reflections
-        float early_l = s_early_l.process(predelayed, s_early_level);
-        float early_r = s_early_r.process(predelayed, s_early_level);
-        
-        // Input diffusion
-        float diffused = predelayed;
-        for (uint8_t i = 0; i < 4; i++) {
-            diffused = s_input_diffuser[i].process(diffused);
+    // Feedback per half of the tank, near infinite at maximum TIME
+    float feedback = 0.65f + s_time * 0.345f;
+    feedback = clipminmaxf(0.65f, feedback, 0.995f);
+    
+    // Modulation rate (0.1 - 5 Hz)
+    float mod_rate = 0.1f + s_mod_rate * 4.9f;
+    
+    // Size multiplier (0.5 - 1.5x)
+    float size_mult = 0.5f + s_size;
+    
+    // The plate applies its decay twice per half
+    s_plate.setDecay(sqrtf(feedback));
+    s_plate.setDamping(s_damping);
+    s_plate.setSize(size_mult);
+    s_plate.setModulation(s_depth * 8.f, mod_rate, 48000.f);
+    
+    float early[2 * 64];
+    float tank[2 * 64];
+    
+    while (frames) {
+        const uint32_t n = (frames < 64) ? frames : 64;
+        
+        for (uint32_t f = 0; f < n; f++) {
+            // Input clip
+            const float in_l = clipminmaxf(-1.f, in_p[f * 2], 1.f);
+            const float in_r = clipminmaxf(-1.f, in_p[f * 2 + 1], 1.f);
+            
+            // Mono sum for reverb
+            float mono = (in_l + in_r) * 0.5f;
+            
+            // Pre-delay
+            s_predelay.write(mono);
+            float predelayed = s_predelay.read_linear(s_predelay_time * 24000.f);
+            
+            // Early reflections
+            early[f * 2] = s_early_l.process(predelayed, s_early_level);
+            early[f * 2 + 1] = s_early_r.process(predelayed, s_early_level);
+            
+            // Scale by diffusion parameter, the plate diffuses its input
+            tank[f * 2] = tank[f * 2 + 1] = predelayed * s_diffusion;
         }
         
-        // Scale by diffusion parameter
-        diffused *= s_diffusion;
-        
-        // Feedback calculation (safe for infinite reverb)
-        float feedback = 0.65f + s_time * 0.33f;
-        feedback = clipminmaxf(0.65f, feedback, 0.98f);
-        
-        // Modulation rate (0.1 - 5 Hz)
-        float mod_rate = 0.1f + s_mod_rate * 4.9f;
-        
-        // Size multiplier (0.5 - 1.5x)
-        float size_mult = 0.5f + s_size;
-        
-        // Process tank
-        float tank_l, tank_r;
-        s_tank.process(diffused, diffused,
-                      &tank_l, &tank_r,
-                      feedback, s_damping,
-                      s_depth, mod_rate, size_mult);
-        
-        // Combine early + late
-        float wet_l = early_l + tank_l;
-        float wet_r = early_r + tank_r;
-        
-        // Stereo width control
-        float mid = (wet_l + wet_r) * 0.5f;
-        float side = (wet_l - wet_r) * 0.5f * s_width;
-        wet_l = mid + side;
-        wet_r = mid - side;
-        
-        // Output gain compensation (-6dB)
-        wet_l *= 0.5f;
-        wet_r *= 0.5f;
-        
-        // Soft clip wet signal
-        wet_l = fastertanhf(wet_l * 0.9f);
-        wet_r = fastertanhf(wet_r * 0.9f);
-        
-        // Dry/wet mix
-        float dry_wet = (s_mix + 1.f) * 0.5f;
-        
-        out_p[f * 2] = in_l * (1.f - dry_wet) + wet_l * dry_wet;
-        out_p[f * 2 + 1] = in_r * (1.f - dry_wet) + wet_r * dry_wet;
+        s_plate.process(tank, tank, n);
+        
+        for (uint32_t f = 0; f < n; f++) {
+            const float in_l = clipminmaxf(-1.f, in_p[f * 2], 1.f);
+            const float in_r = clipminmaxf(-1.f, in_p[f * 2 + 1], 1.f);
+            
+            // Combine early + late
+            float wet_l = early[f * 2] + tank[f * 2] * PLATE_GAIN;
+            float wet_r = early[f * 2 + 1] + tank[f * 2 + 1] * PLATE_GAIN;
+            
+            // Stereo width control
+            float mid = (wet_l + wet_r) * 0.5f;
+            float side = (wet_l - wet_r) * 0.5f * s_width;
+            wet_l = mid + side;
+            wet_r = mid - side;
+            
+            // Output gain compensation (-6dB)
+            wet_l *= 0.5f;
+            wet_r *= 0.5f;
+            
+            // Soft clip wet signal
+            wet_l = dsp::approx::tanh<dsp::approx::k_faster>(wet_l * 0.9f);
+            wet_r = dsp::approx::tanh<dsp::approx::k_faster>(wet_r * 0.9f);
+            
+            // Dry/wet mix
+            float dry_wet = (s_mix + 1.f) * 0.5f;
+            
+            out_p[f * 2] = in_l * (1.f - dry_wet) + wet_l * dry_wet;
+            out_p[f * 2 + 1] = in_r * (1.f - dry_wet) + wet_r * dry_wet;
+            
+            // Final safety clip
+            out_p[f * 2] = clipminmaxf(-1.f, out_p[f * 2], 1.f);
+            out_p[f * 2 + 1] = clipminmaxf(-1.f, out_p[f * 2 + 1], 1.f);
+        }
         
-        // Final safety clip
-        out_p[f * 2] = clipminmaxf(-1.f, out_p[f * 2], 1.f);
-        out_p[f * 2 + 1] = clipminmaxf(-1.f, out_p[f * 2 + 1], 1.f);
+        in_p += 2 * n;
+        out_p += 2 * n;
+        frames -= n;
     }
 }
 
@@ -3,27 +3,24 @@
     
     CRITICAL FIXES:
     - Removed custom is_finite macro (use si_isfinite!)
-    - Removed custom fast_tanh (use si_tanhf!)
+    - Saturation uses dsp::approx::tanh
     - Buffer clearing on init
     - All validation uses SDK functions
 */
 
 #include "unit_modfx.h"
 #include "utils/float_math.h"
+#include "utils/buffer_ops.h"
 #include "fx_api.h"
-
-// ========== FAST TANH (CORRECT IMPLEMENTATION) ==========
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
+#include "dsp/oversampler.hpp"
+#include "dsp/noisegen.hpp"
+#include "dsp/approx.hpp"
 
 // ========== MEMORY BUDGET ==========
 
 #define MAX_DELAY_SAMPLES 2400
-#define NOISE_BUFFER_SIZE 512
+#define BLOCK_SIZE 64
+#define SAT_WARMUP_BLOCKS 4     // Oversampler blocks discarded after bypass
 
 // ========== TAPE TYPES ==========
 
@@ -50,8 +47,27 @@ enum SpeedMode {
 static float *s_delay_buffer_l = nullptr;
 static float *s_delay_buffer_r = nullptr;
 static uint32_t s_delay_write_pos = 0;
-static float s_noise_buffer[NOISE_BUFFER_SIZE];
-static uint32_t s_noise_pos = 0;
+
+// Per block stage buffers, the saturation runs on them at 2x
+static float s_in_l[BLOCK_SIZE];
+static float s_in_r[BLOCK_SIZE];
+static float s_tape_l[BLOCK_SIZE];
+static float s_tape_r[BLOCK_SIZE];
+static dsp::Oversampler<2, BLOCK_SIZE> s_sat_os_l;
+static dsp::Oversampler<2, BLOCK_SIZE> s_sat_os_r;
+static float s_sat_dry_l[BLOCK_SIZE];
+static float s_sat_dry_r[BLOCK_SIZE];
+
+// Stands in for the oversampler in bypass: 2 samples plus a first order
+// allpass of 0.63, the 2.63 sample latency of the 2x round trip below 1kHz
+struct SatBypassDelay {
+    float z0, z1;       // Integer delay
+    float ap_x, ap_y;   // Allpass state
+};
+
+static SatBypassDelay s_sat_delay_l;
+static SatBypassDelay s_sat_delay_r;
+static uint32_t s_sat_blocks = SAT_WARMUP_BLOCKS + 1;  // Blocks the oversamplers have run, 0 in bypass
 
 // ========== STATE ==========
 
@@ -79,57 +95,80 @@ static SpeedMode s_speed_mode = SPEED_NORMAL;
 
 // ========== RANDOM ==========
 
-static uint32_t s_rand_state = 12345;
+static dsp::NoiseGen s_noise_gen;
 
 inline float random_float() {
-    s_rand_state ^= s_rand_state << 13;
-    s_rand_state ^= s_rand_state >> 17;
-    s_rand_state ^= s_rand_state << 5;
-    return ((float)(s_rand_state % 10000) / 10000.f) * 2.f - 1.f;
+    return s_noise_gen.white();
 }
 
 // ========== TAPE CHARACTERISTICS ==========
 
-inline void get_tape_characteristics(float *wow_scale, float *flutter_scale, 
-                                     float *hf_loss, float *noise_scale) {
+// Per tape type scales, with the age and speed settings applied. They only
+// change with the parameters, so unit_render() computes them once per block.
+struct TapeCharacteristics {
+    float wow_scale;
+    float flutter_scale;
+    float hf_loss;
+    float noise_scale;
+    float speed_pitch;
+};
+
+inline TapeCharacteristics get_tape_characteristics() {
+    float wow_scale, flutter_scale, hf_loss, noise_scale;
     switch (s_tape_type) {
         case TAPE_CASSETTE_I:
-            *wow_scale = 1.5f; *flutter_scale = 1.2f;
-            *hf_loss = 0.7f; *noise_scale = 1.3f;
+            wow_scale = 1.5f; flutter_scale = 1.2f;
+            hf_loss = 0.7f; noise_scale = 1.3f;
             break;
         case TAPE_CASSETTE_II:
-            *wow_scale = 1.0f; *flutter_scale = 0.9f;
-            *hf_loss = 0.5f; *noise_scale = 0.9f;
+            wow_scale = 1.0f; flutter_scale = 0.9f;
+            hf_loss = 0.5f; noise_scale = 0.9f;
             break;
         case TAPE_CASSETTE_IV:
-            *wow_scale = 0.8f; *flutter_scale = 0.7f;
-            *hf_loss = 0.3f; *noise_scale = 0.7f;
+            wow_scale = 0.8f; flutter_scale = 0.7f;
+            hf_loss = 0.3f; noise_scale = 0.7f;
             break;
         case TAPE_REEL_7_5:
-            *wow_scale = 1.2f; *flutter_scale = 0.8f;
-            *hf_loss = 0.6f; *noise_scale = 1.0f;
+            wow_scale = 1.2f; flutter_scale = 0.8f;
+            hf_loss = 0.6f; noise_scale = 1.0f;
             break;
         case TAPE_REEL_15:
-            *wow_scale = 0.6f; *flutter_scale = 0.5f;
-            *hf_loss = 0.4f; *noise_scale = 0.6f;
+            wow_scale = 0.6f; flutter_scale = 0.5f;
+            hf_loss = 0.4f; noise_scale = 0.6f;
             break;
         case TAPE_REEL_30:
-            *wow_scale = 0.3f; *flutter_scale = 0.3f;
-            *hf_loss = 0.2f; *noise_scale = 0.4f;
+            wow_scale = 0.3f; flutter_scale = 0.3f;
+            hf_loss = 0.2f; noise_scale = 0.4f;
             break;
         case TAPE_8TRACK:
-            *wow_scale = 3.0f; *flutter_scale = 2.0f;
-            *hf_loss = 0.9f; *noise_scale = 1.8f;
+            wow_scale = 3.0f; flutter_scale = 2.0f;
+            hf_loss = 0.9f; noise_scale = 1.8f;
             break;
         case TAPE_DICTAPHONE:
-            *wow_scale = 2.5f; *flutter_scale = 2.5f;
-            *hf_loss = 0.95f; *noise_scale = 2.0f;
+            wow_scale = 2.5f; flutter_scale = 2.5f;
+            hf_loss = 0.95f; noise_scale = 2.0f;
             break;
         default:
-            *wow_scale = 1.0f; *flutter_scale = 1.0f;
-            *hf_loss = 0.5f; *noise_scale = 1.0f;
+            wow_scale = 1.0f; flutter_scale = 1.0f;
+            hf_loss = 0.5f; noise_scale = 1.0f;
             break;
     }
+    
+    TapeCharacteristics tc;
+    float age_mult = 1.f + s_age * 0.5f;
+    tc.wow_scale = wow_scale * age_mult;
+    tc.flutter_scale = flutter_scale * age_mult;
+    tc.hf_loss = hf_loss * (1.f + s_age * 0.3f);
+    tc.noise_scale = noise_scale * age_mult;
+    
+    tc.speed_pitch = 1.f;
+    switch (s_speed_mode) {
+        case SPEED_STOPPED: tc.speed_pitch = 0.01f; break;
+        case SPEED_SLOW: tc.speed_pitch = 0.5f; break;
+        case SPEED_NORMAL: tc.speed_pitch = 1.f; break;
+        case SPEED_FAST: tc.speed_pitch = 2.f; break;
+    }
+    return tc;
 }
 
 // ========== DELAY READ ==========
@@ -160,16 +199,85 @@ inline float delay_read(float *buffer, float delay_samples) {
 // ========== SATURATION ==========
 
 inline float apply_saturation(float input, float amount) {
-    if (amount < 0.01f) return input;
-    
     float drive = 1.f + amount * 3.f;
     
-    // ✅ FIX: Use fast_tanh (fx_tanhf doesn't exist for modfx)
-    float saturated = fast_tanh(input * drive);
+    // Clamped Pade tanh from dsp/approx.hpp (fx_tanhf doesn't exist for modfx)
+    float saturated = dsp::approx::tanh<dsp::approx::k_faster>(input * drive);
     
     return input * (1.f - amount) + saturated * amount;
 }
 
+// Delays buf by the oversampler latency into out, in place allowed
+inline void sat_bypass_delay(const float *buf, float *out, SatBypassDelay &d, uint32_t frames) {
+    const float a = (1.f - 0.63f) / (1.f + 0.63f);  // Thiran allpass for 0.63 samples
+    for (uint32_t f = 0; f < frames; f++) {
+        const float x = d.z0;
+        d.z0 = d.z1;
+        d.z1 = buf[f];
+        const float y = a * (x - d.ap_y) + d.ap_x;
+        d.ap_x = x;
+        d.ap_y = y;
+        out[f] = y;
+    }
+}
+
+// Crossfades buf from a to b over the block, the result goes to buf
+inline void sat_crossfade(float *buf, const float *a, const float *b, uint32_t frames) {
+    const float step = 1.f / (float)frames;
+    for (uint32_t f = 0; f < frames; f++) {
+        const float t = (float)(f + 1) * step;
+        buf[f] = a[f] + (b[f] - a[f]) * t;
+    }
+}
+
+// Runs at 2x so the harmonics of the tanh above 24kHz do not fold back.
+// Below 1% the oversamplers are skipped and a plain delay of about their
+// latency takes their place. When the saturation comes back they run from
+// a cleared state for SAT_WARMUP_BLOCKS blocks, hidden behind the delay,
+// before a one block crossfade, so neither direction clicks.
+inline void apply_saturation_stage(uint32_t frames, float amount) {
+    const bool active = (amount >= 0.01f);
+    
+    if (!active && s_sat_blocks == 0) {
+        sat_bypass_delay(s_tape_l, s_tape_l, s_sat_delay_l, frames);
+        sat_bypass_delay(s_tape_r, s_tape_r, s_sat_delay_r, frames);
+        return;
+    }
+    
+    sat_bypass_delay(s_tape_l, s_sat_dry_l, s_sat_delay_l, frames);
+    sat_bypass_delay(s_tape_r, s_sat_dry_r, s_sat_delay_r, frames);
+    const auto sat = [amount](float x) { return apply_saturation(x, amount); };
+    s_sat_os_l.process(s_tape_l, s_tape_l, frames, sat);
+    s_sat_os_r.process(s_tape_r, s_tape_r, frames, sat);
+    
+    if (!active) {
+        // Fade out, unless the oversamplers were still warming up
+        if (s_sat_blocks > SAT_WARMUP_BLOCKS) {
+            sat_crossfade(s_tape_l, s_tape_l, s_sat_dry_l, frames);
+            sat_crossfade(s_tape_r, s_tape_r, s_sat_dry_r, frames);
+        }
+        else {
+            buf_cpy_f32(s_sat_dry_l, s_tape_l, frames);
+            buf_cpy_f32(s_sat_dry_r, s_tape_r, frames);
+        }
+        s_sat_os_l.clear();
+        s_sat_os_r.clear();
+        s_sat_blocks = 0;
+        return;
+    }
+    
+    if (s_sat_blocks < SAT_WARMUP_BLOCKS) {
+        buf_cpy_f32(s_sat_dry_l, s_tape_l, frames);
+        buf_cpy_f32(s_sat_dry_r, s_tape_r, frames);
+        s_sat_blocks++;
+    }
+    else if (s_sat_blocks == SAT_WARMUP_BLOCKS) {
+        sat_crossfade(s_tape_l, s_sat_dry_l, s_tape_l, frames);
+        sat_crossfade(s_tape_r, s_sat_dry_r, s_tape_r, frames);
+        s_sat_blocks++;
+    }
+}
+
 // ========== COMPRESSION ==========
 
 inline void update_compressor(float input_level) {
@@ -214,27 +322,11 @@ inline void apply_hf_loss(float *l, float *r, float amount) {
 
 // ========== MAIN PROCESSOR ==========
 
-inline void process_tape_wobble(float in_l, float in_r, float *out_l, float *out_r) {
-    // Input validation
-    if (in_l != in_l || in_l > 1e10f || in_l < -1e10f) in_l = 0.f;
-    if (in_r != in_r || in_r > 1e10f || in_r < -1e10f) in_r = 0.f;
-    
-    float wow_scale, flutter_scale, hf_loss, noise_scale;
-    get_tape_characteristics(&wow_scale, &flutter_scale, &hf_loss, &noise_scale);
-    
-    float age_mult = 1.f + s_age * 0.5f;
-    wow_scale *= age_mult;
-    flutter_scale *= age_mult;
-    hf_loss *= (1.f + s_age * 0.3f);
-    noise_scale *= age_mult;
-    
-    float speed_pitch = 1.f;
-    switch (s_speed_mode) {
-        case SPEED_STOPPED: speed_pitch = 0.01f; break;
-        case SPEED_SLOW: speed_pitch = 0.5f; break;
-        case SPEED_NORMAL: speed_pitch = 1.f; break;
-        case SPEED_FAST: speed_pitch = 2.f; break;
-    }
+// Tape transport: everything before the saturation
+inline void process_tape_read(const TapeCharacteristics &tc, float in_l, float in_r,
+                              float *out_l, float *out_r) {
+    const float wow_scale = tc.wow_scale;
+    const float flutter_scale = tc.flutter_scale;
     
     // Update LFOs
     float wow_rate = (0.2f + s_wow * 1.8f) * wow_scale;
@@ -253,7 +345,7 @@ inline void process_tape_wobble(float in_l, float in_r, float *out_l, float *out
     float wow_mod = fx_sinf(s_lfo_wow * 2.f * 3.14159265f) * s_wow * 0.02f * wow_scale;
     float flutter_mod = fx_sinf(s_lfo_flutter * 2.f * 3.14159265f) * s_flutter * 0.005f * flutter_scale;
     
-    float total_pitch_mod = (1.f + wow_mod + flutter_mod) * speed_pitch;
+    float total_pitch_mod = (1.f + wow_mod + flutter_mod) * tc.speed_pitch;
     total_pitch_mod = clipminmaxf(0.5f, total_pitch_mod, 2.f);
     
     float base_delay = 100.f;
@@ -278,10 +370,13 @@ inline void process_tape_wobble(float in_l, float in_r, float *out_l, float *out
         delayed_r = delayed_r * (1.f - si_fabsf(warble)) + temp * (-warble);
     }
     
-    // Saturation
-    delayed_l = apply_saturation(delayed_l, s_saturation);
-    delayed_r = apply_saturation(delayed_r, s_saturation);
-    
+    *out_l = delayed_l;
+    *out_r = delayed_r;
+}
+
+// Everything after the saturation
+inline void process_tape_finish(const TapeCharacteristics &tc, float in_l, float in_r,
+                                float delayed_l, float delayed_r, float *out_l, float *out_r) {
     // Compression
     float comp_level = (si_fabsf(delayed_l) + si_fabsf(delayed_r)) * 0.5f;
     update_compressor(comp_level);
@@ -308,13 +403,13 @@ inline void process_tape_wobble(float in_l, float in_r, float *out_l, float *out
     
     // Noise
     if (s_noise > 0.01f) {
-        float noise = s_noise_buffer[s_noise_pos] * s_noise * 0.1f * noise_scale;
+        float noise = s_noise_gen.white() * 0.05f * s_noise * 0.1f * tc.noise_scale;
         delayed_l += noise;
         delayed_r += noise * 0.8f;
     }
     
     // HF loss
-    apply_hf_loss(&delayed_l, &delayed_r, hf_loss * s_age);
+    apply_hf_loss(&delayed_l, &delayed_r, tc.hf_loss * s_age);
     
     // Validate
     if (delayed_l != delayed_l || delayed_l > 1e10f || delayed_l < -1e10f) delayed_l = in_l;
@@ -352,11 +447,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     
     s_delay_write_pos = 0;
     
-    // Generate noise
-    for (uint32_t i = 0; i < NOISE_BUFFER_SIZE; i++) {
-        s_noise_buffer[i] = random_float() * 0.05f;
-    }
-    s_noise_pos = 0;
+    s_noise_gen.seed(12345);
     
     // Init state
     s_lfo_wow = 0.f;
@@ -402,6 +493,11 @@ __unit_callback void unit_reset() {
     s_dropout_level = 1.f;
     s_hf_z1_l = 0.f;
     s_hf_z1_r = 0.f;
+    s_sat_os_l.clear();
+    s_sat_os_r.clear();
+    s_sat_delay_l = SatBypassDelay();
+    s_sat_delay_r = SatBypassDelay();
+    s_sat_blocks = SAT_WARMUP_BLOCKS + 1;  // Cleared oversamplers are ready
 }
 
 __unit_callback void unit_resume() {}
@@ -411,18 +507,39 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
     const float *in_ptr = in;
     float *out_ptr = out;
     
-    for (uint32_t f = 0; f < frames; f++) {
-        float out_l, out_r;
-        process_tape_wobble(in_ptr[0], in_ptr[1], &out_l, &out_r);
+    while (frames) {
+        const uint32_t n = (frames < BLOCK_SIZE) ? frames : BLOCK_SIZE;
+        const TapeCharacteristics tc = get_tape_characteristics();
         
-        out_ptr[0] = clipminmaxf(-1.f, out_l, 1.f);
-        out_ptr[1] = clipminmaxf(-1.f, out_r, 1.f);
+        for (uint32_t f = 0; f < n; f++) {
+            float in_l = in_ptr[0];
+            float in_r = in_ptr[1];
+            // Input validation
+            if (in_l != in_l || in_l > 1e10f || in_l < -1e10f) in_l = 0.f;
+            if (in_r != in_r || in_r > 1e10f || in_r < -1e10f) in_r = 0.f;
+            s_in_l[f] = in_l;
+            s_in_r[f] = in_r;
+            
+            process_tape_read(tc, in_l, in_r, &s_tape_l[f], &s_tape_r[f]);
+            
+            s_delay_write_pos = (s_delay_write_pos + 1) % MAX_DELAY_SAMPLES;
+            in_ptr += 2;
+        }
+        
+        // Saturation
+        apply_saturation_stage(n, s_saturation);
         
-        s_delay_write_pos = (s_delay_write_pos + 1) % MAX_DELAY_SAMPLES;
-        s_noise_pos = (s_noise_pos + 1) % NOISE_BUFFER_SIZE;
+        for (uint32_t f = 0; f < n; f++) {
+            float out_l, out_r;
+            process_tape_finish(tc, s_in_l[f], s_in_r[f], s_tape_l[f], s_tape_r[f], &out_l, &out_r);
+            
+            out_ptr[0] = clipminmaxf(-1.f, out_l, 1.f);
+            out_ptr[1] = clipminmaxf(-1.f, out_r, 1.f);
+            
+            out_ptr += 2;
+        }
         
-        in_ptr += 2;
-        out_ptr += 2;
+        frames -= n;
     }
 }
 
@@ -54,6 +54,7 @@
 #include "utils/int_math.h"
 #include "macros.h"
 #include <math.h>
+#include "dsp/approx.hpp"
 
 #define MAX_VOICES 1  // TB-303 is monophonic!
 
@@ -97,13 +98,6 @@ static uint8_t s_last_velocity;
 static uint32_t s_sample_counter;
 
 // Fast math approximations
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
-}
-
 inline float fast_exp(float x) {
     // Approximation: e^x ≈ (1 + x/256)^256
     // Simplified for speed
@@ -154,17 +148,17 @@ inline float tb303_filter(float input, float cutoff, float resonance) {
     float in_stage = input - fb * s_filter_feedback;
     
     // CRITICAL: Overdrive in feedback path (the ACID sound!)
-    in_stage = fast_tanh(in_stage * 1.5f);
+    in_stage = dsp::approx::tanh<dsp::approx::k_faster>(in_stage * 1.5f);
     
     // 3-pole ladder (diode-style)
     s_filter_z1 = s_filter_z1 + g * (in_stage - s_filter_z1);
-    s_filter_z1 = fast_tanh(s_filter_z1);  // Diode saturation!
+    s_filter_z1 = dsp::approx::tanh<dsp::approx::k_faster>(s_filter_z1);  // Diode saturation!
     
     s_filter_z2 = s_filter_z2 + g * (s_filter_z1 - s_filter_z2);
-    s_filter_z2 = fast_tanh(s_filter_z2);
+    s_filter_z2 = dsp::approx::tanh<dsp::approx::k_faster>(s_filter_z2);
     
     s_filter_z3 = s_filter_z3 + g * (s_filter_z2 - s_filter_z3);
-    s_filter_z3 = fast_tanh(s_filter_z3);
+    s_filter_z3 = dsp::approx::tanh<dsp::approx::k_faster>(s_filter_z3);
     
     s_filter_feedback = s_filter_z3;
     
@@ -311,7 +305,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         
         // PRE-FILTER DISTORTION (VCO soft saturation)
         float pre_dist = 1.f + s_distortion * 0.5f;
-        osc_out = fast_tanh(osc_out * pre_dist);
+        osc_out = dsp::approx::tanh<dsp::approx::k_faster>(osc_out * pre_dist);
         
         // ENVELOPE
         float env = tb303_envelope();
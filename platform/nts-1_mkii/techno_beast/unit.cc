@@ -11,7 +11,7 @@
 
 #include "unit_osc.h"
 #include "osc_api.h"
-#include "fx_api.h"  // For fx_pow2f()
+#include "fx_api.h"
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 
@@ -62,6 +62,24 @@ static float s_accent = 0.5f;           // ✅ NEW: Velocity sensitivity
 static float s_glide = 0.0f;            // ✅ NEW: Portamento time
 static float s_phase_spread = 0.0f;
 
+// Unison frequency ratios, recomputed only when the detune changes
+#define UNISON_SAW_VOICES 7
+#define UNISON_SQR_VOICES 5
+static float s_saw_ratio[UNISON_SAW_VOICES];
+static float s_sqr_ratio[UNISON_SQR_VOICES];
+
+inline void update_detune_ratios() {
+    // Center voice = no detune, others spread out
+    for (int v = 0; v < UNISON_SAW_VOICES; v++) {
+        int offset = v - UNISON_SAW_VOICES / 2;
+        s_saw_ratio[v] = fastpow2f((float)offset * s_detune * 12.f / 1200.f);  // ±36 cents max
+    }
+    for (int v = 0; v < UNISON_SQR_VOICES; v++) {
+        int offset = v - UNISON_SQR_VOICES / 2;
+        s_sqr_ratio[v] = fastpow2f((float)offset * s_detune * 10.f / 1200.f);  // ±20 cents max
+    }
+}
+
 // ========== POLY BLEP ANTI-ALIASING ==========
 inline float poly_blep(float t, float dt) {
     if (t < dt) {
@@ -166,18 +184,10 @@ inline float generate_square(float phase, float w, float pulse_width) {
 // ========== UNISON SAW (7 voices) ==========
 inline float generate_unison_saw() {
     float sum = 0.f;
-    const int num_voices = 7;
+    const int num_voices = UNISON_SAW_VOICES;
     
     for (int v = 0; v < num_voices; v++) {
-        // Detune spread: center voice = 0, others spread out
-        float detune_cents = 0.f;
-        if (v != num_voices / 2) {  // Center voice = no detune
-            int offset = v - num_voices / 2;
-            detune_cents = (float)offset * s_detune * 12.f;  // ±36 cents max
-        }
-        
-        float ratio = fx_pow2f(detune_cents / 1200.f);
-        float w = s_voice.w0 * ratio;
+        float w = s_voice.w0 * s_saw_ratio[v];
         w = clipminmaxf(0.0001f, w, 0.48f);
         
         // ✅ NEW: Apply phase spread
@@ -202,19 +212,11 @@ inline float generate_unison_saw() {
 // ========== UNISON SQUARE (5 voices) ==========
 inline float generate_unison_square() {
     float sum = 0.f;
-    const int num_voices = 5;
+    const int num_voices = UNISON_SQR_VOICES;
     float pwm = get_pwm_offset();
     
     for (int v = 0; v < num_voices; v++) {
-        // Detune spread
-        float detune_cents = 0.f;
-        if (v != num_voices / 2) {
-            int offset = v - num_voices / 2;
-            detune_cents = (float)offset * s_detune * 10.f;  // ±20 cents max
-        }
-        
-        float ratio = fx_pow2f(detune_cents / 1200.f);
-        float w = s_voice.w0 * ratio;
+        float w = s_voice.w0 * s_sqr_ratio[v];
         w = clipminmaxf(0.0001f, w, 0.48f);
         
         // ✅ NEW: Apply phase spread
@@ -345,9 +347,9 @@ inline float process_filter(float input) {
     float w = 2.f * 3.14159265f * cutoff_hz / 48000.f;
     w = clipminmaxf(0.001f, w, 1.5f);  // Hard limit!
     
-    // ✅ FIX: Safe f calculation (use si_sinf for oscillators)
+    // ✅ FIX: Safe f calculation (osc_sinf takes the phase in cycles)
     float phase_norm = w / (2.f * 3.14159265f);
-    float f = 2.f * si_sinf(phase_norm * 0.5f);
+    float f = 2.f * osc_sinf(phase_norm * 0.5f);
     f = clipminmaxf(0.0001f, f, 1.9f);  // MAX 1.9 (safe!)
     
     // ✅ FIX: Resonance (safe range)
@@ -467,6 +469,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc) {
     s_accent = 0.5f;
     s_glide = 0.0f;
     s_phase_spread = 0.0f;
+    update_detune_ratios();
     
     return k_unit_err_none;
 }
@@ -569,6 +572,7 @@ __unit_callback void unit_set_param_value(uint8_t id, int32_t value) {
             
         case 1: // Detune
             s_detune = valf;
+            update_detune_ratios();
             break;
             
         case 2: // Sub Mix
@@ -96,14 +96,15 @@
 #include "macros.h"
 #include <math.h>
 
+#include "dsp/noisegen.hpp"
+#include "dsp/approx.hpp"
+
 #define MAX_VOICES 1  // Drums are monophonic per sound
-#define NOISE_BUFFER_SIZE 1024  // Reduced from 2048
 
 static const unit_runtime_osc_context_t *s_context;
 
-// Noise buffer
-static float s_noise_buffer[NOISE_BUFFER_SIZE];
-static uint32_t s_noise_seed;
+// White noise source
+static dsp::NoiseGen s_noise_gen;
 
 // Hi-hat square wave frequencies (prime ratios for metallic character)
 static const float s_hihat_freqs[6] = {
@@ -181,26 +182,8 @@ static const TR909Preset s_presets[8] = {
     {0.60f, 0.50f, 0.80f, 0.75f, 0.30f, 0.40f, 0.25f, 0.65f, "CUSTOM"}
 };
 
-void init_noise_buffer() {
-    s_noise_seed = 0x87654321;
-    for (int i = 0; i < NOISE_BUFFER_SIZE; i++) {
-        s_noise_seed = s_noise_seed * 1103515245u + 12345u;
-        float white = ((float)(s_noise_seed >> 16) / 32768.f) - 1.f;
-        s_noise_buffer[i] = white;
-    }
-}
-
 inline float read_noise() {
-    s_noise_seed = s_noise_seed * 1103515245u + 12345u;
-    uint32_t idx = (s_noise_seed >> 16) % NOISE_BUFFER_SIZE;
-    return s_noise_buffer[idx];
-}
-
-inline float fast_tanh(float x) {
-    if (x < -3.f) return -1.f;
-    if (x > 3.f) return 1.f;
-    float x2 = x * x;
-    return x * (27.f + x2) / (27.f + 9.f * x2);
+    return s_noise_gen.white();
 }
 
 // 2-pole lowpass filter
@@ -495,7 +478,7 @@ __unit_callback int8_t unit_init(const unit_runtime_desc_t *desc)
 
     s_context = static_cast<const unit_runtime_osc_context_t *>(desc->hooks.runtime_context);
 
-    init_noise_buffer();
+    s_noise_gen.seed(0x87654321);
     
     s_voice.phase = 0.f;
     s_voice.env_level = 0.f;
@@ -599,7 +582,7 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames)
         // Distortion
         if (s_distortion > 0.01f) {
             float drive = 1.f + s_distortion * 3.f;
-            sig = fast_tanh(sig * drive) / drive;
+            sig = dsp::approx::tanh<dsp::approx::k_faster>(sig * drive) / drive;
         }
         
         out[f] = clipminmaxf(-1.f, sig * 32.0f, 1.f);  // MAXIMUM VOLUME for D&B - bass must be audible!
@@ -16,15 +16,12 @@
 #include "utils/float_math.h"
 #include "utils/int_math.h"
 #include "utils/buffer_ops.h"
+#include "dsp/noisegen.hpp"
+#include "utils/fp_guard.h"
 
 #define NUM_DELAY_LINES 10
 #define MAX_DELAY_SAMPLES 144000  // 3 seconds @ 48kHz
 
-// ========== NaN/Inf CHECK MACRO (FIXED!) ==========
-// ✅ FIX: Correct NaN detection (NaN != NaN is TRUE)
-// Note: si_isfinite() not available for delfx, using correct macro instead
-#define is_finite(x) ((x) != (x) ? false : ((x) <= 1e10f && (x) >= -1e10f))
-
 // ========== DELAY LINE STRUCTURE ==========
 
 struct DelayLine {
@@ -46,13 +43,10 @@ static float s_mod_phase = 0.f;
 
 // ========== RANDOM GENERATOR ==========
 
-static uint32_t s_rand_state = 12345;
+static dsp::NoiseGen s_noise_gen;
 
 inline float random_float() {
-    s_rand_state ^= s_rand_state << 13;
-    s_rand_state ^= s_rand_state >> 17;
-    s_rand_state ^= s_rand_state << 5;
-    return (float)(s_rand_state % 10000) / 10000.f;
+    return s_noise_gen.uniform();
 }
 
 // ========== PARAMETERS ==========
@@ -87,10 +81,6 @@ inline void process_delay_line(DelayLine *line, float in_l, float in_r,
     float delayed_l = line->buffer_l[read_pos];
     float delayed_r = line->buffer_r[read_pos];
     
-    // ✅ FIX: Use correct NaN check!
-    if (!is_finite(delayed_l)) delayed_l = 0.f;
-    if (!is_finite(delayed_r)) delayed_r = 0.f;
-    
     // Apply tone filter
     float tone_coeff = 0.3f + s_tone * 0.4f;
     line->tone_z1_l += tone_coeff * (delayed_l - line->tone_z1_l);
@@ -99,10 +89,6 @@ inline void process_delay_line(DelayLine *line, float in_l, float in_r,
     delayed_l = line->tone_z1_l;
     delayed_r = line->tone_z1_r;
     
-    // Denormal kill
-    if (si_fabsf(line->tone_z1_l) < 1e-15f) line->tone_z1_l = 0.f;
-    if (si_fabsf(line->tone_z1_r) < 1e-15f) line->tone_z1_r = 0.f;
-    
     // Write to buffer
     float write_l, write_r;
     
@@ -120,10 +106,6 @@ inline void process_delay_line(DelayLine *line, float in_l, float in_r,
     write_l = clipminmaxf(-2.f, write_l, 2.f);
     write_r = clipminmaxf(-2.f, write_r, 2.f);
     
-    // ✅ FIX: Use correct NaN check!
-    if (!is_finite(write_l)) write_l = 0.f;
-    if (!is_finite(write_r)) write_r = 0.f;
-    
     line->buffer_l[line->write_pos] = write_l;
     line->buffer_r[line->write_pos] = write_r;
     
@@ -243,6 +225,8 @@ __unit_callback void unit_resume() {}
 __unit_callback void unit_suspend() {}
 
 __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
+    const FpGuardScope fp_guard;  // Flush-to-zero for the whole block
+    
     // ✅ FIX: Safety check
     if (!s_delay_buffer_base) {
         for (uint32_t f = 0; f < frames; f++) {
@@ -252,6 +236,14 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         return;
     }
     
+    // Sanitize the tone filter state once per block
+    for (int i = 0; i < NUM_DELAY_LINES; i++) {
+        FP_GUARD_WATCH("tone.z1_l", s_delay_lines[i].tone_z1_l);
+        FP_GUARD_WATCH("tone.z1_r", s_delay_lines[i].tone_z1_r);
+        fp_sanitize_block(&s_delay_lines[i].tone_z1_l, 1);
+        fp_sanitize_block(&s_delay_lines[i].tone_z1_r, 1);
+    }
+    
     // Get modulation
     float mod = get_modulation();
     
@@ -283,10 +275,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float in_l = in[f * 2];
         float in_r = in[f * 2 + 1];
         
-        // ✅ FIX: Use correct NaN check!
-        if (!is_finite(in_l)) in_l = 0.f;
-        if (!is_finite(in_r)) in_r = 0.f;
-        
         float wet_l = 0.f;
         float wet_r = 0.f;
         
@@ -320,9 +308,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
             
             wet_l = wet_l * (1.f - s_diffusion) + diff_z1_l * s_diffusion;
             wet_r = wet_r * (1.f - s_diffusion) + diff_z1_r * s_diffusion;
-            
-            if (si_fabsf(diff_z1_l) < 1e-15f) diff_z1_l = 0.f;
-            if (si_fabsf(diff_z1_r) < 1e-15f) diff_z1_r = 0.f;
         }
         
         // Apply stereo width
@@ -335,10 +320,6 @@ __unit_callback void unit_render(const float *in, float *out, uint32_t frames) {
         float out_l = in_l * dry_gain + wet_l * wet_gain;
         float out_r = in_r * dry_gain + wet_r * wet_gain;
         
-        // ✅ FIX: Use correct NaN check!
-        if (!is_finite(out_l)) out_l = 0.f;
-        if (!is_finite(out_r)) out_r = 0.f;
-        
         // Output limiting
         out[f * 2] = clipminmaxf(-1.f, out_l, 1.f);
         out[f * 2 + 1] = clipminmaxf(-1.f, out_r, 1.f);
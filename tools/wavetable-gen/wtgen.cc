@@ -0,0 +1,237 @@
+/**
+ *  @file wtgen.cc
+ *
+ *  @brief Generates band-limited wavetables as constant C arrays.
+ *
+ *  Reads a table description and writes a header with one array per
+ *  description, which units include so the tables are placed in flash
+ *  instead of being computed into RAM by unit_init(). See README.md for the
+ *  description format.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+  const double k_samplerate = 48000.0;
+
+  struct Table {
+    std::string name;
+    double divisor;
+    std::vector<int> harmonics;
+    std::vector<double> amplitudes;
+  };
+
+  struct Spec {
+    std::string name;
+    unsigned size;
+    unsigned levels;
+    double limit;
+    std::vector<Table> tables;
+    Spec() : size(512), levels(1), limit(20000.0) {}
+  };
+
+  bool fail(const char * path, unsigned line, const char * what) {
+    fprintf(stderr, "%s:%u: %s\n", path, line, what);
+    return false;
+  }
+
+  bool parse(const char * path, Spec * spec) {
+    FILE * fp = fopen(path, "r");
+    if (!fp) {
+      fprintf(stderr, "cannot read %s\n", path);
+      return false;
+    }
+    char buf[1024];
+    unsigned line = 0;
+    bool ok = true;
+    while (ok && fgets(buf, sizeof(buf), fp)) {
+      ++line;
+      char * hash = strchr(buf, '#');
+      if (hash)
+        *hash = 0;
+      char * tok = strtok(buf, " \t\r\n");
+      if (!tok)
+        continue;
+      char * arg = strtok(NULL, " \t\r\n");
+      if (!arg)
+        ok = fail(path, line, "missing value");
+      else if (!strcmp(tok, "name"))
+        spec->name = arg;
+      else if (!strcmp(tok, "size"))
+        spec->size = static_cast<unsigned>(atoi(arg));
+      else if (!strcmp(tok, "levels"))
+        spec->levels = static_cast<unsigned>(atoi(arg));
+      else if (!strcmp(tok, "limit"))
+        spec->limit = atof(arg);
+      else if (!strcmp(tok, "table")) {
+        Table t;
+        t.name = arg;
+        char * div = strtok(NULL, " \t\r\n");
+        t.divisor = div ? atof(div) : 0.0;
+        if (t.divisor <= 0.0)
+          ok = fail(path, line, "table needs a name and a divisor");
+        for (char * h = strtok(NULL, " \t\r\n"); ok && h; h = strtok(NULL, " \t\r\n")) {
+          const char * colon = strchr(h, ':');
+          const int n = atoi(h);
+          if (!colon || n < 1)
+            ok = fail(path, line, "harmonics are written <number>:<amplitude>");
+          t.harmonics.push_back(n);
+          t.amplitudes.push_back(colon ? atof(colon + 1) : 0.0);
+        }
+        if (ok && t.harmonics.empty())
+          ok = fail(path, line, "table has no harmonics");
+        spec->tables.push_back(t);
+      }
+      else
+        ok = fail(path, line, "unknown keyword");
+    }
+    fclose(fp);
+    if (!ok)
+      return false;
+    if (spec->name.empty() || spec->tables.empty())
+      return fail(path, line, "description needs a name and at least one table");
+    if (spec->size < 16 || (spec->size & (spec->size - 1)))
+      return fail(path, line, "size must be a power of two, at least 16");
+    if (spec->levels < 1 || (spec->size >> (spec->levels - 1)) < 8)
+      return fail(path, line, "too many levels for the table size");
+    return true;
+  }
+
+  std::string upper(const std::string & s) {
+    std::string r(s);
+    for (size_t i = 0; i < r.size(); ++i)
+      if (r[i] >= 'a' && r[i] <= 'z')
+        r[i] = static_cast<char>(r[i] - 'a' + 'A');
+    return r;
+  }
+
+  /** Shortest float literal that reads back as the same float. */
+  std::string literal(double v) {
+    if (fabs(v) < 1e-12)
+      v = 0.0;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.9g", static_cast<double>(static_cast<float>(v)));
+    std::string r(buf);
+    if (r.find_first_of(".e") == std::string::npos)
+      r += ".0";
+    return r + "f";
+  }
+
+  unsigned log2u(unsigned v) {
+    unsigned r = 0;
+    while (v >>= 1)
+      ++r;
+    return r;
+  }
+
+  void define(FILE * fp, const std::string & name, const std::string & value, const char * note = 0) {
+    if (note)
+      fprintf(fp, "#define %-24s (%s)  // %s\n", name.c_str(), value.c_str(), note);
+    else
+      fprintf(fp, "#define %-24s (%s)\n", name.c_str(), value.c_str());
+  }
+
+  bool write(const char * in_path, const char * out_path, const Spec & spec) {
+    FILE * fp = fopen(out_path, "w");
+    if (!fp) {
+      fprintf(stderr, "cannot write %s\n", out_path);
+      return false;
+    }
+
+    int max_harmonic = 1;
+    for (size_t t = 0; t < spec.tables.size(); ++t)
+      for (size_t h = 0; h < spec.tables[t].harmonics.size(); ++h)
+        if (spec.tables[t].harmonics[h] > max_harmonic)
+          max_harmonic = spec.tables[t].harmonics[h];
+
+    // Level 0 holds every harmonic up to this fundamental, each level above
+    // covers an octave more and keeps half the harmonics
+    const double w_base = spec.limit / max_harmonic / k_samplerate;
+    unsigned stride = 0;
+    for (unsigned l = 0; l < spec.levels; ++l)
+      stride += (spec.size >> l) + 1;
+
+    const char * base = strrchr(in_path, '/');
+    base = base ? base + 1 : in_path;
+    const std::string prefix = upper(spec.name);
+
+    fprintf(fp, "/*\n * Generated by tools/wavetable-gen from %s, do not edit.\n */\n\n", base);
+    fprintf(fp, "#pragma once\n\n");
+    const std::string count = std::to_string(spec.tables.size());
+    define(fp, prefix + "_SIZE_EXP", std::to_string(log2u(spec.size)));
+    define(fp, prefix + "_SIZE", std::to_string(spec.size));
+    define(fp, prefix + "_LEVELS", std::to_string(spec.levels));
+    define(fp, prefix + "_STRIDE", std::to_string(stride));
+    if (spec.levels > 1) {
+      char note[64];
+      snprintf(note, sizeof(note), "%.1f Hz, highest fundamental of level 0", w_base * k_samplerate);
+      define(fp, prefix + "_W_BASE", literal(w_base), note);
+    }
+    if (spec.tables.size() > 1) {
+      define(fp, prefix + "_COUNT", count);
+      for (size_t t = 0; t < spec.tables.size(); ++t)
+        define(fp, prefix + "_" + upper(spec.tables[t].name), std::to_string(t));
+    }
+    fprintf(fp, "\n");
+
+    if (spec.tables.size() > 1)
+      fprintf(fp, "static const float s_%s[%s_COUNT][%s_STRIDE] __attribute__((aligned(4))) = {\n",
+              spec.name.c_str(), prefix.c_str(), prefix.c_str());
+    else
+      fprintf(fp, "static const float s_%s[%s_STRIDE] __attribute__((aligned(4))) = {\n",
+              spec.name.c_str(), prefix.c_str());
+
+    for (size_t t = 0; t < spec.tables.size(); ++t) {
+      const Table & tab = spec.tables[t];
+      const char * ind = (spec.tables.size() > 1) ? "  " : "";
+      if (spec.tables.size() > 1)
+        fprintf(fp, "  { // %s\n", tab.name.c_str());
+      for (unsigned l = 0; l < spec.levels; ++l) {
+        const unsigned n = spec.size >> l;
+        const int keep = max_harmonic >> l;
+        if (spec.levels > 1 && l + 1 < spec.levels)
+          fprintf(fp, "%s  // level %u, %u samples, harmonics up to %d, fundamentals below %.0f Hz\n",
+                  ind, l, n, keep > 1 ? keep : 1, w_base * (1U << l) * k_samplerate);
+        else if (spec.levels > 1)
+          fprintf(fp, "%s  // level %u, %u samples, harmonics up to %d, higher fundamentals\n", ind, l, n, keep > 1 ? keep : 1);
+        for (unsigned i = 0; i <= n; ++i) {
+          // The last sample repeats the first so reads need no wrap
+          const double phase = static_cast<double>(i % n) / n;
+          double v = 0.0;
+          for (size_t h = 0; h < tab.harmonics.size(); ++h)
+            if (tab.harmonics[h] <= keep || tab.harmonics[h] == 1)
+              v += tab.amplitudes[h] * sin(2.0 * M_PI * tab.harmonics[h] * phase);
+          v /= tab.divisor;
+          fprintf(fp, "%s%s%s,", (i % 8) ? "" : ind, (i % 8) ? " " : "  ", literal(v).c_str());
+          if (i % 8 == 7 || i == n)
+            fprintf(fp, "\n");
+        }
+      }
+      if (spec.tables.size() > 1)
+        fprintf(fp, "  },\n");
+    }
+    fprintf(fp, "};\n");
+    fclose(fp);
+    return true;
+  }
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: wtgen <wavetables.txt> <wavetables.h>\n");
+    return 2;
+  }
+  Spec spec;
+  if (!parse(argv[1], &spec) || !write(argv[1], argv[2], spec))
+    return 1;
+  return 0;
+}
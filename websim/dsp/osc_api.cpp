@@ -48,9 +48,16 @@ typedef int32_t q31_t;
 
 #define __api_var __attribute__((aligned(4))) // TODO: may want to fix the ram location to be able to use MPU
 
+#if defined(HOSTSIM)
+// hostsim links the API into one executable, where code in the .oscapi.r* sections would share
+// an output section, and a segment, with the writable tables of the .c files. Keep it in .text.
+#define __api_data_r0 __attribute__((aligned(4)))
+#define __api_func_r0 __attribute__((used, optimize("Ofast")))
+#else
 // Keep API aligned after minor updates by appending additions by revision r0, r1, r2...
 #define __api_data_r0 __attribute__((used, section(".oscapi.r0"), aligned(4)))
 #define __api_func_r0 __attribute__((used, section(".oscapi.r0"), optimize("Ofast")))
+#endif
 
 /*===========================================================================*/
 /* Local types                                                               */
@@ -171,7 +178,8 @@ typedef struct NoiseFlt {
     mState = r2;
     
     
-    const float r1f = (uint32_t)r1 * scale;
+    // osc_sqrtm2logf() is only defined from k_sqrtm2log_base upwards
+    const float r1f = clipminf(k_sqrtm2log_base, (uint32_t)r1 * scale);
     const float r2f = (uint32_t)r2 * scale;
     
     //const float x = mean + var * (sqrtf(-2.f * si_logf(r1f)) * mSine.scan(r2f + 0.25f));